@@ -0,0 +1,104 @@
+#pragma once
+
+#include <M5Unified.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "LoudnessDetector.h"
+
+/**
+ * @brief Class listening to the built-in microphone for sudden loud sounds on a dedicated task
+ *
+ * The microphone driver fills blocks by DMA on its own task and keeps two
+ * of them queued. This task hands it one block after another and runs the
+ * loudness detector over each block as it completes, while the next two
+ * are recorded, so the animation only picks up a counter. The speaker
+ * shares the microphone's I2S port and is stopped while listening.
+ */
+class AudioInput {
+public:
+  // Capture settings
+  static constexpr uint32_t SAMPLE_RATE = 16000;
+  static constexpr uint16_t BLOCK_SAMPLES = 256;   // 16 ms per block
+  static constexpr uint8_t NUM_BLOCKS = 3;         // Two queued with the driver, one being processed
+  
+  // Listener task settings
+  static constexpr uint32_t TASK_STACK_SIZE = 4096;
+  static constexpr uint8_t TASK_PRIORITY = 2;      // Below the input sampler
+  static constexpr uint8_t TASK_CORE = 0;
+
+public:
+  /**
+   * @brief Constructor
+   */
+  AudioInput();
+  
+  /**
+   * @brief Start the microphone and the listener task
+   * @return Whether both were started
+   */
+  bool begin();
+  
+  /**
+   * @brief Check whether the listener task is running
+   * @return true if running
+   */
+  bool isRunning() const;
+  
+  /**
+   * @brief Set how far above the noise floor a sound must be to startle
+   * @param thresholdDb Threshold in dB (applied from the next block)
+   */
+  void setThresholdDb(uint8_t thresholdDb);
+  
+  /**
+   * @brief Take whether a loud sound started since the previous call
+   * @return true if at least one onset was detected
+   */
+  bool takeStartle();
+  
+  /**
+   * @brief Get the levels of the latest block
+   * @param level Receives the block RMS (full scale 32767)
+   * @param floor Receives the noise floor RMS
+   */
+  void getLevels(uint16_t& level, uint16_t& floor) const;
+  
+  /**
+   * @brief Get number of onsets since startup
+   * @return Onset count
+   */
+  uint32_t getOnsets() const;
+  
+  /**
+   * @brief Take the cost of the loudness detector since the previous call
+   * @param blocks Receives the number of blocks processed
+   * @param averageCycles Receives the average CPU cycles per block
+   * @param maxCycles Receives the largest CPU cycles for one block
+   */
+  void takeKernelCost(uint32_t& blocks, uint32_t& averageCycles, uint32_t& maxCycles);
+
+private:
+  TaskHandle_t task;                  // Listener task
+  int16_t blocks[NUM_BLOCKS][BLOCK_SAMPLES]; // Blocks handed to the driver in turn
+  LoudnessDetector detector;          // Finds onsets (listener task only)
+  std::atomic<uint8_t> thresholdDb;   // Threshold requested for the detector
+  std::atomic<uint32_t> startles;     // Onsets since takeStartle()
+  std::atomic<uint32_t> onsets;       // Onsets since startup
+  std::atomic<uint32_t> levels;       // Latest level in the low, floor in the high half
+  std::atomic<uint32_t> kernelBlocks; // Blocks processed since takeKernelCost()
+  std::atomic<uint32_t> kernelCycles; // CPU cycles spent processing them
+  std::atomic<uint32_t> kernelMaxCycles; // Most CPU cycles for one of them
+  
+  /**
+   * @brief Listener task body
+   * @param param AudioInput instance
+   */
+  static void taskLoop(void* param);
+  
+  /**
+   * @brief Run the detector over a completed block and publish the result
+   * @param block Block to process
+   */
+  void processBlock(const int16_t* block);
+};
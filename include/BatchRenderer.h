@@ -0,0 +1,102 @@
+#pragma once
+
+#include <M5Unified.h>
+#include "EyesAnimation.h"
+
+/**
+ * @brief Enumeration representing a scripted input action
+ */
+enum class TimelineAction {
+  TOUCH,    // Finger at (x, y); positions are interpolated between TOUCH entries
+  RELEASE,  // Finger lifted
+  SHAKE     // Device shaken
+};
+
+/**
+ * @brief Structure representing one entry of a scripted input timeline
+ */
+struct TimelineEvent {
+  uint32_t timeMs;        // Animation time of the entry
+  TimelineAction action;  // What happens
+  int16_t x;              // Touch position (TOUCH only)
+  int16_t y;
+};
+
+/**
+ * @brief Class rendering a scripted animation as fast as possible
+ *
+ * Runs a separate animation instance with injected input on a virtual clock
+ * that advances one frame period per frame, so a run is reproducible for a
+ * given seed and is not paced by the real frame rate. Frames are rendered
+ * into the sprites only and exported through a blocking FrameStreamer;
+ * tools/frame_decoder turns the captured stream into PGM images.
+ */
+class BatchRenderer {
+public:
+  // Batch settings
+  static constexpr uint32_t DEMO_DURATION_MS = 8000;  // Length of the built-in timeline
+  static constexpr uint32_t DEFAULT_SEED = 1;          // Seed for reproducible runs
+  static constexpr uint8_t MAX_BENCH_INSTANCES = 4;    // Most instances run side by side
+
+public:
+  /**
+   * @brief Constructor
+   * @param timeline Scripted input sorted by time (default: built-in demo)
+   * @param eventCount Number of timeline entries
+   * @param durationMs Length of the run
+   */
+  BatchRenderer(const TimelineEvent* timeline = DEMO_TIMELINE,
+                uint8_t eventCount = DEMO_EVENT_COUNT,
+                uint32_t durationMs = DEMO_DURATION_MS);
+  
+  /**
+   * @brief Render the whole timeline
+   * @param out Destination of the frame stream (nullptr to render only)
+   * @param seed Random seed of the animation
+   * @return Whether the run completed
+   */
+  bool run(Print* out, uint32_t seed = DEFAULT_SEED);
+  
+  /**
+   * @brief Print the result of the last run
+   * @param out Destination of the report
+   */
+  void printReport(Print& out) const;
+  
+  /**
+   * @brief Render the timeline with one to MAX_BENCH_INSTANCES instances side by side
+   * @param out Destination of the report (printed as each count completes)
+   * @param seed Random seed of every instance
+   * @return false if no instance could be set up or the frames of instances differ
+   *
+   * All instances share the virtual clock, seed and input, so they must draw
+   * the same frames as a single one; any state shared between instances
+   * shows up as a mismatch. Reports the render time per frame for each
+   * count to show how the cost scales.
+   */
+  bool printInstanceBenchmark(Print& out, uint32_t seed = DEFAULT_SEED);
+
+private:
+  static constexpr uint8_t DEMO_EVENT_COUNT = 7;
+  static const TimelineEvent DEMO_TIMELINE[DEMO_EVENT_COUNT];
+  
+  const TimelineEvent* timeline;  // Scripted input
+  uint8_t eventCount;             // Number of timeline entries
+  uint32_t durationMs;            // Length of the run
+  uint32_t frames;                // Frames rendered in the last run
+  uint32_t renderMicros;          // Time spent in the animation
+  uint32_t totalMicros;           // Time including export
+  uint32_t exportedBytes;         // Bytes written to the frame stream
+  uint32_t rawBytes;              // Raw sprite bytes of the exported frames
+  
+  /**
+   * @brief Inject the input for one frame
+   * @param eyes Animation instance
+   * @param nowMs Virtual time of the frame
+   * @param nextEvent Index of the next timeline entry (advanced in place)
+   * @param lastTouch Index of the latest TOUCH entry applied (updated in place)
+   * @param touching Whether a finger is down (updated in place)
+   */
+  void injectInput(EyesAnimation& eyes, uint32_t nowMs, uint8_t& nextEvent, uint8_t& lastTouch,
+                   bool& touching) const;
+};
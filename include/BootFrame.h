@@ -0,0 +1,16 @@
+#pragma once
+
+#include "EyeStyleFormat.h"
+
+/**
+ * @brief Prerendered first frame stored in flash
+ *
+ * White runs of both eyes with centered pupils, rendered in mono from the
+ * built-in style by tools/eyestyle_compiler. Runs are relative to the eye
+ * center, so the frame can be drawn straight to the display before any
+ * sprite has been rasterised.
+ */
+namespace BootFrame {
+  extern const EyeStyleFormat::Span SPANS[];  // Left eye runs, then right eye runs
+  extern const uint16_t SPAN_COUNTS[2];       // Runs per eye (0: left, 1: right)
+}
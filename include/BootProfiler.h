@@ -0,0 +1,27 @@
+#pragma once
+
+#include <M5Unified.h>
+
+/**
+ * @brief Startup phase timestamps
+ *
+ * Each mark records the time since application start at which a phase
+ * ended, so that the time to the first visible eyes can be measured and
+ * compared between builds. Works from global constructors.
+ */
+namespace BootProfiler {
+  // Maximum number of recorded phases
+  static constexpr uint8_t MAX_PHASES = 12;
+  
+  /**
+   * @brief Record the end of a startup phase
+   * @param phase Phase name (static string, shown in the report)
+   */
+  void mark(const char* phase);
+  
+  /**
+   * @brief Print phase timestamps and durations
+   * @param out Output stream
+   */
+  void printReport(Print& out);
+}
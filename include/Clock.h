@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Time source shared by the animation and its input handlers
+ * 
+ * Defaults to the Arduino millis()/micros(). Passing other functions lets
+ * several animation instances run against a simulated time base.
+ */
+class Clock {
+public:
+  using TimeFunction = unsigned long (*)();
+  
+  /**
+   * @brief Constructor
+   * @param millisFunction Millisecond time function (default: millis)
+   * @param microsFunction Microsecond time function (default: micros)
+   */
+  Clock(TimeFunction millisFunction = ::millis, TimeFunction microsFunction = ::micros)
+    : millisFunction(millisFunction), microsFunction(microsFunction) {}
+  
+  /**
+   * @brief Get current time in milliseconds
+   * @return Current time in milliseconds
+   */
+  uint32_t nowMillis() const {
+    return static_cast<uint32_t>(millisFunction());
+  }
+  
+  /**
+   * @brief Get current time in microseconds
+   * @return Current time in microseconds
+   */
+  uint32_t nowMicros() const {
+    return static_cast<uint32_t>(microsFunction());
+  }
+  
+private:
+  TimeFunction millisFunction;  // Millisecond time function
+  TimeFunction microsFunction;  // Microsecond time function
+};
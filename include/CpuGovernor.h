@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include "GovernorPolicy.h"
+
+/**
+ * @brief Class applying the CPU frequency chosen by a frequency policy
+ *
+ * The policy decides after every frame; the clock is only switched when
+ * the decision changes, and switches are counted for telemetry.
+ */
+class CpuGovernor {
+public:
+  /**
+   * @brief Constructor
+   */
+  CpuGovernor();
+  
+  /**
+   * @brief Start governing with a policy
+   * @param policy Decision function
+   * @param context Passed to the policy (must outlive the governor)
+   * @return false if no policy was given
+   */
+  bool begin(FrequencyPolicy policy, void* context);
+  
+  /**
+   * @brief Report a finished frame and apply the policy's decision
+   * @param load Load implied by the current state
+   * @param workMicros Frame work time
+   * @param budgetMicros Frame budget
+   */
+  void update(AnimationLoad load, uint32_t workMicros, uint32_t budgetMicros);
+  
+  /**
+   * @brief Check whether the governor is running
+   * @return true if begin() succeeded
+   */
+  bool isRunning() const;
+  
+  /**
+   * @brief Get current CPU frequency
+   * @return Frequency in MHz
+   */
+  uint16_t getFrequencyMhz() const;
+  
+  /**
+   * @brief Get number of frequency switches
+   * @return Switch count
+   */
+  uint32_t getSwitches() const;
+
+private:
+  FrequencyPolicy policy;  // Decision function (nullptr: not running)
+  void* context;           // Passed to the policy
+  uint16_t frequencyMhz;   // Current CPU frequency
+  uint32_t switches;       // Frequency switches
+};
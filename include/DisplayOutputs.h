@@ -0,0 +1,87 @@
+#pragma once
+
+#include <M5Unified.h>
+#include "DisplaySink.h"
+
+/**
+ * @brief Class sending eye frames to every registered display sink
+ *
+ * Changed rows are tracked per sink and per eye: each sink receives the
+ * union of everything drawn since it last took that eye, so a sink that
+ * skips frames (or only shows one eye) never misses a change and never
+ * receives rows it already has. Newly added sinks start with the whole
+ * sprite pending.
+ */
+class DisplayOutputs {
+public:
+  // Output settings
+  static constexpr uint8_t MAX_SINKS = 4;
+  static constexpr uint8_t MAX_EYES = 2;
+  static constexpr uint8_t ALL_EYES = (1 << MAX_EYES) - 1;
+
+public:
+  /**
+   * @brief Constructor
+   */
+  DisplayOutputs();
+  
+  /**
+   * @brief Register a sink
+   * @param name Name shown in the report (must outlive the outputs)
+   * @param sink Sink function
+   * @param context Passed to the sink (must outlive the outputs)
+   * @param eyeMask Eyes the sink shows (bit 0: left, bit 1: right)
+   * @return false if the sink table is full or no sink was given
+   */
+  bool add(const char* name, DisplaySink sink, void* context, uint8_t eyeMask = ALL_EYES);
+  
+  /**
+   * @brief Record rows drawn into an eye sprite
+   * @param eyeIndex Eye index
+   * @param rows Rows drawn
+   */
+  void markDirty(uint8_t eyeIndex, const DirtyRows& rows);
+  
+  /**
+   * @brief Mark every eye as completely changed for every sink (e.g. after drawing over the panel)
+   */
+  void invalidate();
+  
+  /**
+   * @brief Offer an eye's pending rows to every sink that shows it
+   * @param eyeIndex Eye index
+   * @param eye Eye to send
+   * @param nowMs Current time
+   */
+  void present(uint8_t eyeIndex, Eye& eye, uint32_t nowMs);
+  
+  /**
+   * @brief Get number of registered sinks
+   * @return Sink count
+   */
+  uint8_t getCount() const;
+  
+  /**
+   * @brief Print frames, skips and sprite bytes sent per sink
+   * @param out Output (e.g. Serial)
+   */
+  void printReport(Print& out) const;
+
+private:
+  /**
+   * @brief Structure holding one registered sink
+   */
+  struct Entry {
+    const char* name;              // Name shown in the report
+    DisplaySink sink;              // Sink function
+    void* context;                 // Passed to the sink
+    uint8_t eyeMask;               // Eyes the sink shows
+    DirtyRows pending[MAX_EYES];   // Rows changed since the sink last took each eye
+    uint32_t frames;               // Eye frames taken
+    uint32_t skipped;              // Eye frames refused
+    uint32_t bytes;                // Sprite bytes in the rows taken
+  };
+  
+  Entry entries[MAX_SINKS];  // Registered sinks
+  uint8_t count;             // Number of registered sinks
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <M5Unified.h>
+#include "Eye.h"
+#include "MemoryBudget.h"
+
+/**
+ * @brief Output for eye frames: receives one eye and the rows changed since it last took that eye
+ *
+ * Returns false if the frame was not taken (e.g. no bandwidth left); the
+ * rows are then offered again, merged with later changes, on the next
+ * frame. Sinks are registered with DisplayOutputs.
+ */
+using DisplaySink = bool (*)(void* context, uint8_t eyeIndex, Eye& eye, const DirtyRows& rows, uint32_t nowMs);
+
+/**
+ * @brief Sink pushing eyes to a panel driven by M5GFX/LovyanGFX
+ *
+ * Drives the built-in LCD, where each eye goes to its own sprite position,
+ * or an extra SPI/I2C panel showing a single eye at a fixed position.
+ * Only the changed rows are transferred.
+ */
+class PanelSink {
+public:
+  /**
+   * @brief Constructor for a panel showing each eye at its sprite position
+   * @param display Panel (must outlive the sink)
+   */
+  explicit PanelSink(lgfx::LovyanGFX* display);
+  
+  /**
+   * @brief Constructor for a panel showing an eye at a fixed position
+   * @param display Panel (must outlive the sink)
+   * @param x X coordinate of the sprite on the panel
+   * @param y Y coordinate of the sprite on the panel
+   */
+  PanelSink(lgfx::LovyanGFX* display, int16_t x, int16_t y);
+  
+  /**
+   * @brief DisplaySink entry point
+   * @param context PanelSink instance
+   * @param eyeIndex Eye index
+   * @param eye Eye to push
+   * @param rows Rows to push
+   * @param nowMs Current time
+   * @return Always true
+   */
+  static bool write(void* context, uint8_t eyeIndex, Eye& eye, const DirtyRows& rows, uint32_t nowMs);
+
+private:
+  lgfx::LovyanGFX* display;  // Panel
+  Point origin;              // Fixed sprite position
+  bool fixedOrigin;          // false: use each eye's sprite position
+};
+
+/**
+ * @brief Sink keeping a copy of the latest frame of each eye in memory
+ *
+ * Copies only the changed rows. Useful to check what a multi-panel setup
+ * received and to measure throughput without a panel attached.
+ */
+class MemorySink {
+public:
+  static constexpr uint8_t MAX_EYES = 2;
+
+public:
+  /**
+   * @brief Constructor
+   */
+  MemorySink();
+  
+  /**
+   * @brief Destructor
+   */
+  ~MemorySink();
+  
+  /**
+   * @brief Allocate one frame buffer per eye
+   * @param placement Where to put the buffers
+   * @return Whether buffers were allocated
+   */
+  bool begin(MemoryPlacement placement);
+  
+  /**
+   * @brief DisplaySink entry point
+   * @param context MemorySink instance
+   * @param eyeIndex Eye index
+   * @param eye Eye to copy
+   * @param rows Rows to copy
+   * @param nowMs Current time
+   * @return false if begin() has not succeeded
+   */
+  static bool write(void* context, uint8_t eyeIndex, Eye& eye, const DirtyRows& rows, uint32_t nowMs);
+  
+  /**
+   * @brief Get the latest frame of an eye
+   * @param eyeIndex Eye index
+   * @return Frame buffer in the sprite's layout (nullptr before begin())
+   */
+  const uint8_t* getFrame(uint8_t eyeIndex) const;
+  
+  /**
+   * @brief Get number of bytes copied
+   * @return Copied byte count
+   */
+  uint32_t getCopiedBytes() const;
+
+private:
+  uint8_t* frames[MAX_EYES];  // Latest frame per eye
+  uint32_t copiedBytes;       // Statistics
+};
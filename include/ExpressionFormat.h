@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Binary layout of an expression library
+ *
+ * Shared by the firmware and tools/expression_compiler, so it only depends
+ * on <stdint.h>. Like an eye style asset, all fields are little endian and
+ * naturally aligned so that a library can be read in place.
+ *
+ *   Header
+ *   Expression[expressionCount]  at expressionOffset
+ *   Track[]                      at each expression's trackOffset
+ *   Key[]                        at each track's keyOffset (ascending time)
+ *
+ * Offsets are from the start of the library. The checksum covers every
+ * byte after the header and is computed like an eye style's
+ * (EyeStyleFormat::checksum).
+ */
+namespace ExpressionFormat {
+  static constexpr char MAGIC[4] = { 'E', 'X', 'P', 'R' };
+  static constexpr uint16_t VERSION = 1;
+  static constexpr uint8_t NAME_LENGTH = 12;  // Including the terminating NUL
+  
+  /**
+   * @brief What a track animates
+   *
+   * Pupil offsets are in percent of the pupil travel range, lids in percent
+   * of the way from the sclera rim to the eye center, and the pupil scale
+   * in percent of the style's pupil size.
+   */
+  enum Channel : uint8_t {
+    CHANNEL_PUPIL_X = 0,      // -100 (left) .. 100 (right)
+    CHANNEL_PUPIL_Y = 1,      // -100 (up) .. 100 (down)
+    CHANNEL_LID_TOP = 2,      // 0 (open) .. 100 (down to the center)
+    CHANNEL_LID_BOTTOM = 3,   // 0 (open) .. 100 (up to the center)
+    CHANNEL_PUPIL_SCALE = 4,  // 25 .. 200
+    CHANNEL_COUNT = 5
+  };
+  
+  /**
+   * @brief How a key is approached from the previous one
+   */
+  enum Easing : uint8_t {
+    EASE_STEP = 0,    // Hold the previous value, then jump
+    EASE_LINEAR = 1,
+    EASE_IN = 2,      // Quadratic, slow start
+    EASE_OUT = 3,     // Quadratic, slow end
+    EASE_IN_OUT = 4,  // Smoothstep
+    EASE_COUNT = 5
+  };
+  
+  /**
+   * @brief Library header
+   */
+  struct Header {
+    char magic[4];             // "EXPR"
+    uint16_t version;          // Format version
+    uint16_t headerSize;       // sizeof(Header)
+    uint32_t totalSize;        // Size of the whole library in bytes
+    uint32_t checksum;         // FNV-1a over bytes [headerSize, totalSize)
+    uint8_t expressionCount;   // Number of expressions
+    uint8_t reserved[3];
+    uint32_t expressionOffset; // Offset of the expression table
+  };
+  
+  /**
+   * @brief Named set of tracks played together
+   */
+  struct Expression {
+    char name[NAME_LENGTH];  // NUL-terminated
+    uint16_t durationMs;     // Time the expression is held for (at least its last key)
+    uint8_t trackCount;      // Number of tracks (at most one per channel)
+    uint8_t reserved;
+    uint32_t trackOffset;    // Offset of the first track
+  };
+  
+  /**
+   * @brief Keyframes of one channel
+   *
+   * The value before the first key is the first key's, and the value after
+   * the last key is held.
+   */
+  struct Track {
+    uint8_t channel;    // Channel
+    uint8_t reserved;
+    uint16_t keyCount;  // Number of keys (at least one)
+    uint32_t keyOffset; // Offset of the first key
+  };
+  
+  /**
+   * @brief Channel value at a point in time
+   */
+  struct Key {
+    uint16_t timeMs;  // Time from the start of the expression
+    int16_t value;    // Channel value
+    uint8_t easing;   // Easing from the previous key to this one
+    uint8_t reserved;
+  };
+  
+  static_assert(sizeof(Header) == 24, "Unexpected expression header size");
+  static_assert(sizeof(Expression) == 20, "Unexpected expression size");
+  static_assert(sizeof(Track) == 8, "Unexpected expression track size");
+  static_assert(sizeof(Key) == 6, "Unexpected expression key size");
+  
+  /**
+   * @brief Get the valid value range of a channel
+   * @param channel Channel
+   * @param minValue Receives the smallest value
+   * @param maxValue Receives the largest value
+   */
+  inline void getRange(uint8_t channel, int16_t& minValue, int16_t& maxValue) {
+    switch (channel) {
+      case CHANNEL_PUPIL_X:
+      case CHANNEL_PUPIL_Y:
+        minValue = -100;
+        maxValue = 100;
+        return;
+      case CHANNEL_PUPIL_SCALE:
+        minValue = 25;
+        maxValue = 200;
+        return;
+      default:
+        minValue = 0;
+        maxValue = 100;
+        return;
+    }
+  }
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <stdint.h>
+#include "ExpressionFormat.h"
+
+/**
+ * @brief Built-in expression library (generated by tools/expression_compiler)
+ */
+namespace ExpressionData {
+  extern const uint8_t DEFAULT_EXPRESSIONS[];
+  extern const uint32_t DEFAULT_EXPRESSIONS_SIZE;
+}
+
+/**
+ * @brief Structure holding the value of every expression channel
+ */
+struct ExpressionPose {
+  int16_t values[ExpressionFormat::CHANNEL_COUNT];  // Indexed by ExpressionFormat::Channel
+  
+  /**
+   * @brief Get the pose of a neutral eye (centered pupil, open lids, style-sized pupil)
+   * @return Neutral pose
+   */
+  static ExpressionPose neutral() {
+    ExpressionPose pose = {};
+    pose.values[ExpressionFormat::CHANNEL_PUPIL_SCALE] = 100;
+    return pose;
+  }
+};
+
+/**
+ * @brief Class giving read-only access to an expression library
+ *
+ * Like EyeStyle, the library is never copied: accessors point straight into
+ * the built-in array or the buffer passed to load(). Only depends on
+ * <stdint.h>, so tools/expression_compiler can evaluate libraries on the
+ * host with the same code.
+ */
+class ExpressionLibrary {
+public:
+  /**
+   * @brief Constructor (starts with the built-in library)
+   */
+  ExpressionLibrary();
+  
+  /**
+   * @brief Use a library that stays valid for the lifetime of this object
+   * @param data Library bytes (must be 4-byte aligned)
+   * @param size Number of bytes available
+   * @return false if the library is malformed (the previous one stays in use)
+   */
+  bool load(const uint8_t* data, uint32_t size);
+  
+  /**
+   * @brief Check whether the built-in library is in use
+   * @return true if no other library has been loaded
+   */
+  bool isBuiltIn() const;
+  
+  /**
+   * @brief Get size of the library in use
+   * @return Size in bytes
+   */
+  uint32_t getSize() const;
+  
+  /**
+   * @brief Get number of expressions
+   * @return Expression count
+   */
+  uint8_t getCount() const;
+  
+  /**
+   * @brief Get an expression
+   * @param index Expression index (less than getCount())
+   * @return Expression
+   */
+  const ExpressionFormat::Expression& getExpression(uint8_t index) const;
+  
+  /**
+   * @brief Get the tracks of an expression
+   * @param expression Expression
+   * @return First of expression.trackCount tracks
+   */
+  const ExpressionFormat::Track* getTracks(const ExpressionFormat::Expression& expression) const;
+  
+  /**
+   * @brief Get the keys of a track
+   * @param track Track
+   * @return First of track.keyCount keys
+   */
+  const ExpressionFormat::Key* getKeys(const ExpressionFormat::Track& track) const;
+  
+  /**
+   * @brief Find an expression by name
+   * @param name Expression name
+   * @return Expression index, or -1 if there is none
+   */
+  int16_t find(const char* name) const;
+
+private:
+  const uint8_t* data;                     // Library in use
+  uint32_t size;                           // Size of the library
+  const ExpressionFormat::Header* header;  // Header of the library
+  
+  /**
+   * @brief Check that a library is well formed
+   * @param data Library bytes
+   * @param size Number of bytes available
+   * @return true if every table lies inside the library, keys are in order and the checksum matches
+   */
+  static bool validate(const uint8_t* data, uint32_t size);
+};
+
+/**
+ * @brief Class evaluating one expression frame by frame
+ *
+ * Each track keeps a cursor on its current key pair, so a frame only
+ * compares the elapsed time against the next key and interpolates; tracks
+ * past their last key drop out of the active set. A frame therefore costs
+ * O(active tracks) with no allocation, and keys are read in place from the
+ * library.
+ */
+class ExpressionPlayer {
+public:
+  static constexpr uint8_t MAX_TRACKS = ExpressionFormat::CHANNEL_COUNT;
+
+public:
+  /**
+   * @brief Constructor (nothing playing, neutral pose)
+   */
+  ExpressionPlayer();
+  
+  /**
+   * @brief Start an expression
+   * @param library Library holding the expression (must outlive the playback)
+   * @param index Expression index
+   * @param nowMs Current time (time zero of the keys)
+   * @return false if there is no such expression
+   */
+  bool start(const ExpressionLibrary& library, uint8_t index, uint32_t nowMs);
+  
+  /**
+   * @brief Stop playing and return to the neutral pose
+   */
+  void stop();
+  
+  /**
+   * @brief Move the pose to the current time
+   * @param nowMs Current time (not before the previous call)
+   * @return true if any channel changed
+   */
+  bool advance(uint32_t nowMs);
+  
+  /**
+   * @brief Get the current pose
+   * @return Pose as of the latest advance()
+   */
+  const ExpressionPose& getPose() const;
+  
+  /**
+   * @brief Get how long the current expression is held for
+   * @return Duration in milliseconds (0 if nothing was started)
+   */
+  uint32_t getDurationMs() const;
+  
+  /**
+   * @brief Get number of tracks still moving
+   * @return Active track count (0 once every track is past its last key)
+   */
+  uint8_t getActiveTracks() const;
+  
+  /**
+   * @brief Apply an easing curve
+   * @param easing ExpressionFormat::Easing
+   * @param progress Progress between two keys (0 .. 256)
+   * @return Eased progress (0 .. 256)
+   */
+  static int32_t ease(uint8_t easing, int32_t progress);
+
+private:
+  /**
+   * @brief Structure holding the playback position of one track
+   */
+  struct Cursor {
+    const ExpressionFormat::Key* keys;  // Keys of the track
+    uint16_t keyCount;                  // Number of keys
+    uint16_t index;                     // Latest key not after the elapsed time
+    uint8_t channel;                    // Channel written
+  };
+  
+  Cursor cursors[MAX_TRACKS];  // Active tracks first
+  uint8_t activeCount;         // Number of active tracks
+  uint32_t startMs;            // Time zero of the keys
+  uint32_t durationMs;         // How long the expression is held for
+  ExpressionPose pose;         // Current value of every channel
+};
@@ -2,6 +2,12 @@
 
 #include <M5Unified.h>
 #include "TouchHandler.h"
+#include "EyePalette.h"
+#include "EyeStyle.h"
+#include "ExpressionTimeline.h"
+#include "GazeTable.h"
+#include "PupilMotion.h"
+#include "ScreenLayout.h"
 
 /**
  * @brief Enumeration representing eye state
@@ -9,7 +15,8 @@
 enum class EyeState {
   NORMAL,    // Normal state
   GAZING,    // Gaze following state
-  DIZZY      // Dizzy state
+  DIZZY,     // Dizzy state
+  EXPRESSION // Keyframed expression state
 };
 
 /**
@@ -21,40 +28,114 @@ enum class BlinkState {
   CLOSED          // Completely closed
 };
 
+/**
+ * @brief Enumeration representing sprite color mode
+ */
+enum class ColorMode {
+  MONO,      // 1-bit black and white
+  PALETTE    // 4-bit palette-indexed with iris color and blended edge rings
+};
+
+/**
+ * @brief Structure giving read-only access to a sprite buffer
+ */
+struct SpriteView {
+  const uint8_t* buffer;  // Packed pixel data (rows padded to whole bytes)
+  uint32_t length;        // Buffer length in bytes
+  uint16_t width;         // Width in pixels (in the panel's scan order)
+  uint16_t height;        // Height in pixels (in the panel's scan order)
+  uint8_t colorDepth;     // Bits per pixel
+  int16_t x;              // X coordinate on the display
+  int16_t y;              // Y coordinate on the display
+};
+
+/**
+ * @brief Structure representing a band of sprite rows (in the panel's scan order)
+ */
+struct DirtyRows {
+  uint16_t top;     // First row
+  uint16_t bottom;  // One past the last row (empty if not below top)
+  
+  DirtyRows() : top(0), bottom(0) {}
+  DirtyRows(uint16_t _top, uint16_t _bottom) : top(_top), bottom(_bottom) {}
+  
+  bool isEmpty() const {
+    return bottom <= top;
+  }
+  
+  void add(const DirtyRows& other) {
+    if (other.isEmpty()) {
+      return;
+    }
+    if (isEmpty()) {
+      *this = other;
+      return;
+    }
+    top = (other.top < top) ? other.top : top;
+    bottom = (other.bottom > bottom) ? other.bottom : bottom;
+  }
+};
 
 /**
  * @brief Class managing a single eye
  */
 class Eye {
 public:
-  // Eye settings
-  static constexpr uint8_t EYE_RADIUS_X = 60;
-  static constexpr uint8_t EYE_RADIUS_Y = 75;
-  static constexpr uint8_t PUPIL_RADIUS_X = 10;
-  static constexpr uint8_t PUPIL_RADIUS_Y = 13;
-  
-  // Sprite settings
-  static constexpr uint8_t SPRITE_WIDTH = 160;
-  static constexpr uint8_t SPRITE_HEIGHT = 155;
-  
-  // Eye position
-  static constexpr uint8_t EYE_BASE_Y = 120;
-  static constexpr uint8_t EYE_LEFT_X = 80;
-  static constexpr uint8_t EYE_RIGHT_X = 240;
-  static constexpr uint8_t DISPLAY_BASE_Y = 43;
+  // Sprite settings (eye shapes come from the EyeStyle asset)
+  // Sprites cover the sclera's bounding box only; the black surround is drawn once at startup
+  static constexpr uint8_t SCLERA_RADIUS_X = 60;  // Largest sclera a style can draw unclipped
+  static constexpr uint8_t SCLERA_RADIUS_Y = 75;
+  static constexpr uint8_t SPRITE_WIDTH = SCLERA_RADIUS_X * 2 + 1;
+  static constexpr uint8_t SPRITE_HEIGHT = SCLERA_RADIUS_Y * 2 + 1;
+  
+  // Color settings
+  // MONO:    1-bit sprites, 2,416 bytes per eye
+  // PALETTE: 4-bit sprites, 9,211 bytes per eye (RGB565 would need 36,542)
+  // Draw and push times of both: eyes_tune colors (EyesDiagnostics::printColorModeBenchmark)
+  static constexpr ColorMode COLOR_MODE = ColorMode::MONO;
+  static constexpr uint8_t SPRITE_COLOR_DEPTH = (COLOR_MODE == ColorMode::PALETTE) ? 4 : 1;
+  static constexpr uint8_t DISPLAY_COLOR_DEPTH = (COLOR_MODE == ColorMode::PALETTE) ? 16 : 1;
+  static constexpr uint32_t SPRITE_BYTES_LANDSCAPE =  // Rows are padded to whole bytes
+    (static_cast<uint32_t>(SPRITE_WIDTH) * SPRITE_COLOR_DEPTH + 7) / 8 * SPRITE_HEIGHT;
+  static constexpr uint32_t SPRITE_BYTES_PORTRAIT =    // Pre-rotated: rows run along the eye's height
+    (static_cast<uint32_t>(SPRITE_HEIGHT) * SPRITE_COLOR_DEPTH + 7) / 8 * SPRITE_WIDTH;
+  static constexpr uint32_t SPRITE_BYTES =
+    (SPRITE_BYTES_LANDSCAPE > SPRITE_BYTES_PORTRAIT) ? SPRITE_BYTES_LANDSCAPE : SPRITE_BYTES_PORTRAIT;
+  static constexpr uint32_t SPRITE_MEMORY_BUDGET = 32768;  // Both eyes
+  
+  // Gaze table cell size as a power of two: 8 px cells, 5,084 bytes per eye (see GazeTable)
+  static constexpr uint8_t GAZE_TABLE_CELL_SHIFT = 3;
   
 public:
   /**
    * @brief Constructor
-   * @param baseX Center X coordinate of the eye
-   * @param baseY Center Y coordinate of the eye
-   * @param displayX X coordinate on the display
-   * @param displayY Y coordinate on the display
-   * @param pupilOffsetX X offset for pupil drawing (default: 0)
-   * @param pupilOffsetY Y offset for pupil drawing (default: 0)
+   * 
+   * The layout places the eye; the sprite is centered on it and stored
+   * rotated into the panel's scan order, so its place on the display
+   * follows from the center, the sprite size and the mount rotation.
+   * 
+   * @param layout Screen layout (must outlive the eye)
+   * @param style Eye style (must outlive the eye)
+   * @param side Which eye this is in the style and the layout (0: left, 1: right)
    */
-  Eye(int16_t baseX, int16_t baseY, int16_t displayX, int16_t displayY,
-       int16_t pupilOffsetX = 0, int16_t pupilOffsetY = 0);
+  Eye(const ScreenLayout& layout, const EyeStyle& style, uint8_t side);
+  
+  /**
+   * @brief Destructor
+   */
+  ~Eye();
+  
+  /**
+   * @brief Check whether the sprite buffer was allocated
+   * @return true if the eye can be drawn
+   */
+  bool isReady() const;
+  
+  /**
+   * @brief Get center coordinates of the eye
+   * @return Center coordinates
+   */
+  const Point& getBasePoint() const;
   
   /**
    * @brief Clear the eye
@@ -72,17 +153,19 @@ public:
   void resetPupil();
   
   /**
-   * @brief Draw pupil in the center (with small random movements)
+   * @brief Move pupil towards the center (with small random movements)
    * @param saccades Amount of small movements
+   * @param steps PupilMotion steps elapsed since the previous move
    */
-  void drawCenterPupil(const Point& saccades);
+  void drawCenterPupil(const Point& saccades, uint8_t steps);
   
   /**
-   * @brief Draw gaze-following pupil
+   * @brief Move gaze-following pupil towards its target
    * @param targetPoint Target point of the gaze
    * @param saccades Amount of small movements
+   * @param steps PupilMotion steps elapsed since the previous move
    */
-  void drawGazingPupil(const Point& targetPoint, const Point& saccades);
+  void drawGazingPupil(const Point& targetPoint, const Point& saccades, uint8_t steps);
   
   /**
    * @brief Draw dizzy effect pupil
@@ -97,19 +180,107 @@ public:
    */
   void drawBlink(BlinkState state);
   
+  /**
+   * @brief Draw an expression pose (pupil offset and scale, eyelids)
+   * @param pose Pose to draw
+   * 
+   * Only what changed since the previous pose is redrawn. Lids drawn here
+   * are independent of the blink lids, so blinks should not run meanwhile.
+   */
+  void drawPose(const ExpressionPose& pose);
+  
+  /**
+   * @brief Set the share of the pupil travel range actually used
+   * @param percent Margin in percent (the eye style provides the default)
+   */
+  void setPupilMargin(uint8_t percent);
+  
+  /**
+   * @brief Set how quickly the pupil follows small target changes
+   * @param rate Pursuit spring rate in 1/s (see PupilMotion)
+   */
+  void setPursuitRate(float rate);
+  
+  /**
+   * @brief Look gaze positions up in a precomputed table instead of computing them
+   * @param cellShift Cell size as a power of two (see GazeTable)
+   * @return false if the table cannot be allocated (the exact path stays in use)
+   */
+  bool enableGazeTable(uint8_t cellShift);
+  
+  /**
+   * @brief Compare a gaze table against the exact path at every screen pixel, saccades included
+   * @param cellShift Cell size as a power of two
+   * @param maxError Receives the largest distance between the two pupil positions in pixels
+   * @param mismatches Receives the number of pixels where the two differ
+   * @return false if the temporary table cannot be allocated
+   */
+  bool measureGazeTable(uint8_t cellShift, float& maxError, uint32_t& mismatches) const;
+  
+  /**
+   * @brief Draw and push a circling pupil in a temporary sprite of the given color mode
+   * @param mode Color mode to measure (need not be COLOR_MODE)
+   * @param display Display to push to (set to the mode's DISPLAY_COLOR_DEPTH by the caller)
+   * @param frames Number of frames
+   * @param spriteBytes Receives the sprite buffer size
+   * @param drawMicros Receives the total draw time
+   * @param pushMicros Receives the total push time
+   * @return false if the temporary sprite cannot be allocated
+   */
+  bool measureColorMode(ColorMode mode, M5GFX* display, uint16_t frames, uint32_t& spriteBytes,
+                        uint32_t& drawMicros, uint32_t& pushMicros) const;
+  
   /**
    * @brief Render sprite to display
    * @param display Display object
    */
   void render(M5GFX* display);
   
+  /**
+   * @brief Push part of the sprite to a display
+   * @param display Display (or any other target)
+   * @param x X coordinate of the sprite on the target
+   * @param y Y coordinate of the sprite on the target
+   * @param rows Rows to transfer (clamped to the sprite)
+   */
+  void render(lgfx::LovyanGFX* display, int16_t x, int16_t y, const DirtyRows& rows);
+  
+  /**
+   * @brief Get the rows drawn since the previous call and start collecting anew
+   * @return Rows drawn (empty if the sprite is unchanged)
+   */
+  DirtyRows takeDirtyRows();
+  
+  /**
+   * @brief Draw the prerendered first frame straight to the display
+   * @param display Display object (the eye area must already be black)
+   */
+  void renderBootFrame(M5GFX* display) const;
+  
+  /**
+   * @brief Get read-only view of the sprite buffer
+   * @return Sprite view (buffer is nullptr if the eye is not ready)
+   */
+  SpriteView getSpriteView() const;
+  
 private:
+  const ScreenLayout& layout; // Logical screen and mount rotation
   Point basePoint;       // Center coordinates of eye
-  Point displayOffset;   // Offset on display
+  Point spriteOrigin;    // Top-left corner of the sprite in logical coordinates
+  Point displayOffset;   // Top-left corner of the pre-rotated sprite on the panel
   Point pupilPosition;   // Current position of pupil
-  Point pupilDrawOffset; // Offset for pupil drawing only
+  const EyeStyle& style; // Shapes, pupil offset and eyelids
+  uint8_t side;          // Which eye this is in the style (0: left, 1: right)
+  uint8_t pupilMarginPercent; // Share of the pupil travel range used
+  uint8_t pupilScalePercent; // Pupil size relative to the style (expressions)
+  uint8_t lidTopPercent;     // Upper lid drawn by drawPose() (0: none)
+  uint8_t lidBottomPercent;  // Lower lid drawn by drawPose() (0: none)
   BlinkState lastBlinkState; // Previous blink state
   M5Canvas canvas;       // Canvas for drawing
+  GazeTable gazeTable;   // Screen point to pupil offset (not built: exact path)
+  PupilMotion motion;    // Moves the pupil towards CENTER and GAZING targets
+  DirtyRows dirtyRows;   // Rows drawn since takeDirtyRows()
+  bool ready;            // Whether the sprite buffer was allocated
   
   /**
    * @brief Erase the pupil
@@ -127,13 +298,62 @@ private:
    */
   void updatePupil(const Point& newPosition);
   
+  /**
+   * @brief Move the pupil towards a position with the motion model
+   * @param target Position the pupil is heading for
+   * @param steps PupilMotion steps to take
+   */
+  void moveTowards(const Point& target, uint8_t steps);
+  
   /**
    * @brief Calculate pupil position for gaze following
    * @param targetPoint Target point of the gaze
    * @param saccades Amount of small movements
    * @return New position of the pupil
    */
-  Point computeGazingPosition(const Point& targetPoint, const Point& saccades);
+  Point computeGazingPosition(const Point& targetPoint, const Point& saccades) const;
+  
+  /**
+   * @brief Calculate pupil position for gaze following from a gaze table
+   * @param table Built gaze table
+   * @param targetPoint Target point of the gaze
+   * @param saccades Amount of small movements
+   * @return New position of the pupil
+   */
+  Point lookupGazingPosition(const GazeTable& table, const Point& targetPoint, const Point& saccades) const;
+  
+  /**
+   * @brief Calculate pupil position for gaze following without a gaze table
+   * @param targetPoint Target point of the gaze
+   * @param saccades Amount of small movements
+   * @return New position of the pupil
+   */
+  Point computeExactGazingPosition(const Point& targetPoint, const Point& saccades) const;
+  
+  /**
+   * @brief Clamp the offset to a target point to the pupil travel range (GazeTable::ExactMapping)
+   * @param context Eye instance
+   * @param x Target X coordinate
+   * @param y Target Y coordinate
+   * @param offsetX Receives the clamped offset X
+   * @param offsetY Receives the clamped offset Y
+   */
+  static void computeTravelOffset(const void* context, int16_t x, int16_t y, float& offsetX, float& offsetY);
+  
+  /**
+   * @brief Check whether an offset lies within the pupil travel range
+   * @param offset Offset from the eye center
+   * @return true if the offset is inside the margin-scaled travel ellipse
+   */
+  bool isWithinTravel(const Point& offset) const;
+  
+  /**
+   * @brief Scale an offset that left the pupil travel range back onto it
+   * @param offset Offset from the eye center (e.g. a table offset plus saccades)
+   * @param direction Offset whose angle sets the travel radius (the offset before the saccades)
+   * @return offset itself if within range, otherwise scaled as the second clamp of the exact path does
+   */
+  Point clampToTravel(const Point& offset, const Point& direction) const;
   
   /**
    * @brief Convert global coordinates to local coordinates within the sprite
@@ -143,10 +363,84 @@ private:
   Point toLocalCoordinates(const Point& globalPoint) const;
   
   /**
-   * @brief Draw pupil with specified color
-   * @param color Drawing color
+   * @brief Fill a rectangle given in unrotated sprite coordinates
+   * @param x Rectangle X
+   * @param y Rectangle Y
+   * @param w Rectangle width
+   * @param h Rectangle height
+   * @param fillColor Fill color
    */
-  void drawPupilWithColor(uint16_t color);
+  void fillLocalRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t fillColor);
+  
+  /**
+   * @brief Draw the style layers of one target in the current color mode
+   * @param target EyeStyleFormat::Target
+   * @param center Local coordinates of the layer origin
+   * @param erase true to draw every layer in the sclera color
+   */
+  void drawLayers(uint8_t target, const Point& center, bool erase);
+  
+  /**
+   * @brief Draw the unscaled style layers of one target into another sprite
+   * @param sprite Sprite the size of this eye's
+   * @param target EyeStyleFormat::Target
+   * @param mode Color mode whose layers and colors to use
+   * @param center Local coordinates of the layer origin
+   * @param erase true to draw every layer in the sclera color
+   */
+  void fillLayers(M5Canvas& sprite, uint8_t target, ColorMode mode, const Point& center, bool erase) const;
+  
+  /**
+   * @brief Get local coordinates of the pupil layer origin
+   * @return Pupil position plus the style's pupil offset
+   */
+  Point getPupilDrawCenter() const;
+  
+  /**
+   * @brief Cover the rows hidden by the eyelids
+   * @param state Blink state
+   */
+  void drawEyelids(BlinkState state);
+  
+  /**
+   * @brief Cover the rows hidden by the expression lids within a band of rows
+   * @param topPercent Upper lid (percent of the way to the center)
+   * @param bottomPercent Lower lid (percent of the way to the center)
+   * @param fromRow First local row to cover
+   * @param toRow One past the last local row to cover
+   */
+  void coverLids(uint8_t topPercent, uint8_t bottomPercent, int32_t fromRow, int32_t toRow);
+  
+  /**
+   * @brief Get the local rows left uncovered by the expression lids
+   * @param topPercent Upper lid (percent of the way to the center)
+   * @param bottomPercent Lower lid (percent of the way to the center)
+   * @param topRow Receives the first uncovered row
+   * @param bottomRow Receives one past the last uncovered row
+   */
+  void getLidRows(uint8_t topPercent, uint8_t bottomPercent, int32_t& topRow, int32_t& bottomRow) const;
+  
+  /**
+   * @brief Scale a span coordinate, rounding down
+   * @param value Coordinate relative to the layer origin
+   * @param percent Scale in percent
+   * @return floor(value * percent / 100)
+   */
+  static constexpr int32_t scaleFloor(int32_t value, uint8_t percent) {
+    return (value >= 0) ? value * percent / 100 : -((-value * percent + 99) / 100);
+  }
+  
+  /**
+   * @brief Get drawing color for a palette entry in a color mode
+   * @param index Palette index
+   * @param mode Color mode
+   * @return Palette index in PALETTE mode, black or white in MONO mode
+   */
+  static constexpr uint32_t color(EyePalette::Index index, ColorMode mode = COLOR_MODE) {
+    return (mode == ColorMode::PALETTE) ? index
+         : (index == EyePalette::SCLERA || index == EyePalette::SCLERA_SHADE) ? TFT_WHITE
+         : TFT_BLACK;
+  }
   
   /**
    * @brief Get maximum pupil distance at a given angle (ellipse-aware)
@@ -155,3 +449,6 @@ private:
    */
   float getMaxPupilDistanceAtAngle(float angleDeg) const;
 };
+
+static_assert(Eye::SPRITE_BYTES * 2 <= Eye::SPRITE_MEMORY_BUDGET,
+              "Eye sprites exceed the sprite memory budget");
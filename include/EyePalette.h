@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Palette used by 4-bit palette-indexed eye sprites
+ * 
+ * In palette mode every drawing call takes one of these indices instead of
+ * an RGB565 color. Ring entries hold a fixed blend of their two neighbours
+ * and are drawn as a one pixel ring between them. This softens the outlines
+ * but is not coverage anti-aliasing: every ring pixel gets the same blend
+ * however much of it the shape actually covers.
+ */
+namespace EyePalette {
+  /**
+   * @brief Palette indices
+   */
+  enum Index : uint8_t {
+    BACKGROUND = 0,   // Surround and eyelids
+    SCLERA_RING,      // Ring between background and sclera shade
+    SCLERA_SHADE,     // Darker rim of the white of the eye
+    SCLERA,           // White of the eye
+    IRIS_OUTER_RING,  // Ring between sclera and iris
+    IRIS,             // Iris
+    IRIS_INNER_RING,  // Ring between iris and pupil
+    PUPIL,            // Pupil
+    COUNT
+  };
+  
+  // Palette colors (RGB888) indexed by Index
+  extern const uint32_t COLORS[COUNT];
+}
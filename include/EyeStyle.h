@@ -0,0 +1,136 @@
+#pragma once
+
+#include <M5Unified.h>
+#include "EyeStyleFormat.h"
+#include "TouchHandler.h"
+#if !defined(ARDUINO)
+#include <vector>
+#endif
+
+/**
+ * @brief Built-in eye style asset (generated by tools/eyestyle_compiler)
+ */
+namespace EyeStyleData {
+  extern const uint8_t DEFAULT_STYLE[];
+  extern const uint32_t DEFAULT_STYLE_SIZE;
+}
+
+/**
+ * @brief Class giving read-only access to an eye style asset
+ *
+ * The asset is never copied: accessors point straight into the built-in
+ * array, a memory-mapped flash partition, or (host builds) a loaded file.
+ * A failed load keeps the previous style, so the eyes always have one.
+ */
+class EyeStyle {
+public:
+  // Flash partition holding a custom style
+  static constexpr const char* PARTITION_LABEL = "eyestyle";
+
+public:
+  /**
+   * @brief Constructor (starts with the built-in style)
+   */
+  EyeStyle();
+  
+  /**
+   * @brief Destructor
+   */
+  ~EyeStyle();
+  
+  EyeStyle(const EyeStyle&) = delete;
+  EyeStyle& operator=(const EyeStyle&) = delete;
+  
+  /**
+   * @brief Use an asset that stays valid for the lifetime of this object
+   * @param data Asset bytes (must be 4-byte aligned)
+   * @param size Number of bytes available
+   * @return false if the asset is malformed
+   */
+  bool load(const uint8_t* data, uint32_t size);
+  
+  /**
+   * @brief Memory-map a flash data partition and use the asset stored in it
+   * @param label Partition label
+   * @return false if the partition is missing, cannot be mapped or is malformed
+   */
+  bool mapPartition(const char* label = PARTITION_LABEL);
+
+#if !defined(ARDUINO)
+  /**
+   * @brief Read an asset from a file
+   * @param path File path
+   * @return false if the file cannot be read or is malformed
+   */
+  bool loadFile(const char* path);
+#endif
+
+  /**
+   * @brief Check whether the built-in style is in use
+   * @return true if no custom asset has been loaded
+   */
+  bool isBuiltIn() const;
+  
+  /**
+   * @brief Get size of the asset in use
+   * @return Size in bytes
+   */
+  uint32_t getSize() const;
+  
+  /**
+   * @brief Get asset header
+   * @return Header
+   */
+  const EyeStyleFormat::Header& getHeader() const;
+  
+  /**
+   * @brief Get a layer
+   * @param index Layer index (less than getHeader().layerCount)
+   * @return Layer
+   */
+  const EyeStyleFormat::Layer& getLayer(uint8_t index) const;
+  
+  /**
+   * @brief Get the spans of a layer
+   * @param layer Layer
+   * @return First of layer.spanCount spans
+   */
+  const EyeStyleFormat::Span* getSpans(const EyeStyleFormat::Layer& layer) const;
+  
+  /**
+   * @brief Get the eyelid entry for a blink level
+   * @param level Blink level (BlinkState value)
+   * @return Eyelid entry, or nullptr if the asset has none for this level
+   */
+  const EyeStyleFormat::Eyelid* getEyelid(uint8_t level) const;
+  
+  /**
+   * @brief Get pupil drawing offset
+   * @param side Eye (0: left, 1: right)
+   * @return Offset applied when drawing the pupil
+   */
+  Point getPupilOffset(uint8_t side) const;
+
+private:
+  const uint8_t* data;                   // Asset in use
+  uint32_t size;                         // Size of the asset
+  const EyeStyleFormat::Header* header;  // Header of the asset
+  uint32_t mapHandle;                    // Flash mapping (0 if none)
+#if !defined(ARDUINO)
+  std::vector<uint32_t> fileData;        // Word-aligned copy of a loaded file
+#endif
+
+  /**
+   * @brief Check that an asset is well formed
+   * @param data Asset bytes
+   * @param size Number of bytes available
+   * @return true if every table lies inside the asset and the checksum matches
+   */
+  static bool validate(const uint8_t* data, uint32_t size);
+  
+  /**
+   * @brief Release a flash mapping
+   * @param handle Mapping handle (0 for none)
+   */
+  static void unmap(uint32_t handle);
+};
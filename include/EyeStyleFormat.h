@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Binary layout of an eye style asset
+ *
+ * Shared by the firmware and tools/eyestyle_compiler, so it only depends on
+ * <stdint.h>. All fields are little endian and naturally aligned, which lets
+ * the firmware read an asset in place from memory-mapped flash.
+ *
+ *   Header
+ *   Layer[layerCount]     at layerOffset
+ *   Eyelid[eyelidCount]   at eyelidOffset (indexed by BlinkState)
+ *   Span[]                at each layer's spanOffset
+ *
+ * Offsets are from the start of the asset. The checksum covers every byte
+ * after the header.
+ */
+namespace EyeStyleFormat {
+  static constexpr char MAGIC[4] = { 'E', 'Y', 'S', 'T' };
+  static constexpr uint16_t VERSION = 1;
+  
+  /**
+   * @brief What a layer is drawn relative to
+   */
+  enum Target : uint8_t {
+    TARGET_SCLERA = 0,  // Eye center, drawn once per redraw of the white
+    TARGET_PUPIL = 1    // Pupil center, redrawn whenever the pupil moves
+  };
+  
+  /**
+   * @brief Color modes a layer is drawn in (bit mask)
+   */
+  enum Mode : uint8_t {
+    MODE_MONO = 0x01,
+    MODE_PALETTE = 0x02,
+    MODE_ALL = MODE_MONO | MODE_PALETTE
+  };
+  
+  /**
+   * @brief Asset header
+   */
+  struct Header {
+    char magic[4];               // "EYST"
+    uint16_t version;            // Format version
+    uint16_t headerSize;         // sizeof(Header)
+    uint32_t totalSize;          // Size of the whole asset in bytes
+    uint32_t checksum;           // FNV-1a over bytes [headerSize, totalSize)
+    uint8_t scleraRadiusX;       // Pupil travel is limited to the sclera ellipse
+    uint8_t scleraRadiusY;
+    uint8_t pupilRadiusX;        // minus the pupil radii
+    uint8_t pupilRadiusY;
+    int8_t pupilOffsetX[2];      // Pupil drawing offset per eye (0: left, 1: right)
+    int8_t pupilOffsetY[2];
+    uint8_t pupilMarginPercent;  // Share of the travel range actually used
+    uint8_t layerCount;          // Number of layers
+    uint8_t eyelidCount;         // Number of eyelid entries
+    uint8_t reserved;
+    uint32_t layerOffset;        // Offset of the layer table
+    uint32_t eyelidOffset;       // Offset of the eyelid table
+  };
+  
+  /**
+   * @brief Pre-rasterised layer drawn in a single palette color
+   */
+  struct Layer {
+    uint8_t target;      // Target
+    uint8_t colorIndex;  // EyePalette::Index
+    uint8_t modes;       // Mode mask
+    uint8_t reserved;
+    uint16_t spanCount;  // Number of spans
+    uint16_t reserved2;
+    uint32_t spanOffset; // Offset of the first span
+  };
+  
+  /**
+   * @brief Horizontal run of pixels relative to the layer's center
+   */
+  struct Span {
+    int16_t dy;       // Row
+    int16_t dx;       // First column
+    uint16_t length;  // Number of pixels
+  };
+  
+  /**
+   * @brief Rows hidden by the eyelids, relative to the eye center
+   *
+   * Rows above topEdge and from bottomEdge down are covered; an entry with
+   * topEdge >= bottomEdge closes the eye completely.
+   */
+  struct Eyelid {
+    int16_t topEdge;
+    int16_t bottomEdge;
+  };
+  
+  static_assert(sizeof(Header) == 36, "Unexpected eye style header size");
+  static_assert(sizeof(Layer) == 12, "Unexpected eye style layer size");
+  static_assert(sizeof(Span) == 6, "Unexpected eye style span size");
+  static_assert(sizeof(Eyelid) == 4, "Unexpected eye style eyelid size");
+  
+  /**
+   * @brief Compute the asset checksum (32-bit FNV-1a)
+   * @param data Bytes to hash
+   * @param length Number of bytes
+   * @return Checksum
+   */
+  inline uint32_t checksum(const uint8_t* data, uint32_t length) {
+    uint32_t hash = 2166136261U;
+    for (uint32_t i = 0; i < length; i++) {
+      hash = (hash ^ data[i]) * 16777619U;
+    }
+    return hash;
+  }
+}
@@ -1,44 +1,172 @@
 #pragma once
 
 #include <M5Unified.h>
+#include "AudioInput.h"
+#include "Clock.h"
+#include "CpuGovernor.h"
+#include "DisplayOutputs.h"
+#include "FastRandom.h"
+#include "ForkJoin.h"
+#include "FrameDeadline.h"
+#include "GazeArbiter.h"
+#include "InputSampler.h"
+#include "FrameStreamer.h"
 #include "TouchHandler.h"
 #include "Eye.h"
+#include "ParameterRegistry.h"
+#include "ScreenLayout.h"
+
+/**
+ * @brief Enumeration representing events that drive state transitions
+ */
+enum class EyeEvent {
+  SHAKE,          // Acceleration exceeded the threshold
+  TOUCH_BEGIN,    // Screen is being touched
+  TOUCH_RELEASE,  // Screen is no longer touched
+  TIMEOUT,        // Time limit of the current state elapsed
+  EXPRESSION,     // An expression was requested
+  LONG_PRESS,     // Touch held still (plays LONG_PRESS_EXPRESSION)
+  FLICK,          // Touch released while moving fast
+  STARTLE         // Sudden loud sound (plays STARTLE_EXPRESSION)
+};
+
+/**
+ * @brief Enumeration representing where input comes from
+ */
+enum class InputMode {
+  SAMPLED,   // Touch and IMU sampled from the hardware
+  INJECTED   // Touch and shakes injected by the caller (scripted or replayed input)
+};
+
+/**
+ * @brief Enumeration representing the pupil drawing queued for a frame
+ */
+enum class PupilAction {
+  NONE,      // Leave pupils as they are
+  CENTER,    // Centered pupils with saccades
+  GAZING,    // Gaze-following pupils with saccades
+  DIZZY,     // Dizzy effect pupils
+  EXPRESSION // Keyframed expression pose
+};
+
+/**
+ * @brief Enumeration representing how eyes pick a target among several touches
+ */
+enum class GazePolicy {
+  NEAREST,   // Each eye follows its nearest touch point
+  CENTROID   // Both eyes follow the centroid of all touch points
+};
+
+/**
+ * @brief Structure holding per-state cost statistics
+ */
+struct StateStats {
+  uint32_t entries;      // Number of times the state was entered
+  uint32_t frames;       // Number of frames spent in the state
+  uint32_t totalMicros;  // Total update and render time
+  uint32_t maxMicros;    // Worst update and render time of a single frame
+};
+
+/**
+ * @brief Structure holding frame counters for telemetry
+ */
+struct FrameTelemetry {
+  static constexpr uint8_t HISTOGRAM_BUCKETS = 8;
+  
+  uint32_t frames;          // Frames drawn
+  uint32_t transitions;     // State transitions
+  uint32_t histogram[HISTOGRAM_BUCKETS]; // Frame work time: <1, <2, <4 ... <64, >=64 ms
+  uint32_t maxFrameMicros;  // Worst frame work time
+  uint32_t lastFrameMicros; // Work time of the most recent frame
+  uint32_t lastBudgetMicros; // Budget of the most recent frame
+  uint16_t lastFrameMhz;    // CPU frequency the most recent frame ran at
+};
 
 /**
  * @brief Class managing eye animations
  */
 class EyesAnimation {
 public:
+  // Defaults of the settings marked (tunable) can be changed at runtime through getParameters()
+  
   // Dizzy effect settings
-  static constexpr float ACCELERATION_THRESHOLD = 1.05F;
+  static constexpr float ACCELERATION_THRESHOLD = 1.05F;   // (tunable)
   static constexpr uint8_t NUM_OF_ROTATION = 3;
-  static constexpr float DIZZY_ROTATION_SPEED = 15.0F;
+  static constexpr float DIZZY_ROTATION_SPEED = 15.0F;     // (tunable)
   static constexpr float DIZZY_TOTAL_DEGREES = 360.0F * NUM_OF_ROTATION;
   static constexpr float DIZZY_DISTANCE_FACTOR = 1080.0F;
   
   // Blink settings
   static constexpr uint8_t BLINK_INITIAL_MAX = 20;
-  static constexpr uint8_t BLINK_RANDOM_MIN = 10;
-  static constexpr uint8_t BLINK_RANDOM_MAX = 200;
-  static constexpr uint8_t BLINK_HALF_CLOSED_TOP_HEIGHT = 60;
-  static constexpr uint8_t BLINK_HALF_CLOSED_BOTTOM_HEIGHT = 25;
-  static constexpr uint8_t BLINK_HALF_CLOSED_BOTTOM_Y = 179;
+  static constexpr uint8_t BLINK_RANDOM_MIN = 10;   // (tunable)
+  static constexpr uint8_t BLINK_RANDOM_MAX = 200;  // (tunable)
+  static constexpr uint8_t BLINK_INTERVAL_MS = 50;
   
   // Animation settings
-  static constexpr uint8_t ANIMATION_DELAY_MS = 20;
+  static constexpr uint8_t ANIMATION_DELAY_MS = 20;  // (tunable)
+  static constexpr uint8_t ACCEL_CHECK_INTERVAL_MS = 30;
   static constexpr uint8_t SACCADES_MAX = 11;
   static constexpr uint8_t SACCADES_DIVISOR = 10;
+  static constexpr uint8_t SACCADE_INTERVAL_MS = 50;
+  static constexpr bool PARALLEL_RENDER = true;  // Draw each eye on its own core
+  static constexpr GazePolicy GAZE_POLICY = GazePolicy::NEAREST;
+  static constexpr bool CPU_GOVERNOR_ENABLED = true;  // Scale the CPU clock with the animation load
+  static constexpr bool GAZE_TABLE_ENABLED = true;    // Look gaze positions up instead of computing them
+  static constexpr uint16_t TILT_GAZE_PX = 80;        // (tunable) Untouched eyes look downhill this far per g of tilt (0: off)
+  
+  // Gaze arbitration settings (higher priority wins, equal ones are averaged)
+  static constexpr uint8_t GAZE_TOUCH_PRIORITY = 3;
+  static constexpr uint8_t GAZE_EXTERNAL_PRIORITY = 2;
+  static constexpr uint8_t GAZE_TILT_PRIORITY = 1;
+  static constexpr uint16_t GAZE_TOUCH_EXPIRY_MS = 100;    // Eyes linger this long on a released touch
+  static constexpr uint16_t GAZE_EXTERNAL_EXPIRY_MS = 500; // Senders refresh targets faster than this
+  static constexpr uint16_t GAZE_TILT_EXPIRY_MS = 100;
+  static constexpr uint16_t GAZE_BLEND_MS = GazeArbiter::BLEND_MS; // (tunable)
+  
+  // Expression settings
+  static constexpr uint8_t IDLE_EXPRESSION_S = 30;  // (tunable) Play a random expression after this long untouched (0: never)
+  static constexpr const char* LONG_PRESS_EXPRESSION = "squint";  // Played on a long press (nullptr: none)
+  
+  // Startle settings (microphone)
+  static constexpr bool AUDIO_ENABLED = true;        // Listen for sudden loud sounds (stops the speaker)
+  static constexpr uint8_t STARTLE_DB = LoudnessDetector::THRESHOLD_DB; // (tunable) Loudness above the noise floor that startles
+  static constexpr const char* STARTLE_EXPRESSION = "surprised";  // Played on a startle (nullptr: none)
+  
+  // Frame streaming settings (mirror eye sprites over Serial)
+  static constexpr bool FRAME_STREAM_ENABLED = false;
+  static constexpr uint32_t FRAME_STREAM_BYTES_PER_SECOND = 11520;  // 115200 baud
+  static constexpr uint32_t FRAME_STREAM_TX_BUFFER_BYTES =         // Serial transmit buffer (set before M5.begin())
+    FrameStreamer::getMaxPacketBytes(Eye::SPRITE_BYTES) + 512;      // A keyframe plus room for text reports
+  
+  // State machine settings
+  static constexpr uint8_t NUM_OF_STATES = 4;
+  static constexpr uint8_t NUM_OF_TRANSITIONS = 16;
+  
+  // Receives every recognised gesture (positions in panel coordinates)
+  using GestureHook = void (*)(void* context, const GestureEvent& event);
 public:
   /**
    * @brief Constructor
+   * @param clock Time source shared with the touch handler (default: Arduino millis/micros)
+   * @param mount How the unit is mounted (default: LANDSCAPE)
    */
-  EyesAnimation();
+  explicit EyesAnimation(const Clock& clock = Clock(), MountRotation mount = MountRotation::LANDSCAPE);
   
   /**
    * @brief Initialization process
+   * @param inputMode Where input comes from (default: SAMPLED)
    * @return Whether initialization was successful
    */
-  bool setup();
+  bool setup(InputMode inputMode = InputMode::SAMPLED);
+  
+  /**
+   * @brief Draw the prerendered first frame straight to the display
+   * 
+   * Needs only the display, so it can run before setup() to put eyes on
+   * screen as early as possible. The first loop() frame replaces it. Also
+   * draws the black surround, which the eye sprites do not cover.
+   */
+  void showBootFrame();
   
   /**
    * @brief Main loop process
@@ -51,14 +179,290 @@ public:
    */
   TouchHandler& getTouchHandler();
   
+  /**
+   * @brief Inject a touch sample (INJECTED input mode)
+   * @param sample Touch sample
+   * @return false if the touch queue is full
+   */
+  bool injectTouch(const TouchSample& sample);
+  
+  /**
+   * @brief Inject a shake that starts the dizzy effect (INJECTED input mode)
+   */
+  void injectShake();
+  
+  /**
+   * @brief Set a function receiving every touch gesture, before the built-in reactions
+   * @param hook Gesture receiver (nullptr: none)
+   * @param context Passed to the hook
+   * 
+   * Gestures reach the hook in every state, including while dizzy.
+   */
+  void setGestureHook(GestureHook hook, void* context);
+  
+  /**
+   * @brief Play an expression from the expression library
+   * @param index Expression index
+   * @return false if there is no such expression or the current state does not allow one
+   */
+  bool playExpression(uint8_t index);
+  
+  /**
+   * @brief Get expression library
+   * @return Library the expressions are played from
+   */
+  const ExpressionLibrary& getExpressions() const;
+  
+  /**
+   * @brief Enable or disable pushing sprites to the display
+   * @param enabled false to render into the sprites only
+   */
+  void setDisplayOutput(bool enabled);
+  
+  /**
+   * @brief Get read-only view of an eye sprite
+   * @param index Eye index (0: left, 1: right)
+   * @return Sprite view
+   */
+  SpriteView getEyeSpriteView(uint8_t index) const;
+  
+  /**
+   * @brief Seed the animation random number generator
+   * @param seed Seed value (the same seed reproduces the same animation)
+   */
+  void setRandomSeed(uint32_t seed);
+  
+  /**
+   * @brief Get current state
+   * @return Current state
+   */
+  EyeState getState() const;
+  
+  /**
+   * @brief Get load implied by the current state
+   * @return Animation load
+   */
+  AnimationLoad getLoad() const;
+  
+  /**
+   * @brief Get cost statistics of a state
+   * @param eyeState State to query
+   * @return Statistics of the state
+   */
+  const StateStats& getStateStats(EyeState eyeState) const;
+  
+  /**
+   * @brief Get frame counters
+   * @return Frame counters since startup
+   */
+  const FrameTelemetry& getFrameTelemetry() const;
+  
+  /**
+   * @brief Get frame deadline monitor
+   * @return Deadline counters and current degradation level
+   */
+  const FrameDeadline& getFrameDeadline() const;
+  
+  /**
+   * @brief Get CPU frequency governor
+   * @return Governor (not running with injected input)
+   */
+  const CpuGovernor& getCpuGovernor() const;
+  
+  /**
+   * @brief Get display sinks
+   * @return Outputs receiving eye frames (add extra panels or a memory sink here)
+   */
+  DisplayOutputs& getDisplayOutputs();
+  
+  /**
+   * @brief Look at a point sent from outside (e.g. a host-side tracker)
+   * @param target Target in logical screen coordinates
+   * 
+   * Both eyes follow it, below touch, until GAZE_EXTERNAL_EXPIRY_MS passes
+   * without another one. Call from the loop thread.
+   */
+  void lookAt(const Point& target);
+  
+  /**
+   * @brief Stop looking at the point sent from outside before it expires
+   */
+  void stopLooking();
+  
+  /**
+   * @brief Get gaze arbiter
+   * @return Arbiter (integrators may configure free slots from GazeArbiter::USER on
+   *         from the loop thread, then submit to them from any one task each,
+   *         stamped with the animation clock)
+   */
+  GazeArbiter& getGazeArbiter();
+  
+  /**
+   * @brief Get input sampler
+   * @return Sampler (not running with injected input)
+   */
+  InputSampler& getInputSampler();
+  
+  /**
+   * @brief Get microphone listener
+   * @return Listener (not running with injected input or AUDIO_ENABLED off)
+   */
+  AudioInput& getAudioInput();
+  
+  /**
+   * @brief Get number of touch samples the input sampler had to drop
+   * @return Dropped sample count
+   */
+  uint32_t getDroppedTouchSamples() const;
+  
+  /**
+   * @brief Get runtime-tunable parameters
+   * @return Parameter registry (read and write it from the loop thread only)
+   */
+  ParameterRegistry& getParameters();
+  
+  /**
+   * @brief Get display name of a state
+   * @param eyeState State to query
+   * @return Name of the state
+   */
+  static const char* getStateName(EyeState eyeState);
+  
 private:
+  // Device reports and benchmarks read and briefly borrow the internals
+  friend class EyesDiagnostics;
+  
+  // Per-state or per-transition hook
+  using Hook = void (EyesAnimation::*)();
+  
+  /**
+   * @brief Structure describing a state
+   */
+  struct StateDescriptor {
+    EyeState state;      // State described by this entry
+    const char* name;    // Display name
+    Hook update;         // Input processing, may dispatch events (nullable)
+    Hook render;         // Drawing into the eye sprites (nullable)
+    uint32_t EyesAnimation::* timeoutMs;  // Time after which TIMEOUT is dispatched (nullptr: none)
+    AnimationLoad load;  // Work implied by the state (drives the CPU governor)
+  };
+  
+  /**
+   * @brief Structure holding per-eye drawing queued by the render hooks
+   * 
+   * Shared inputs (saccades, blink state, angle) are resolved once on the
+   * loop core so that both eyes can be drawn independently.
+   */
+  struct EyeFrame {
+    PupilAction pupil;      // Pupil drawing to perform
+    Point targets[2];       // Gaze target per eye (GAZING)
+    Point saccades;         // Small movements (CENTER, GAZING)
+    uint8_t motionSteps;    // PupilMotion steps since the previous move (CENTER, GAZING)
+    float degree;           // Rotation angle (DIZZY)
+    ExpressionPose pose;    // Pose to draw (EXPRESSION)
+    bool blink;             // Whether to update the blink
+    BlinkState blinkState;  // Blink state to draw
+  };
+  
+  /**
+   * @brief Structure describing a state transition
+   */
+  struct Transition {
+    EyeState from;       // Source state
+    EyeEvent event;      // Triggering event
+    EyeState to;         // Destination state
+    Hook action;         // Action run on the transition (nullable)
+  };
+  
+  /**
+   * @brief Structure holding the current values of the tunable settings
+   */
+  struct Tunables {
+    float accelerationThreshold;  // ACCELERATION_THRESHOLD
+    float dizzyRotationSpeed;     // DIZZY_ROTATION_SPEED
+    uint8_t blinkRandomMin;       // BLINK_RANDOM_MIN
+    uint8_t blinkRandomMax;       // BLINK_RANDOM_MAX
+    uint8_t animationDelayMs;     // ANIMATION_DELAY_MS
+    uint8_t pupilMarginPercent;   // Pupil travel margin (default from the eye style)
+    uint16_t displayDelayMicros;  // Artificial display delay for exercising the deadline monitor (0: off)
+    uint8_t idleExpressionSeconds; // IDLE_EXPRESSION_S
+    float pursuitRate;            // PupilMotion::PURSUIT_RATE
+    uint16_t tiltGazePx;          // TILT_GAZE_PX
+    uint16_t gazeBlendMs;         // GAZE_BLEND_MS
+    uint8_t startleDb;            // STARTLE_DB
+  };
+  
+  static const StateDescriptor STATES[NUM_OF_STATES];
+  static const Transition TRANSITIONS[NUM_OF_TRANSITIONS];
+  
+  Clock clock;           // Time source
+  ScreenLayout layout;   // Logical screen and eye placement for the mount
+  EyeStyle style;        // Eye shapes shared by both eyes
   Eye leftEye;           // Left eye
   Eye rightEye;          // Right eye
   TouchHandler touchHandler; // Touch handler
+  InputSampler inputSampler; // Samples touch and IMU on its own task
+  AudioInput audioInput;     // Listens for loud sounds on its own task
+  InputMode inputMode;   // Where input comes from
+  bool shakePending;     // Injected shake not yet handled
+  bool displayOutput;    // Whether sprites are pushed to the display
   EyeState state;        // Eye state
-  float degree;          // Dizzy effect angle
   uint8_t blinkCounter;  // Blink counter
   uint8_t blinkMaxCount; // Maximum blink count
+  uint32_t frameTime;          // Time of the current frame
+  uint32_t lastFrameTime;      // Time of the previous frame
+  uint32_t lastAccelCheckTime; // Time of the previous accelerometer check
+  uint32_t lastBlinkTime;      // Time of the previous blink update
+  uint32_t stateEnteredTime;   // Time the current state was entered
+  uint32_t lastSaccadeTime;    // Time of the previous saccade update
+  Point lastSaccade;           // Current saccades
+  uint32_t motionStepTime;     // Time up to which pupil motion was stepped
+  GazeArbiter gazeArbiter;     // Chooses the gaze target among touch, tilt and external sources
+  FastRandom rng;              // Random source for saccades and blinks
+  EyeFrame eyeFrame;           // Drawing queued for the current frame
+  ForkJoin forkJoin;           // Runs per-eye drawing on both cores
+  FrameStreamer frameStreamer; // Mirrors eye sprites over Serial
+  PanelSink lcdSink;           // Pushes eyes to the built-in LCD
+  DisplayOutputs outputs;      // Sinks receiving eye frames
+  StateStats stateStats[NUM_OF_STATES]; // Per-state cost statistics
+  FrameTelemetry frameTelemetry; // Frame counters
+  FrameDeadline deadline;      // Detects overruns and sheds optional work
+  LoadFrequencyPolicy frequencyPolicy; // Picks the CPU frequency
+  CpuGovernor governor;        // Applies the CPU frequency
+  Tunables tunables;           // Current values of the tunable settings
+  uint32_t dizzyDurationMs;    // Derived from the rotation speed and frame delay
+  ExpressionLibrary expressions; // Keyframed expressions
+  ExpressionPlayer expressionPlayer; // Evaluates the playing expression
+  uint8_t pendingExpression;   // Expression started by the next EXPRESSION transition
+  uint32_t expressionDurationMs; // Length of the playing expression
+  uint32_t idleExpressionMs;   // Derived from the idle expression setting
+  GestureHook gestureHook;     // Receives every gesture (nullable)
+  void* gestureContext;        // Passed to the gesture hook
+  ParameterRegistry parameters; // Exposes the tunables
+  
+  /**
+   * @brief Register the tunable settings
+   */
+  void registerParameters();
+  
+  /**
+   * @brief Derive dependent values after a parameter write
+   * @param context Animation instance
+   * @param id Parameter ID
+   */
+  static void applyParameters(void* context, uint8_t id);
+  
+  /**
+   * @brief Count a frame in the frame time histogram
+   * @param frameMicros Frame work time
+   */
+  void recordFrameTime(uint32_t frameMicros);
+  
+  /**
+   * @brief Dispatch an event to the state machine
+   * @param event Event to dispatch
+   */
+  void dispatch(EyeEvent event);
   
   /**
    * @brief Reset eyes
@@ -66,49 +470,142 @@ private:
   void resetEyes();
   
   /**
-   * @brief Draw pupils in the center
+   * @brief Queue pupils in the center
    */
   void drawCenterEyes();
   
   /**
-   * @brief Draw gaze-following pupils
-   * @param touchPoint Touch coordinates
+   * @brief Queue gaze-following pupils
+   * @param leftTarget Target of the left eye
+   * @param rightTarget Target of the right eye
    */
-  void drawGazingEyes(const Point& touchPoint);
+  void drawGazingEyes(const Point& leftTarget, const Point& rightTarget);
   
   /**
-   * @brief Draw dizzy effect pupils
+   * @brief Pick the touch point an eye follows
+   * @param touch Touch handler holding the points
+   * @param eye Eye to pick a target for
+   * @param policy How to pick among several points (GAZE_POLICY in the animation)
+   * @return Target point
+   */
+  Point selectGazeTarget(const TouchHandler& touch, const Eye& eye, GazePolicy policy) const;
+  
+  /**
+   * @brief Get how far untouched eyes look downhill
+   * @param offset Receives the gaze target relative to each eye, in logical axes
+   * @return false if tilt gaze is off or there is no tilt estimate
+   */
+  bool selectTiltOffset(Point& offset) const;
+  
+  /**
+   * @brief Submit this frame's touch and tilt targets, then queue pupils for the arbitrated ones
+   * @param touching Whether touch points are live (gazing state)
+   */
+  void drawArbitratedEyes(bool touching);
+  
+  /**
+   * @brief Queue dizzy effect pupils
    */
   void drawDizzyEyes();
   
   /**
-   * @brief Draw blink
+   * @brief Queue blink
    */
   void drawBlink();
   
+  /**
+   * @brief Transition action: start the requested expression from a clean eye
+   */
+  void startExpression();
+  
+  /**
+   * @brief Transition action: start a random expression after the eyes were left alone
+   */
+  void startIdleExpression();
+  
+  /**
+   * @brief Draw the queued frame into both eyes and clear the queue
+   */
+  void drawQueuedFrame();
+  
+  /**
+   * @brief Fork/join job drawing the queued frame into one eye
+   * @param context EyesAnimation instance
+   * @param index Eye index (0: left, 1: right)
+   */
+  static void drawEyeJob(void* context, uint8_t index);
+  
+  /**
+   * @brief Draw the queued frame into one eye
+   * @param eye Eye to draw
+   * @param index Eye index (0: left, 1: right)
+   */
+  void drawEye(Eye& eye, uint8_t index);
+  
   /**
    * @brief Redraw the white parts of the eyes
    */
   void redrawWhiteEyes();
   
   /**
-   * @brief Check accelerometer values and determine whether to start dizzy effect
-   * @return true if state changed
+   * @brief Check accelerometer values for a dizzy-inducing shake
+   * @return true if acceleration exceeds the threshold
    */
   bool checkAccelerationForDizzy();
   
   /**
-   * @brief Update eyes based on current state
+   * @brief Run update and render hooks of the current state
    */
   void updateEyesBasedOnState();
   
   /**
-   * @brief Handle normal state eyes
+   * @brief Update hook: dispatch touch events
+   */
+  void updateTouch();
+  
+  /**
+   * @brief Update hook: let only new touches interrupt (a long press expression plays while held)
+   */
+  void interruptOnTouch();
+  
+  /**
+   * @brief Update hook: consume touch samples without reacting to them
+   */
+  void drainTouch();
+  
+  /**
+   * @brief Pass gestures to the hook, then react to long presses and flicks
+   * @param react false to only pass them to the hook
+   */
+  void handleGestures(bool react);
+  
+  /**
+   * @brief React to a sudden loud sound picked up since the previous frame
+   */
+  void handleStartle();
+  
+  /**
+   * @brief Render hook: centered pupils with blinking
+   */
+  void renderNormal();
+  
+  /**
+   * @brief Render hook: gaze-following pupils with blinking
+   */
+  void renderGazing();
+  
+  /**
+   * @brief Render hook: keyframed expression pose
+   */
+  void renderExpression();
+  
+  /**
+   * @brief Update blink at its own interval
    */
-  void handleNormalState();
+  void updateBlink();
   
   /**
-   * @brief Render both eyes to display
+   * @brief Send the changed rows of both eyes to the display sinks
    */
   void renderEyes();
   
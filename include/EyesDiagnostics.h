@@ -0,0 +1,93 @@
+#pragma once
+
+#include <M5Unified.h>
+#include "EyesAnimation.h"
+
+/**
+ * @brief Class printing the device reports and benchmarks of an eye animation
+ *
+ * Kept apart from EyesAnimation so the animation holds only behaviour and
+ * rendering. The reports read the animation's internals, and some
+ * benchmarks borrow them for a moment (the expression report saves and
+ * restores the motion state, the rotation and color benchmarks draw over
+ * the display), so this is a friend of EyesAnimation. Call from the loop
+ * thread between frames; SerialProtocol runs these on request.
+ */
+class EyesDiagnostics {
+public:
+  /**
+   * @brief Constructor
+   * @param eyes Animation to report on
+   */
+  explicit EyesDiagnostics(EyesAnimation& eyes);
+  
+  /**
+   * @brief Print memory cost and error against the exact path for each gaze table cell size
+   * @param out Output (e.g. Serial)
+   * 
+   * Compares every screen pixel for every cell size, which blocks for
+   * about a second; meant for tuning sessions, not for normal runs.
+   */
+  void printGazeTableReport(Print& out);
+  
+  /**
+   * @brief Print draw and push time of a pre-rotated eye sprite for each mount rotation
+   * @param out Output (e.g. Serial)
+   * 
+   * Draws and pushes a temporary eye over the display, then restores the
+   * screen; meant for tuning sessions, not for normal runs.
+   */
+  void printRotationBenchmark(Print& out);
+  
+  /**
+   * @brief Print sprite size, draw and push time of the mono and palette color modes
+   * @param out Output (e.g. Serial)
+   * 
+   * Measures both modes whichever one the firmware is built for, with a
+   * temporary sprite over the left eye, then restores the display depth
+   * and the screen; meant for tuning sessions, not for normal runs.
+   */
+  void printColorModeBenchmark(Print& out);
+  
+  /**
+   * @brief Print the expressions and their evaluation cost per frame next to the hard-coded states
+   * @param out Output (e.g. Serial)
+   * 
+   * Only evaluates (no drawing), and leaves the animation state as it was.
+   */
+  void printExpressionReport(Print& out);
+  
+  /**
+   * @brief Print the tilt estimate and the cost of fusing it against the frame budget
+   * @param out Output (e.g. Serial)
+   * 
+   * Costs are since the previous report.
+   */
+  void printTiltReport(Print& out);
+  
+  /**
+   * @brief Print the gaze sources, what they last submitted and how often they won
+   * @param out Output (e.g. Serial)
+   */
+  void printGazeSourceReport(Print& out);
+  
+  /**
+   * @brief Print the microphone levels, onsets and the detector's cost against the frame budget
+   * @param out Output (e.g. Serial)
+   * 
+   * Costs are since the previous report.
+   */
+  void printAudioReport(Print& out);
+  
+  /**
+   * @brief Print the cost of coalescing queued touch samples and picking gaze targets per frame
+   * @param out Output (e.g. Serial)
+   * 
+   * Feeds a separate touch handler with synthetic one- and two-point samples
+   * at the input sampler's touch rate, so the live touch state is untouched.
+   */
+  void printTouchBenchmark(Print& out);
+
+private:
+  EyesAnimation& eyes;  // Animation reported on
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Fast deterministic pseudo-random number generator (xorshift32)
+ * 
+ * Each instance owns its state, so a given seed reproduces the same
+ * sequence on every platform. Ranges use a multiply-shift instead of a
+ * modulo, so each call is a handful of integer operations.
+ */
+class FastRandom {
+public:
+  // Seed used when zero is given (xorshift never leaves the zero state)
+  static constexpr uint32_t DEFAULT_SEED = 0x9E3779B9U;
+  
+public:
+  /**
+   * @brief Constructor
+   * @param seed Initial seed (default: DEFAULT_SEED)
+   */
+  explicit FastRandom(uint32_t seed = DEFAULT_SEED) : state(0) {
+    setSeed(seed);
+  }
+  
+  /**
+   * @brief Set seed
+   * @param seed New seed (zero is replaced with DEFAULT_SEED)
+   */
+  void setSeed(uint32_t seed) {
+    state = (seed != 0) ? seed : DEFAULT_SEED;
+  }
+  
+  /**
+   * @brief Generate next 32-bit value
+   * @return Pseudo-random value
+   */
+  uint32_t next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+  
+  /**
+   * @brief Generate value in [0, max)
+   * @param max Upper bound (exclusive)
+   * @return Pseudo-random value, or 0 if max is not positive
+   */
+  int32_t range(int32_t max) {
+    if (max <= 0) {
+      return 0;
+    }
+    return static_cast<int32_t>((static_cast<uint64_t>(next()) * static_cast<uint32_t>(max)) >> 32);
+  }
+  
+  /**
+   * @brief Generate value in [min, max)
+   * @param min Lower bound (inclusive)
+   * @param max Upper bound (exclusive)
+   * @return Pseudo-random value, or min if the range is empty
+   */
+  int32_t range(int32_t min, int32_t max) {
+    if (min >= max) {
+      return min;
+    }
+    return min + range(max - min);
+  }
+  
+private:
+  uint32_t state;  // Generator state (never zero)
+};
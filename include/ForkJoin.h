@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+/**
+ * @brief Two-way fork/join barrier for running per-eye work on both cores
+ * 
+ * run() executes the job for index 0 on the calling core and for index 1
+ * on a worker pinned to the other core, then waits for both. Until begin()
+ * succeeds, run() executes both indices sequentially on the caller.
+ * On ESP32 the worker is a FreeRTOS task woken by task notifications; on
+ * host builds it is a std::thread, which tools/fork_join_check uses to
+ * compare parallel and sequential drawing.
+ */
+class ForkJoin {
+public:
+  // Job executed once per index
+  using Job = void (*)(void* context, uint8_t index);
+  
+  // Worker task settings
+  static constexpr uint32_t WORKER_STACK_SIZE = 4096;
+  static constexpr uint8_t WORKER_PRIORITY = 2;
+  static constexpr uint8_t WORKER_CORE = 0;
+  
+public:
+  /**
+   * @brief Constructor
+   */
+  ForkJoin();
+  
+  /**
+   * @brief Destructor
+   */
+  ~ForkJoin();
+  
+  /**
+   * @brief Start the worker
+   * @return Whether the worker was started
+   */
+  bool begin();
+  
+  /**
+   * @brief Check whether jobs run in parallel
+   * @return true if the worker is running
+   */
+  bool isParallel() const;
+  
+  /**
+   * @brief Run a job for index 0 and 1 and wait for both
+   * @param job Job to run
+   * @param context Context passed to the job
+   */
+  void run(Job job, void* context);
+  
+private:
+  Job job;         // Job of the current run
+  void* context;   // Context of the current run
+  bool running;    // Whether the worker is running
+  
+#if defined(ARDUINO)
+  TaskHandle_t workerTask;  // Worker task
+  TaskHandle_t callerTask;  // Task waiting in run()
+  
+  /**
+   * @brief Worker task body
+   * @param param ForkJoin instance
+   */
+  static void workerLoop(void* param);
+#else
+  std::thread worker;              // Worker thread
+  std::mutex mutex;                // Guards the fields below
+  std::condition_variable signal;  // Signals start and completion
+  uint32_t startGeneration;        // Incremented for each run
+  uint32_t doneGeneration;         // Set to startGeneration when the worker finishes
+  bool stopping;                   // Asks the worker to exit
+  
+  /**
+   * @brief Worker thread body
+   */
+  void workerLoop();
+#endif
+};
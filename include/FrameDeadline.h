@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Enumeration representing how much optional work is shed
+ *
+ * Levels are cumulative: each one also sheds the work of the levels below it.
+ */
+enum class Degradation : uint8_t {
+  NONE,            // Full quality
+  HOLD_SACCADES,   // Saccades are not recomputed
+  COARSE_BLINK,    // Blinks skip the half-closed step
+  ALTERNATE_PUSH   // Eyes are pushed to the display on alternate frames
+};
+
+/**
+ * @brief Structure holding deadline counters for telemetry
+ */
+struct DeadlineStats {
+  uint32_t missedDeadlines;   // Frames whose work exceeded the frame budget
+  uint32_t worstWorkMicros;   // Worst frame work time
+  uint32_t worstIntervalMs;   // Worst time between the starts of two frames
+  uint32_t degradations;      // Times a level of work was shed
+  uint32_t restorations;      // Times a level of work was restored
+};
+
+/**
+ * @brief Class detecting missed frame deadlines and choosing how much work to shed
+ *
+ * A few consecutive overruns raise the degradation level one step; a
+ * longer run of frames with headroom lowers it again, so a single slow
+ * frame does not change quality and the level does not oscillate. Only
+ * depends on <stdint.h>, so tools/frame_deadline_check can replay frame
+ * times through it on the host.
+ */
+class FrameDeadline {
+public:
+  // Degradation settings
+  static constexpr uint8_t DEGRADE_AFTER_FRAMES = 3;   // Consecutive overruns before shedding a level
+  static constexpr uint8_t RESTORE_AFTER_FRAMES = 50;  // Consecutive frames with headroom before restoring one
+  static constexpr uint8_t HEADROOM_PERCENT = 50;      // Work below this share of the budget leaves headroom
+  static constexpr Degradation MAX_LEVEL = Degradation::ALTERNATE_PUSH;
+
+public:
+  /**
+   * @brief Constructor
+   */
+  FrameDeadline();
+  
+  /**
+   * @brief Record a frame and adjust the degradation level
+   * @param workMicros Time spent on the frame
+   * @param intervalMs Time since the start of the previous frame (0 for the first frame)
+   * @param budgetMicros Frame budget
+   */
+  void recordFrame(uint32_t workMicros, uint32_t intervalMs, uint32_t budgetMicros);
+  
+  /**
+   * @brief Allow or forbid shedding work (counters are kept either way)
+   * @param allowed false to stay at full quality
+   */
+  void setSheddingAllowed(bool allowed);
+  
+  /**
+   * @brief Check whether a kind of optional work is currently shed
+   * @param work Degradation level that sheds the work
+   * @return true if the work should be skipped this frame
+   */
+  bool isShedding(Degradation work) const;
+  
+  /**
+   * @brief Get current degradation level
+   * @return Degradation level
+   */
+  Degradation getLevel() const;
+  
+  /**
+   * @brief Get deadline counters
+   * @return Counters since startup
+   */
+  const DeadlineStats& getStats() const;
+
+private:
+  Degradation level;       // Current degradation level
+  bool sheddingAllowed;    // Whether the level may rise above NONE
+  uint8_t overrunStreak;   // Consecutive frames over budget
+  uint8_t headroomStreak;  // Consecutive frames with headroom
+  DeadlineStats stats;     // Counters
+};
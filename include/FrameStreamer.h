@@ -0,0 +1,164 @@
+#pragma once
+
+#include <M5Unified.h>
+#include "Eye.h"
+
+/**
+ * @brief Class streaming eye sprites over a serial link
+ * 
+ * Each submitted sprite is XORed with the last frame sent for that eye and
+ * the result is run-length coded, so unchanged areas cost almost nothing.
+ * Frames that would exceed the bandwidth budget or the free space in the
+ * transmit buffer are skipped; the next frame is then coded against the
+ * last frame actually sent, so the receiver never loses sync. Whole packets
+ * are written at once, so a non-blocking stream needs a transmit buffer of
+ * at least getMaxPacketBytes() or keyframes never fit.
+ * 
+ * Packet layout (little endian):
+ *   0  'E' 'F'          magic
+ *   2  eye index        uint8
+ *   3  flags            uint8 (bit 0: keyframe, reference is all zeros)
+ *   4  frame number     uint16
+ *   6  x, y             int16, int16 (position on the display)
+ *  10  width, height    uint16, uint16
+ *  14  color depth      uint8
+ *  15  payload length   uint16
+ *  17  payload          RLE tokens over the XOR delta
+ *  17+n checksum        uint8 (sum of all preceding bytes)
+ * 
+ * RLE token: 0x00-0x7F = run of (token + 1) zero bytes,
+ *            0x80-0xFF = (token - 0x7F) literal bytes follow.
+ */
+class FrameStreamer {
+public:
+  // Stream settings
+  static constexpr uint8_t MAX_EYES = 2;
+  static constexpr uint16_t KEYFRAME_INTERVAL = 250;  // Frames between keyframes
+  static constexpr uint8_t HEADER_SIZE = 17;
+  static constexpr uint8_t FLAG_KEYFRAME = 0x01;
+  static constexpr uint32_t MAX_TOKEN_LENGTH = 128;  // Longest run or literal a single RLE token can describe
+  
+  /**
+   * @brief Get the size of the largest packet (a keyframe of incompressible data)
+   * @param maxSpriteBytes Largest sprite buffer that will be submitted
+   * @return Packet size in bytes (every token a full literal)
+   */
+  static constexpr uint32_t getMaxPacketBytes(uint32_t maxSpriteBytes) {
+    return HEADER_SIZE + maxSpriteBytes + (maxSpriteBytes + MAX_TOKEN_LENGTH - 1) / MAX_TOKEN_LENGTH + 1;
+  }
+  
+public:
+  /**
+   * @brief Constructor
+   */
+  FrameStreamer();
+  
+  /**
+   * @brief Destructor
+   */
+  ~FrameStreamer();
+  
+  /**
+   * @brief Allocate buffers and start streaming
+   * @param out Output stream
+   * @param bytesPerSecond Bandwidth budget
+   * @param maxSpriteBytes Largest sprite buffer that will be submitted
+   * @return Whether buffers were allocated
+   */
+  bool begin(Print& out, uint32_t bytesPerSecond, uint32_t maxSpriteBytes);
+  
+  /**
+   * @brief Wait for the output instead of skipping frames
+   * @param enabled true to send every frame regardless of the budget
+   */
+  void setBlocking(bool enabled);
+  
+  /**
+   * @brief Encode and send one eye sprite if the budget allows
+   * @param eyeIndex Eye index (less than MAX_EYES)
+   * @param view Sprite to send
+   * @param nowMs Current time
+   * @return Whether the frame was sent
+   */
+  bool submit(uint8_t eyeIndex, const SpriteView& view, uint32_t nowMs);
+  
+  /**
+   * @brief DisplaySink entry point (the XOR delta already skips unchanged rows)
+   * @param context FrameStreamer instance
+   * @param eyeIndex Eye index
+   * @param eye Eye to send
+   * @param rows Rows changed since the last frame sent (unused)
+   * @param nowMs Current time
+   * @return Whether the frame was sent
+   */
+  static bool write(void* context, uint8_t eyeIndex, Eye& eye, const DirtyRows& rows, uint32_t nowMs);
+  
+  /**
+   * @brief Force the next frame of every eye to be a keyframe
+   */
+  void requestKeyframe();
+  
+  /**
+   * @brief Get number of frames sent
+   * @return Sent frame count
+   */
+  uint32_t getSentFrames() const;
+  
+  /**
+   * @brief Get number of frames skipped for lack of bandwidth
+   * @return Skipped frame count
+   */
+  uint32_t getSkippedFrames() const;
+  
+  /**
+   * @brief Get total bytes sent
+   * @return Sent byte count
+   */
+  uint32_t getSentBytes() const;
+  
+  /**
+   * @brief Get total raw sprite bytes of sent frames
+   * @return Raw byte count
+   */
+  uint32_t getRawBytes() const;
+  
+private:
+  Print* out;                        // Output stream (nullptr until begin)
+  uint32_t bytesPerSecond;           // Bandwidth budget
+  uint32_t maxSpriteBytes;           // Size of each reference buffer
+  uint8_t* references[MAX_EYES];     // Last frame sent per eye
+  uint8_t* packet;                   // Encoding scratch buffer
+  uint32_t packetCapacity;           // Scratch buffer size
+  uint16_t frameNumbers[MAX_EYES];   // Next frame number per eye
+  bool keyframePending[MAX_EYES];    // Next frame must be a keyframe
+  bool blocking;                     // Send every frame regardless of the budget
+  uint32_t credit;                   // Available bytes in the token bucket
+  uint32_t lastCreditTime;           // Time of the previous refill
+  uint32_t sentFrames;               // Statistics
+  uint32_t skippedFrames;
+  uint32_t sentBytes;
+  uint32_t rawBytes;
+  
+  /**
+   * @brief RLE-code the XOR of a frame and its reference
+   * @param frame Current frame
+   * @param reference Reference frame (nullptr for a keyframe)
+   * @param length Frame length
+   * @param output Destination of the tokens
+   * @return Number of bytes written
+   */
+  static uint32_t encodeDelta(const uint8_t* frame, const uint8_t* reference,
+                              uint32_t length, uint8_t* output);
+  
+  /**
+   * @brief Refill the token bucket
+   * @param nowMs Current time
+   */
+  void refillCredit(uint32_t nowMs);
+  
+  /**
+   * @brief Get token bucket capacity
+   * @return Half a second of budget, but never less than one full packet
+   */
+  uint32_t getBurst() const;
+};
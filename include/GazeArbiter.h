@@ -0,0 +1,209 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Structure holding a gaze target in logical screen coordinates
+ */
+struct GazeTarget {
+  int16_t x;  // X coordinate
+  int16_t y;  // Y coordinate
+};
+
+/**
+ * @brief Class choosing one gaze target per eye from several timestamped producers
+ *
+ * Each producer owns a source slot and submits targets for both eyes
+ * whenever it has them. Once per frame the animation resolves the slots:
+ * sources older than their expiry drop out, the highest priority among the
+ * rest wins, and sources sharing that priority are averaged by weight. When
+ * the winner changes, the output slides from the previous target to the new
+ * one over the blend time instead of jumping.
+ *
+ * Slots are fixed-size sequence locks: a submit never blocks and never
+ * allocates, so producers may run on other tasks or cores, as long as each
+ * slot has a single producer. Configuration and resolve() belong to the
+ * consumer (the animation loop). Only depends on <stdint.h> and <atomic>,
+ * so tools/gaze_arbiter_check can exercise the same code on the host.
+ */
+class GazeArbiter {
+public:
+  /**
+   * @brief Predefined sources (slots up to MAX_SOURCES are free for integrators)
+   */
+  enum Source : uint8_t {
+    TOUCH = 0,     // Touch points (GAZE_POLICY)
+    EXTERNAL = 1,  // Targets sent over Serial (e.g. a host-side tracker)
+    TILT = 2,      // Downhill from the IMU tilt estimate
+    USER = 3       // First slot free for integrators
+  };
+  
+  // Arbitration settings
+  static constexpr uint8_t MAX_SOURCES = 6;
+  static constexpr uint16_t BLEND_MS = 150;         // Default time to slide over to a new winner
+  static constexpr uint8_t MAX_READ_ATTEMPTS = 4;   // Reads of a slot being written before skipping it for a frame
+  
+  /**
+   * @brief Structure holding what a source last submitted
+   */
+  struct Submission {
+    GazeTarget targets[2];  // Left and right eye targets
+    uint32_t timeMs;        // Time of the submission
+  };
+
+public:
+  /**
+   * @brief Constructor (all sources disabled until configured)
+   */
+  GazeArbiter();
+  
+  /**
+   * @brief Enable a source and set how it competes (consumer side)
+   * @param source Source slot
+   * @param priority Priority (higher wins)
+   * @param expiryMs How long a submission stays live
+   * @param weight Share when averaged with sources of the same priority (at least 1)
+   */
+  void configure(uint8_t source, uint8_t priority, uint16_t expiryMs, uint8_t weight = 1);
+  
+  /**
+   * @brief Disable a source (consumer side)
+   * @param source Source slot
+   */
+  void disable(uint8_t source);
+  
+  /**
+   * @brief Set how long the output takes to slide over to a new winner (consumer side)
+   * @param blendMs Blend time in milliseconds (0: jump)
+   */
+  void setBlendTime(uint16_t blendMs);
+  
+  /**
+   * @brief Submit targets for both eyes (producer side, one producer per source)
+   * @param source Source slot
+   * @param left Left eye target
+   * @param right Right eye target
+   * @param timeMs Time of the submission (on the consumer's clock)
+   */
+  void submit(uint8_t source, const GazeTarget& left, const GazeTarget& right, uint32_t timeMs);
+  
+  /**
+   * @brief Withdraw the source's targets before they expire (producer side)
+   * @param source Source slot
+   */
+  void withdraw(uint8_t source);
+  
+  /**
+   * @brief Choose this frame's targets (consumer side)
+   * @param nowMs Current time
+   * @param targets Receives the left and right eye targets
+   * @return false if no source is live (the eyes look ahead)
+   */
+  bool resolve(uint32_t nowMs, GazeTarget targets[2]);
+  
+  /**
+   * @brief Read what a source last submitted (consumer side)
+   * @param source Source slot
+   * @param submission Receives the submission
+   * @return false if the source has nothing submitted or is being written
+   */
+  bool peek(uint8_t source, Submission& submission) const;
+  
+  /**
+   * @brief Check whether a source is enabled
+   * @param source Source slot
+   * @return true if configured and not disabled
+   */
+  bool isEnabled(uint8_t source) const;
+  
+  /**
+   * @brief Get a source's priority
+   * @param source Source slot
+   * @return Priority (higher wins)
+   */
+  uint8_t getPriority(uint8_t source) const;
+  
+  /**
+   * @brief Get how long a source's submissions stay live
+   * @param source Source slot
+   * @return Expiry in milliseconds
+   */
+  uint16_t getExpiry(uint8_t source) const;
+  
+  /**
+   * @brief Get number of frames a source contributed to the output
+   * @param source Source slot
+   * @return Frame count
+   */
+  uint32_t getWins(uint8_t source) const;
+  
+  /**
+   * @brief Get number of times the winning sources changed
+   * @return Switch count
+   */
+  uint32_t getSwitches() const;
+  
+  /**
+   * @brief Get number of slot reads that found a submission half written
+   * @return Retry count
+   */
+  uint32_t getRetries() const;
+  
+  /**
+   * @brief Check whether the output is sliding over to a new winner
+   * @return true while blending
+   */
+  bool isBlending() const;
+
+private:
+  /**
+   * @brief Structure holding one source's slot
+   */
+  struct Slot {
+    std::atomic<uint32_t> sequence;  // Odd while being written, 0 before the first submission
+    std::atomic<uint32_t> left;      // Left eye target (x in the low, y in the high half)
+    std::atomic<uint32_t> right;     // Right eye target (x in the low, y in the high half)
+    std::atomic<uint32_t> timeMs;    // Time of the submission
+    std::atomic<bool> live;          // false once withdrawn
+    bool enabled;                    // Whether the source takes part
+    uint8_t priority;                // Higher wins
+    uint8_t weight;                  // Share among equal priorities
+    uint16_t expiryMs;               // How long a submission stays live
+    uint32_t wins;                   // Frames contributed to the output
+  };
+  
+  Slot slots[MAX_SOURCES];     // Source slots
+  uint16_t blendMs;            // Time to slide over to a new winner
+  uint8_t winners;             // Bit mask of the sources behind the previous output
+  bool hasOutput;              // Whether the previous frame resolved to targets
+  GazeTarget output[2];        // Previous frame's targets
+  GazeTarget blendFrom[2];     // Targets the current blend started from
+  uint32_t blendStartMs;       // Time the current blend started
+  bool blending;               // Whether a blend is in progress
+  uint32_t switches;           // Changes of the winning sources
+  mutable uint32_t retries;    // Reads that found a slot half written
+  
+  /**
+   * @brief Read a slot consistently
+   * @param slot Slot to read
+   * @param submission Receives the submission
+   * @param live Receives whether it was not withdrawn
+   * @return false if nothing is submitted or it kept changing while read
+   */
+  bool read(const Slot& slot, Submission& submission, bool& live) const;
+  
+  /**
+   * @brief Pack a target into one word
+   * @param target Target to pack
+   * @return x in the low, y in the high half
+   */
+  static uint32_t pack(const GazeTarget& target);
+  
+  /**
+   * @brief Unpack a target from one word
+   * @param value x in the low, y in the high half
+   * @return Target
+   */
+  static GazeTarget unpack(uint32_t value);
+};
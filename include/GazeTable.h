@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Arduino.h>
+#include "TouchHandler.h"
+
+/**
+ * @brief Class mapping screen coordinates to clamped pupil offsets through a precomputed grid
+ *
+ * Nodes every 2^cellShift pixels hold the exact offset in 1/16 pixels and
+ * lookups interpolate the four surrounding nodes, so a lookup costs four
+ * loads and a few multiplies instead of atan2, hypot and an ellipse
+ * evaluation. Inside the pupil travel ellipse the mapping is the identity,
+ * which bilinear interpolation reproduces exactly; errors are confined to
+ * cells crossing the rim, where interpolation cuts the corner inwards.
+ *
+ * Cost for a 320x240 screen, per eye, stock style:
+ *   cell  4 px: 19,764 bytes, max error 1.4 px
+ *   cell  8 px:  5,084 bytes, max error 2.8 px
+ *   cell 16 px:  1,344 bytes, max error 5.1 px
+ *   cell 32 px:    396 bytes, max error 9.2 px
+ * EyesDiagnostics::printGazeTableReport() measures these on the device.
+ */
+class GazeTable {
+public:
+  // Grid settings
+  static constexpr uint8_t FRACTION_BITS = 4;   // Node offsets are stored in 1/16 pixels
+  static constexpr uint8_t MIN_CELL_SHIFT = 2;  // 4 px cells
+  static constexpr uint8_t MAX_CELL_SHIFT = 5;  // 32 px cells
+  
+  /**
+   * @brief Exact mapping sampled at the grid nodes
+   * @param context Passed through from build()
+   * @param x Screen X coordinate
+   * @param y Screen Y coordinate
+   * @param offsetX Receives the clamped pupil offset X
+   * @param offsetY Receives the clamped pupil offset Y
+   */
+  using ExactMapping = void (*)(const void* context, int16_t x, int16_t y, float& offsetX, float& offsetY);
+
+public:
+  /**
+   * @brief Constructor
+   */
+  GazeTable();
+  
+  /**
+   * @brief Destructor
+   */
+  ~GazeTable();
+  
+  /**
+   * @brief Allocate the grid and sample the exact mapping at every node
+   * @param width Screen width in pixels
+   * @param height Screen height in pixels
+   * @param cellShift Cell size as a power of two (MIN_CELL_SHIFT to MAX_CELL_SHIFT)
+   * @param mapping Exact mapping
+   * @param context Passed to the mapping (must outlive the table)
+   * @return false if the arguments are invalid or the grid cannot be allocated
+   */
+  bool build(uint16_t width, uint16_t height, uint8_t cellShift, ExactMapping mapping, const void* context);
+  
+  /**
+   * @brief Sample the exact mapping again after its inputs changed
+   */
+  void refresh();
+  
+  /**
+   * @brief Release the grid
+   */
+  void release();
+  
+  /**
+   * @brief Check whether the grid was built
+   * @return true if lookup() can be used
+   */
+  bool isReady() const;
+  
+  /**
+   * @brief Look up the clamped pupil offset for a screen point
+   * @param screenPoint Screen coordinates (clamped to the screen)
+   * @return Pupil offset from the eye center, truncated toward zero like the exact path
+   */
+  Point lookup(const Point& screenPoint) const;
+  
+  /**
+   * @brief Get grid size for a screen and cell size
+   * @param width Screen width in pixels
+   * @param height Screen height in pixels
+   * @param cellShift Cell size as a power of two
+   * @return Grid size in bytes
+   */
+  static size_t getBytes(uint16_t width, uint16_t height, uint8_t cellShift);
+
+private:
+  int16_t* nodes;        // Offset pairs (x, y) in 1/16 pixels, row-major
+  ExactMapping mapping;  // Mapping sampled at the nodes
+  const void* context;   // Passed to the mapping
+  uint16_t width;        // Screen width in pixels
+  uint16_t height;       // Screen height in pixels
+  uint16_t columns;      // Nodes per row
+  uint16_t rows;         // Node rows
+  uint8_t cellShift;     // Cell size as a power of two
+};
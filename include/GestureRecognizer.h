@@ -0,0 +1,183 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Enumeration representing recognised gestures
+ */
+enum class GestureType : uint8_t {
+  TAP,         // Short press without moving (the first of a double tap too)
+  DOUBLE_TAP,  // Second tap soon after and near the first (instead of a second TAP)
+  LONG_PRESS,  // Held without moving for LONG_PRESS_MS (while still held)
+  DRAG_BEGIN,  // Moved beyond the slop while pressed
+  DRAG,        // Moved while dragging (only the latest is queued)
+  DRAG_END,    // Released, or joined by a second finger, while dragging
+  FLICK        // Released while moving fast (after DRAG_END)
+};
+
+/**
+ * @brief Enumeration representing the dominant direction of a movement (panel axes)
+ */
+enum class GestureDirection : uint8_t {
+  NONE,
+  LEFT,
+  RIGHT,
+  UP,
+  DOWN
+};
+
+/**
+ * @brief Structure holding one recognised gesture
+ */
+struct GestureEvent {
+  GestureType type;            // Gesture
+  GestureDirection direction;  // Direction of DRAG, DRAG_END and FLICK (NONE for the others)
+  uint32_t timeMs;             // Time of the sample (or advance()) that completed it
+  int16_t x;                   // Press position for taps and long presses, latest position otherwise
+  int16_t y;
+  int16_t velocityX;           // Velocity in pixels per second (drags and flicks)
+  int16_t velocityY;
+};
+
+/**
+ * @brief Class recognising taps, long presses, drags and flicks from raw touch samples
+ *
+ * Fed with every sample of the first touch point in order, not just the
+ * coalesced state of a frame, so short taps and the speed at release
+ * survive a slow frame. Each sample is handled as it arrives and events
+ * are queued as soon as they are certain: taps on release, long presses
+ * from the sample or advance() that reaches LONG_PRESS_MS, drags on the
+ * sample that leaves the slop. A second finger cancels the gesture.
+ *
+ * Velocity is the displacement over the last VELOCITY_WINDOW_MS of samples.
+ * Positions and directions are in panel coordinates, as touch points are.
+ * Everything lives in fixed arrays. Only depends on <stdint.h>, so
+ * tools/gesture_check can run synthetic sample sequences through it on
+ * the host.
+ */
+class GestureRecognizer {
+public:
+  // Recognition settings
+  static constexpr uint8_t SLOP_PX = 10;             // Movement still counted as holding still
+  static constexpr uint16_t TAP_MAX_MS = 250;        // Longest press that is a tap
+  static constexpr uint16_t DOUBLE_TAP_MS = 300;     // Longest gap from the first release to the second press
+  static constexpr uint16_t LONG_PRESS_MS = 600;     // Shortest still press that is a long press
+  static constexpr uint16_t FLICK_MIN_SPEED = 500;   // Release speed that makes a drag a flick (pixels per second)
+  static constexpr uint8_t VELOCITY_WINDOW_MS = 60;  // Samples this recent set the velocity
+  static constexpr uint8_t HISTORY_SIZE = 8;         // Samples kept for the velocity (power of two)
+  static constexpr uint8_t EVENT_CAPACITY = 8;       // Events queued until taken
+
+public:
+  /**
+   * @brief Constructor
+   */
+  GestureRecognizer();
+  
+  /**
+   * @brief Forget the gesture in progress and the queued events
+   */
+  void reset();
+  
+  /**
+   * @brief Handle one touch sample
+   * @param timeMs Sampling time (not earlier than the previous sample)
+   * @param touching Whether the screen is touched
+   * @param count Number of touch points (a second one cancels the gesture)
+   * @param x X of the first touch point
+   * @param y Y of the first touch point
+   */
+  void addSample(uint32_t timeMs, bool touching, uint8_t count, int16_t x, int16_t y);
+  
+  /**
+   * @brief Complete gestures that only need time to pass (long press without new samples)
+   * @param nowMs Current time (not earlier than the latest sample)
+   */
+  void advance(uint32_t nowMs);
+  
+  /**
+   * @brief Take the oldest queued event
+   * @param event Receives the event
+   * @return false if there is none
+   */
+  bool takeEvent(GestureEvent& event);
+  
+  /**
+   * @brief Get number of events dropped because nobody took them
+   * @return Dropped event count
+   */
+  uint32_t getDroppedEvents() const;
+
+private:
+  /**
+   * @brief Enumeration representing the phase of the touch in progress
+   */
+  enum class Phase : uint8_t {
+    IDLE,      // Not touched
+    PRESSED,   // Touched, within the slop
+    HELD,      // Long press reported
+    DRAGGING,  // Moved beyond the slop
+    CANCELLED  // Second finger, ignored until released
+  };
+  
+  /**
+   * @brief Structure holding one recent touching sample
+   */
+  struct HistorySample {
+    uint32_t timeMs;  // Sampling time
+    int16_t x;        // Position
+    int16_t y;
+  };
+  
+  Phase phase;                            // Phase of the touch in progress
+  uint32_t pressTimeMs;                   // Time the touch began
+  int16_t pressX;                         // Position the touch began at
+  int16_t pressY;
+  bool tapPending;                        // A tap may still become a double tap
+  uint32_t tapReleaseMs;                  // Release time of that tap
+  int16_t tapX;                           // Position of that tap
+  int16_t tapY;
+  HistorySample history[HISTORY_SIZE];    // Recent touching samples
+  uint8_t historyCount;                   // Valid history samples (up to HISTORY_SIZE)
+  uint8_t historyHead;                    // Index of the next history sample
+  GestureEvent events[EVENT_CAPACITY];    // Queued events
+  uint8_t eventHead;                      // Index of the oldest queued event
+  uint8_t eventCount;                     // Number of queued events
+  uint32_t droppedEvents;                 // Events lost to a full queue
+  
+  /**
+   * @brief Estimate the velocity from the history
+   * @param velocityX Receives the x velocity in pixels per second
+   * @param velocityY Receives the y velocity in pixels per second
+   */
+  void estimateVelocity(int16_t& velocityX, int16_t& velocityY) const;
+  
+  /**
+   * @brief Queue an event (a DRAG replaces a DRAG still queued)
+   * @param type Gesture
+   * @param timeMs Time of completion
+   * @param x X position
+   * @param y Y position
+   * @param withVelocity Whether to fill in the velocity and direction
+   */
+  void queue(GestureType type, uint32_t timeMs, int16_t x, int16_t y, bool withVelocity);
+  
+  /**
+   * @brief Handle the release of the touch in progress
+   * @param timeMs Release time
+   */
+  void release(uint32_t timeMs);
+  
+  /**
+   * @brief Get the dominant direction of a velocity
+   * @param velocityX X velocity
+   * @param velocityY Y velocity
+   * @return Direction (NONE if not moving)
+   */
+  static GestureDirection directionOf(int16_t velocityX, int16_t velocityY);
+  
+  /**
+   * @brief Check whether a position is within the slop of another
+   * @return true if neither coordinate differs by more than SLOP_PX
+   */
+  static bool withinSlop(int16_t x, int16_t y, int16_t originX, int16_t originY);
+};
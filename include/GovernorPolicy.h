@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Enumeration representing how much work the current animation state implies
+ */
+enum class AnimationLoad : uint8_t {
+  IDLE,    // Centered pupils with saccades and blinks
+  ACTIVE,  // Gaze following
+  HEAVY    // Dizzy rotation
+};
+
+/**
+ * @brief Structure describing a finished frame to a frequency policy
+ */
+struct GovernorSample {
+  AnimationLoad load;     // Load implied by the current state
+  uint32_t workMicros;    // Frame work time at currentMhz
+  uint32_t budgetMicros;  // Frame budget
+  uint16_t currentMhz;    // CPU frequency the frame ran at
+};
+
+/**
+ * @brief Frequency decision: returns the CPU frequency for the following frames
+ *
+ * Policies only see the samples passed to them and never touch the
+ * hardware, so the same code runs on the device (CpuGovernor) and on the
+ * host against recorded frame traces (tools/governor_sim.cpp). This header
+ * therefore only depends on <stdint.h>.
+ */
+using FrequencyPolicy = uint16_t (*)(void* context, const GovernorSample& sample);
+
+/**
+ * @brief Policy that always asks for the same frequency (baseline for comparisons)
+ */
+class FixedFrequencyPolicy {
+public:
+  /**
+   * @brief Constructor
+   * @param mhz Frequency to ask for
+   */
+  explicit FixedFrequencyPolicy(uint16_t mhz);
+  
+  /**
+   * @brief FrequencyPolicy entry point
+   * @param context FixedFrequencyPolicy instance
+   * @param sample Finished frame
+   * @return Frequency for the following frames
+   */
+  static uint16_t decide(void* context, const GovernorSample& sample);
+
+private:
+  uint16_t mhz;  // Frequency to ask for
+};
+
+/**
+ * @brief Policy combining a frequency floor per load with utilisation steps
+ *
+ * Each load has a minimum step, taken at once when the load rises. Above
+ * the floor, a few frames over RAISE_PERCENT of the budget raise one step
+ * and a long run under LOWER_PERCENT lowers one. Steps at most double the
+ * frequency, so a frame under LOWER_PERCENT stays under RAISE_PERCENT one
+ * step down and the two rules cannot alternate.
+ */
+class LoadFrequencyPolicy {
+public:
+  // Frequency steps supported by the ESP32 without changing the APB clock
+  static constexpr uint8_t NUM_OF_STEPS = 3;
+  static constexpr uint16_t STEPS_MHZ[NUM_OF_STEPS] = { 80, 160, 240 };
+  
+  // Minimum step per AnimationLoad
+  static constexpr uint8_t LOAD_FLOOR_STEP[] = { 0, 1, 2 };
+  
+  // Hysteresis settings
+  static constexpr uint8_t RAISE_PERCENT = 70;
+  static constexpr uint8_t RAISE_AFTER_FRAMES = 2;
+  static constexpr uint8_t LOWER_PERCENT = 30;
+  static constexpr uint8_t LOWER_AFTER_FRAMES = 25;
+
+public:
+  /**
+   * @brief Constructor
+   */
+  LoadFrequencyPolicy();
+  
+  /**
+   * @brief FrequencyPolicy entry point
+   * @param context LoadFrequencyPolicy instance
+   * @param sample Finished frame
+   * @return Frequency for the following frames
+   */
+  static uint16_t decide(void* context, const GovernorSample& sample);
+
+private:
+  uint8_t raiseStreak;  // Consecutive frames over RAISE_PERCENT
+  uint8_t lowerStreak;  // Consecutive frames under LOWER_PERCENT
+  
+  /**
+   * @brief Pick the frequency for the following frames
+   * @param sample Finished frame
+   * @return Frequency for the following frames
+   */
+  uint16_t choose(const GovernorSample& sample);
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <M5Unified.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Clock.h"
+#include "SpscRing.h"
+#include "TiltFilter.h"
+#include "TouchHandler.h"
+
+/**
+ * @brief Class sampling input peripherals on a dedicated task
+ * 
+ * Once started, the task is the only code calling M5.update() and reading
+ * the IMU, so the shared internal I2C bus is never used from two cores.
+ * Touch samples go to the touch handler's queue; acceleration is reduced
+ * to the peak magnitude since the animation last asked for it. The IMU is
+ * read at four times the default frame rate and fused into a tilt
+ * estimate here, so the animation only picks up the latest result.
+ */
+class InputSampler {
+public:
+  // Sampler task settings
+  static constexpr uint8_t SAMPLE_INTERVAL_MS = 5;    // IMU period (tilt fusion rate)
+  static constexpr uint8_t TOUCH_EVERY = 2;           // Touch is sampled every this many IMU samples
+  static constexpr uint32_t IMU_TRACE_CAPACITY = 64;  // Traced IMU samples waiting to be sent
+  static constexpr uint32_t TASK_STACK_SIZE = 4096;
+  static constexpr uint8_t TASK_PRIORITY = 3;
+  static constexpr uint8_t TASK_CORE = 0;
+  
+public:
+  /**
+   * @brief Constructor
+   * @param clock Time source used to stamp samples
+   */
+  explicit InputSampler(const Clock& clock = Clock());
+  
+  /**
+   * @brief Start the sampler task
+   * @param touchHandler Touch handler receiving samples (switched to queue mode)
+   * @return Whether the task was started
+   */
+  bool begin(TouchHandler& touchHandler);
+  
+  /**
+   * @brief Check whether the sampler task is running
+   * @return true if running
+   */
+  bool isRunning() const;
+  
+  /**
+   * @brief Take the peak acceleration since the previous call
+   * @param magnitude Receives the peak magnitude in g
+   * @return false if no acceleration was sampled since the previous call
+   */
+  bool takePeakAcceleration(float& magnitude);
+  
+  /**
+   * @brief Get number of touch samples dropped because the queue was full
+   * @return Dropped sample count
+   */
+  uint32_t getDroppedTouchSamples() const;
+  
+  /**
+   * @brief Get the latest tilt estimate
+   * @param x Receives the reaction to gravity along the panel's x axis (Q14, 1 g = 16384)
+   * @param y Receives the reaction to gravity along the panel's y axis
+   * @return false if no estimate is available
+   */
+  bool getTilt(int16_t& x, int16_t& y) const;
+  
+  /**
+   * @brief Take the cost of fusing IMU samples since the previous call
+   * @param samples Receives the number of samples fused
+   * @param averageCycles Receives the average CPU cycles per sample
+   * @param maxCycles Receives the largest CPU cycles for one sample
+   */
+  void takeFusionCost(uint32_t& samples, uint32_t& averageCycles, uint32_t& maxCycles);
+  
+  /**
+   * @brief Start queueing raw IMU samples for takeImuSample()
+   * @param samples Number of samples to queue (0 stops)
+   */
+  void traceImu(uint16_t samples);
+  
+  /**
+   * @brief Take a queued IMU sample
+   * @param sample Receives the sample
+   * @return false if none is queued
+   */
+  bool takeImuSample(ImuSample& sample);
+  
+private:
+  Clock clock;                        // Time source
+  TouchHandler::TouchQueue* touchQueue; // Destination of touch samples
+  TaskHandle_t task;                  // Sampler task
+  uint8_t lastTouchState;             // Touch state of the previous sample
+  std::atomic<uint32_t> peakAccelMilliG;  // Peak magnitude (0: none)
+  std::atomic<uint32_t> droppedTouchSamples; // Samples lost to a full queue
+  uint8_t touchCountdown;             // IMU samples until the next touch sample
+  TiltFilter tiltFilter;              // Fuses IMU samples (sampler task only)
+  std::atomic<uint32_t> tilt;         // Latest tilt (x in the low, y in the high half)
+  std::atomic<bool> tiltValid;        // Whether tilt holds an estimate
+  std::atomic<uint32_t> fusionSamples; // Samples fused since takeFusionCost()
+  std::atomic<uint32_t> fusionCycles;  // CPU cycles spent fusing them
+  std::atomic<uint32_t> fusionMaxCycles; // Most CPU cycles for one of them
+  std::atomic<uint16_t> imuTraceLeft; // Samples still to queue for tracing
+  SpscRing<ImuSample, IMU_TRACE_CAPACITY> imuTrace; // Traced samples
+  
+  /**
+   * @brief Sampler task body
+   * @param param InputSampler instance
+   */
+  static void taskLoop(void* param);
+  
+  /**
+   * @brief Take one sample of every input
+   */
+  void sample();
+  
+  /**
+   * @brief Read the IMU, keep the peak acceleration and fuse the tilt
+   * @param now Time of the sample
+   */
+  void sampleImu(uint32_t now);
+};
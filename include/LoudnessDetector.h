@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Class detecting sudden loud sounds in a stream of audio blocks
+ *
+ * Each block has its DC offset removed and its mean square taken, all in
+ * integer arithmetic. A noise floor follows the block level, rising slowly
+ * (a sustained noise needs seconds to become the floor) and falling fast.
+ * An onset is a block louder than the floor by the threshold and louder
+ * than MIN_RMS; it must fall back below the threshold before the next one.
+ *
+ * The floor time constants count blocks, so they assume blocks of about
+ * AudioInput::BLOCK_SAMPLES. Only depends on <stdint.h>, so
+ * tools/loudness_check can feed WAV files through it on the host with the
+ * same block size.
+ */
+class LoudnessDetector {
+public:
+  // Detection settings
+  static constexpr uint8_t THRESHOLD_DB = 15;         // Default onset level above the floor
+  static constexpr uint8_t MAX_THRESHOLD_DB = 40;
+  static constexpr uint16_t MIN_RMS = 500;            // Quieter blocks never start an onset (full scale 32767)
+  static constexpr uint16_t REFRACTORY_MS = 500;      // Shortest time between onsets
+  static constexpr uint16_t WARMUP_MS = 250;          // Lets the floor settle before the first onset
+  static constexpr uint8_t DC_SHIFT = 10;             // DC tracker time constant (2^n samples)
+  static constexpr uint8_t FLOOR_RISE_SHIFT = 7;      // Floor rise time constant (2^n blocks)
+  static constexpr uint8_t FLOOR_FALL_SHIFT = 3;      // Floor fall time constant (2^n blocks)
+
+public:
+  /**
+   * @brief Constructor
+   * @param sampleRate Sample rate in Hz
+   */
+  explicit LoudnessDetector(uint32_t sampleRate);
+  
+  /**
+   * @brief Forget the floor, the DC offset and the onset in progress
+   */
+  void reset();
+  
+  /**
+   * @brief Set how far above the floor a block must be to start an onset
+   * @param thresholdDb Threshold in dB (limited to MAX_THRESHOLD_DB)
+   */
+  void setThresholdDb(uint8_t thresholdDb);
+  
+  /**
+   * @brief Get the onset threshold
+   * @return Threshold in dB
+   */
+  uint8_t getThresholdDb() const;
+  
+  /**
+   * @brief Process one block of mono samples
+   * @param samples Samples
+   * @param count Number of samples (at most 65536)
+   * @return true if the block starts an onset
+   */
+  bool process(const int16_t* samples, size_t count);
+  
+  /**
+   * @brief Get the RMS level of the latest block
+   * @return RMS after DC removal (full scale 32767)
+   */
+  uint16_t getLevel() const;
+  
+  /**
+   * @brief Get the RMS level of the noise floor
+   * @return RMS (full scale 32767)
+   */
+  uint16_t getFloor() const;
+  
+  /**
+   * @brief Get number of onsets since construction
+   * @return Onset count
+   */
+  uint32_t getOnsets() const;
+  
+  /**
+   * @brief Get the integer square root
+   * @param value Value
+   * @return Largest integer whose square does not exceed value
+   */
+  static uint32_t squareRoot(uint64_t value);
+
+private:
+  uint32_t sampleRate;       // Sample rate in Hz
+  uint8_t thresholdDb;       // Onset threshold
+  uint32_t thresholdRatio;   // Power ratio of the threshold (Q8)
+  bool started;              // Whether a sample initialized the DC tracker
+  int32_t dcOffset;          // DC offset (Q8)
+  uint32_t meanSquare;       // Mean square of the latest block
+  uint64_t floorMeanSquare;  // Mean square of the noise floor (Q8)
+  bool armed;                // Level fell below the threshold since the previous onset
+  uint32_t samplesSinceOnset; // Samples since the previous onset (saturates)
+  uint32_t warmupSamples;    // Samples still to process before onsets are allowed
+  uint32_t onsets;           // Onsets since construction
+};
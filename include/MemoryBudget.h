@@ -0,0 +1,84 @@
+#pragma once
+
+#include <M5Unified.h>
+
+/**
+ * @brief Enumeration representing where a buffer is placed
+ */
+enum class MemoryPlacement {
+  INTERNAL,  // Internal SRAM (hot working buffers)
+  PSRAM,     // External PSRAM (large, rarely written assets)
+  FLASH      // Read-only data in flash (no heap usage)
+};
+
+/**
+ * @brief Allocation layer for canvases and tables
+ * 
+ * Every sprite and table goes through this namespace so that internal RAM,
+ * PSRAM and flash usage can be reported, and so that a failed allocation
+ * is recorded instead of leaving an unusable buffer behind.
+ */
+namespace MemoryBudget {
+  // Maximum number of tracked allocations
+  static constexpr uint8_t MAX_ENTRIES = 16;
+  
+  /**
+   * @brief Create a sprite buffer according to a placement policy
+   * @param canvas Canvas to create the sprite on
+   * @param width Sprite width
+   * @param height Sprite height
+   * @param colorDepth Sprite color depth in bits
+   * @param placement Requested placement (PSRAM falls back to internal RAM)
+   * @param tag Name shown in the heap report
+   * @return Whether the sprite buffer was allocated
+   */
+  bool createSprite(M5Canvas& canvas, int32_t width, int32_t height, uint8_t colorDepth,
+                    MemoryPlacement placement, const char* tag);
+  
+  /**
+   * @brief Delete a sprite buffer created with createSprite()
+   * @param canvas Canvas to delete the sprite of
+   */
+  void deleteSprite(M5Canvas& canvas);
+  
+  /**
+   * @brief Allocate a raw buffer according to a placement policy
+   * @param bytes Buffer size
+   * @param placement Requested placement (PSRAM falls back to internal RAM)
+   * @param tag Name shown in the heap report
+   * @return Buffer, or nullptr if allocation failed
+   */
+  void* allocate(size_t bytes, MemoryPlacement placement, const char* tag);
+  
+  /**
+   * @brief Release a buffer obtained from allocate()
+   * @param buffer Buffer to release
+   */
+  void release(void* buffer);
+  
+  /**
+   * @brief Record a read-only table that lives in flash
+   * @param bytes Table size
+   * @param tag Name shown in the heap report
+   */
+  void trackStatic(size_t bytes, const char* tag);
+  
+  /**
+   * @brief Get total tracked bytes for a placement
+   * @param placement Placement to sum
+   * @return Tracked bytes
+   */
+  size_t getUsage(MemoryPlacement placement);
+  
+  /**
+   * @brief Get number of failed allocations
+   * @return Failed allocation count
+   */
+  uint8_t getFailureCount();
+  
+  /**
+   * @brief Print heap and tracked allocation report
+   * @param out Output stream
+   */
+  void printReport(Print& out);
+}
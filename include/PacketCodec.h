@@ -0,0 +1,208 @@
+#pragma once
+
+#include <stdint.h>
+#include "ParameterRegistry.h"
+
+/**
+ * @brief Class parsing request packets and framing replies of the tuning protocol
+ *
+ * Holds the part of SerialProtocol that does not touch the animation: the
+ * byte-at-a-time request parser, reply framing and the parameter requests
+ * answered from a ParameterRegistry. Only depends on <stdint.h> and the
+ * registry, so tools/packet_codec_check can feed it packets on the host.
+ *
+ * Packet layout (little endian):
+ *   0  sync       0xA5 (host to device) or 0x5A (device to host)
+ *   1  command    uint8 (replies: request command | 0x80)
+ *   2  length     uint8 (payload length)
+ *   3  payload
+ *   3+n checksum  uint8 (sum of all preceding bytes)
+ */
+class PacketCodec {
+public:
+  // Protocol settings
+  static constexpr uint8_t VERSION = 1;
+  static constexpr uint8_t SYNC_REQUEST = 0xA5;
+  static constexpr uint8_t SYNC_REPLY = 0x5A;
+  static constexpr uint8_t REPLY_FLAG = 0x80;
+  static constexpr uint8_t MAX_REQUEST_PAYLOAD = 8;
+  static constexpr uint8_t MAX_REPLY_PAYLOAD = 48;
+  static constexpr uint8_t OVERHEAD = 4;              // Sync, command, length, checksum
+  static constexpr uint8_t PAYLOAD_OFFSET = 3;        // Offset of the payload within a packet
+  
+  /**
+   * @brief Request commands
+   */
+  enum Command : uint8_t {
+    PING = 0x00,
+    PARAM_INFO = 0x01,
+    PARAM_GET = 0x02,
+    PARAM_SET = 0x03,
+    TELEMETRY = 0x04,
+    MEMORY_REPORT = 0x05,
+    BATCH_RENDER = 0x06,
+    BOOT_REPORT = 0x07,
+    FRAME_TRACE = 0x08,
+    GAZE_REPORT = 0x09,
+    ROTATION_BENCH = 0x0A,
+    SINK_REPORT = 0x0B,
+    EXPRESSION = 0x0C,
+    EXPRESSION_REPORT = 0x0D,
+    IMU_TRACE = 0x0E,
+    TILT_REPORT = 0x0F,
+    LOOK_AT = 0x10,
+    GAZE_SOURCE_REPORT = 0x11,
+    AUDIO_REPORT = 0x12,
+    INSTANCE_BENCH = 0x13,
+    TOUCH_BENCH = 0x14,
+    COLOR_BENCH = 0x15,
+    TELEMETRY_REPORT = 0x70,  // Device to host only
+    FRAME_TRACE_REPORT = 0x71, // Device to host only
+    IMU_TRACE_REPORT = 0x72   // Device to host only
+  };
+  
+  /**
+   * @brief Reply status codes
+   */
+  enum Status : uint8_t {
+    OK = 0,
+    UNKNOWN_COMMAND = 1,
+    BAD_LENGTH = 2,
+    UNKNOWN_PARAMETER = 3,
+    OUT_OF_RANGE = 4,
+    FAILED = 5
+  };
+
+public:
+  /**
+   * @brief Constructor
+   */
+  PacketCodec();
+  
+  /**
+   * @brief Feed one received byte to the request parser
+   * @param value Received byte
+   * @return true if the byte completed a request with a valid checksum
+   */
+  bool parse(uint8_t value);
+  
+  /**
+   * @brief Get command of the latest complete request
+   * @return Command byte
+   */
+  uint8_t getCommand() const;
+  
+  /**
+   * @brief Get payload length of the latest complete request
+   * @return Payload length
+   */
+  uint8_t getLength() const;
+  
+  /**
+   * @brief Get payload of the latest complete request
+   * @return Payload (getLength() bytes, valid until the next parse())
+   */
+  const uint8_t* getPayload() const;
+  
+  /**
+   * @brief Get number of malformed request packets
+   * @return Bad packet count
+   */
+  uint32_t getBadPackets() const;
+  
+  /**
+   * @brief Answer the latest request if it is PING or a parameter request
+   * @param parameters Registry the request refers to
+   * @return false if the request is of another kind (nothing is framed)
+   */
+  bool answerParameterRequest(ParameterRegistry& parameters);
+  
+  /**
+   * @brief Frame a reply to the latest request with a bare status
+   * @param status Status code
+   */
+  void frameStatus(Status status);
+  
+  /**
+   * @brief Frame a packet whose payload is already in the reply payload buffer
+   * @param packetCommand Command byte
+   * @param payloadLength Payload length (at most MAX_REPLY_PAYLOAD)
+   */
+  void frame(uint8_t packetCommand, uint8_t payloadLength);
+  
+  /**
+   * @brief Get the reply payload buffer to fill before frame()
+   * @return MAX_REPLY_PAYLOAD bytes
+   */
+  uint8_t* getReplyPayload();
+  
+  /**
+   * @brief Get the most recently framed packet
+   * @return Packet (getPacketLength() bytes)
+   */
+  const uint8_t* getPacket() const;
+  
+  /**
+   * @brief Get length of the most recently framed packet
+   * @return Packet length including the overhead
+   */
+  uint8_t getPacketLength() const;
+  
+  /**
+   * @brief Write a 16-bit value in little endian
+   * @param output Destination
+   * @param value Value to write
+   */
+  static void writeU16(uint8_t* output, uint16_t value);
+  
+  /**
+   * @brief Write a 32-bit value in little endian
+   * @param output Destination
+   * @param value Value to write
+   */
+  static void writeU32(uint8_t* output, uint32_t value);
+  
+  /**
+   * @brief Read a 16-bit value in little endian
+   * @param input Source
+   * @return Value
+   */
+  static uint16_t readU16(const uint8_t* input);
+  
+  /**
+   * @brief Read a 32-bit value in little endian
+   * @param input Source
+   * @return Value
+   */
+  static uint32_t readU32(const uint8_t* input);
+
+private:
+  /**
+   * @brief Enumeration representing the parser position within a packet
+   */
+  enum class ParseState : uint8_t {
+    SYNC,
+    COMMAND,
+    LENGTH,
+    PAYLOAD,
+    CHECKSUM
+  };
+  
+  ParseState parseState;       // Parser position
+  uint8_t command;             // Command of the packet being parsed
+  uint8_t length;              // Payload length of the packet being parsed
+  uint8_t received;            // Payload bytes received so far
+  uint8_t checksum;            // Running checksum
+  uint8_t payload[MAX_REQUEST_PAYLOAD]; // Payload of the packet being parsed
+  uint8_t reply[OVERHEAD + MAX_REPLY_PAYLOAD]; // Transmit scratch buffer
+  uint8_t replyLength;         // Length of the framed packet in reply
+  uint32_t badPackets;         // Malformed request packets
+  
+  /**
+   * @brief Frame a parameter reply
+   * @param parameters Registry holding the parameter
+   * @param id Parameter ID
+   * @param withInfo true to include type, limits and name
+   */
+  void frameParameter(const ParameterRegistry& parameters, uint8_t id, bool withInfo);
+};
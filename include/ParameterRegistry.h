@@ -0,0 +1,158 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Enumeration representing the storage type of a parameter
+ */
+enum class ParameterType : uint8_t {
+  UINT8,
+  UINT16,
+  UINT32,
+  FLOAT
+};
+
+/**
+ * @brief Structure describing a runtime-tunable parameter
+ *
+ * Values and limits travel as 32-bit words: integers zero-extended, floats
+ * as their IEEE 754 bit pattern.
+ */
+struct Parameter {
+  const char* name;    // Display name
+  ParameterType type;  // Storage type
+  void* value;         // Storage owned by the registering object
+  uint32_t minValue;   // Lower limit (encoded)
+  uint32_t maxValue;   // Upper limit (encoded)
+};
+
+/**
+ * @brief Class holding a fixed table of runtime-tunable parameters
+ *
+ * Parameters point at storage owned by the object that registered them;
+ * the registry only validates and applies writes, then runs the change
+ * hook so the owner can derive dependent values. Reads and writes must
+ * happen on the thread that uses the values.
+ */
+class ParameterRegistry {
+public:
+  // Registry settings
+  static constexpr uint8_t MAX_PARAMETERS = 16;
+  static constexpr uint8_t MAX_NAME_LENGTH = 24;
+  
+  // Called after a successful write
+  using ChangeHook = void (*)(void* context, uint8_t id);
+
+public:
+  /**
+   * @brief Constructor
+   */
+  ParameterRegistry();
+  
+  /**
+   * @brief Register an 8-bit parameter
+   * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+   * @param value Storage
+   * @param minValue Lower limit
+   * @param maxValue Upper limit
+   * @return Parameter ID, or -1 if the table is full
+   */
+  int16_t add(const char* name, uint8_t* value, uint8_t minValue, uint8_t maxValue);
+  
+  /**
+   * @brief Register a 16-bit parameter
+   * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+   * @param value Storage
+   * @param minValue Lower limit
+   * @param maxValue Upper limit
+   * @return Parameter ID, or -1 if the table is full
+   */
+  int16_t add(const char* name, uint16_t* value, uint16_t minValue, uint16_t maxValue);
+  
+  /**
+   * @brief Register a 32-bit parameter
+   * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+   * @param value Storage
+   * @param minValue Lower limit
+   * @param maxValue Upper limit
+   * @return Parameter ID, or -1 if the table is full
+   */
+  int16_t add(const char* name, uint32_t* value, uint32_t minValue, uint32_t maxValue);
+  
+  /**
+   * @brief Register a floating-point parameter
+   * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+   * @param value Storage
+   * @param minValue Lower limit
+   * @param maxValue Upper limit
+   * @return Parameter ID, or -1 if the table is full
+   */
+  int16_t add(const char* name, float* value, float minValue, float maxValue);
+  
+  /**
+   * @brief Set the hook run after a successful write
+   * @param hook Hook (nullptr for none)
+   * @param context Passed to the hook
+   */
+  void setChangeHook(ChangeHook hook, void* context);
+  
+  /**
+   * @brief Get number of registered parameters
+   * @return Parameter count
+   */
+  uint8_t getCount() const;
+  
+  /**
+   * @brief Get a parameter description
+   * @param id Parameter ID
+   * @return Parameter, or nullptr if the ID is unknown
+   */
+  const Parameter* get(uint8_t id) const;
+  
+  /**
+   * @brief Read the encoded value of a parameter
+   * @param id Parameter ID
+   * @param encoded Receives the value
+   * @return false if the ID is unknown
+   */
+  bool read(uint8_t id, uint32_t& encoded) const;
+  
+  /**
+   * @brief Write the encoded value of a parameter
+   * @param id Parameter ID
+   * @param encoded New value
+   * @return false if the ID is unknown or the value is out of range
+   */
+  bool write(uint8_t id, uint32_t encoded);
+  
+  /**
+   * @brief Encode a float as a 32-bit word
+   * @param value Value
+   * @return Encoded value
+   */
+  static uint32_t encodeFloat(float value);
+  
+  /**
+   * @brief Decode a 32-bit word as a float
+   * @param encoded Encoded value
+   * @return Value
+   */
+  static float decodeFloat(uint32_t encoded);
+
+private:
+  Parameter parameters[MAX_PARAMETERS];  // Registered parameters
+  uint8_t count;                         // Number of registered parameters
+  ChangeHook changeHook;                 // Run after a successful write
+  void* changeContext;                   // Passed to the hook
+  
+  /**
+   * @brief Append a parameter to the table
+   * @param name Display name
+   * @param type Storage type
+   * @param value Storage
+   * @param minValue Lower limit (encoded)
+   * @param maxValue Upper limit (encoded)
+   * @return Parameter ID, or -1 if the table is full
+   */
+  int16_t append(const char* name, ParameterType type, void* value, uint32_t minValue, uint32_t maxValue);
+};
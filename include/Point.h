@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Structure representing coordinates
+ */
+struct Point {
+  int16_t x;
+  int16_t y;
+  
+  Point() : x(0), y(0) {}
+  Point(int16_t _x, int16_t _y) : x(_x), y(_y) {}
+  
+  Point operator+(const Point& other) const {
+    return Point(x + other.x, y + other.y);
+  }
+  
+  Point operator-(const Point& other) const {
+    return Point(x - other.x, y - other.y);
+  }
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Class moving a pupil towards its target at a fixed timestep
+ *
+ * Small target changes are followed by smooth pursuit: a critically damped
+ * spring, stepped with its exact discretisation, so the trajectory matches
+ * the analytic solution x(t) = T + (e0 + (v0 + w e0) t) exp(-w t) up to
+ * fixed-point rounding and never overshoots. Large changes start a
+ * ballistic saccade: a fixed-duration smoothstep to the target that later
+ * target changes cannot divert, after which pursuit resumes at rest.
+ *
+ * Positions are fixed point with FRACTION_BITS fractional bits; fewer
+ * would leave a dead zone around the target where the spring force rounds
+ * to nothing. A step costs four 32x32->64 bit multiplies per axis in
+ * pursuit and one in a saccade. Steps are counted from the caller's clock
+ * (takeSteps()), so the motion does not depend on the frame rate. Only
+ * depends on <stdint.h>, so tools/pupil_motion_check can compare it
+ * against the analytic solution on the host.
+ */
+class PupilMotion {
+public:
+  // Motion settings
+  static constexpr uint8_t STEP_MS = 5;             // Fixed integration timestep
+  static constexpr uint8_t FRACTION_BITS = 16;      // Sub-pixel position bits
+  static constexpr uint8_t COEFFICIENT_BITS = 16;   // Fixed-point bits of the step coefficients
+  static constexpr uint8_t MAX_STEPS = 40;          // Steps caught up at most (longer gaps are dropped)
+  static constexpr float PURSUIT_RATE = 30.0F;      // Spring rate w in 1/s (settles in about 4/w)
+  static constexpr uint8_t SACCADE_THRESHOLD = 6;   // Target jumps beyond this (px, either axis) are saccades
+  static constexpr uint8_t SACCADE_BASE_MS = 20;    // Saccade duration: base plus ...
+  static constexpr uint8_t SACCADE_MS_PER_8PX = 5;  // ... this much per 8 px travelled
+
+public:
+  /**
+   * @brief Constructor (at rest at the origin)
+   * @param rate Pursuit spring rate in 1/s
+   */
+  explicit PupilMotion(float rate = PURSUIT_RATE);
+  
+  /**
+   * @brief Set the pursuit spring rate
+   * @param rate Spring rate in 1/s (higher follows faster)
+   */
+  void setRate(float rate);
+  
+  /**
+   * @brief Put the pupil at a position, at rest, with no saccade in flight
+   * @param x X coordinate in pixels
+   * @param y Y coordinate in pixels
+   */
+  void reset(int16_t x, int16_t y);
+  
+  /**
+   * @brief Set the position to move towards
+   * @param x X coordinate in pixels
+   * @param y Y coordinate in pixels
+   */
+  void setTarget(int16_t x, int16_t y);
+  
+  /**
+   * @brief Advance by whole timesteps
+   * @param count Number of STEP_MS steps
+   */
+  void step(uint16_t count);
+  
+  /**
+   * @brief Get X coordinate
+   * @return Fixed-point X coordinate (FRACTION_BITS fractional bits)
+   */
+  int32_t getX() const;
+  
+  /**
+   * @brief Get Y coordinate
+   * @return Fixed-point Y coordinate (FRACTION_BITS fractional bits)
+   */
+  int32_t getY() const;
+  
+  /**
+   * @brief Get X coordinate rounded to a pixel
+   * @return X coordinate in pixels
+   */
+  int16_t getPixelX() const;
+  
+  /**
+   * @brief Get Y coordinate rounded to a pixel
+   * @return Y coordinate in pixels
+   */
+  int16_t getPixelY() const;
+  
+  /**
+   * @brief Check whether a saccade is in flight
+   * @return true until the saccade has landed
+   */
+  bool isSaccading() const;
+  
+  /**
+   * @brief Count the timesteps elapsed on a clock
+   * @param nowMs Current time
+   * @param stepTimeMs Time up to which steps were taken (advanced by the steps returned)
+   * @return Number of steps to take (at most MAX_STEPS; time beyond that is dropped)
+   */
+  static uint8_t takeSteps(uint32_t nowMs, uint32_t& stepTimeMs);
+
+private:
+  /**
+   * @brief Structure holding one axis
+   */
+  struct Axis {
+    int32_t position;     // Fixed-point position
+    int32_t velocity;     // Fixed-point distance per step
+    int32_t target;       // Fixed-point target
+    int32_t saccadeFrom;  // Where the saccade in flight started
+    int32_t saccadeTo;    // Where it lands (target when it started)
+  };
+  
+  Axis axes[2];            // X and Y
+  int32_t coefficients[4]; // Pursuit step matrix (COEFFICIENT_BITS fractional bits)
+  uint16_t saccadeSteps;   // Length of the saccade in flight (0: pursuit)
+  uint16_t saccadeStep;    // Steps of it taken so far
+  
+  /**
+   * @brief Start a saccade if the target is too far for pursuit
+   */
+  void startSaccadeIfFar();
+  
+  /**
+   * @brief Advance one axis by one pursuit step
+   * @param axis Axis
+   */
+  void pursue(Axis& axis) const;
+  
+  /**
+   * @brief Shape a saccade
+   * @param progress Progress (0 .. 256)
+   * @return Smoothstep of the progress (0 .. 256)
+   */
+  static int32_t smoothstep(int32_t progress);
+};
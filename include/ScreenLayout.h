@@ -0,0 +1,143 @@
+#pragma once
+
+#include <stdint.h>
+#include "Point.h"
+
+#if defined(ARDUINO)
+#include <M5Unified.h>
+#endif
+
+/**
+ * @brief Enumeration representing how the unit is mounted (quarter turns clockwise from landscape)
+ */
+enum class MountRotation : uint8_t {
+  LANDSCAPE,          // Buttons below the screen
+  PORTRAIT,           // Turned a quarter clockwise
+  LANDSCAPE_FLIPPED,  // Upside down
+  PORTRAIT_FLIPPED    // Turned a quarter counter-clockwise
+};
+
+/**
+ * @brief Class mapping the mounted (logical) screen onto the panel
+ *
+ * The panel is always driven at PANEL_ROTATION, the orientation the sprite
+ * pushes were written for. Mounting is handled in the raster instead: eyes
+ * are laid out in logical coordinates and every span is rotated into the
+ * panel's scan order as it is drawn, so sprites are stored pre-rotated and
+ * a push stays a linear transfer whatever the mount. Apart from fillRect(),
+ * only depends on <stdint.h>, so tools/screen_layout_check can check the
+ * mappings on the host.
+ */
+class ScreenLayout {
+public:
+  // Panel settings
+  static constexpr uint8_t PANEL_ROTATION = 1;  // M5GFX rotation of the 320x240 landscape panel
+  static constexpr uint16_t PANEL_WIDTH = 320;
+  static constexpr uint16_t PANEL_HEIGHT = 240;
+  static constexpr uint8_t NUM_OF_ROTATIONS = 4;
+
+public:
+  /**
+   * @brief Constructor
+   * @param rotation How the unit is mounted
+   */
+  explicit ScreenLayout(MountRotation rotation);
+  
+  /**
+   * @brief Get how the unit is mounted
+   * @return Mount rotation
+   */
+  MountRotation getRotation() const;
+  
+  /**
+   * @brief Get logical screen width
+   * @return Width in pixels as seen by the viewer
+   */
+  uint16_t getWidth() const;
+  
+  /**
+   * @brief Get logical screen height
+   * @return Height in pixels as seen by the viewer
+   */
+  uint16_t getHeight() const;
+  
+  /**
+   * @brief Get center of an eye in logical coordinates
+   * @param side Which eye (0: left, 1: right, as seen by the viewer)
+   * @return Eye center
+   */
+  Point getEyeCenter(uint8_t side) const;
+  
+  /**
+   * @brief Convert logical screen coordinates to panel coordinates
+   * @param logical Logical coordinates
+   * @return Panel coordinates
+   */
+  Point toPanel(const Point& logical) const;
+  
+  /**
+   * @brief Convert panel coordinates (e.g. touch points) to logical screen coordinates
+   * @param panel Panel coordinates
+   * @return Logical coordinates
+   */
+  Point toLogical(const Point& panel) const;
+  
+  /**
+   * @brief Convert a direction on the panel (e.g. a tilt) to logical screen axes
+   * @param panel Vector in panel axes
+   * @return Vector in logical axes
+   */
+  Point directionToLogical(const Point& panel) const;
+  
+  /**
+   * @brief Get display name of a mount rotation
+   * @param rotation Mount rotation
+   * @return Display name
+   */
+  static const char* getName(MountRotation rotation);
+  
+  /**
+   * @brief Rotate a point of a logical area into the area's panel scan order
+   * @param rotation Mount rotation
+   * @param point Point in the logical area
+   * @param width Logical area width
+   * @param height Logical area height
+   * @return Point in the rotated area
+   */
+  static Point rotate(MountRotation rotation, const Point& point, int32_t width, int32_t height);
+  
+  /**
+   * @brief Rotate a rectangle of a logical area into the area's panel scan order
+   * @param rotation Mount rotation
+   * @param width Logical area width
+   * @param height Logical area height
+   * @param x Rectangle X (replaced by the rotated rectangle's)
+   * @param y Rectangle Y (replaced)
+   * @param w Rectangle width (replaced)
+   * @param h Rectangle height (replaced)
+   */
+  static void rotateRect(MountRotation rotation, int32_t width, int32_t height,
+                         int32_t& x, int32_t& y, int32_t& w, int32_t& h);
+  
+#if defined(ARDUINO)
+  /**
+   * @brief Fill a rectangle given in logical coordinates of a pre-rotated area
+   * @param target Canvas or display holding the area in panel scan order
+   * @param rotation Mount rotation
+   * @param width Logical area width
+   * @param height Logical area height
+   * @param x Rectangle X in the logical area
+   * @param y Rectangle Y in the logical area
+   * @param w Rectangle width
+   * @param h Rectangle height
+   * @param color Fill color
+   */
+  static void fillRect(lgfx::LovyanGFX& target, MountRotation rotation, int32_t width, int32_t height,
+                       int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+#endif
+
+private:
+  MountRotation rotation;  // How the unit is mounted
+  uint16_t width;          // Logical screen width
+  uint16_t height;         // Logical screen height
+};
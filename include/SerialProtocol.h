@@ -0,0 +1,146 @@
+#pragma once
+
+#include <M5Unified.h>
+#include "EyesAnimation.h"
+#include "EyesDiagnostics.h"
+#include "PacketCodec.h"
+#include "ParameterRegistry.h"
+
+/**
+ * @brief Class handling the binary tuning and telemetry protocol on Serial
+ *
+ * Requests are parsed a byte at a time from whatever has arrived, so the
+ * frame loop never waits for a whole packet. Replies and telemetry are
+ * written only when they fit in the transmit buffer; otherwise they are
+ * dropped and counted. Nothing is allocated. PacketCodec parses requests,
+ * frames replies (see there for the packet layout) and answers PING and
+ * the parameter requests.
+ *
+ * Every reply payload starts with a status byte. Requests and replies:
+ *   PING          -                -> version u8, parameter count u8
+ *   PARAM_INFO    id u8            -> id, type u8, min u32, max u32, value u32, name
+ *   PARAM_GET     id u8            -> id, value u32
+ *   PARAM_SET     id u8, value u32 -> id, value u32 (value in effect)
+ *   TELEMETRY     interval u16 ms  -> - (0 stops the TELEMETRY_REPORT stream)
+ *   MEMORY_REPORT -                -> - (the text report follows the reply)
+ *   BATCH_RENDER  seed u32         -> - (sent after the frame stream ends)
+ *   BOOT_REPORT   -                -> - (the text report follows the reply)
+ *   FRAME_TRACE   frames u16       -> - (one FRAME_TRACE_REPORT per frame follows)
+ *   GAZE_REPORT   -                -> - (the text report follows the reply)
+ *   ROTATION_BENCH -               -> - (the text report follows the reply)
+ *   SINK_REPORT   -                -> - (the text report follows the reply)
+ *   EXPRESSION    index u8         -> - (FAILED if unknown or not allowed in the current state)
+ *   EXPRESSION_REPORT -            -> - (the text report follows the reply)
+ *   IMU_TRACE     samples u16      -> - (one IMU_TRACE_REPORT per sample follows;
+ *                                        FAILED if the input sampler is not running)
+ *   TILT_REPORT   -                -> - (the text report follows the reply)
+ *   LOOK_AT       x i16, y i16     -> - (logical screen coordinates, held for
+ *                                        GAZE_EXTERNAL_EXPIRY_MS; no payload stops looking)
+ *   GAZE_SOURCE_REPORT -           -> - (the text report follows the reply)
+ *   AUDIO_REPORT  -                -> - (the text report follows the reply)
+ *   INSTANCE_BENCH -               -> - (sent after the text report; FAILED if the
+ *                                        instances drew different frames)
+ *   TOUCH_BENCH   -                -> - (the text report follows the reply)
+ *   COLOR_BENCH   -                -> - (the text report follows the reply)
+ *
+ * TELEMETRY_REPORT (device to host, no status byte):
+ *   uptime u32 ms, frames u32, fps u16 (x10), state u8, transitions u32,
+ *   frame time histogram u16[8] (since the previous report), max frame time
+ *   u32 us, dropped touch samples u32, bad request packets u16, degradation
+ *   level u8, missed frame deadlines u32, CPU frequency u16 MHz
+ *
+ * FRAME_TRACE_REPORT (device to host, no status byte), for tools/governor_sim:
+ *   state u8, load u8, frame work time u32 us, CPU frequency u16 MHz,
+ *   frame budget u16 ms
+ *
+ * IMU_TRACE_REPORT (device to host, no status byte), for tools/tilt_check:
+ *   time u32 ms, acceleration i16[3] milli-g, angular rate i16[3] 0.1 deg/s
+ *   (panel axes, see ImuSample)
+ */
+class SerialProtocol {
+public:
+  // Protocol settings
+  static constexpr uint8_t MAX_BYTES_PER_POLL = 64;   // Bounds the time spent per frame
+  static constexpr uint8_t MAX_IMU_REPORTS_PER_POLL = 8; // Keeps up with the sampler at any frame rate
+
+public:
+  /**
+   * @brief Constructor
+   * @param io Serial stream carrying the protocol
+   * @param eyes Animation providing the parameters and telemetry
+   */
+  SerialProtocol(Stream& io, EyesAnimation& eyes);
+  
+  /**
+   * @brief Parse received bytes and send telemetry when due
+   * @param nowMs Current time
+   */
+  void poll(uint32_t nowMs);
+  
+  /**
+   * @brief Get number of malformed request packets
+   * @return Bad packet count
+   */
+  uint32_t getBadPackets() const;
+  
+  /**
+   * @brief Get number of replies dropped for lack of transmit space
+   * @return Dropped reply count
+   */
+  uint32_t getDroppedReplies() const;
+
+private:
+  Stream& io;                  // Serial stream
+  EyesAnimation& eyes;         // Parameters and telemetry
+  PacketCodec codec;           // Request parser and reply framing
+  EyesDiagnostics diagnostics; // Text reports and benchmarks of the animation
+  uint16_t telemetryIntervalMs; // Telemetry period (0: off)
+  uint32_t lastTelemetryTime;  // Time of the previous report
+  uint32_t lastTelemetryFrames; // Frame count at the previous report
+  uint32_t lastHistogram[FrameTelemetry::HISTOGRAM_BUCKETS]; // Histogram at the previous report
+  uint16_t traceFramesLeft;    // Frames still to trace
+  uint32_t lastTracedFrame;    // Frame count at the previous trace report
+  uint32_t droppedReplies;     // Replies dropped for lack of transmit space
+  
+  /**
+   * @brief Execute a complete request
+   * @param nowMs Current time
+   */
+  void handleRequest(uint32_t nowMs);
+  
+  /**
+   * @brief Reply with a bare status
+   * @param status Status code
+   */
+  void replyStatus(PacketCodec::Status status);
+  
+  /**
+   * @brief Send a telemetry report
+   * @param nowMs Current time
+   */
+  void sendTelemetry(uint32_t nowMs);
+  
+  /**
+   * @brief Send a trace report for the most recent frame
+   */
+  void sendFrameTrace();
+  
+  /**
+   * @brief Send trace reports for the IMU samples queued by the input sampler
+   */
+  void sendImuTrace();
+  
+  /**
+   * @brief Frame and send a packet whose payload is already in the codec's reply buffer
+   * @param packetCommand Command byte
+   * @param payloadLength Payload length
+   * @return false if the packet did not fit in the transmit buffer
+   */
+  bool send(uint8_t packetCommand, uint8_t payloadLength);
+  
+  /**
+   * @brief Send the packet most recently framed by the codec
+   * @return false if the packet did not fit in the transmit buffer
+   */
+  bool transmit();
+};
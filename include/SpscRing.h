@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @brief Lock-free single-producer single-consumer ring buffer
+ * 
+ * One task may push and one task may pop concurrently without locks.
+ * Capacity must be a power of two; indices wrap freely and are masked on
+ * access, so all slots are usable.
+ * 
+ * @tparam T Element type (copied by value)
+ * @tparam CAPACITY Number of slots (power of two)
+ */
+template <typename T, uint32_t CAPACITY>
+class SpscRing {
+  static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+                "SpscRing capacity must be a power of two");
+  
+public:
+  /**
+   * @brief Constructor
+   */
+  SpscRing() : head(0), tail(0) {}
+  
+  /**
+   * @brief Push an element (producer side)
+   * @param value Element to push
+   * @return false if the ring is full
+   */
+  bool push(const T& value) {
+    uint32_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead - tail.load(std::memory_order_acquire) >= CAPACITY) {
+      return false;
+    }
+    slots[currentHead & (CAPACITY - 1)] = value;
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+  }
+  
+  /**
+   * @brief Pop an element (consumer side)
+   * @param value Receives the popped element
+   * @return false if the ring is empty
+   */
+  bool pop(T& value) {
+    uint32_t currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = slots[currentTail & (CAPACITY - 1)];
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+  }
+  
+  /**
+   * @brief Get number of queued elements (approximate while the other side runs)
+   * @return Number of queued elements
+   */
+  uint32_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+  
+private:
+  T slots[CAPACITY];           // Element storage
+  std::atomic<uint32_t> head;  // Next slot to write (producer)
+  std::atomic<uint32_t> tail;  // Next slot to read (consumer)
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Structure holding one IMU reading in panel axes
+ *
+ * Axes follow the panel: x to the right, y down, z into the screen. Units
+ * are integers so that readings can be traced and replayed exactly.
+ */
+struct ImuSample {
+  uint32_t timeMs;   // Time of the reading
+  int16_t accel[3];  // Acceleration in milli-g
+  int16_t gyro[3];   // Angular rate in 0.1 degrees per second
+};
+
+/**
+ * @brief Class estimating which way is down from accelerometer and gyro readings
+ *
+ * A complementary filter on the gravity vector: each reading rotates the
+ * estimate by the gyro's angle increment (g += g x w dt, accurate for the
+ * small increments of a high sample rate), then pulls it towards the
+ * accelerometer with a weight of dt / time constant. Readings whose
+ * magnitude is far from 1 g (shakes, taps) do not pull at all, so the gyro
+ * carries the estimate through them.
+ *
+ * The vector is in Q14 (1 g = 16384) and an update costs about twenty
+ * integer multiplies. Only depends on <stdint.h>, so tools/tilt_check can
+ * replay recorded traces through the same code on the host.
+ */
+class TiltFilter {
+public:
+  // Filter settings
+  static constexpr uint8_t GRAVITY_BITS = 14;            // Fixed-point bits of the vector (1 g)
+  static constexpr uint16_t TIME_CONSTANT_MS = 500;      // Default accelerometer time constant
+  static constexpr uint16_t ACCEL_GATE_MILLI_G = 250;    // Readings this far from 1 g are not trusted
+  static constexpr uint8_t MAX_STEP_MS = 50;             // Longer gaps are integrated as this long
+  static constexpr int32_t MAX_STEP_ANGLE = 1 << 14;     // Rotation per reading in rad Q16 (0.25 rad)
+
+public:
+  /**
+   * @brief Constructor (no estimate until the first reading)
+   * @param timeConstantMs How long the accelerometer takes to pull the estimate over
+   */
+  explicit TiltFilter(uint16_t timeConstantMs = TIME_CONSTANT_MS);
+  
+  /**
+   * @brief Set how long the accelerometer takes to pull the estimate over
+   * @param timeConstantMs Time constant in milliseconds (longer trusts the gyro more)
+   */
+  void setTimeConstant(uint16_t timeConstantMs);
+  
+  /**
+   * @brief Forget the estimate (the next reading starts a new one)
+   */
+  void reset();
+  
+  /**
+   * @brief Fuse one reading
+   * @param sample Reading (not older than the previous one)
+   */
+  void update(const ImuSample& sample);
+  
+  /**
+   * @brief Check whether there is an estimate
+   * @return true after the first reading
+   */
+  bool hasEstimate() const;
+  
+  /**
+   * @brief Get the estimated reaction to gravity (points up, like a resting accelerometer)
+   * @param axis Axis (0: x, 1: y, 2: z)
+   * @return Component in Q14 (1 g = 16384)
+   */
+  int32_t get(uint8_t axis) const;
+  
+  /**
+   * @brief Convert an acceleration reading to the vector's scale
+   * @param milliG Acceleration in milli-g
+   * @return Acceleration in Q14, limited to 2 g
+   */
+  static int32_t toGravity(int16_t milliG);
+
+private:
+  int32_t gravity[3];       // Estimate in Q14
+  int32_t weightPerMs;      // Accelerometer weight per millisecond in Q16
+  uint32_t lastTimeMs;      // Time of the previous reading
+  bool estimated;           // Whether gravity holds an estimate
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <stdint.h>
+#include "GestureRecognizer.h"
+#include "Point.h"
+
+/**
+ * @brief Enumeration representing touch state
+ */
+enum class TouchState {
+  NONE,       // No touch
+  TOUCHING,   // Touching
+  RELEASED,   // Touch released
+  MULTI_TOUCH // Multiple touches
+};
+
+/**
+ * @brief Structure representing one raw touch sample
+ */
+struct TouchSample {
+  static constexpr uint8_t MAX_POINTS = 2;  // FT6336U reports two
+  
+  uint32_t timeMs;                  // Sampling time
+  uint8_t state;                    // M5Stack touch state of the first point
+  uint8_t count;                    // Number of valid points
+  Point points[MAX_POINTS];         // Touch positions
+};
+
+/**
+ * @brief Class coalescing raw touch samples into position, velocity and begin/end edges
+ *
+ * Holds the part of TouchHandler that does not touch M5Unified or the
+ * sample queue: the interpretation of the M5Stack touch states, the
+ * coalescing of a batch of samples and the gesture recogniser fed with
+ * every sample. Only depends on <stdint.h> and GestureRecognizer, so
+ * tools/touch_check can feed it M5Stack state sequences on the host.
+ */
+class TouchCoalescer {
+public:
+  // M5Stack touch states (m5::touch_state_t, checked against it in TouchHandler.cpp)
+  // Bit 0: touching, bit 1: changed, bit 2: holding, bit 3: moving
+  static constexpr uint8_t STATE_NONE = 0x00;
+  static constexpr uint8_t STATE_TOUCH = 0x01;
+  static constexpr uint8_t STATE_TOUCH_END = 0x02;
+  static constexpr uint8_t STATE_TOUCH_BEGIN = 0x03;
+  static constexpr uint8_t STATE_HOLD = 0x05;
+  static constexpr uint8_t STATE_HOLD_END = 0x06;
+  static constexpr uint8_t STATE_HOLD_BEGIN = 0x07;
+  static constexpr uint8_t STATE_FLICK = 0x09;
+  static constexpr uint8_t STATE_FLICK_END = 0x0A;
+  static constexpr uint8_t STATE_FLICK_BEGIN = 0x0B;
+  static constexpr uint8_t STATE_DRAG = 0x0D;
+  static constexpr uint8_t STATE_DRAG_END = 0x0E;
+  static constexpr uint8_t STATE_DRAG_BEGIN = 0x0F;
+
+public:
+  /**
+   * @brief Constructor
+   */
+  TouchCoalescer();
+  
+  /**
+   * @brief Start a batch of samples (clears the begin/end edges)
+   */
+  void beginBatch();
+  
+  /**
+   * @brief Coalesce one sample into the current touch state
+   * @param sample Touch sample
+   * @return Touch state of the sample
+   */
+  TouchState apply(const TouchSample& sample);
+  
+  /**
+   * @brief Finish a batch of samples
+   * @param state Touch state of the batch so far
+   * @param nowMs Current time (completes long presses without new samples)
+   * @return Touch state of the batch (RELEASED if the touch ended within it)
+   */
+  TouchState endBatch(TouchState state, uint32_t nowMs);
+  
+  /**
+   * @brief Let time pass without a batch (completes long presses)
+   * @param nowMs Current time
+   */
+  void advance(uint32_t nowMs);
+  
+  /**
+   * @brief Check whether a touch began during the last batch
+   * @return true if a touch began
+   */
+  bool wasBegun() const;
+  
+  /**
+   * @brief Check whether a touch ended during the last batch
+   * @return true if a touch ended
+   */
+  bool wasEnded() const;
+  
+  /**
+   * @brief Get velocity of the first touch point
+   * @return Velocity in pixels per second
+   */
+  const Point& getVelocity() const;
+  
+  /**
+   * @brief Get a touch position
+   * @param index Touch point index (less than getTouchCount())
+   * @return Touch position
+   */
+  const Point& getTouchPoint(uint8_t index) const;
+  
+  /**
+   * @brief Get number of current touch points
+   * @return Number of touch points
+   */
+  uint8_t getTouchCount() const;
+  
+  /**
+   * @brief Get centroid of current touch points
+   * @return Centroid, or the first touch position if there is no touch point
+   */
+  Point getCentroid() const;
+  
+  /**
+   * @brief Take the oldest gesture recognised from the samples
+   * @param event Receives the gesture (positions in panel coordinates)
+   * @return false if there is none
+   */
+  bool takeGesture(GestureEvent& event);
+  
+  /**
+   * @brief Interpret M5Stack touch state
+   * @param state M5Stack touch state
+   * @return Interpreted touch state
+   */
+  static TouchState interpretTouchState(uint8_t state);
+
+private:
+  Point touchPoints[TouchSample::MAX_POINTS]; // Touch positions
+  uint8_t touchCount;         // Number of valid touch positions
+  bool touching;              // Whether the latest sample was touching
+  bool begun;                 // Touch began during the last batch
+  bool ended;                 // Touch ended during the last batch
+  Point velocity;             // Velocity of the first point (pixels per second)
+  uint32_t lastSampleTime;    // Time of the latest touching sample
+  GestureRecognizer gestures; // Recognises gestures from every sample
+};
@@ -1,45 +1,38 @@
 #pragma once
 
 #include <M5Unified.h>
+#include "Clock.h"
+#include "SpscRing.h"
+#include "TouchCoalescer.h"
 
 /**
- * @brief Structure representing coordinates
+ * @brief Class managing touch input
+ * 
+ * Touch samples either come from a producer task through the sample queue
+ * (queue mode) or are polled from the render loop. Each update() consumes
+ * all pending samples and coalesces them into the latest position,
+ * velocity and begin/end edges. Every sample also goes through a gesture
+ * recogniser, whose events are taken with takeGesture(). Both happen in
+ * TouchCoalescer; this class adds the M5Unified polling and the queue.
  */
-struct Point {
-  int16_t x;
-  int16_t y;
+class TouchHandler {
+public:
+  // Maximum number of simultaneous touch points
+  static constexpr uint8_t MAX_TOUCH_POINTS = TouchSample::MAX_POINTS;
   
-  Point() : x(0), y(0) {}
-  Point(int16_t _x, int16_t _y) : x(_x), y(_y) {}
+  // Touch polling interval (polling mode only)
+  static constexpr uint8_t UPDATE_INTERVAL_MS = 25;
   
-  Point operator+(const Point& other) const {
-    return Point(x + other.x, y + other.y);
-  }
+  // Sample queue filled by a producer task
+  static constexpr uint32_t QUEUE_CAPACITY = 32;
+  using TouchQueue = SpscRing<TouchSample, QUEUE_CAPACITY>;
   
-  Point operator-(const Point& other) const {
-    return Point(x - other.x, y - other.y);
-  }
-};
-
-/**
- * @brief Enumeration representing touch state
- */
-enum class TouchState {
-  NONE,       // No touch
-  TOUCHING,   // Touching
-  RELEASED,   // Touch released
-  MULTI_TOUCH // Multiple touches
-};
-
-/**
- * @brief Class managing touch input
- */
-class TouchHandler {
 public:
   /**
    * @brief Constructor
+   * @param clock Time source (default: Arduino millis/micros)
    */
-  TouchHandler();
+  explicit TouchHandler(const Clock& clock = Clock());
   
   /**
    * @brief Update touch state
@@ -47,26 +40,86 @@ public:
    */
   TouchState update();
   
+  /**
+   * @brief Read a touch sample from M5.Touch (call after M5.update())
+   * @param timeMs Sampling time
+   * @return Touch sample
+   */
+  static TouchSample readSample(uint32_t timeMs);
+  
+  /**
+   * @brief Get sample queue for a producer task
+   * @return Sample queue
+   */
+  TouchQueue& getQueue();
+  
+  /**
+   * @brief Switch between consuming the sample queue and polling
+   * @param enabled true to consume samples from the queue
+   */
+  void setQueueMode(bool enabled);
+  
+  /**
+   * @brief Check whether a touch began during the last update
+   * @return true if a touch began
+   */
+  bool wasBegun() const;
+  
+  /**
+   * @brief Check whether a touch ended during the last update
+   * @return true if a touch ended
+   */
+  bool wasEnded() const;
+  
+  /**
+   * @brief Get velocity of the first touch point
+   * @return Velocity in pixels per second
+   */
+  const Point& getVelocity() const;
+  
   /**
    * @brief Get current touch position
-   * @return Touch position
+   * @return Touch position of the first touch point
    */
   const Point& getTouchPoint() const;
   
+  /**
+   * @brief Get a touch position
+   * @param index Touch point index (less than getTouchCount())
+   * @return Touch position
+   */
+  const Point& getTouchPoint(uint8_t index) const;
+  
+  /**
+   * @brief Get number of current touch points
+   * @return Number of touch points
+   */
+  uint8_t getTouchCount() const;
+  
+  /**
+   * @brief Get centroid of current touch points
+   * @return Centroid, or the first touch position if there is no touch point
+   */
+  Point getCentroid() const;
+  
   /**
    * @brief Get previous touch state
    * @return Previous touch state
    */
   TouchState getLastTouchState() const;
   
-private:
-  TouchState lastTouchState;  // Previous touch state
-  Point touchPoint;           // Touch position
-  
   /**
-   * @brief Interpret M5Stack touch state
-   * @param state M5Stack touch state
-   * @return Interpreted touch state
+   * @brief Take the oldest gesture recognised by update()
+   * @param event Receives the gesture (positions in panel coordinates)
+   * @return false if there is none
    */
-  TouchState interpretTouchState(uint8_t state);
+  bool takeGesture(GestureEvent& event);
+  
+private:
+  Clock clock;                // Time source
+  TouchState lastTouchState;  // Previous touch state
+  uint32_t lastUpdateTime;    // Time of the previous poll
+  TouchQueue queue;           // Samples from the producer task
+  bool queueMode;             // Whether samples come from the queue
+  TouchCoalescer coalescer;   // Coalesces samples and recognises gestures
 };
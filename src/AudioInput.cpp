@@ -0,0 +1,149 @@
+#include "AudioInput.h"
+
+/**
+ * @brief Constructor
+ */
+AudioInput::AudioInput()
+  : task(nullptr),
+    blocks(),
+    detector(SAMPLE_RATE),
+    thresholdDb(LoudnessDetector::THRESHOLD_DB),
+    startles(0),
+    onsets(0),
+    levels(0),
+    kernelBlocks(0),
+    kernelCycles(0),
+    kernelMaxCycles(0)
+{
+}
+
+/**
+ * @brief Start the microphone and the listener task
+ * @return Whether both were started
+ */
+bool AudioInput::begin() {
+  if (task != nullptr) {
+    return true;
+  }
+  
+  // The Core2's speaker and microphone cannot share the I2S port
+  M5.Speaker.end();
+  if (!M5.Mic.begin()) {
+    return false;
+  }
+  
+  if (xTaskCreatePinnedToCore(taskLoop, "AudioInput", TASK_STACK_SIZE, this,
+                              TASK_PRIORITY, &task, TASK_CORE) != pdPASS) {
+    task = nullptr;
+    M5.Mic.end();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Check whether the listener task is running
+ * @return true if running
+ */
+bool AudioInput::isRunning() const {
+  return task != nullptr;
+}
+
+/**
+ * @brief Set how far above the noise floor a sound must be to startle
+ * @param thresholdDb Threshold in dB (applied from the next block)
+ */
+void AudioInput::setThresholdDb(uint8_t thresholdDb) {
+  this->thresholdDb.store(thresholdDb, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Take whether a loud sound started since the previous call
+ * @return true if at least one onset was detected
+ */
+bool AudioInput::takeStartle() {
+  return startles.exchange(0, std::memory_order_relaxed) > 0;
+}
+
+/**
+ * @brief Get the levels of the latest block
+ * @param level Receives the block RMS (full scale 32767)
+ * @param floor Receives the noise floor RMS
+ */
+void AudioInput::getLevels(uint16_t& level, uint16_t& floor) const {
+  uint32_t packed = levels.load(std::memory_order_relaxed);
+  level = static_cast<uint16_t>(packed & 0xFFFF);
+  floor = static_cast<uint16_t>(packed >> 16);
+}
+
+/**
+ * @brief Get number of onsets since startup
+ * @return Onset count
+ */
+uint32_t AudioInput::getOnsets() const {
+  return onsets.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Take the cost of the loudness detector since the previous call
+ * @param blocks Receives the number of blocks processed
+ * @param averageCycles Receives the average CPU cycles per block
+ * @param maxCycles Receives the largest CPU cycles for one block
+ */
+void AudioInput::takeKernelCost(uint32_t& blocks, uint32_t& averageCycles, uint32_t& maxCycles) {
+  blocks = kernelBlocks.exchange(0, std::memory_order_relaxed);
+  uint32_t cycles = kernelCycles.exchange(0, std::memory_order_relaxed);
+  averageCycles = (blocks > 0) ? cycles / blocks : 0;
+  maxCycles = kernelMaxCycles.exchange(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Listener task body
+ * @param param AudioInput instance
+ */
+void AudioInput::taskLoop(void* param) {
+  AudioInput* self = static_cast<AudioInput*>(param);
+  uint8_t next = 0;
+  uint8_t queued = 0;
+  for (;;) {
+    // Waits while the driver already holds two blocks, i.e. until the older one is complete
+    M5.Mic.record(self->blocks[next], BLOCK_SAMPLES, SAMPLE_RATE);
+    next = (next + 1) % NUM_BLOCKS;
+    if (queued < NUM_BLOCKS - 1) {
+      queued++;
+      continue;
+    }
+  
+    // The block handed over two calls ago is the one that just completed
+    self->processBlock(self->blocks[next]);
+  }
+}
+
+/**
+ * @brief Run the detector over a completed block and publish the result
+ * @param block Block to process
+ */
+void AudioInput::processBlock(const int16_t* block) {
+  uint8_t requestedDb = thresholdDb.load(std::memory_order_relaxed);
+  if (requestedDb != detector.getThresholdDb()) {
+    detector.setThresholdDb(requestedDb);
+  }
+  
+  uint32_t start = ESP.getCycleCount();
+  bool onset = detector.process(block, BLOCK_SAMPLES);
+  uint32_t cycles = ESP.getCycleCount() - start;
+  
+  levels.store(detector.getLevel() | (static_cast<uint32_t>(detector.getFloor()) << 16), std::memory_order_relaxed);
+  if (onset) {
+    startles.fetch_add(1, std::memory_order_relaxed);
+    onsets.fetch_add(1, std::memory_order_relaxed);
+  }
+  
+  // Readers take the counters; they may see them a block apart
+  kernelBlocks.fetch_add(1, std::memory_order_relaxed);
+  kernelCycles.fetch_add(cycles, std::memory_order_relaxed);
+  uint32_t maxCycles = kernelMaxCycles.load(std::memory_order_relaxed);
+  while (cycles > maxCycles &&
+         !kernelMaxCycles.compare_exchange_weak(maxCycles, cycles, std::memory_order_relaxed)) {
+  }
+}
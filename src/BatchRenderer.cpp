@@ -0,0 +1,279 @@
+#include "BatchRenderer.h"
+#include <new>
+
+// Virtual time of the batch run (Clock takes plain functions, so it cannot be a member)
+static uint32_t virtualMillis = 0;
+
+/**
+ * @brief Read the virtual clock
+ * @return Virtual time in milliseconds
+ */
+static unsigned long readVirtualMillis() {
+  return virtualMillis;
+}
+
+/**
+ * @brief Fold a sprite into a running hash (32-bit FNV-1a)
+ * @param hash Hash so far
+ * @param view Sprite
+ * @return Updated hash
+ */
+static uint32_t hashSprite(uint32_t hash, const SpriteView& view) {
+  for (uint32_t i = 0; i < view.length; i++) {
+    hash = (hash ^ view.buffer[i]) * 16777619U;
+  }
+  return hash;
+}
+
+/**
+ * @brief Built-in demo: idle, drag around the screen, release, shake
+ */
+const TimelineEvent BatchRenderer::DEMO_TIMELINE[BatchRenderer::DEMO_EVENT_COUNT] = {
+  { 1000, TimelineAction::TOUCH,    60,  60 },
+  { 1800, TimelineAction::TOUCH,   260,  60 },
+  { 2600, TimelineAction::TOUCH,   260, 200 },
+  { 3400, TimelineAction::TOUCH,    60, 200 },
+  { 3600, TimelineAction::RELEASE,   0,   0 },
+  { 4200, TimelineAction::SHAKE,     0,   0 },
+  { 7000, TimelineAction::TOUCH,   160, 120 },
+};
+
+/**
+ * @brief Constructor
+ * @param timeline Scripted input sorted by time (default: built-in demo)
+ * @param eventCount Number of timeline entries
+ * @param durationMs Length of the run
+ */
+BatchRenderer::BatchRenderer(const TimelineEvent* timeline, uint8_t eventCount, uint32_t durationMs)
+  : timeline(timeline),
+    eventCount(eventCount),
+    durationMs(durationMs),
+    frames(0),
+    renderMicros(0),
+    totalMicros(0),
+    exportedBytes(0),
+    rawBytes(0) {
+}
+
+/**
+ * @brief Render the whole timeline
+ * @param out Destination of the frame stream (nullptr to render only)
+ * @param seed Random seed of the animation
+ * @return Whether the run completed
+ */
+bool BatchRenderer::run(Print* out, uint32_t seed) {
+  frames = 0;
+  renderMicros = 0;
+  totalMicros = 0;
+  exportedBytes = 0;
+  rawBytes = 0;
+  virtualMillis = 0;
+  
+  // A separate instance keeps the live animation untouched
+  EyesAnimation* eyes = new (std::nothrow) EyesAnimation(Clock(readVirtualMillis, ::micros));
+  if (eyes == nullptr) {
+    Serial.println("Warning: Not enough memory for the batch renderer.");
+    return false;
+  }
+  
+  eyes->setRandomSeed(seed);
+  eyes->setDisplayOutput(false);
+  if (!eyes->setup(InputMode::INJECTED)) {
+    delete eyes;
+    return false;
+  }
+  
+  FrameStreamer streamer;
+  if (out != nullptr) {
+    if (!streamer.begin(*out, 0, Eye::SPRITE_BYTES)) {
+      Serial.println("Warning: Failed to allocate batch export buffers.");
+      delete eyes;
+      return false;
+    }
+    streamer.setBlocking(true);
+  }
+  
+  uint8_t nextEvent = 0;
+  uint8_t lastTouch = 0;
+  bool touching = false;
+  uint32_t startMicros = micros();
+  
+  while (virtualMillis < durationMs) {
+    virtualMillis += EyesAnimation::ANIMATION_DELAY_MS;
+    injectInput(*eyes, virtualMillis, nextEvent, lastTouch, touching);
+  
+    uint32_t frameStart = micros();
+    eyes->loop();
+    renderMicros += micros() - frameStart;
+    frames++;
+  
+    if (out != nullptr) {
+      streamer.submit(0, eyes->getEyeSpriteView(0), virtualMillis);
+      streamer.submit(1, eyes->getEyeSpriteView(1), virtualMillis);
+    }
+  }
+  
+  totalMicros = micros() - startMicros;
+  exportedBytes = streamer.getSentBytes();
+  rawBytes = streamer.getRawBytes();
+  
+  delete eyes;
+  return true;
+}
+
+/**
+ * @brief Inject the input for one frame
+ * @param eyes Animation instance
+ * @param nowMs Virtual time of the frame
+ * @param nextEvent Index of the next timeline entry (advanced in place)
+ * @param lastTouch Index of the latest TOUCH entry applied (updated in place)
+ * @param touching Whether a finger is down (updated in place)
+ */
+void BatchRenderer::injectInput(EyesAnimation& eyes, uint32_t nowMs, uint8_t& nextEvent, uint8_t& lastTouch,
+                                bool& touching) const {
+  // Apply the entries that are due
+  while (nextEvent < eventCount && timeline[nextEvent].timeMs <= nowMs) {
+    const TimelineEvent& event = timeline[nextEvent];
+    if (event.action == TimelineAction::TOUCH) {
+      touching = true;
+      lastTouch = nextEvent;
+    } else if (event.action == TimelineAction::RELEASE && touching) {
+      touching = false;
+      TouchSample sample = {};
+      sample.timeMs = nowMs;
+      sample.state = m5::touch_state_t::touch_end;
+      eyes.injectTouch(sample);
+    } else if (event.action == TimelineAction::SHAKE) {
+      eyes.injectShake();
+    }
+    nextEvent++;
+  }
+  
+  if (!touching) {
+    return;
+  }
+  
+  // Hold the finger at the last TOUCH entry, moving towards the next one unless it is lifted first
+  const TimelineEvent& from = timeline[lastTouch];
+  int32_t x = from.x;
+  int32_t y = from.y;
+  for (uint8_t i = nextEvent; i < eventCount && timeline[i].action != TimelineAction::RELEASE; i++) {
+    const TimelineEvent& to = timeline[i];
+    if (to.action != TimelineAction::TOUCH) {
+      continue;
+    }
+    int32_t span = static_cast<int32_t>(to.timeMs - from.timeMs);
+    if (span > 0) {
+      int32_t elapsed = static_cast<int32_t>(nowMs - from.timeMs);
+      x += (to.x - from.x) * elapsed / span;
+      y += (to.y - from.y) * elapsed / span;
+    }
+    break;
+  }
+  
+  TouchSample sample = {};
+  sample.timeMs = nowMs;
+  sample.state = m5::touch_state_t::touch;
+  sample.count = 1;
+  sample.points[0] = Point(static_cast<int16_t>(x), static_cast<int16_t>(y));
+  eyes.injectTouch(sample);
+}
+
+/**
+ * @brief Print the result of the last run
+ * @param out Destination of the report
+ */
+void BatchRenderer::printReport(Print& out) const {
+  float seconds = totalMicros / 1000000.0F;
+  float renderFps = (renderMicros > 0) ? frames * 1000000.0F / renderMicros : 0.0F;
+  out.printf("[batch] %u frames (%u ms animated) in %.2f s, render %.1f fps\n",
+             static_cast<unsigned>(frames), static_cast<unsigned>(frames * EyesAnimation::ANIMATION_DELAY_MS),
+             seconds, renderFps);
+  if (rawBytes > 0) {
+    out.printf("[batch] exported %u bytes (%u raw, %.1f%%)\n",
+               static_cast<unsigned>(exportedBytes), static_cast<unsigned>(rawBytes),
+               exportedBytes * 100.0F / rawBytes);
+  }
+}
+
+/**
+ * @brief Render the timeline with one to MAX_BENCH_INSTANCES instances side by side
+ * @param out Destination of the report (printed as each count completes)
+ * @param seed Random seed of every instance
+ * @return false if no instance could be set up or the frames of instances differ
+ */
+bool BatchRenderer::printInstanceBenchmark(Print& out, uint32_t seed) {
+  out.printf("[instances] seed %u, %u ms animated per run\n", static_cast<unsigned>(seed),
+             static_cast<unsigned>(durationMs));
+  uint32_t referenceHash = 0;
+  uint32_t singleMicros = 0;
+  bool identical = true;
+  uint8_t completedCount = 0;
+  
+  for (uint8_t count = 1; count <= MAX_BENCH_INSTANCES; count++) {
+    EyesAnimation* instances[MAX_BENCH_INSTANCES] = {};
+    uint8_t created = 0;
+    bool ready = true;
+    virtualMillis = 0;
+    while (ready && created < count) {
+      EyesAnimation* eyes = new (std::nothrow) EyesAnimation(Clock(readVirtualMillis, ::micros));
+      if (eyes == nullptr) {
+        ready = false;
+        break;
+      }
+      instances[created++] = eyes;
+      eyes->setRandomSeed(seed);
+      eyes->setDisplayOutput(false);
+      ready = eyes->setup(InputMode::INJECTED);
+    }
+    if (!ready) {
+      out.printf("[instances]   %u: setup failed (memory)\n", count);
+      for (uint8_t i = 0; i < created; i++) {
+        delete instances[i];
+      }
+      break;
+    }
+    
+    // Each instance keeps its own input cursor and frame hash
+    uint8_t nextEvent[MAX_BENCH_INSTANCES] = {};
+    uint8_t lastTouch[MAX_BENCH_INSTANCES] = {};
+    bool touching[MAX_BENCH_INSTANCES] = {};
+    uint32_t hashes[MAX_BENCH_INSTANCES];
+    for (uint8_t i = 0; i < count; i++) {
+      hashes[i] = 2166136261U;
+    }
+    uint32_t loopMicros = 0;
+    uint32_t frameCount = 0;
+    while (virtualMillis < durationMs) {
+      virtualMillis += EyesAnimation::ANIMATION_DELAY_MS;
+      for (uint8_t i = 0; i < count; i++) {
+        injectInput(*instances[i], virtualMillis, nextEvent[i], lastTouch[i], touching[i]);
+        uint32_t frameStart = micros();
+        instances[i]->loop();
+        loopMicros += micros() - frameStart;
+        hashes[i] = hashSprite(hashSprite(hashes[i], instances[i]->getEyeSpriteView(0)),
+                               instances[i]->getEyeSpriteView(1));
+      }
+      frameCount++;
+    }
+    
+    bool same = true;
+    if (count == 1) {
+      referenceHash = hashes[0];
+      singleMicros = loopMicros;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+      same = same && hashes[i] == referenceHash;
+      delete instances[i];
+    }
+    identical = identical && same;
+    completedCount = count;
+    
+    float perFrame = (frameCount > 0) ? static_cast<float>(loopMicros) / frameCount : 0.0F;
+    out.printf("[instances]   %u: %u frames, %7.1f us per frame, %6.1f us per instance, x%.2f of one, frames %s\n",
+               count, static_cast<unsigned>(frameCount), perFrame, perFrame / count,
+               (singleMicros > 0) ? static_cast<float>(loopMicros) / singleMicros : 0.0F,
+               same ? "match" : "DIFFER");
+  }
+  return completedCount > 0 && identical;
+}
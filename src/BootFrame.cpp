@@ -0,0 +1,67 @@
+// Generated by tools/eyestyle_compiler from tools/eyestyles/default.txt. Do not edit.
+#include "BootFrame.h"
+
+const EyeStyleFormat::Span BootFrame::SPANS[] = {
+  { -75, 0, 1 }, { -74, -10, 21 }, { -73, -14, 29 }, { -72, -17, 35 }, { -71, -19, 39 }, { -70, -22, 45 },
+  { -69, -24, 49 }, { -68, -25, 51 }, { -67, -27, 55 }, { -66, -28, 57 }, { -65, -30, 61 }, { -64, -31, 63 },
+  { -63, -33, 67 }, { -62, -34, 69 }, { -61, -35, 71 }, { -60, -36, 73 }, { -59, -37, 75 }, { -58, -38, 77 },
+  { -57, -39, 79 }, { -56, -40, 81 }, { -55, -41, 83 }, { -54, -42, 85 }, { -53, -42, 85 }, { -52, -43, 87 },
+  { -51, -44, 89 }, { -50, -45, 91 }, { -49, -45, 91 }, { -48, -46, 93 }, { -47, -47, 95 }, { -46, -47, 95 },
+  { -45, -48, 97 }, { -44, -49, 99 }, { -43, -49, 99 }, { -42, -50, 101 }, { -41, -50, 101 }, { -40, -51, 103 },
+  { -39, -51, 103 }, { -38, -52, 105 }, { -37, -52, 105 }, { -36, -53, 107 }, { -35, -53, 107 }, { -34, -53, 107 },
+  { -33, -54, 109 }, { -32, -54, 109 }, { -31, -55, 111 }, { -30, -55, 111 }, { -29, -55, 111 }, { -28, -56, 113 },
+  { -27, -56, 113 }, { -26, -56, 113 }, { -25, -57, 115 }, { -24, -57, 115 }, { -23, -57, 115 }, { -22, -57, 115 },
+  { -21, -58, 117 }, { -20, -58, 117 }, { -19, -58, 117 }, { -18, -58, 117 }, { -17, -58, 117 }, { -16, -59, 119 },
+  { -15, -59, 119 }, { -14, -59, 119 }, { -13, -59, 66 }, { -13, 8, 52 }, { -12, -59, 62 }, { -12, 12, 48 },
+  { -11, -59, 61 }, { -11, 13, 47 }, { -10, -59, 60 }, { -10, 14, 46 }, { -9, -60, 60 }, { -9, 15, 46 },
+  { -8, -60, 59 }, { -8, 16, 45 }, { -7, -60, 59 }, { -7, 16, 45 }, { -6, -60, 58 }, { -6, 17, 44 },
+  { -5, -60, 58 }, { -5, 17, 44 }, { -4, -60, 57 }, { -4, 18, 43 }, { -3, -60, 57 }, { -3, 18, 43 },
+  { -2, -60, 57 }, { -2, 18, 43 }, { -1, -60, 57 }, { -1, 18, 43 }, { 0, -60, 57 }, { 0, 18, 43 },
+  { 1, -60, 57 }, { 1, 18, 43 }, { 2, -60, 57 }, { 2, 18, 43 }, { 3, -60, 57 }, { 3, 18, 43 },
+  { 4, -60, 57 }, { 4, 18, 43 }, { 5, -60, 58 }, { 5, 17, 44 }, { 6, -60, 58 }, { 6, 17, 44 },
+  { 7, -60, 59 }, { 7, 16, 45 }, { 8, -60, 59 }, { 8, 16, 45 }, { 9, -60, 60 }, { 9, 15, 46 },
+  { 10, -59, 60 }, { 10, 14, 46 }, { 11, -59, 61 }, { 11, 13, 47 }, { 12, -59, 62 }, { 12, 12, 48 },
+  { 13, -59, 66 }, { 13, 8, 52 }, { 14, -59, 119 }, { 15, -59, 119 }, { 16, -59, 119 }, { 17, -58, 117 },
+  { 18, -58, 117 }, { 19, -58, 117 }, { 20, -58, 117 }, { 21, -58, 117 }, { 22, -57, 115 }, { 23, -57, 115 },
+  { 24, -57, 115 }, { 25, -57, 115 }, { 26, -56, 113 }, { 27, -56, 113 }, { 28, -56, 113 }, { 29, -55, 111 },
+  { 30, -55, 111 }, { 31, -55, 111 }, { 32, -54, 109 }, { 33, -54, 109 }, { 34, -53, 107 }, { 35, -53, 107 },
+  { 36, -53, 107 }, { 37, -52, 105 }, { 38, -52, 105 }, { 39, -51, 103 }, { 40, -51, 103 }, { 41, -50, 101 },
+  { 42, -50, 101 }, { 43, -49, 99 }, { 44, -49, 99 }, { 45, -48, 97 }, { 46, -47, 95 }, { 47, -47, 95 },
+  { 48, -46, 93 }, { 49, -45, 91 }, { 50, -45, 91 }, { 51, -44, 89 }, { 52, -43, 87 }, { 53, -42, 85 },
+  { 54, -42, 85 }, { 55, -41, 83 }, { 56, -40, 81 }, { 57, -39, 79 }, { 58, -38, 77 }, { 59, -37, 75 },
+  { 60, -36, 73 }, { 61, -35, 71 }, { 62, -34, 69 }, { 63, -33, 67 }, { 64, -31, 63 }, { 65, -30, 61 },
+  { 66, -28, 57 }, { 67, -27, 55 }, { 68, -25, 51 }, { 69, -24, 49 }, { 70, -22, 45 }, { 71, -19, 39 },
+  { 72, -17, 35 }, { 73, -14, 29 }, { 74, -10, 21 }, { 75, 0, 1 }, { -75, 0, 1 }, { -74, -10, 21 },
+  { -73, -14, 29 }, { -72, -17, 35 }, { -71, -19, 39 }, { -70, -22, 45 }, { -69, -24, 49 }, { -68, -25, 51 },
+  { -67, -27, 55 }, { -66, -28, 57 }, { -65, -30, 61 }, { -64, -31, 63 }, { -63, -33, 67 }, { -62, -34, 69 },
+  { -61, -35, 71 }, { -60, -36, 73 }, { -59, -37, 75 }, { -58, -38, 77 }, { -57, -39, 79 }, { -56, -40, 81 },
+  { -55, -41, 83 }, { -54, -42, 85 }, { -53, -42, 85 }, { -52, -43, 87 }, { -51, -44, 89 }, { -50, -45, 91 },
+  { -49, -45, 91 }, { -48, -46, 93 }, { -47, -47, 95 }, { -46, -47, 95 }, { -45, -48, 97 }, { -44, -49, 99 },
+  { -43, -49, 99 }, { -42, -50, 101 }, { -41, -50, 101 }, { -40, -51, 103 }, { -39, -51, 103 }, { -38, -52, 105 },
+  { -37, -52, 105 }, { -36, -53, 107 }, { -35, -53, 107 }, { -34, -53, 107 }, { -33, -54, 109 }, { -32, -54, 109 },
+  { -31, -55, 111 }, { -30, -55, 111 }, { -29, -55, 111 }, { -28, -56, 113 }, { -27, -56, 113 }, { -26, -56, 113 },
+  { -25, -57, 115 }, { -24, -57, 115 }, { -23, -57, 115 }, { -22, -57, 115 }, { -21, -58, 117 }, { -20, -58, 117 },
+  { -19, -58, 117 }, { -18, -58, 117 }, { -17, -58, 117 }, { -16, -59, 119 }, { -15, -59, 119 }, { -14, -59, 119 },
+  { -13, -59, 52 }, { -13, -6, 66 }, { -12, -59, 48 }, { -12, -2, 62 }, { -11, -59, 47 }, { -11, -1, 61 },
+  { -10, -59, 46 }, { -10, 0, 60 }, { -9, -60, 46 }, { -9, 1, 60 }, { -8, -60, 45 }, { -8, 2, 59 },
+  { -7, -60, 45 }, { -7, 2, 59 }, { -6, -60, 44 }, { -6, 3, 58 }, { -5, -60, 44 }, { -5, 3, 58 },
+  { -4, -60, 43 }, { -4, 4, 57 }, { -3, -60, 43 }, { -3, 4, 57 }, { -2, -60, 43 }, { -2, 4, 57 },
+  { -1, -60, 43 }, { -1, 4, 57 }, { 0, -60, 43 }, { 0, 4, 57 }, { 1, -60, 43 }, { 1, 4, 57 },
+  { 2, -60, 43 }, { 2, 4, 57 }, { 3, -60, 43 }, { 3, 4, 57 }, { 4, -60, 43 }, { 4, 4, 57 },
+  { 5, -60, 44 }, { 5, 3, 58 }, { 6, -60, 44 }, { 6, 3, 58 }, { 7, -60, 45 }, { 7, 2, 59 },
+  { 8, -60, 45 }, { 8, 2, 59 }, { 9, -60, 46 }, { 9, 1, 60 }, { 10, -59, 46 }, { 10, 0, 60 },
+  { 11, -59, 47 }, { 11, -1, 61 }, { 12, -59, 48 }, { 12, -2, 62 }, { 13, -59, 52 }, { 13, -6, 66 },
+  { 14, -59, 119 }, { 15, -59, 119 }, { 16, -59, 119 }, { 17, -58, 117 }, { 18, -58, 117 }, { 19, -58, 117 },
+  { 20, -58, 117 }, { 21, -58, 117 }, { 22, -57, 115 }, { 23, -57, 115 }, { 24, -57, 115 }, { 25, -57, 115 },
+  { 26, -56, 113 }, { 27, -56, 113 }, { 28, -56, 113 }, { 29, -55, 111 }, { 30, -55, 111 }, { 31, -55, 111 },
+  { 32, -54, 109 }, { 33, -54, 109 }, { 34, -53, 107 }, { 35, -53, 107 }, { 36, -53, 107 }, { 37, -52, 105 },
+  { 38, -52, 105 }, { 39, -51, 103 }, { 40, -51, 103 }, { 41, -50, 101 }, { 42, -50, 101 }, { 43, -49, 99 },
+  { 44, -49, 99 }, { 45, -48, 97 }, { 46, -47, 95 }, { 47, -47, 95 }, { 48, -46, 93 }, { 49, -45, 91 },
+  { 50, -45, 91 }, { 51, -44, 89 }, { 52, -43, 87 }, { 53, -42, 85 }, { 54, -42, 85 }, { 55, -41, 83 },
+  { 56, -40, 81 }, { 57, -39, 79 }, { 58, -38, 77 }, { 59, -37, 75 }, { 60, -36, 73 }, { 61, -35, 71 },
+  { 62, -34, 69 }, { 63, -33, 67 }, { 64, -31, 63 }, { 65, -30, 61 }, { 66, -28, 57 }, { 67, -27, 55 },
+  { 68, -25, 51 }, { 69, -24, 49 }, { 70, -22, 45 }, { 71, -19, 39 }, { 72, -17, 35 }, { 73, -14, 29 },
+  { 74, -10, 21 }, { 75, 0, 1 },
+};
+
+const uint16_t BootFrame::SPAN_COUNTS[2] = { 178, 178 };
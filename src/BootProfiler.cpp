@@ -0,0 +1,38 @@
+#include "BootProfiler.h"
+
+namespace {
+  /**
+   * @brief Recorded phase
+   */
+  struct Phase {
+    const char* name;
+    uint32_t timeMicros;  // Time since application start
+  };
+  
+  // Plain arrays so that marks work from global constructors
+  Phase phases[BootProfiler::MAX_PHASES];
+  uint8_t phaseCount;
+}
+
+/**
+ * @brief Record the end of a startup phase
+ * @param phase Phase name (static string, shown in the report)
+ */
+void BootProfiler::mark(const char* phase) {
+  if (phaseCount < MAX_PHASES) {
+    phases[phaseCount++] = { phase, static_cast<uint32_t>(micros()) };
+  }
+}
+
+/**
+ * @brief Print phase timestamps and durations
+ * @param out Output stream
+ */
+void BootProfiler::printReport(Print& out) {
+  uint32_t previous = 0;
+  for (uint8_t i = 0; i < phaseCount; i++) {
+    out.printf("[boot] %-20s at %8.1f ms  (+%.1f ms)\n", phases[i].name,
+               phases[i].timeMicros / 1000.0F, (phases[i].timeMicros - previous) / 1000.0F);
+    previous = phases[i].timeMicros;
+  }
+}
@@ -0,0 +1,77 @@
+#include "CpuGovernor.h"
+
+/**
+ * @brief Constructor
+ */
+CpuGovernor::CpuGovernor()
+  : policy(nullptr),
+    context(nullptr),
+    frequencyMhz(0),
+    switches(0)
+{
+}
+
+/**
+ * @brief Start governing with a policy
+ * @param policy Decision function
+ * @param context Passed to the policy (must outlive the governor)
+ * @return false if no policy was given
+ */
+bool CpuGovernor::begin(FrequencyPolicy policy, void* context) {
+  if (policy == nullptr) {
+    return false;
+  }
+  
+  this->policy = policy;
+  this->context = context;
+  frequencyMhz = static_cast<uint16_t>(getCpuFrequencyMhz());
+  return true;
+}
+
+/**
+ * @brief Report a finished frame and apply the policy's decision
+ * @param load Load implied by the current state
+ * @param workMicros Frame work time
+ * @param budgetMicros Frame budget
+ */
+void CpuGovernor::update(AnimationLoad load, uint32_t workMicros, uint32_t budgetMicros) {
+  if (policy == nullptr) {
+    return;
+  }
+  
+  uint16_t targetMhz = policy(context, { load, workMicros, budgetMicros, frequencyMhz });
+  if (targetMhz == frequencyMhz) {
+    return;
+  }
+  
+  // Keep the current clock if the frequency is not supported
+  if (!setCpuFrequencyMhz(targetMhz)) {
+    return;
+  }
+  frequencyMhz = targetMhz;
+  switches++;
+}
+
+/**
+ * @brief Check whether the governor is running
+ * @return true if begin() succeeded
+ */
+bool CpuGovernor::isRunning() const {
+  return policy != nullptr;
+}
+
+/**
+ * @brief Get current CPU frequency
+ * @return Frequency in MHz
+ */
+uint16_t CpuGovernor::getFrequencyMhz() const {
+  return isRunning() ? frequencyMhz : static_cast<uint16_t>(getCpuFrequencyMhz());
+}
+
+/**
+ * @brief Get number of frequency switches
+ * @return Switch count
+ */
+uint32_t CpuGovernor::getSwitches() const {
+  return switches;
+}
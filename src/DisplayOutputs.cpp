@@ -0,0 +1,119 @@
+#include "DisplayOutputs.h"
+
+namespace {
+  // Pending band of a sink that has not received an eye yet (clamped to the sprite when presented)
+  const DirtyRows WHOLE_SPRITE(0, UINT16_MAX);
+}
+
+/**
+ * @brief Constructor
+ */
+DisplayOutputs::DisplayOutputs()
+  : entries(),
+    count(0)
+{
+}
+
+/**
+ * @brief Register a sink
+ * @param name Name shown in the report (must outlive the outputs)
+ * @param sink Sink function
+ * @param context Passed to the sink (must outlive the outputs)
+ * @param eyeMask Eyes the sink shows (bit 0: left, bit 1: right)
+ * @return false if the sink table is full or no sink was given
+ */
+bool DisplayOutputs::add(const char* name, DisplaySink sink, void* context, uint8_t eyeMask) {
+  if (sink == nullptr || count >= MAX_SINKS) {
+    return false;
+  }
+  
+  Entry& entry = entries[count++];
+  entry = Entry();
+  entry.name = name;
+  entry.sink = sink;
+  entry.context = context;
+  entry.eyeMask = eyeMask;
+  for (uint8_t i = 0; i < MAX_EYES; i++) {
+    entry.pending[i] = WHOLE_SPRITE;
+  }
+  return true;
+}
+
+/**
+ * @brief Record rows drawn into an eye sprite
+ * @param eyeIndex Eye index
+ * @param rows Rows drawn
+ */
+void DisplayOutputs::markDirty(uint8_t eyeIndex, const DirtyRows& rows) {
+  if (eyeIndex >= MAX_EYES) {
+    return;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    entries[i].pending[eyeIndex].add(rows);
+  }
+}
+
+/**
+ * @brief Mark every eye as completely changed for every sink (e.g. after drawing over the panel)
+ */
+void DisplayOutputs::invalidate() {
+  for (uint8_t i = 0; i < MAX_EYES; i++) {
+    markDirty(i, WHOLE_SPRITE);
+  }
+}
+
+/**
+ * @brief Offer an eye's pending rows to every sink that shows it
+ * @param eyeIndex Eye index
+ * @param eye Eye to send
+ * @param nowMs Current time
+ */
+void DisplayOutputs::present(uint8_t eyeIndex, Eye& eye, uint32_t nowMs) {
+  if (eyeIndex >= MAX_EYES) {
+    return;
+  }
+  
+  SpriteView view = eye.getSpriteView();
+  uint32_t rowBytes = (static_cast<uint32_t>(view.width) * view.colorDepth + 7) / 8;
+  for (uint8_t i = 0; i < count; i++) {
+    Entry& entry = entries[i];
+    DirtyRows& pending = entry.pending[eyeIndex];
+    if ((entry.eyeMask & (1 << eyeIndex)) == 0 || pending.isEmpty()) {
+      continue;
+    }
+  
+    DirtyRows rows(pending.top, (pending.bottom < view.height) ? pending.bottom : view.height);
+    if (!entry.sink(entry.context, eyeIndex, eye, rows, nowMs)) {
+      entry.skipped++;
+      continue;
+    }
+    entry.frames++;
+    entry.bytes += rows.isEmpty() ? 0 : (rows.bottom - rows.top) * rowBytes;
+    pending = DirtyRows();
+  }
+}
+
+/**
+ * @brief Get number of registered sinks
+ * @return Sink count
+ */
+uint8_t DisplayOutputs::getCount() const {
+  return count;
+}
+
+/**
+ * @brief Print frames, skips and sprite bytes sent per sink
+ * @param out Output (e.g. Serial)
+ */
+void DisplayOutputs::printReport(Print& out) const {
+  uint32_t totalBytes = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const Entry& entry = entries[i];
+    out.printf("[sinks] %-16s eyes %c%c  frames %8u  skipped %6u  bytes %10u\n", entry.name,
+               (entry.eyeMask & 1) ? 'L' : '-', (entry.eyeMask & 2) ? 'R' : '-',
+               static_cast<unsigned>(entry.frames), static_cast<unsigned>(entry.skipped),
+               static_cast<unsigned>(entry.bytes));
+    totalBytes += entry.bytes;
+  }
+  out.printf("[sinks] %u sinks, %u bytes in total\n", count, static_cast<unsigned>(totalBytes));
+}
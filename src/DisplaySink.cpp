@@ -0,0 +1,126 @@
+#include "DisplaySink.h"
+
+/**
+ * @brief Constructor for a panel showing each eye at its sprite position
+ * @param display Panel (must outlive the sink)
+ */
+PanelSink::PanelSink(lgfx::LovyanGFX* display)
+  : display(display),
+    origin(),
+    fixedOrigin(false)
+{
+}
+
+/**
+ * @brief Constructor for a panel showing an eye at a fixed position
+ * @param display Panel (must outlive the sink)
+ * @param x X coordinate of the sprite on the panel
+ * @param y Y coordinate of the sprite on the panel
+ */
+PanelSink::PanelSink(lgfx::LovyanGFX* display, int16_t x, int16_t y)
+  : display(display),
+    origin(x, y),
+    fixedOrigin(true)
+{
+}
+
+/**
+ * @brief DisplaySink entry point
+ * @param context PanelSink instance
+ * @param eyeIndex Eye index
+ * @param eye Eye to push
+ * @param rows Rows to push
+ * @param nowMs Current time
+ * @return Always true
+ */
+bool PanelSink::write(void* context, uint8_t eyeIndex, Eye& eye, const DirtyRows& rows, uint32_t nowMs) {
+  PanelSink* self = static_cast<PanelSink*>(context);
+  if (self->fixedOrigin) {
+    eye.render(self->display, self->origin.x, self->origin.y, rows);
+  } else {
+    SpriteView view = eye.getSpriteView();
+    eye.render(self->display, view.x, view.y, rows);
+  }
+  return true;
+}
+
+/**
+ * @brief Constructor
+ */
+MemorySink::MemorySink()
+  : frames(),
+    copiedBytes(0)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+MemorySink::~MemorySink() {
+  for (uint8_t i = 0; i < MAX_EYES; i++) {
+    MemoryBudget::release(frames[i]);
+  }
+}
+
+/**
+ * @brief Allocate one frame buffer per eye
+ * @param placement Where to put the buffers
+ * @return Whether buffers were allocated
+ */
+bool MemorySink::begin(MemoryPlacement placement) {
+  for (uint8_t i = 0; i < MAX_EYES; i++) {
+    if (frames[i] == nullptr) {
+      frames[i] = static_cast<uint8_t*>(MemoryBudget::allocate(Eye::SPRITE_BYTES, placement, "memory sink"));
+    }
+    if (frames[i] == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief DisplaySink entry point
+ * @param context MemorySink instance
+ * @param eyeIndex Eye index
+ * @param eye Eye to copy
+ * @param rows Rows to copy
+ * @param nowMs Current time
+ * @return false if begin() has not succeeded
+ */
+bool MemorySink::write(void* context, uint8_t eyeIndex, Eye& eye, const DirtyRows& rows, uint32_t nowMs) {
+  MemorySink* self = static_cast<MemorySink*>(context);
+  SpriteView view = eye.getSpriteView();
+  if (eyeIndex >= MAX_EYES || self->frames[eyeIndex] == nullptr || view.buffer == nullptr) {
+    return false;
+  }
+  
+  // Rows are padded to whole bytes, so a band of rows is one contiguous range
+  uint32_t rowBytes = (static_cast<uint32_t>(view.width) * view.colorDepth + 7) / 8;
+  uint32_t bottom = (rows.bottom < view.height) ? rows.bottom : view.height;
+  if (bottom <= rows.top) {
+    return true;
+  }
+  uint32_t offset = rows.top * rowBytes;
+  uint32_t length = (bottom - rows.top) * rowBytes;
+  memcpy(self->frames[eyeIndex] + offset, view.buffer + offset, length);
+  self->copiedBytes += length;
+  return true;
+}
+
+/**
+ * @brief Get the latest frame of an eye
+ * @param eyeIndex Eye index
+ * @return Frame buffer in the sprite's layout (nullptr before begin())
+ */
+const uint8_t* MemorySink::getFrame(uint8_t eyeIndex) const {
+  return (eyeIndex < MAX_EYES) ? frames[eyeIndex] : nullptr;
+}
+
+/**
+ * @brief Get number of bytes copied
+ * @return Copied byte count
+ */
+uint32_t MemorySink::getCopiedBytes() const {
+  return copiedBytes;
+}
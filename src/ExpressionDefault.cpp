@@ -0,0 +1,43 @@
+// Generated by tools/expression_compiler from tools/expressions/default.txt. Do not edit.
+#include "ExpressionTimeline.h"
+
+alignas(4) const uint8_t ExpressionData::DEFAULT_EXPRESSIONS[] = {
+  0x45, 0x58, 0x50, 0x52, 0x01, 0x00, 0x18, 0x00, 0x40, 0x02, 0x00, 0x00, 0x37, 0x1F, 0x38, 0x84,
+  0x04, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x73, 0x6C, 0x65, 0x65, 0x70, 0x79, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xA0, 0x0F, 0x03, 0x00, 0x68, 0x00, 0x00, 0x00, 0x73, 0x75, 0x72, 0x70,
+  0x72, 0x69, 0x73, 0x65, 0x64, 0x00, 0x00, 0x00, 0x40, 0x06, 0x04, 0x00, 0xDC, 0x00, 0x00, 0x00,
+  0x61, 0x6E, 0x67, 0x72, 0x79, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0x0A, 0x04, 0x00,
+  0x54, 0x01, 0x00, 0x00, 0x73, 0x71, 0x75, 0x69, 0x6E, 0x74, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x60, 0x09, 0x03, 0x00, 0xE0, 0x01, 0x00, 0x00, 0x02, 0x00, 0x07, 0x00, 0x80, 0x00, 0x00, 0x00,
+  0x03, 0x00, 0x04, 0x00, 0xAC, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0xC4, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x20, 0x03, 0x37, 0x00, 0x04, 0x00, 0xD0, 0x07, 0x3C, 0x00,
+  0x01, 0x00, 0x60, 0x09, 0x5A, 0x00, 0x02, 0x00, 0xF0, 0x0A, 0x32, 0x00, 0x03, 0x00, 0x48, 0x0D,
+  0x37, 0x00, 0x04, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x20, 0x03, 0x0C, 0x00, 0x04, 0x00, 0x48, 0x0D, 0x0C, 0x00, 0x01, 0x00, 0xA0, 0x0F,
+  0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x20, 0x03, 0x23, 0x00, 0x04, 0x00,
+  0x48, 0x0D, 0x23, 0x00, 0x01, 0x00, 0xA0, 0x0F, 0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x03, 0x00,
+  0xFC, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x10, 0x01, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00,
+  0x24, 0x01, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x3C, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x50, 0x00, 0x64, 0x00, 0x02, 0x00, 0xA0, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x50, 0x00, 0x64, 0x00, 0x02, 0x00, 0xA0, 0x00, 0x00, 0x00,
+  0x03, 0x00, 0x00, 0x00, 0xA0, 0x00, 0x64, 0x00, 0x01, 0x00, 0x04, 0x01, 0x3C, 0x00, 0x03, 0x00,
+  0xB0, 0x04, 0x3C, 0x00, 0x01, 0x00, 0x40, 0x06, 0x64, 0x00, 0x04, 0x00, 0xA0, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x04, 0x01, 0xE7, 0xFF, 0x03, 0x00, 0xB0, 0x04, 0xE7, 0xFF, 0x01, 0x00, 0x40, 0x06,
+  0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x04, 0x00, 0x74, 0x01, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00,
+  0x8C, 0x01, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0xA4, 0x01, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00,
+  0xBC, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x2C, 0x01, 0x2D, 0x00, 0x03, 0x00,
+  0x98, 0x08, 0x2D, 0x00, 0x01, 0x00, 0x28, 0x0A, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x2C, 0x01, 0x19, 0x00, 0x03, 0x00, 0x98, 0x08, 0x19, 0x00, 0x01, 0x00, 0x28, 0x0A,
+  0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x01, 0x00, 0x2C, 0x01, 0x50, 0x00, 0x03, 0x00,
+  0x98, 0x08, 0x50, 0x00, 0x01, 0x00, 0x28, 0x0A, 0x64, 0x00, 0x04, 0x00, 0x2C, 0x01, 0x00, 0x00,
+  0x01, 0x00, 0xBC, 0x02, 0xBA, 0xFF, 0x03, 0x00, 0xE8, 0x03, 0xBA, 0xFF, 0x00, 0x00, 0x78, 0x05,
+  0x46, 0x00, 0x04, 0x00, 0x08, 0x07, 0x46, 0x00, 0x00, 0x00, 0x98, 0x08, 0x00, 0x00, 0x04, 0x00,
+  0x02, 0x00, 0x04, 0x00, 0xF8, 0x01, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x10, 0x02, 0x00, 0x00,
+  0x04, 0x00, 0x04, 0x00, 0x28, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xFA, 0x00,
+  0x28, 0x00, 0x03, 0x00, 0xD0, 0x07, 0x28, 0x00, 0x01, 0x00, 0x60, 0x09, 0x00, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xFA, 0x00, 0x1E, 0x00, 0x03, 0x00, 0xD0, 0x07, 0x1E, 0x00,
+  0x01, 0x00, 0x60, 0x09, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x01, 0x00, 0xFA, 0x00,
+  0x55, 0x00, 0x03, 0x00, 0xD0, 0x07, 0x55, 0x00, 0x01, 0x00, 0x60, 0x09, 0x64, 0x00, 0x04, 0x00,
+};
+
+const uint32_t ExpressionData::DEFAULT_EXPRESSIONS_SIZE = sizeof(ExpressionData::DEFAULT_EXPRESSIONS);
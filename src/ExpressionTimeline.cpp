@@ -0,0 +1,303 @@
+#include "ExpressionTimeline.h"
+#include "EyeStyleFormat.h"
+#include <string.h>
+
+// Fixed-point scale of the progress between two keys
+static constexpr int32_t PROGRESS_ONE = 256;
+
+/**
+ * @brief Constructor (starts with the built-in library)
+ */
+ExpressionLibrary::ExpressionLibrary()
+  : data(ExpressionData::DEFAULT_EXPRESSIONS),
+    size(ExpressionData::DEFAULT_EXPRESSIONS_SIZE),
+    header(reinterpret_cast<const ExpressionFormat::Header*>(ExpressionData::DEFAULT_EXPRESSIONS)) {
+}
+
+/**
+ * @brief Use a library that stays valid for the lifetime of this object
+ * @param data Library bytes (must be 4-byte aligned)
+ * @param size Number of bytes available
+ * @return false if the library is malformed (the previous one stays in use)
+ */
+bool ExpressionLibrary::load(const uint8_t* data, uint32_t size) {
+  if (!validate(data, size)) {
+    return false;
+  }
+  
+  this->data = data;
+  this->header = reinterpret_cast<const ExpressionFormat::Header*>(data);
+  this->size = header->totalSize;
+  return true;
+}
+
+/**
+ * @brief Check whether the built-in library is in use
+ * @return true if no other library has been loaded
+ */
+bool ExpressionLibrary::isBuiltIn() const {
+  return data == ExpressionData::DEFAULT_EXPRESSIONS;
+}
+
+/**
+ * @brief Get size of the library in use
+ * @return Size in bytes
+ */
+uint32_t ExpressionLibrary::getSize() const {
+  return size;
+}
+
+/**
+ * @brief Get number of expressions
+ * @return Expression count
+ */
+uint8_t ExpressionLibrary::getCount() const {
+  return header->expressionCount;
+}
+
+/**
+ * @brief Get an expression
+ * @param index Expression index (less than getCount())
+ * @return Expression
+ */
+const ExpressionFormat::Expression& ExpressionLibrary::getExpression(uint8_t index) const {
+  const ExpressionFormat::Expression* expressions =
+    reinterpret_cast<const ExpressionFormat::Expression*>(data + header->expressionOffset);
+  return expressions[index];
+}
+
+/**
+ * @brief Get the tracks of an expression
+ * @param expression Expression
+ * @return First of expression.trackCount tracks
+ */
+const ExpressionFormat::Track* ExpressionLibrary::getTracks(const ExpressionFormat::Expression& expression) const {
+  return reinterpret_cast<const ExpressionFormat::Track*>(data + expression.trackOffset);
+}
+
+/**
+ * @brief Get the keys of a track
+ * @param track Track
+ * @return First of track.keyCount keys
+ */
+const ExpressionFormat::Key* ExpressionLibrary::getKeys(const ExpressionFormat::Track& track) const {
+  return reinterpret_cast<const ExpressionFormat::Key*>(data + track.keyOffset);
+}
+
+/**
+ * @brief Find an expression by name
+ * @param name Expression name
+ * @return Expression index, or -1 if there is none
+ */
+int16_t ExpressionLibrary::find(const char* name) const {
+  for (uint8_t i = 0; i < header->expressionCount; i++) {
+    if (strncmp(getExpression(i).name, name, ExpressionFormat::NAME_LENGTH) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Check that a library is well formed
+ * @param data Library bytes
+ * @param size Number of bytes available
+ * @return true if every table lies inside the library, keys are in order and the checksum matches
+ */
+bool ExpressionLibrary::validate(const uint8_t* data, uint32_t size) {
+  using namespace ExpressionFormat;
+  
+  if (data == nullptr || (reinterpret_cast<uintptr_t>(data) & 3) != 0 || size < sizeof(Header)) {
+    return false;
+  }
+  
+  const Header* header = reinterpret_cast<const Header*>(data);
+  if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->version != VERSION ||
+      header->headerSize != sizeof(Header) ||
+      header->totalSize < sizeof(Header) ||
+      header->totalSize > size) {
+    return false;
+  }
+  
+  // Tables must be aligned and lie inside the library (64-bit sums cannot overflow)
+  uint64_t totalSize = header->totalSize;
+  if ((header->expressionOffset & 3) != 0 || header->expressionOffset < sizeof(Header) ||
+      header->expressionOffset + static_cast<uint64_t>(header->expressionCount) * sizeof(Expression) > totalSize) {
+    return false;
+  }
+  
+  const Expression* expressions = reinterpret_cast<const Expression*>(data + header->expressionOffset);
+  for (uint8_t i = 0; i < header->expressionCount; i++) {
+    const Expression& expression = expressions[i];
+    if (memchr(expression.name, '\0', NAME_LENGTH) == nullptr ||
+        expression.trackCount > ExpressionPlayer::MAX_TRACKS ||
+        (expression.trackOffset & 3) != 0 || expression.trackOffset < sizeof(Header) ||
+        expression.trackOffset + static_cast<uint64_t>(expression.trackCount) * sizeof(Track) > totalSize) {
+      return false;
+    }
+  
+    const Track* tracks = reinterpret_cast<const Track*>(data + expression.trackOffset);
+    for (uint8_t j = 0; j < expression.trackCount; j++) {
+      const Track& track = tracks[j];
+      if (track.channel >= CHANNEL_COUNT || track.keyCount == 0 ||
+          (track.keyOffset & 1) != 0 || track.keyOffset < sizeof(Header) ||
+          track.keyOffset + static_cast<uint64_t>(track.keyCount) * sizeof(Key) > totalSize) {
+        return false;
+      }
+  
+      // The player only ever moves forward, and draws values straight into the eyes
+      int16_t minValue, maxValue;
+      getRange(track.channel, minValue, maxValue);
+      const Key* keys = reinterpret_cast<const Key*>(data + track.keyOffset);
+      for (uint16_t k = 0; k < track.keyCount; k++) {
+        if (keys[k].easing >= EASE_COUNT || keys[k].value < minValue || keys[k].value > maxValue ||
+            (k > 0 && keys[k].timeMs < keys[k - 1].timeMs)) {
+          return false;
+        }
+      }
+    }
+  }
+  
+  return EyeStyleFormat::checksum(data + sizeof(Header), header->totalSize - sizeof(Header)) == header->checksum;
+}
+
+/**
+ * @brief Constructor (nothing playing, neutral pose)
+ */
+ExpressionPlayer::ExpressionPlayer()
+  : cursors(),
+    activeCount(0),
+    startMs(0),
+    durationMs(0),
+    pose(ExpressionPose::neutral()) {
+}
+
+/**
+ * @brief Start an expression
+ * @param library Library holding the expression (must outlive the playback)
+ * @param index Expression index
+ * @param nowMs Current time (time zero of the keys)
+ * @return false if there is no such expression
+ */
+bool ExpressionPlayer::start(const ExpressionLibrary& library, uint8_t index, uint32_t nowMs) {
+  if (index >= library.getCount()) {
+    return false;
+  }
+  
+  const ExpressionFormat::Expression& expression = library.getExpression(index);
+  const ExpressionFormat::Track* tracks = library.getTracks(expression);
+  activeCount = 0;
+  for (uint8_t i = 0; i < expression.trackCount; i++) {
+    Cursor& cursor = cursors[activeCount++];
+    cursor.keys = library.getKeys(tracks[i]);
+    cursor.keyCount = tracks[i].keyCount;
+    cursor.index = 0;
+    cursor.channel = tracks[i].channel;
+  }
+  
+  // Channels without a track stay neutral
+  pose = ExpressionPose::neutral();
+  startMs = nowMs;
+  durationMs = expression.durationMs;
+  return true;
+}
+
+/**
+ * @brief Stop playing and return to the neutral pose
+ */
+void ExpressionPlayer::stop() {
+  activeCount = 0;
+  durationMs = 0;
+  pose = ExpressionPose::neutral();
+}
+
+/**
+ * @brief Move the pose to the current time
+ * @param nowMs Current time (not before the previous call)
+ * @return true if any channel changed
+ */
+bool ExpressionPlayer::advance(uint32_t nowMs) {
+  uint32_t elapsedMs = nowMs - startMs;
+  bool changed = false;
+  uint8_t i = 0;
+  while (i < activeCount) {
+    Cursor& cursor = cursors[i];
+  
+    // Usually at most one step: frames are much shorter than the gap between keys
+    while (cursor.index + 1 < cursor.keyCount && cursor.keys[cursor.index + 1].timeMs <= elapsedMs) {
+      cursor.index++;
+    }
+  
+    const ExpressionFormat::Key& from = cursor.keys[cursor.index];
+    bool finished = cursor.index + 1 >= cursor.keyCount;
+    int16_t value = from.value;
+    if (!finished && elapsedMs > from.timeMs) {
+      const ExpressionFormat::Key& to = cursor.keys[cursor.index + 1];
+      int32_t progress = static_cast<int32_t>((elapsedMs - from.timeMs) * PROGRESS_ONE / (to.timeMs - from.timeMs));
+      value = from.value + (to.value - from.value) * ease(to.easing, progress) / PROGRESS_ONE;
+    }
+  
+    if (pose.values[cursor.channel] != value) {
+      pose.values[cursor.channel] = value;
+      changed = true;
+    }
+  
+    // The last value is held, so a finished track needs no more work
+    if (finished) {
+      cursor = cursors[--activeCount];
+    } else {
+      i++;
+    }
+  }
+  return changed;
+}
+
+/**
+ * @brief Get the current pose
+ * @return Pose as of the latest advance()
+ */
+const ExpressionPose& ExpressionPlayer::getPose() const {
+  return pose;
+}
+
+/**
+ * @brief Get how long the current expression is held for
+ * @return Duration in milliseconds (0 if nothing was started)
+ */
+uint32_t ExpressionPlayer::getDurationMs() const {
+  return durationMs;
+}
+
+/**
+ * @brief Get number of tracks still moving
+ * @return Active track count (0 once every track is past its last key)
+ */
+uint8_t ExpressionPlayer::getActiveTracks() const {
+  return activeCount;
+}
+
+/**
+ * @brief Apply an easing curve
+ * @param easing ExpressionFormat::Easing
+ * @param progress Progress between two keys (0 .. 256)
+ * @return Eased progress (0 .. 256)
+ */
+int32_t ExpressionPlayer::ease(uint8_t easing, int32_t progress) {
+  switch (easing) {
+    case ExpressionFormat::EASE_STEP:
+      return 0;
+    case ExpressionFormat::EASE_IN:
+      return progress * progress / PROGRESS_ONE;
+    case ExpressionFormat::EASE_OUT: {
+      int32_t remaining = PROGRESS_ONE - progress;
+      return PROGRESS_ONE - remaining * remaining / PROGRESS_ONE;
+    }
+    case ExpressionFormat::EASE_IN_OUT:
+      // Smoothstep: 3p² - 2p³
+      return progress * progress * (3 * PROGRESS_ONE - 2 * progress) / (PROGRESS_ONE * PROGRESS_ONE);
+    case ExpressionFormat::EASE_LINEAR:
+    default:
+      return progress;
+  }
+}
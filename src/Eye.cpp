@@ -1,44 +1,93 @@
 #include "Eye.h"
+#include "BootFrame.h"
 #include "EyesAnimation.h"
 #include "MathLookup.h"
+#include "MemoryBudget.h"
 
 /**
  * @brief Constructor
- * @param baseX Center X coordinate of the eye
- * @param baseY Center Y coordinate of the eye
- * @param displayX X coordinate on the display
- * @param displayY Y coordinate on the display
- * @param pupilOffsetX X offset for pupil drawing (default: 0)
- * @param pupilOffsetY Y offset for pupil drawing (default: 0)
- */
-Eye::Eye(int16_t baseX, int16_t baseY, int16_t displayX, int16_t displayY,
-         int16_t pupilOffsetX, int16_t pupilOffsetY) 
-  : basePoint(baseX, baseY),
-    displayOffset(displayX, displayY),
-    pupilPosition(baseX, baseY),
-    pupilDrawOffset(pupilOffsetX, pupilOffsetY),
-    lastBlinkState(BlinkState::OPEN)
+ * @param layout Screen layout (must outlive the eye)
+ * @param style Eye style (must outlive the eye)
+ * @param side Which eye this is in the style and the layout (0: left, 1: right)
+ */
+Eye::Eye(const ScreenLayout& layout, const EyeStyle& style, uint8_t side) 
+  : layout(layout),
+    basePoint(layout.getEyeCenter(side)),
+    spriteOrigin(basePoint - Point(SCLERA_RADIUS_X, SCLERA_RADIUS_Y)),
+    displayOffset(),
+    pupilPosition(basePoint),
+    style(style),
+    side(side),
+    pupilMarginPercent(style.getHeader().pupilMarginPercent),
+    pupilScalePercent(100),
+    lidTopPercent(0),
+    lidBottomPercent(0),
+    lastBlinkState(BlinkState::OPEN),
+    ready(false)
 {
-  // Create sprite with 1-bit color depth
-  canvas.setPsram(false);
-  canvas.setColorDepth(1);
-  canvas.createSprite(SPRITE_WIDTH, SPRITE_HEIGHT);
+  // The pre-rotated sprite starts at whichever corner of the box lands top-left on the panel
+  Point first = layout.toPanel(spriteOrigin);
+  Point last = layout.toPanel(spriteOrigin + Point(SPRITE_WIDTH - 1, SPRITE_HEIGHT - 1));
+  displayOffset = Point((first.x < last.x) ? first.x : last.x, (first.y < last.y) ? first.y : last.y);
+  motion.reset(basePoint.x, basePoint.y);
+  
+  // Create sprite in internal RAM since it is redrawn and pushed every frame
+  ready = MemoryBudget::createSprite(canvas, abs(last.x - first.x) + 1, abs(last.y - first.y) + 1,
+                                     SPRITE_COLOR_DEPTH, MemoryPlacement::INTERNAL, "eye sprite");
+  if (!ready) {
+    return;
+  }
+  
+  if (COLOR_MODE == ColorMode::PALETTE) {
+    canvas.createPalette();
+    for (uint8_t i = 0; i < EyePalette::COUNT; i++) {
+      canvas.setPaletteColor(i, EyePalette::COLORS[i]);
+    }
+  }
   clear();
 }
 
+/**
+ * @brief Destructor
+ */
+Eye::~Eye() {
+  if (ready) {
+    MemoryBudget::deleteSprite(canvas);
+  }
+}
+
+/**
+ * @brief Check whether the sprite buffer was allocated
+ * @return true if the eye can be drawn
+ */
+bool Eye::isReady() const {
+  return ready;
+}
+
+/**
+ * @brief Get center coordinates of the eye
+ * @return Center coordinates
+ */
+const Point& Eye::getBasePoint() const {
+  return basePoint;
+}
+
 /**
  * @brief Clear the eye
  */
 void Eye::clear() {
-  canvas.fillScreen(TFT_BLACK);
+  canvas.fillScreen(color(EyePalette::BACKGROUND));
+  dirtyRows = DirtyRows(0, canvas.height());
 }
 
 /**
  * @brief Draw the white part of the eye
  */
 void Eye::drawWhite() {
-  Point localCenter = toLocalCoordinates(basePoint);
-  canvas.fillEllipse(localCenter.x, localCenter.y, EYE_RADIUS_X, EYE_RADIUS_Y, TFT_WHITE);
+  drawLayers(EyeStyleFormat::TARGET_SCLERA, toLocalCoordinates(basePoint), false);
+  // The white covers any expression lids
+  lidTopPercent = 0;
+  lidBottomPercent = 0;
 }
 
 /**
@@ -47,14 +96,17 @@ void Eye::drawWhite() {
 void Eye::resetPupil() {
   erasePupil();
   pupilPosition = basePoint;
+  pupilScalePercent = 100;
+  motion.reset(basePoint.x, basePoint.y);
   drawPupil();
 }
 
 /**
- * @brief Draw pupil in the center (with small random movements)
+ * @brief Move pupil towards the center (with small random movements)
  * @param saccades Amount of small movements
+ * @param steps PupilMotion steps elapsed since the previous move
  */
-void Eye::drawCenterPupil(const Point& saccades) {
+void Eye::drawCenterPupil(const Point& saccades, uint8_t steps) {
   Point diff = saccades;
   float dist = FastMath::fastHypot(diff.x, diff.y);
   
@@ -76,17 +128,17 @@ void Eye::drawCenterPupil(const Point& saccades) {
     result = basePoint;
   }
   
-  updatePupil(result);
+  moveTowards(result, steps);
 }
 
 /**
- * @brief Draw gaze-following pupil
+ * @brief Move gaze-following pupil towards its target
  * @param targetPoint Target point of the gaze
  * @param saccades Amount of small movements
+ * @param steps PupilMotion steps elapsed since the previous move
  */
-void Eye::drawGazingPupil(const Point& targetPoint, const Point& saccades) {
-  Point newPosition = computeGazingPosition(targetPoint, saccades);
-  updatePupil(newPosition);
+void Eye::drawGazingPupil(const Point& targetPoint, const Point& saccades, uint8_t steps) {
+  moveTowards(computeGazingPosition(targetPoint, saccades), steps);
 }
 
 /**
@@ -106,7 +158,9 @@ void Eye::drawDizzyPupil(float degree, float offsetDegree) {
     static_cast<int16_t>(maxDist * distanceFactor * FastMath::fastSin(angleDegrees)) + basePoint.y
   );
   
+  // The spin is drawn as computed; pursuit picks up from wherever it stops
   updatePupil(newPosition);
+  motion.reset(newPosition.x, newPosition.y);
 }
 
 /**
@@ -119,79 +173,428 @@ void Eye::drawBlink(BlinkState state) {
     return;
   }
   
-  // Display base Y coordinate in local coordinate system
-  int16_t localBaseY = DISPLAY_BASE_Y - displayOffset.y;
-  
-  switch (state) {
-    case BlinkState::HALF_CLOSED:
-      // Half-closed state - draw black rectangles at top and bottom
-      canvas.fillRect(
-        0, 
-        localBaseY, 
-        SPRITE_WIDTH, 
-        EyesAnimation::BLINK_HALF_CLOSED_TOP_HEIGHT, 
-        TFT_BLACK
-      );
-      canvas.fillRect(
-        0, 
-        EyesAnimation::BLINK_HALF_CLOSED_BOTTOM_Y - displayOffset.y, 
-        SPRITE_WIDTH, 
-        EyesAnimation::BLINK_HALF_CLOSED_BOTTOM_HEIGHT, 
-        TFT_BLACK
-      );
-      break;
-      
-    case BlinkState::CLOSED:
-      // Completely closed state - fill entire screen with black (using fillScreen for optimization)
-      canvas.fillScreen(TFT_BLACK);
-      break;
-      
-    case BlinkState::OPEN:
-      // Open state - redraw the white part of the eye
-      drawWhite();
-      drawPupil();
-      break;
-      
-    default:
-      // Do nothing for unknown states
-      break;
+  if (state == BlinkState::OPEN) {
+    // Open state - redraw the white part of the eye
+    drawWhite();
+    drawPupil();
+  } else {
+    drawEyelids(state);
   }
   
   // Update state
   lastBlinkState = state;
 }
 
+/**
+ * @brief Draw an expression pose (pupil offset and scale, eyelids)
+ * @param pose Pose to draw
+ */
+void Eye::drawPose(const ExpressionPose& pose) {
+  const uint8_t scale = pose.values[ExpressionFormat::CHANNEL_PUPIL_SCALE];
+  const uint8_t lidTop = pose.values[ExpressionFormat::CHANNEL_LID_TOP];
+  const uint8_t lidBottom = pose.values[ExpressionFormat::CHANNEL_LID_BOTTOM];
+  
+  // Travel shrinks as the pupil grows, so that a scaled pupil stays on the sclera
+  const EyeStyleFormat::Header& header = style.getHeader();
+  int32_t travelX = (header.scleraRadiusX - header.pupilRadiusX * scale / 100) * pupilMarginPercent / 100;
+  int32_t travelY = (header.scleraRadiusY - header.pupilRadiusY * scale / 100) * pupilMarginPercent / 100;
+  travelX = (travelX > 0) ? travelX : 0;
+  travelY = (travelY > 0) ? travelY : 0;
+  Point position = basePoint + Point(pose.values[ExpressionFormat::CHANNEL_PUPIL_X] * travelX / 100,
+                                     pose.values[ExpressionFormat::CHANNEL_PUPIL_Y] * travelY / 100);
+  
+  bool opening = lidTop < lidTopPercent || lidBottom < lidBottomPercent;
+  bool pupilChanged = position.x != pupilPosition.x || position.y != pupilPosition.y ||
+                      scale != pupilScalePercent;
+  if (opening) {
+    // Rows coming out from under a lid need the white and the pupil back
+    drawWhite();
+    pupilPosition = position;
+    pupilScalePercent = scale;
+    drawPupil();
+  } else if (pupilChanged) {
+    erasePupil();
+    pupilPosition = position;
+    pupilScalePercent = scale;
+    drawPupil();
+  }
+  motion.reset(pupilPosition.x, pupilPosition.y);
+  
+  if (opening || pupilChanged) {
+    // The pupil may have been drawn over the lids
+    coverLids(lidTop, lidBottom, 0, SPRITE_HEIGHT);
+  } else {
+    // Closing lids only cover the rows they newly reach
+    int32_t oldTop, oldBottom, newTop, newBottom;
+    getLidRows(lidTopPercent, lidBottomPercent, oldTop, oldBottom);
+    getLidRows(lidTop, lidBottom, newTop, newBottom);
+    coverLids(lidTop, lidBottom, oldTop, newTop);
+    coverLids(lidTop, lidBottom, newBottom, oldBottom);
+  }
+  lidTopPercent = lidTop;
+  lidBottomPercent = lidBottom;
+}
+
+/**
+ * @brief Set the share of the pupil travel range actually used
+ * @param percent Margin in percent (the eye style provides the default)
+ */
+void Eye::setPupilMargin(uint8_t percent) {
+  if (percent == pupilMarginPercent) {
+    return;
+  }
+  
+  pupilMarginPercent = percent;
+  gazeTable.refresh();
+}
+
+/**
+ * @brief Set how quickly the pupil follows small target changes
+ * @param rate Pursuit spring rate in 1/s (see PupilMotion)
+ */
+void Eye::setPursuitRate(float rate) {
+  motion.setRate(rate);
+}
+
+/**
+ * @brief Look gaze positions up in a precomputed table instead of computing them
+ * @param cellShift Cell size as a power of two (see GazeTable)
+ * @return false if the table cannot be allocated (the exact path stays in use)
+ */
+bool Eye::enableGazeTable(uint8_t cellShift) {
+  return gazeTable.build(layout.getWidth(), layout.getHeight(), cellShift, computeTravelOffset, this);
+}
+
+/**
+ * @brief Compare a gaze table against the exact path at every screen pixel
+ * @param cellShift Cell size as a power of two
+ * @param maxError Receives the largest distance between the two in pixels
+ * @param mismatches Receives the number of pixels where the two differ
+ * @return false if the temporary table cannot be allocated
+ */
+bool Eye::measureGazeTable(uint8_t cellShift, float& maxError, uint32_t& mismatches) const {
+  // Every saccade generateSaccades() can return, one per pixel in turn
+  const int16_t reach = (EyesAnimation::SACCADES_MAX - 1) / EyesAnimation::SACCADES_DIVISOR;
+  const Point saccades[] = { Point(0, 0), Point(reach, 0), Point(0, reach), Point(reach, reach) };
+  
+  const int16_t width = layout.getWidth();
+  const int16_t height = layout.getHeight();
+  GazeTable table;
+  if (!table.build(width, height, cellShift, computeTravelOffset, this)) {
+    return false;
+  }
+  
+  maxError = 0.0F;
+  mismatches = 0;
+  for (int16_t y = 0; y < height; y++) {
+    for (int16_t x = 0; x < width; x++) {
+      const Point& saccade = saccades[(x & 1) | ((y & 1) << 1)];
+      Point exact = computeExactGazingPosition(Point(x, y), saccade);
+      Point looked = lookupGazingPosition(table, Point(x, y), saccade);
+      float error = FastMath::fastHypot(exact.x - looked.x, exact.y - looked.y);
+      if (error > 0.0F) {
+        mismatches++;
+      }
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+    // A full-screen pass takes a few hundred milliseconds
+    yield();
+  }
+  return true;
+}
+
+/**
+ * @brief Draw and push a circling pupil in a temporary sprite of the given color mode
+ * @param mode Color mode to measure (need not be COLOR_MODE)
+ * @param display Display to push to (set to the mode's DISPLAY_COLOR_DEPTH by the caller)
+ * @param frames Number of frames
+ * @param spriteBytes Receives the sprite buffer size
+ * @param drawMicros Receives the total draw time
+ * @param pushMicros Receives the total push time
+ * @return false if the temporary sprite cannot be allocated
+ */
+bool Eye::measureColorMode(ColorMode mode, M5GFX* display, uint16_t frames, uint32_t& spriteBytes,
+                           uint32_t& drawMicros, uint32_t& pushMicros) const {
+  static constexpr float DEGREES_PER_FRAME = 10.0F;
+  
+  M5Canvas sprite;
+  if (!MemoryBudget::createSprite(sprite, canvas.width(), canvas.height(), (mode == ColorMode::PALETTE) ? 4 : 1,
+                                  MemoryPlacement::INTERNAL, "color bench sprite")) {
+    return false;
+  }
+  if (mode == ColorMode::PALETTE) {
+    sprite.createPalette();
+    for (uint8_t i = 0; i < EyePalette::COUNT; i++) {
+      sprite.setPaletteColor(i, EyePalette::COLORS[i]);
+    }
+  }
+  spriteBytes = sprite.bufferLength();
+  
+  // Circle the pupil along the rim so every frame redraws it
+  sprite.fillScreen(color(EyePalette::BACKGROUND, mode));
+  fillLayers(sprite, EyeStyleFormat::TARGET_SCLERA, mode, toLocalCoordinates(basePoint), false);
+  Point center = toLocalCoordinates(basePoint) + style.getPupilOffset(side);
+  Point pupil = center;
+  drawMicros = 0;
+  pushMicros = 0;
+  for (uint16_t frame = 0; frame < frames; frame++) {
+    uint32_t start = micros();
+    fillLayers(sprite, EyeStyleFormat::TARGET_PUPIL, mode, pupil, true);
+    float angleDegrees = frame * DEGREES_PER_FRAME;
+    float distance = getMaxPupilDistanceAtAngle(angleDegrees);
+    pupil = center + Point(static_cast<int16_t>(distance * FastMath::fastCos(angleDegrees)),
+                           static_cast<int16_t>(distance * FastMath::fastSin(angleDegrees)));
+    fillLayers(sprite, EyeStyleFormat::TARGET_PUPIL, mode, pupil, false);
+    uint32_t drawn = micros();
+    sprite.pushSprite(display, displayOffset.x, displayOffset.y);
+    display->waitDMA();
+    drawMicros += drawn - start;
+    pushMicros += micros() - drawn;
+  }
+  
+  MemoryBudget::deleteSprite(sprite);
+  return true;
+}
+
 /**
  * @brief Render sprite to display
  * @param display Display object
  */
 void Eye::render(M5GFX* display) {
+  if (!ready) {
+    return;
+  }
   canvas.pushSprite(display, displayOffset.x, displayOffset.y);
 }
 
+/**
+ * @brief Push part of the sprite to a display
+ * @param display Display (or any other target)
+ * @param x X coordinate of the sprite on the target
+ * @param y Y coordinate of the sprite on the target
+ * @param rows Rows to transfer (clamped to the sprite)
+ */
+void Eye::render(lgfx::LovyanGFX* display, int16_t x, int16_t y, const DirtyRows& rows) {
+  int32_t bottom = (rows.bottom < canvas.height()) ? rows.bottom : canvas.height();
+  if (!ready || bottom <= rows.top) {
+    return;
+  }
+  
+  // Clipping limits the transfer to the given rows
+  display->setClipRect(x, y + rows.top, canvas.width(), bottom - rows.top);
+  canvas.pushSprite(display, x, y);
+  display->clearClipRect();
+}
+
+/**
+ * @brief Get the rows drawn since the previous call and start collecting anew
+ * @return Rows drawn (empty if the sprite is unchanged)
+ */
+DirtyRows Eye::takeDirtyRows() {
+  DirtyRows rows = dirtyRows;
+  dirtyRows = DirtyRows();
+  return rows;
+}
+
+/**
+ * @brief Draw the prerendered first frame straight to the display
+ * @param display Display object (the eye area must already be black)
+ */
+void Eye::renderBootFrame(M5GFX* display) const {
+  // Left eye runs come first in the table
+  const EyeStyleFormat::Span* spans = BootFrame::SPANS + (side == 0 ? 0 : BootFrame::SPAN_COUNTS[0]);
+  for (uint16_t i = 0; i < BootFrame::SPAN_COUNTS[side]; i++) {
+    ScreenLayout::fillRect(*display, layout.getRotation(), layout.getWidth(), layout.getHeight(),
+                           basePoint.x + spans[i].dx, basePoint.y + spans[i].dy, spans[i].length, 1, TFT_WHITE);
+  }
+}
+
+/**
+ * @brief Get read-only view of the sprite buffer
+ * @return Sprite view (buffer is nullptr if the eye is not ready)
+ */
+SpriteView Eye::getSpriteView() const {
+  SpriteView view;
+  view.buffer = ready ? static_cast<const uint8_t*>(canvas.getBuffer()) : nullptr;
+  view.length = ready ? canvas.bufferLength() : 0;
+  view.width = ready ? canvas.width() : 0;
+  view.height = ready ? canvas.height() : 0;
+  view.colorDepth = SPRITE_COLOR_DEPTH;
+  view.x = displayOffset.x;
+  view.y = displayOffset.y;
+  return view;
+}
+
 /**
  * @brief Erase the pupil
  */
 void Eye::erasePupil() {
-  drawPupilWithColor(TFT_WHITE);
+  drawLayers(EyeStyleFormat::TARGET_PUPIL, getPupilDrawCenter(), true);
 }
 
 /**
  * @brief Draw the pupil
  */
 void Eye::drawPupil() {
-  drawPupilWithColor(TFT_BLACK);
+  drawLayers(EyeStyleFormat::TARGET_PUPIL, getPupilDrawCenter(), false);
+}
+
+/**
+ * @brief Fill a rectangle given in unrotated sprite coordinates
+ * @param x Rectangle X
+ * @param y Rectangle Y
+ * @param w Rectangle width
+ * @param h Rectangle height
+ * @param fillColor Fill color
+ */
+void Eye::fillLocalRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t fillColor) {
+  ScreenLayout::rotateRect(layout.getRotation(), SPRITE_WIDTH, SPRITE_HEIGHT, x, y, w, h);
+  int32_t top = constrain(y, 0, canvas.height());
+  int32_t bottom = constrain(y + h, 0, canvas.height());
+  if (w <= 0 || bottom <= top) {
+    return;
+  }
+  
+  canvas.fillRect(x, y, w, h, fillColor);
+  dirtyRows.add(DirtyRows(top, bottom));
+}
+
+/**
+ * @brief Draw the style layers of one target in the current color mode
+ * @param target EyeStyleFormat::Target
+ * @param center Local coordinates of the layer origin
+ * @param erase true to draw every layer in the sclera color
+ */
+void Eye::drawLayers(uint8_t target, const Point& center, bool erase) {
+  uint8_t mode = (COLOR_MODE == ColorMode::PALETTE) ? EyeStyleFormat::MODE_PALETTE
+                                                    : EyeStyleFormat::MODE_MONO;
+  const EyeStyleFormat::Header& header = style.getHeader();
+  for (uint8_t i = 0; i < header.layerCount; i++) {
+    const EyeStyleFormat::Layer& layer = style.getLayer(i);
+    if (layer.target != target || (layer.modes & mode) == 0) {
+      continue;
+    }
+    
+    uint32_t layerColor = erase ? color(EyePalette::SCLERA)
+                                : color(static_cast<EyePalette::Index>(layer.colorIndex));
+    const EyeStyleFormat::Span* spans = style.getSpans(layer);
+    if (target != EyeStyleFormat::TARGET_PUPIL || pupilScalePercent == 100) {
+      for (uint16_t j = 0; j < layer.spanCount; j++) {
+        fillLocalRect(center.x + spans[j].dx, center.y + spans[j].dy, spans[j].length, 1, layerColor);
+      }
+      continue;
+    }
+    
+    // Scaled pupil: each span covers the scaled image of its pixels, so rows and columns tile without gaps
+    for (uint16_t j = 0; j < layer.spanCount; j++) {
+      int32_t top = scaleFloor(spans[j].dy, pupilScalePercent);
+      int32_t bottom = scaleFloor(spans[j].dy + 1, pupilScalePercent);
+      int32_t left = scaleFloor(spans[j].dx, pupilScalePercent);
+      int32_t right = scaleFloor(spans[j].dx + spans[j].length, pupilScalePercent);
+      fillLocalRect(center.x + left, center.y + top, right - left, bottom - top, layerColor);
+    }
+  }
+}
+
+/**
+ * @brief Draw the unscaled style layers of one target into another sprite
+ * @param sprite Sprite the size of this eye's
+ * @param target EyeStyleFormat::Target
+ * @param mode Color mode whose layers and colors to use
+ * @param center Local coordinates of the layer origin
+ * @param erase true to draw every layer in the sclera color
+ */
+void Eye::fillLayers(M5Canvas& sprite, uint8_t target, ColorMode mode, const Point& center, bool erase) const {
+  uint8_t modeMask = (mode == ColorMode::PALETTE) ? EyeStyleFormat::MODE_PALETTE : EyeStyleFormat::MODE_MONO;
+  const EyeStyleFormat::Header& header = style.getHeader();
+  for (uint8_t i = 0; i < header.layerCount; i++) {
+    const EyeStyleFormat::Layer& layer = style.getLayer(i);
+    if (layer.target != target || (layer.modes & modeMask) == 0) {
+      continue;
+    }
+    
+    uint32_t layerColor = color(erase ? EyePalette::SCLERA : static_cast<EyePalette::Index>(layer.colorIndex), mode);
+    const EyeStyleFormat::Span* spans = style.getSpans(layer);
+    for (uint16_t j = 0; j < layer.spanCount; j++) {
+      int32_t x = center.x + spans[j].dx;
+      int32_t y = center.y + spans[j].dy;
+      int32_t w = spans[j].length;
+      int32_t h = 1;
+      ScreenLayout::rotateRect(layout.getRotation(), SPRITE_WIDTH, SPRITE_HEIGHT, x, y, w, h);
+      sprite.fillRect(x, y, w, h, layerColor);
+    }
+  }
+}
+
+/**
+ * @brief Get local coordinates of the pupil layer origin
+ * @return Pupil position plus the style's pupil offset
+ */
+Point Eye::getPupilDrawCenter() const {
+  // The offset applies to drawing only
+  return toLocalCoordinates(pupilPosition) + style.getPupilOffset(side);
+}
+
+/**
+ * @brief Cover the rows hidden by the eyelids
+ * @param state Blink state
+ */
+void Eye::drawEyelids(BlinkState state) {
+  const EyeStyleFormat::Eyelid* eyelid = style.getEyelid(static_cast<uint8_t>(state));
+  if (eyelid == nullptr || eyelid->topEdge >= eyelid->bottomEdge) {
+    // Completely closed - fill entire sprite with black (using fillScreen for optimization)
+    clear();
+    return;
+  }
+  
+  // Eyelid edges are relative to the eye center
+  int32_t localCenterY = basePoint.y - spriteOrigin.y;
+  int32_t top = constrain(localCenterY + eyelid->topEdge, 0, static_cast<int32_t>(SPRITE_HEIGHT));
+  int32_t bottom = constrain(localCenterY + eyelid->bottomEdge, 0, static_cast<int32_t>(SPRITE_HEIGHT));
+  if (top > 0) {
+    fillLocalRect(0, 0, SPRITE_WIDTH, top, color(EyePalette::BACKGROUND));
+  }
+  if (bottom < SPRITE_HEIGHT) {
+    fillLocalRect(0, bottom, SPRITE_WIDTH, SPRITE_HEIGHT - bottom, color(EyePalette::BACKGROUND));
+  }
 }
 
 /**
- * @brief Draw pupil with specified color
- * @param color Drawing color
+ * @brief Cover the rows hidden by the expression lids within a band of rows
+ * @param topPercent Upper lid (percent of the way to the center)
+ * @param bottomPercent Lower lid (percent of the way to the center)
+ * @param fromRow First local row to cover
+ * @param toRow One past the last local row to cover
  */
-void Eye::drawPupilWithColor(uint16_t color) {
-  Point localPupil = toLocalCoordinates(pupilPosition);
-  // Apply pupil draw offset for drawing only
-  canvas.fillEllipse(localPupil.x + pupilDrawOffset.x, localPupil.y + pupilDrawOffset.y, 
-                      PUPIL_RADIUS_X, PUPIL_RADIUS_Y, color);
+void Eye::coverLids(uint8_t topPercent, uint8_t bottomPercent, int32_t fromRow, int32_t toRow) {
+  int32_t topRow, bottomRow;
+  getLidRows(topPercent, bottomPercent, topRow, bottomRow);
+  
+  int32_t upperEnd = (topRow < toRow) ? topRow : toRow;
+  if (fromRow < upperEnd) {
+    fillLocalRect(0, fromRow, SPRITE_WIDTH, upperEnd - fromRow, color(EyePalette::BACKGROUND));
+  }
+  int32_t lowerStart = (bottomRow > fromRow) ? bottomRow : fromRow;
+  if (lowerStart < toRow) {
+    fillLocalRect(0, lowerStart, SPRITE_WIDTH, toRow - lowerStart, color(EyePalette::BACKGROUND));
+  }
+}
+
+/**
+ * @brief Get the local rows left uncovered by the expression lids
+ * @param topPercent Upper lid (percent of the way to the center)
+ * @param bottomPercent Lower lid (percent of the way to the center)
+ * @param topRow Receives the first uncovered row
+ * @param bottomRow Receives one past the last uncovered row
+ */
+void Eye::getLidRows(uint8_t topPercent, uint8_t bottomPercent, int32_t& topRow, int32_t& bottomRow) const {
+  // Lids travel from the style's sclera rim to the eye center, so both at 100% close the eye
+  int32_t localCenterY = basePoint.y - spriteOrigin.y;
+  int32_t radiusY = style.getHeader().scleraRadiusY;
+  topRow = localCenterY - radiusY + radiusY * topPercent / 100;
+  bottomRow = localCenterY + radiusY + 1 - (radiusY + 1) * bottomPercent / 100;
 }
 
 /**
@@ -209,6 +612,19 @@ void Eye::updatePupil(const Point& newPosition) {
   drawPupil();
 }
 
+/**
+ * @brief Move the pupil towards a position with the motion model
+ * @param target Position the pupil is heading for
+ * @param steps PupilMotion steps to take
+ */
+void Eye::moveTowards(const Point& target, uint8_t steps) {
+  motion.setTarget(target.x, target.y);
+  motion.step(steps);
+  
+  // Sub-pixel motion only shows once it crosses a pixel; updatePupil() skips the rest
+  updatePupil(Point(motion.getPixelX(), motion.getPixelY()));
+}
+
 /**
  * @brief Convert global coordinates to local coordinates within the sprite
  * @param globalPoint Global coordinates
@@ -216,8 +632,8 @@ void Eye::updatePupil(const Point& newPosition) {
  */
 Point Eye::toLocalCoordinates(const Point& globalPoint) const {
   return Point(
-    globalPoint.x - displayOffset.x,
-    globalPoint.y - displayOffset.y
+    globalPoint.x - spriteOrigin.x,
+    globalPoint.y - spriteOrigin.y
   );
 }
 
@@ -231,15 +647,16 @@ float Eye::getMaxPupilDistanceAtAngle(float angleDeg) const {
   float sinA = FastMath::fastSin(angleDeg);
   
   // Pupil movement range (radius of the white of the eye - radius of the pupil)
-  float a = EYE_RADIUS_X - PUPIL_RADIUS_X;
-  float b = EYE_RADIUS_Y - PUPIL_RADIUS_Y;
+  const EyeStyleFormat::Header& header = style.getHeader();
+  float a = header.scleraRadiusX - header.pupilRadiusX;
+  float b = header.scleraRadiusY - header.pupilRadiusY;
   
   // Ellipse radius in polar coordinates: r = ab / sqrt((b*cos)² + (a*sin)²)
   float denominator = FastMath::fastHypot(b * cosA, a * sinA);
   float maxDist = (a * b) / denominator;
   
   // Apply a margin factor to prevent the pupil from clinging to the outline of the white of the eye
-  return maxDist * 0.80F;
+  return maxDist * pupilMarginPercent / 100.0F;
 }
 
 /**
@@ -248,7 +665,33 @@ float Eye::getMaxPupilDistanceAtAngle(float angleDeg) const {
  * @param saccades Amount of small movements
  * @return New position of the pupil
  */
-Point Eye::computeGazingPosition(const Point& targetPoint, const Point& saccades) {
+Point Eye::computeGazingPosition(const Point& targetPoint, const Point& saccades) const {
+  if (gazeTable.isReady()) {
+    return lookupGazingPosition(gazeTable, targetPoint, saccades);
+  }
+  return computeExactGazingPosition(targetPoint, saccades);
+}
+
+/**
+ * @brief Calculate pupil position for gaze following from a gaze table
+ * @param table Built gaze table
+ * @param targetPoint Target point of the gaze
+ * @param saccades Amount of small movements
+ * @return New position of the pupil
+ */
+Point Eye::lookupGazingPosition(const GazeTable& table, const Point& targetPoint, const Point& saccades) const {
+  // Saccades that leave the travel range are rescaled onto it, as on the exact path
+  Point offset = table.lookup(targetPoint);
+  return basePoint + clampToTravel(offset + saccades, offset);
+}
+
+/**
+ * @brief Calculate pupil position for gaze following without a gaze table
+ * @param targetPoint Target point of the gaze
+ * @param saccades Amount of small movements
+ * @return New position of the pupil
+ */
+Point Eye::computeExactGazingPosition(const Point& targetPoint, const Point& saccades) const {
   // Difference vector from eye center to target point
   Point diff = targetPoint - basePoint;
   
@@ -286,3 +729,59 @@ Point Eye::computeGazingPosition(const Point& targetPoint, const Point& saccades
   
   return result;
 }
+
+/**
+ * @brief Clamp the offset to a target point to the pupil travel range (GazeTable::ExactMapping)
+ * @param context Eye instance
+ * @param x Target X coordinate
+ * @param y Target Y coordinate
+ * @param offsetX Receives the clamped offset X
+ * @param offsetY Receives the clamped offset Y
+ */
+void Eye::computeTravelOffset(const void* context, int16_t x, int16_t y, float& offsetX, float& offsetY) {
+  const Eye* self = static_cast<const Eye*>(context);
+  Point diff = Point(x, y) - self->basePoint;
+  
+  // Same steps as the first clamp in computeGazingPosition(), without truncating
+  float angleDeg = FastMath::radiansToDegrees(FastMath::fastAtan2(diff.y, diff.x));
+  float maxDist = self->getMaxPupilDistanceAtAngle(angleDeg);
+  float dist = FastMath::fastHypot(diff.x, diff.y);
+  float scale = (dist > maxDist) ? maxDist / dist : 1.0F;
+  offsetX = diff.x * scale;
+  offsetY = diff.y * scale;
+}
+
+/**
+ * @brief Check whether an offset lies within the pupil travel range
+ * @param offset Offset from the eye center
+ * @return true if the offset is inside the margin-scaled travel ellipse
+ */
+bool Eye::isWithinTravel(const Point& offset) const {
+  // The margin scales the polar radius, so the range is an ellipse with scaled semi-axes
+  const EyeStyleFormat::Header& header = style.getHeader();
+  float a = (header.scleraRadiusX - header.pupilRadiusX) * pupilMarginPercent / 100.0F;
+  float b = (header.scleraRadiusY - header.pupilRadiusY) * pupilMarginPercent / 100.0F;
+  return offset.x * offset.x * b * b + offset.y * offset.y * a * a <= a * a * b * b;
+}
+
+/**
+ * @brief Scale an offset that left the pupil travel range back onto it
+ * @param offset Offset from the eye center (e.g. a table offset plus saccades)
+ * @param direction Offset whose angle sets the travel radius (the offset before the saccades)
+ * @return offset itself if within range, otherwise scaled as the second clamp of the exact path does
+ */
+Point Eye::clampToTravel(const Point& offset, const Point& direction) const {
+  // Most frames stay inside and skip the trigonometry
+  if (isWithinTravel(offset)) {
+    return offset;
+  }
+  
+  float angleDeg = FastMath::radiansToDegrees(FastMath::fastAtan2(direction.y, direction.x));
+  float maxDist = getMaxPupilDistanceAtAngle(angleDeg);
+  float dist = FastMath::fastHypot(offset.x, offset.y);
+  if (dist <= maxDist) {
+    return offset;
+  }
+  float scale = maxDist / dist;
+  return Point(static_cast<int16_t>(offset.x * scale), static_cast<int16_t>(offset.y * scale));
+}
@@ -0,0 +1,15 @@
+#include "EyePalette.h"
+
+/**
+ * @brief Palette colors (RGB888) indexed by EyePalette::Index
+ */
+const uint32_t EyePalette::COLORS[EyePalette::COUNT] = {
+  0x000000,  // BACKGROUND
+  0x5A5A5E,  // SCLERA_RING
+  0xB4B4BC,  // SCLERA_SHADE
+  0xFFFFFF,  // SCLERA
+  0x8AA6C8,  // IRIS_OUTER_RING
+  0x2A6CB8,  // IRIS
+  0x15365C,  // IRIS_INNER_RING
+  0x000000   // PUPIL
+};
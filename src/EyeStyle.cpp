@@ -0,0 +1,257 @@
+#include "EyeStyle.h"
+#include "EyePalette.h"
+#include "MemoryBudget.h"
+#include <string.h>
+#if defined(ARDUINO)
+#include <esp_partition.h>
+#else
+#include <stdio.h>
+#endif
+
+/**
+ * @brief Constructor (starts with the built-in style)
+ */
+EyeStyle::EyeStyle()
+  : data(EyeStyleData::DEFAULT_STYLE),
+    size(EyeStyleData::DEFAULT_STYLE_SIZE),
+    header(reinterpret_cast<const EyeStyleFormat::Header*>(EyeStyleData::DEFAULT_STYLE)),
+    mapHandle(0) {
+}
+
+/**
+ * @brief Destructor
+ */
+EyeStyle::~EyeStyle() {
+  unmap(mapHandle);
+}
+
+/**
+ * @brief Use an asset that stays valid for the lifetime of this object
+ * @param data Asset bytes (must be 4-byte aligned)
+ * @param size Number of bytes available
+ * @return false if the asset is malformed
+ */
+bool EyeStyle::load(const uint8_t* data, uint32_t size) {
+  if (!validate(data, size)) {
+    return false;
+  }
+  
+  this->data = data;
+  this->header = reinterpret_cast<const EyeStyleFormat::Header*>(data);
+  this->size = header->totalSize;
+  return true;
+}
+
+/**
+ * @brief Memory-map a flash data partition and use the asset stored in it
+ * @param label Partition label
+ * @return false if the partition is missing, cannot be mapped or is malformed
+ */
+bool EyeStyle::mapPartition(const char* label) {
+#if defined(ARDUINO)
+  const esp_partition_t* partition =
+    esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  if (partition == nullptr) {
+    return false;
+  }
+  
+  // Map through the flash cache so the asset is read in place
+  const void* mapped = nullptr;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_mmap_handle_t handle;
+  esp_err_t result = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                                        &mapped, &handle);
+#else
+  spi_flash_mmap_handle_t handle;
+  esp_err_t result = esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA,
+                                        &mapped, &handle);
+#endif
+  if (result != ESP_OK) {
+    return false;
+  }
+  
+  if (!load(static_cast<const uint8_t*>(mapped), partition->size)) {
+    Serial.println("Warning: Eye style partition holds no valid style. Using the built-in style.");
+    unmap(handle);
+    return false;
+  }
+  
+  // Nothing points into the previous mapping any more
+  unmap(mapHandle);
+  mapHandle = handle;
+  MemoryBudget::trackStatic(size, "eye style (partition)");
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if !defined(ARDUINO)
+/**
+ * @brief Read an asset from a file
+ * @param path File path
+ * @return false if the file cannot be read or is malformed
+ */
+bool EyeStyle::loadFile(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  
+  // Read into words so the asset is aligned like mapped flash
+  std::vector<uint32_t> buffer;
+  uint32_t length = 0;
+  uint8_t chunk[1024];
+  size_t count;
+  while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    buffer.resize((length + count + 3) / 4);
+    memcpy(reinterpret_cast<uint8_t*>(buffer.data()) + length, chunk, count);
+    length += count;
+  }
+  fclose(file);
+  
+  if (!validate(reinterpret_cast<const uint8_t*>(buffer.data()), length)) {
+    return false;
+  }
+  
+  fileData.swap(buffer);
+  return load(reinterpret_cast<const uint8_t*>(fileData.data()), length);
+}
+#endif
+
+/**
+ * @brief Check whether the built-in style is in use
+ * @return true if no custom asset has been loaded
+ */
+bool EyeStyle::isBuiltIn() const {
+  return data == EyeStyleData::DEFAULT_STYLE;
+}
+
+/**
+ * @brief Get size of the asset in use
+ * @return Size in bytes
+ */
+uint32_t EyeStyle::getSize() const {
+  return size;
+}
+
+/**
+ * @brief Get asset header
+ * @return Header
+ */
+const EyeStyleFormat::Header& EyeStyle::getHeader() const {
+  return *header;
+}
+
+/**
+ * @brief Get a layer
+ * @param index Layer index (less than getHeader().layerCount)
+ * @return Layer
+ */
+const EyeStyleFormat::Layer& EyeStyle::getLayer(uint8_t index) const {
+  const EyeStyleFormat::Layer* layers =
+    reinterpret_cast<const EyeStyleFormat::Layer*>(data + header->layerOffset);
+  return layers[index];
+}
+
+/**
+ * @brief Get the spans of a layer
+ * @param layer Layer
+ * @return First of layer.spanCount spans
+ */
+const EyeStyleFormat::Span* EyeStyle::getSpans(const EyeStyleFormat::Layer& layer) const {
+  return reinterpret_cast<const EyeStyleFormat::Span*>(data + layer.spanOffset);
+}
+
+/**
+ * @brief Get the eyelid entry for a blink level
+ * @param level Blink level (BlinkState value)
+ * @return Eyelid entry, or nullptr if the asset has none for this level
+ */
+const EyeStyleFormat::Eyelid* EyeStyle::getEyelid(uint8_t level) const {
+  if (level >= header->eyelidCount) {
+    return nullptr;
+  }
+  const EyeStyleFormat::Eyelid* eyelids =
+    reinterpret_cast<const EyeStyleFormat::Eyelid*>(data + header->eyelidOffset);
+  return &eyelids[level];
+}
+
+/**
+ * @brief Get pupil drawing offset
+ * @param side Eye (0: left, 1: right)
+ * @return Offset applied when drawing the pupil
+ */
+Point EyeStyle::getPupilOffset(uint8_t side) const {
+  uint8_t index = (side == 0) ? 0 : 1;
+  return Point(header->pupilOffsetX[index], header->pupilOffsetY[index]);
+}
+
+/**
+ * @brief Check that an asset is well formed
+ * @param data Asset bytes
+ * @param size Number of bytes available
+ * @return true if every table lies inside the asset and the checksum matches
+ */
+bool EyeStyle::validate(const uint8_t* data, uint32_t size) {
+  using namespace EyeStyleFormat;
+  
+  if (data == nullptr || (reinterpret_cast<uintptr_t>(data) & 3) != 0 || size < sizeof(Header)) {
+    return false;
+  }
+  
+  const Header* header = reinterpret_cast<const Header*>(data);
+  if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->version != VERSION ||
+      header->headerSize != sizeof(Header) ||
+      header->totalSize < sizeof(Header) ||
+      header->totalSize > size) {
+    return false;
+  }
+  
+  // Pupil travel range must be positive
+  if (header->pupilRadiusX >= header->scleraRadiusX ||
+      header->pupilRadiusY >= header->scleraRadiusY ||
+      header->pupilMarginPercent > 100) {
+    return false;
+  }
+  
+  // Tables must be aligned and lie inside the asset (64-bit sums cannot overflow)
+  uint64_t totalSize = header->totalSize;
+  if ((header->layerOffset & 3) != 0 || header->layerOffset < sizeof(Header) ||
+      header->layerOffset + static_cast<uint64_t>(header->layerCount) * sizeof(Layer) > totalSize) {
+    return false;
+  }
+  if ((header->eyelidOffset & 1) != 0 || header->eyelidOffset < sizeof(Header) ||
+      header->eyelidOffset + static_cast<uint64_t>(header->eyelidCount) * sizeof(Eyelid) > totalSize) {
+    return false;
+  }
+  
+  const Layer* layers = reinterpret_cast<const Layer*>(data + header->layerOffset);
+  for (uint8_t i = 0; i < header->layerCount; i++) {
+    const Layer& layer = layers[i];
+    if (layer.target > TARGET_PUPIL || layer.colorIndex >= EyePalette::COUNT ||
+        (layer.spanOffset & 1) != 0 || layer.spanOffset < sizeof(Header) ||
+        layer.spanOffset + static_cast<uint64_t>(layer.spanCount) * sizeof(Span) > totalSize) {
+      return false;
+    }
+  }
+  
+  return checksum(data + sizeof(Header), header->totalSize - sizeof(Header)) == header->checksum;
+}
+
+/**
+ * @brief Release a flash mapping
+ * @param handle Mapping handle (0 for none)
+ */
+void EyeStyle::unmap(uint32_t handle) {
+#if defined(ARDUINO)
+  if (handle != 0) {
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_munmap(handle);
+#else
+    spi_flash_munmap(handle);
+#endif
+  }
+#endif
+}
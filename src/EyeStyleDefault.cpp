@@ -0,0 +1,285 @@
+// Generated by tools/eyestyle_compiler from tools/eyestyles/default.txt. Do not edit.
+#include "EyeStyle.h"
+
+alignas(4) const uint8_t EyeStyleData::DEFAULT_STYLE[] = {
+  0x45, 0x59, 0x53, 0x54, 0x01, 0x00, 0x24, 0x00, 0x58, 0x11, 0x00, 0x00, 0x19, 0x2F, 0x23, 0x71,
+  0x3C, 0x4B, 0x0A, 0x0D, 0x07, 0xF9, 0x00, 0x00, 0x50, 0x09, 0x03, 0x00, 0x24, 0x00, 0x00, 0x00,
+  0x90, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0x00, 0x97, 0x00, 0x00, 0x00, 0x9C, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x02, 0x00, 0x97, 0x00, 0x00, 0x00, 0x28, 0x04, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00,
+  0x95, 0x00, 0x00, 0x00, 0xB4, 0x07, 0x00, 0x00, 0x00, 0x03, 0x02, 0x00, 0x91, 0x00, 0x00, 0x00,
+  0x34, 0x0B, 0x00, 0x00, 0x01, 0x07, 0x01, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x9C, 0x0E, 0x00, 0x00,
+  0x01, 0x04, 0x02, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x40, 0x0F, 0x00, 0x00, 0x01, 0x05, 0x02, 0x00,
+  0x19, 0x00, 0x00, 0x00, 0xE4, 0x0F, 0x00, 0x00, 0x01, 0x06, 0x02, 0x00, 0x13, 0x00, 0x00, 0x00,
+  0x7C, 0x10, 0x00, 0x00, 0x01, 0x07, 0x02, 0x00, 0x11, 0x00, 0x00, 0x00, 0xF0, 0x10, 0x00, 0x00,
+  0x00, 0x80, 0xFF, 0x7F, 0xEF, 0xFF, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB5, 0xFF, 0x00, 0x00,
+  0x01, 0x00, 0xB6, 0xFF, 0xF6, 0xFF, 0x15, 0x00, 0xB7, 0xFF, 0xF2, 0xFF, 0x1D, 0x00, 0xB8, 0xFF,
+  0xEF, 0xFF, 0x23, 0x00, 0xB9, 0xFF, 0xED, 0xFF, 0x27, 0x00, 0xBA, 0xFF, 0xEA, 0xFF, 0x2D, 0x00,
+  0xBB, 0xFF, 0xE8, 0xFF, 0x31, 0x00, 0xBC, 0xFF, 0xE7, 0xFF, 0x33, 0x00, 0xBD, 0xFF, 0xE5, 0xFF,
+  0x37, 0x00, 0xBE, 0xFF, 0xE4, 0xFF, 0x39, 0x00, 0xBF, 0xFF, 0xE2, 0xFF, 0x3D, 0x00, 0xC0, 0xFF,
+  0xE1, 0xFF, 0x3F, 0x00, 0xC1, 0xFF, 0xDF, 0xFF, 0x43, 0x00, 0xC2, 0xFF, 0xDE, 0xFF, 0x45, 0x00,
+  0xC3, 0xFF, 0xDD, 0xFF, 0x47, 0x00, 0xC4, 0xFF, 0xDC, 0xFF, 0x49, 0x00, 0xC5, 0xFF, 0xDB, 0xFF,
+  0x4B, 0x00, 0xC6, 0xFF, 0xDA, 0xFF, 0x4D, 0x00, 0xC7, 0xFF, 0xD9, 0xFF, 0x4F, 0x00, 0xC8, 0xFF,
+  0xD8, 0xFF, 0x51, 0x00, 0xC9, 0xFF, 0xD7, 0xFF, 0x53, 0x00, 0xCA, 0xFF, 0xD6, 0xFF, 0x55, 0x00,
+  0xCB, 0xFF, 0xD6, 0xFF, 0x55, 0x00, 0xCC, 0xFF, 0xD5, 0xFF, 0x57, 0x00, 0xCD, 0xFF, 0xD4, 0xFF,
+  0x59, 0x00, 0xCE, 0xFF, 0xD3, 0xFF, 0x5B, 0x00, 0xCF, 0xFF, 0xD3, 0xFF, 0x5B, 0x00, 0xD0, 0xFF,
+  0xD2, 0xFF, 0x5D, 0x00, 0xD1, 0xFF, 0xD1, 0xFF, 0x5F, 0x00, 0xD2, 0xFF, 0xD1, 0xFF, 0x5F, 0x00,
+  0xD3, 0xFF, 0xD0, 0xFF, 0x61, 0x00, 0xD4, 0xFF, 0xCF, 0xFF, 0x63, 0x00, 0xD5, 0xFF, 0xCF, 0xFF,
+  0x63, 0x00, 0xD6, 0xFF, 0xCE, 0xFF, 0x65, 0x00, 0xD7, 0xFF, 0xCE, 0xFF, 0x65, 0x00, 0xD8, 0xFF,
+  0xCD, 0xFF, 0x67, 0x00, 0xD9, 0xFF, 0xCD, 0xFF, 0x67, 0x00, 0xDA, 0xFF, 0xCC, 0xFF, 0x69, 0x00,
+  0xDB, 0xFF, 0xCC, 0xFF, 0x69, 0x00, 0xDC, 0xFF, 0xCB, 0xFF, 0x6B, 0x00, 0xDD, 0xFF, 0xCB, 0xFF,
+  0x6B, 0x00, 0xDE, 0xFF, 0xCB, 0xFF, 0x6B, 0x00, 0xDF, 0xFF, 0xCA, 0xFF, 0x6D, 0x00, 0xE0, 0xFF,
+  0xCA, 0xFF, 0x6D, 0x00, 0xE1, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xE2, 0xFF, 0xC9, 0xFF, 0x6F, 0x00,
+  0xE3, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xE4, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xE5, 0xFF, 0xC8, 0xFF,
+  0x71, 0x00, 0xE6, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xE7, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xE8, 0xFF,
+  0xC7, 0xFF, 0x73, 0x00, 0xE9, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xEA, 0xFF, 0xC7, 0xFF, 0x73, 0x00,
+  0xEB, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xEC, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xED, 0xFF, 0xC6, 0xFF,
+  0x75, 0x00, 0xEE, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xEF, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xF0, 0xFF,
+  0xC5, 0xFF, 0x77, 0x00, 0xF1, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF2, 0xFF, 0xC5, 0xFF, 0x77, 0x00,
+  0xF3, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF4, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF5, 0xFF, 0xC5, 0xFF,
+  0x77, 0x00, 0xF6, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF7, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xF8, 0xFF,
+  0xC4, 0xFF, 0x79, 0x00, 0xF9, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFA, 0xFF, 0xC4, 0xFF, 0x79, 0x00,
+  0xFB, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFC, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFD, 0xFF, 0xC4, 0xFF,
+  0x79, 0x00, 0xFE, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFF, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0x00, 0x00,
+  0xC4, 0xFF, 0x79, 0x00, 0x01, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x02, 0x00, 0xC4, 0xFF, 0x79, 0x00,
+  0x03, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x04, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x05, 0x00, 0xC4, 0xFF,
+  0x79, 0x00, 0x06, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x07, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x08, 0x00,
+  0xC4, 0xFF, 0x79, 0x00, 0x09, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x0A, 0x00, 0xC5, 0xFF, 0x77, 0x00,
+  0x0B, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x0C, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x0D, 0x00, 0xC5, 0xFF,
+  0x77, 0x00, 0x0E, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x0F, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x10, 0x00,
+  0xC5, 0xFF, 0x77, 0x00, 0x11, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x12, 0x00, 0xC6, 0xFF, 0x75, 0x00,
+  0x13, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x14, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x15, 0x00, 0xC6, 0xFF,
+  0x75, 0x00, 0x16, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x17, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x18, 0x00,
+  0xC7, 0xFF, 0x73, 0x00, 0x19, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x1A, 0x00, 0xC8, 0xFF, 0x71, 0x00,
+  0x1B, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x1C, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x1D, 0x00, 0xC9, 0xFF,
+  0x6F, 0x00, 0x1E, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x1F, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x20, 0x00,
+  0xCA, 0xFF, 0x6D, 0x00, 0x21, 0x00, 0xCA, 0xFF, 0x6D, 0x00, 0x22, 0x00, 0xCB, 0xFF, 0x6B, 0x00,
+  0x23, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x24, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x25, 0x00, 0xCC, 0xFF,
+  0x69, 0x00, 0x26, 0x00, 0xCC, 0xFF, 0x69, 0x00, 0x27, 0x00, 0xCD, 0xFF, 0x67, 0x00, 0x28, 0x00,
+  0xCD, 0xFF, 0x67, 0x00, 0x29, 0x00, 0xCE, 0xFF, 0x65, 0x00, 0x2A, 0x00, 0xCE, 0xFF, 0x65, 0x00,
+  0x2B, 0x00, 0xCF, 0xFF, 0x63, 0x00, 0x2C, 0x00, 0xCF, 0xFF, 0x63, 0x00, 0x2D, 0x00, 0xD0, 0xFF,
+  0x61, 0x00, 0x2E, 0x00, 0xD1, 0xFF, 0x5F, 0x00, 0x2F, 0x00, 0xD1, 0xFF, 0x5F, 0x00, 0x30, 0x00,
+  0xD2, 0xFF, 0x5D, 0x00, 0x31, 0x00, 0xD3, 0xFF, 0x5B, 0x00, 0x32, 0x00, 0xD3, 0xFF, 0x5B, 0x00,
+  0x33, 0x00, 0xD4, 0xFF, 0x59, 0x00, 0x34, 0x00, 0xD5, 0xFF, 0x57, 0x00, 0x35, 0x00, 0xD6, 0xFF,
+  0x55, 0x00, 0x36, 0x00, 0xD6, 0xFF, 0x55, 0x00, 0x37, 0x00, 0xD7, 0xFF, 0x53, 0x00, 0x38, 0x00,
+  0xD8, 0xFF, 0x51, 0x00, 0x39, 0x00, 0xD9, 0xFF, 0x4F, 0x00, 0x3A, 0x00, 0xDA, 0xFF, 0x4D, 0x00,
+  0x3B, 0x00, 0xDB, 0xFF, 0x4B, 0x00, 0x3C, 0x00, 0xDC, 0xFF, 0x49, 0x00, 0x3D, 0x00, 0xDD, 0xFF,
+  0x47, 0x00, 0x3E, 0x00, 0xDE, 0xFF, 0x45, 0x00, 0x3F, 0x00, 0xDF, 0xFF, 0x43, 0x00, 0x40, 0x00,
+  0xE1, 0xFF, 0x3F, 0x00, 0x41, 0x00, 0xE2, 0xFF, 0x3D, 0x00, 0x42, 0x00, 0xE4, 0xFF, 0x39, 0x00,
+  0x43, 0x00, 0xE5, 0xFF, 0x37, 0x00, 0x44, 0x00, 0xE7, 0xFF, 0x33, 0x00, 0x45, 0x00, 0xE8, 0xFF,
+  0x31, 0x00, 0x46, 0x00, 0xEA, 0xFF, 0x2D, 0x00, 0x47, 0x00, 0xED, 0xFF, 0x27, 0x00, 0x48, 0x00,
+  0xEF, 0xFF, 0x23, 0x00, 0x49, 0x00, 0xF2, 0xFF, 0x1D, 0x00, 0x4A, 0x00, 0xF6, 0xFF, 0x15, 0x00,
+  0x4B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xB5, 0xFF, 0x00, 0x00, 0x01, 0x00, 0xB6, 0xFF,
+  0xF6, 0xFF, 0x15, 0x00, 0xB7, 0xFF, 0xF2, 0xFF, 0x1D, 0x00, 0xB8, 0xFF, 0xEF, 0xFF, 0x23, 0x00,
+  0xB9, 0xFF, 0xED, 0xFF, 0x27, 0x00, 0xBA, 0xFF, 0xEA, 0xFF, 0x2D, 0x00, 0xBB, 0xFF, 0xE8, 0xFF,
+  0x31, 0x00, 0xBC, 0xFF, 0xE7, 0xFF, 0x33, 0x00, 0xBD, 0xFF, 0xE5, 0xFF, 0x37, 0x00, 0xBE, 0xFF,
+  0xE4, 0xFF, 0x39, 0x00, 0xBF, 0xFF, 0xE2, 0xFF, 0x3D, 0x00, 0xC0, 0xFF, 0xE1, 0xFF, 0x3F, 0x00,
+  0xC1, 0xFF, 0xDF, 0xFF, 0x43, 0x00, 0xC2, 0xFF, 0xDE, 0xFF, 0x45, 0x00, 0xC3, 0xFF, 0xDD, 0xFF,
+  0x47, 0x00, 0xC4, 0xFF, 0xDC, 0xFF, 0x49, 0x00, 0xC5, 0xFF, 0xDB, 0xFF, 0x4B, 0x00, 0xC6, 0xFF,
+  0xDA, 0xFF, 0x4D, 0x00, 0xC7, 0xFF, 0xD9, 0xFF, 0x4F, 0x00, 0xC8, 0xFF, 0xD8, 0xFF, 0x51, 0x00,
+  0xC9, 0xFF, 0xD7, 0xFF, 0x53, 0x00, 0xCA, 0xFF, 0xD6, 0xFF, 0x55, 0x00, 0xCB, 0xFF, 0xD6, 0xFF,
+  0x55, 0x00, 0xCC, 0xFF, 0xD5, 0xFF, 0x57, 0x00, 0xCD, 0xFF, 0xD4, 0xFF, 0x59, 0x00, 0xCE, 0xFF,
+  0xD3, 0xFF, 0x5B, 0x00, 0xCF, 0xFF, 0xD3, 0xFF, 0x5B, 0x00, 0xD0, 0xFF, 0xD2, 0xFF, 0x5D, 0x00,
+  0xD1, 0xFF, 0xD1, 0xFF, 0x5F, 0x00, 0xD2, 0xFF, 0xD1, 0xFF, 0x5F, 0x00, 0xD3, 0xFF, 0xD0, 0xFF,
+  0x61, 0x00, 0xD4, 0xFF, 0xCF, 0xFF, 0x63, 0x00, 0xD5, 0xFF, 0xCF, 0xFF, 0x63, 0x00, 0xD6, 0xFF,
+  0xCE, 0xFF, 0x65, 0x00, 0xD7, 0xFF, 0xCE, 0xFF, 0x65, 0x00, 0xD8, 0xFF, 0xCD, 0xFF, 0x67, 0x00,
+  0xD9, 0xFF, 0xCD, 0xFF, 0x67, 0x00, 0xDA, 0xFF, 0xCC, 0xFF, 0x69, 0x00, 0xDB, 0xFF, 0xCC, 0xFF,
+  0x69, 0x00, 0xDC, 0xFF, 0xCB, 0xFF, 0x6B, 0x00, 0xDD, 0xFF, 0xCB, 0xFF, 0x6B, 0x00, 0xDE, 0xFF,
+  0xCB, 0xFF, 0x6B, 0x00, 0xDF, 0xFF, 0xCA, 0xFF, 0x6D, 0x00, 0xE0, 0xFF, 0xCA, 0xFF, 0x6D, 0x00,
+  0xE1, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xE2, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xE3, 0xFF, 0xC9, 0xFF,
+  0x6F, 0x00, 0xE4, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xE5, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xE6, 0xFF,
+  0xC8, 0xFF, 0x71, 0x00, 0xE7, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xE8, 0xFF, 0xC7, 0xFF, 0x73, 0x00,
+  0xE9, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xEA, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xEB, 0xFF, 0xC6, 0xFF,
+  0x75, 0x00, 0xEC, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xED, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xEE, 0xFF,
+  0xC6, 0xFF, 0x75, 0x00, 0xEF, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xF0, 0xFF, 0xC5, 0xFF, 0x77, 0x00,
+  0xF1, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF2, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF3, 0xFF, 0xC5, 0xFF,
+  0x77, 0x00, 0xF4, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF5, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF6, 0xFF,
+  0xC5, 0xFF, 0x77, 0x00, 0xF7, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xF8, 0xFF, 0xC4, 0xFF, 0x79, 0x00,
+  0xF9, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFA, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFB, 0xFF, 0xC4, 0xFF,
+  0x79, 0x00, 0xFC, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFD, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0xFE, 0xFF,
+  0xC4, 0xFF, 0x79, 0x00, 0xFF, 0xFF, 0xC4, 0xFF, 0x79, 0x00, 0x00, 0x00, 0xC4, 0xFF, 0x79, 0x00,
+  0x01, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x02, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x03, 0x00, 0xC4, 0xFF,
+  0x79, 0x00, 0x04, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x05, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x06, 0x00,
+  0xC4, 0xFF, 0x79, 0x00, 0x07, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x08, 0x00, 0xC4, 0xFF, 0x79, 0x00,
+  0x09, 0x00, 0xC4, 0xFF, 0x79, 0x00, 0x0A, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x0B, 0x00, 0xC5, 0xFF,
+  0x77, 0x00, 0x0C, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x0D, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x0E, 0x00,
+  0xC5, 0xFF, 0x77, 0x00, 0x0F, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x10, 0x00, 0xC5, 0xFF, 0x77, 0x00,
+  0x11, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x12, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x13, 0x00, 0xC6, 0xFF,
+  0x75, 0x00, 0x14, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x15, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x16, 0x00,
+  0xC7, 0xFF, 0x73, 0x00, 0x17, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x18, 0x00, 0xC7, 0xFF, 0x73, 0x00,
+  0x19, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x1A, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x1B, 0x00, 0xC8, 0xFF,
+  0x71, 0x00, 0x1C, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x1D, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x1E, 0x00,
+  0xC9, 0xFF, 0x6F, 0x00, 0x1F, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x20, 0x00, 0xCA, 0xFF, 0x6D, 0x00,
+  0x21, 0x00, 0xCA, 0xFF, 0x6D, 0x00, 0x22, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x23, 0x00, 0xCB, 0xFF,
+  0x6B, 0x00, 0x24, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x25, 0x00, 0xCC, 0xFF, 0x69, 0x00, 0x26, 0x00,
+  0xCC, 0xFF, 0x69, 0x00, 0x27, 0x00, 0xCD, 0xFF, 0x67, 0x00, 0x28, 0x00, 0xCD, 0xFF, 0x67, 0x00,
+  0x29, 0x00, 0xCE, 0xFF, 0x65, 0x00, 0x2A, 0x00, 0xCE, 0xFF, 0x65, 0x00, 0x2B, 0x00, 0xCF, 0xFF,
+  0x63, 0x00, 0x2C, 0x00, 0xCF, 0xFF, 0x63, 0x00, 0x2D, 0x00, 0xD0, 0xFF, 0x61, 0x00, 0x2E, 0x00,
+  0xD1, 0xFF, 0x5F, 0x00, 0x2F, 0x00, 0xD1, 0xFF, 0x5F, 0x00, 0x30, 0x00, 0xD2, 0xFF, 0x5D, 0x00,
+  0x31, 0x00, 0xD3, 0xFF, 0x5B, 0x00, 0x32, 0x00, 0xD3, 0xFF, 0x5B, 0x00, 0x33, 0x00, 0xD4, 0xFF,
+  0x59, 0x00, 0x34, 0x00, 0xD5, 0xFF, 0x57, 0x00, 0x35, 0x00, 0xD6, 0xFF, 0x55, 0x00, 0x36, 0x00,
+  0xD6, 0xFF, 0x55, 0x00, 0x37, 0x00, 0xD7, 0xFF, 0x53, 0x00, 0x38, 0x00, 0xD8, 0xFF, 0x51, 0x00,
+  0x39, 0x00, 0xD9, 0xFF, 0x4F, 0x00, 0x3A, 0x00, 0xDA, 0xFF, 0x4D, 0x00, 0x3B, 0x00, 0xDB, 0xFF,
+  0x4B, 0x00, 0x3C, 0x00, 0xDC, 0xFF, 0x49, 0x00, 0x3D, 0x00, 0xDD, 0xFF, 0x47, 0x00, 0x3E, 0x00,
+  0xDE, 0xFF, 0x45, 0x00, 0x3F, 0x00, 0xDF, 0xFF, 0x43, 0x00, 0x40, 0x00, 0xE1, 0xFF, 0x3F, 0x00,
+  0x41, 0x00, 0xE2, 0xFF, 0x3D, 0x00, 0x42, 0x00, 0xE4, 0xFF, 0x39, 0x00, 0x43, 0x00, 0xE5, 0xFF,
+  0x37, 0x00, 0x44, 0x00, 0xE7, 0xFF, 0x33, 0x00, 0x45, 0x00, 0xE8, 0xFF, 0x31, 0x00, 0x46, 0x00,
+  0xEA, 0xFF, 0x2D, 0x00, 0x47, 0x00, 0xED, 0xFF, 0x27, 0x00, 0x48, 0x00, 0xEF, 0xFF, 0x23, 0x00,
+  0x49, 0x00, 0xF2, 0xFF, 0x1D, 0x00, 0x4A, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x4B, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0xB6, 0xFF, 0x00, 0x00, 0x01, 0x00, 0xB7, 0xFF, 0xF6, 0xFF, 0x15, 0x00,
+  0xB8, 0xFF, 0xF2, 0xFF, 0x1D, 0x00, 0xB9, 0xFF, 0xEF, 0xFF, 0x23, 0x00, 0xBA, 0xFF, 0xED, 0xFF,
+  0x27, 0x00, 0xBB, 0xFF, 0xEB, 0xFF, 0x2B, 0x00, 0xBC, 0xFF, 0xE9, 0xFF, 0x2F, 0x00, 0xBD, 0xFF,
+  0xE7, 0xFF, 0x33, 0x00, 0xBE, 0xFF, 0xE5, 0xFF, 0x37, 0x00, 0xBF, 0xFF, 0xE4, 0xFF, 0x39, 0x00,
+  0xC0, 0xFF, 0xE2, 0xFF, 0x3D, 0x00, 0xC1, 0xFF, 0xE1, 0xFF, 0x3F, 0x00, 0xC2, 0xFF, 0xE0, 0xFF,
+  0x41, 0x00, 0xC3, 0xFF, 0xDF, 0xFF, 0x43, 0x00, 0xC4, 0xFF, 0xDD, 0xFF, 0x47, 0x00, 0xC5, 0xFF,
+  0xDC, 0xFF, 0x49, 0x00, 0xC6, 0xFF, 0xDB, 0xFF, 0x4B, 0x00, 0xC7, 0xFF, 0xDA, 0xFF, 0x4D, 0x00,
+  0xC8, 0xFF, 0xD9, 0xFF, 0x4F, 0x00, 0xC9, 0xFF, 0xD9, 0xFF, 0x4F, 0x00, 0xCA, 0xFF, 0xD8, 0xFF,
+  0x51, 0x00, 0xCB, 0xFF, 0xD7, 0xFF, 0x53, 0x00, 0xCC, 0xFF, 0xD6, 0xFF, 0x55, 0x00, 0xCD, 0xFF,
+  0xD5, 0xFF, 0x57, 0x00, 0xCE, 0xFF, 0xD5, 0xFF, 0x57, 0x00, 0xCF, 0xFF, 0xD4, 0xFF, 0x59, 0x00,
+  0xD0, 0xFF, 0xD3, 0xFF, 0x5B, 0x00, 0xD1, 0xFF, 0xD2, 0xFF, 0x5D, 0x00, 0xD2, 0xFF, 0xD2, 0xFF,
+  0x5D, 0x00, 0xD3, 0xFF, 0xD1, 0xFF, 0x5F, 0x00, 0xD4, 0xFF, 0xD1, 0xFF, 0x5F, 0x00, 0xD5, 0xFF,
+  0xD0, 0xFF, 0x61, 0x00, 0xD6, 0xFF, 0xCF, 0xFF, 0x63, 0x00, 0xD7, 0xFF, 0xCF, 0xFF, 0x63, 0x00,
+  0xD8, 0xFF, 0xCE, 0xFF, 0x65, 0x00, 0xD9, 0xFF, 0xCE, 0xFF, 0x65, 0x00, 0xDA, 0xFF, 0xCD, 0xFF,
+  0x67, 0x00, 0xDB, 0xFF, 0xCD, 0xFF, 0x67, 0x00, 0xDC, 0xFF, 0xCC, 0xFF, 0x69, 0x00, 0xDD, 0xFF,
+  0xCC, 0xFF, 0x69, 0x00, 0xDE, 0xFF, 0xCC, 0xFF, 0x69, 0x00, 0xDF, 0xFF, 0xCB, 0xFF, 0x6B, 0x00,
+  0xE0, 0xFF, 0xCB, 0xFF, 0x6B, 0x00, 0xE1, 0xFF, 0xCA, 0xFF, 0x6D, 0x00, 0xE2, 0xFF, 0xCA, 0xFF,
+  0x6D, 0x00, 0xE3, 0xFF, 0xCA, 0xFF, 0x6D, 0x00, 0xE4, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xE5, 0xFF,
+  0xC9, 0xFF, 0x6F, 0x00, 0xE6, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xE7, 0xFF, 0xC8, 0xFF, 0x71, 0x00,
+  0xE8, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xE9, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xEA, 0xFF, 0xC8, 0xFF,
+  0x71, 0x00, 0xEB, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xEC, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xED, 0xFF,
+  0xC7, 0xFF, 0x73, 0x00, 0xEE, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xEF, 0xFF, 0xC7, 0xFF, 0x73, 0x00,
+  0xF0, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xF1, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xF2, 0xFF, 0xC6, 0xFF,
+  0x75, 0x00, 0xF3, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xF4, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xF5, 0xFF,
+  0xC6, 0xFF, 0x75, 0x00, 0xF6, 0xFF, 0xC6, 0xFF, 0x75, 0x00, 0xF7, 0xFF, 0xC5, 0xFF, 0x77, 0x00,
+  0xF8, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xF9, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xFA, 0xFF, 0xC5, 0xFF,
+  0x77, 0x00, 0xFB, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xFC, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xFD, 0xFF,
+  0xC5, 0xFF, 0x77, 0x00, 0xFE, 0xFF, 0xC5, 0xFF, 0x77, 0x00, 0xFF, 0xFF, 0xC5, 0xFF, 0x77, 0x00,
+  0x00, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x01, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x02, 0x00, 0xC5, 0xFF,
+  0x77, 0x00, 0x03, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x04, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x05, 0x00,
+  0xC5, 0xFF, 0x77, 0x00, 0x06, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x07, 0x00, 0xC5, 0xFF, 0x77, 0x00,
+  0x08, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x09, 0x00, 0xC5, 0xFF, 0x77, 0x00, 0x0A, 0x00, 0xC6, 0xFF,
+  0x75, 0x00, 0x0B, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x0C, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x0D, 0x00,
+  0xC6, 0xFF, 0x75, 0x00, 0x0E, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x0F, 0x00, 0xC6, 0xFF, 0x75, 0x00,
+  0x10, 0x00, 0xC6, 0xFF, 0x75, 0x00, 0x11, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x12, 0x00, 0xC7, 0xFF,
+  0x73, 0x00, 0x13, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x14, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x15, 0x00,
+  0xC7, 0xFF, 0x73, 0x00, 0x16, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x17, 0x00, 0xC8, 0xFF, 0x71, 0x00,
+  0x18, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x19, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x1A, 0x00, 0xC9, 0xFF,
+  0x6F, 0x00, 0x1B, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x1C, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x1D, 0x00,
+  0xCA, 0xFF, 0x6D, 0x00, 0x1E, 0x00, 0xCA, 0xFF, 0x6D, 0x00, 0x1F, 0x00, 0xCA, 0xFF, 0x6D, 0x00,
+  0x20, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x21, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x22, 0x00, 0xCC, 0xFF,
+  0x69, 0x00, 0x23, 0x00, 0xCC, 0xFF, 0x69, 0x00, 0x24, 0x00, 0xCC, 0xFF, 0x69, 0x00, 0x25, 0x00,
+  0xCD, 0xFF, 0x67, 0x00, 0x26, 0x00, 0xCD, 0xFF, 0x67, 0x00, 0x27, 0x00, 0xCE, 0xFF, 0x65, 0x00,
+  0x28, 0x00, 0xCE, 0xFF, 0x65, 0x00, 0x29, 0x00, 0xCF, 0xFF, 0x63, 0x00, 0x2A, 0x00, 0xCF, 0xFF,
+  0x63, 0x00, 0x2B, 0x00, 0xD0, 0xFF, 0x61, 0x00, 0x2C, 0x00, 0xD1, 0xFF, 0x5F, 0x00, 0x2D, 0x00,
+  0xD1, 0xFF, 0x5F, 0x00, 0x2E, 0x00, 0xD2, 0xFF, 0x5D, 0x00, 0x2F, 0x00, 0xD2, 0xFF, 0x5D, 0x00,
+  0x30, 0x00, 0xD3, 0xFF, 0x5B, 0x00, 0x31, 0x00, 0xD4, 0xFF, 0x59, 0x00, 0x32, 0x00, 0xD5, 0xFF,
+  0x57, 0x00, 0x33, 0x00, 0xD5, 0xFF, 0x57, 0x00, 0x34, 0x00, 0xD6, 0xFF, 0x55, 0x00, 0x35, 0x00,
+  0xD7, 0xFF, 0x53, 0x00, 0x36, 0x00, 0xD8, 0xFF, 0x51, 0x00, 0x37, 0x00, 0xD9, 0xFF, 0x4F, 0x00,
+  0x38, 0x00, 0xD9, 0xFF, 0x4F, 0x00, 0x39, 0x00, 0xDA, 0xFF, 0x4D, 0x00, 0x3A, 0x00, 0xDB, 0xFF,
+  0x4B, 0x00, 0x3B, 0x00, 0xDC, 0xFF, 0x49, 0x00, 0x3C, 0x00, 0xDD, 0xFF, 0x47, 0x00, 0x3D, 0x00,
+  0xDF, 0xFF, 0x43, 0x00, 0x3E, 0x00, 0xE0, 0xFF, 0x41, 0x00, 0x3F, 0x00, 0xE1, 0xFF, 0x3F, 0x00,
+  0x40, 0x00, 0xE2, 0xFF, 0x3D, 0x00, 0x41, 0x00, 0xE4, 0xFF, 0x39, 0x00, 0x42, 0x00, 0xE5, 0xFF,
+  0x37, 0x00, 0x43, 0x00, 0xE7, 0xFF, 0x33, 0x00, 0x44, 0x00, 0xE9, 0xFF, 0x2F, 0x00, 0x45, 0x00,
+  0xEB, 0xFF, 0x2B, 0x00, 0x46, 0x00, 0xED, 0xFF, 0x27, 0x00, 0x47, 0x00, 0xEF, 0xFF, 0x23, 0x00,
+  0x48, 0x00, 0xF2, 0xFF, 0x1D, 0x00, 0x49, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x4A, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0xB8, 0xFF, 0x00, 0x00, 0x01, 0x00, 0xB9, 0xFF, 0xF7, 0xFF, 0x13, 0x00,
+  0xBA, 0xFF, 0xF3, 0xFF, 0x1B, 0x00, 0xBB, 0xFF, 0xF0, 0xFF, 0x21, 0x00, 0xBC, 0xFF, 0xED, 0xFF,
+  0x27, 0x00, 0xBD, 0xFF, 0xEB, 0xFF, 0x2B, 0x00, 0xBE, 0xFF, 0xE9, 0xFF, 0x2F, 0x00, 0xBF, 0xFF,
+  0xE7, 0xFF, 0x33, 0x00, 0xC0, 0xFF, 0xE6, 0xFF, 0x35, 0x00, 0xC1, 0xFF, 0xE4, 0xFF, 0x39, 0x00,
+  0xC2, 0xFF, 0xE3, 0xFF, 0x3B, 0x00, 0xC3, 0xFF, 0xE2, 0xFF, 0x3D, 0x00, 0xC4, 0xFF, 0xE0, 0xFF,
+  0x41, 0x00, 0xC5, 0xFF, 0xDF, 0xFF, 0x43, 0x00, 0xC6, 0xFF, 0xDE, 0xFF, 0x45, 0x00, 0xC7, 0xFF,
+  0xDD, 0xFF, 0x47, 0x00, 0xC8, 0xFF, 0xDC, 0xFF, 0x49, 0x00, 0xC9, 0xFF, 0xDB, 0xFF, 0x4B, 0x00,
+  0xCA, 0xFF, 0xDA, 0xFF, 0x4D, 0x00, 0xCB, 0xFF, 0xD9, 0xFF, 0x4F, 0x00, 0xCC, 0xFF, 0xD9, 0xFF,
+  0x4F, 0x00, 0xCD, 0xFF, 0xD8, 0xFF, 0x51, 0x00, 0xCE, 0xFF, 0xD7, 0xFF, 0x53, 0x00, 0xCF, 0xFF,
+  0xD6, 0xFF, 0x55, 0x00, 0xD0, 0xFF, 0xD6, 0xFF, 0x55, 0x00, 0xD1, 0xFF, 0xD5, 0xFF, 0x57, 0x00,
+  0xD2, 0xFF, 0xD4, 0xFF, 0x59, 0x00, 0xD3, 0xFF, 0xD4, 0xFF, 0x59, 0x00, 0xD4, 0xFF, 0xD3, 0xFF,
+  0x5B, 0x00, 0xD5, 0xFF, 0xD2, 0xFF, 0x5D, 0x00, 0xD6, 0xFF, 0xD2, 0xFF, 0x5D, 0x00, 0xD7, 0xFF,
+  0xD1, 0xFF, 0x5F, 0x00, 0xD8, 0xFF, 0xD1, 0xFF, 0x5F, 0x00, 0xD9, 0xFF, 0xD0, 0xFF, 0x61, 0x00,
+  0xDA, 0xFF, 0xD0, 0xFF, 0x61, 0x00, 0xDB, 0xFF, 0xCF, 0xFF, 0x63, 0x00, 0xDC, 0xFF, 0xCF, 0xFF,
+  0x63, 0x00, 0xDD, 0xFF, 0xCE, 0xFF, 0x65, 0x00, 0xDE, 0xFF, 0xCE, 0xFF, 0x65, 0x00, 0xDF, 0xFF,
+  0xCD, 0xFF, 0x67, 0x00, 0xE0, 0xFF, 0xCD, 0xFF, 0x67, 0x00, 0xE1, 0xFF, 0xCD, 0xFF, 0x67, 0x00,
+  0xE2, 0xFF, 0xCC, 0xFF, 0x69, 0x00, 0xE3, 0xFF, 0xCC, 0xFF, 0x69, 0x00, 0xE4, 0xFF, 0xCB, 0xFF,
+  0x6B, 0x00, 0xE5, 0xFF, 0xCB, 0xFF, 0x6B, 0x00, 0xE6, 0xFF, 0xCB, 0xFF, 0x6B, 0x00, 0xE7, 0xFF,
+  0xCB, 0xFF, 0x6B, 0x00, 0xE8, 0xFF, 0xCA, 0xFF, 0x6D, 0x00, 0xE9, 0xFF, 0xCA, 0xFF, 0x6D, 0x00,
+  0xEA, 0xFF, 0xCA, 0xFF, 0x6D, 0x00, 0xEB, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xEC, 0xFF, 0xC9, 0xFF,
+  0x6F, 0x00, 0xED, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xEE, 0xFF, 0xC9, 0xFF, 0x6F, 0x00, 0xEF, 0xFF,
+  0xC9, 0xFF, 0x6F, 0x00, 0xF0, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xF1, 0xFF, 0xC8, 0xFF, 0x71, 0x00,
+  0xF2, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xF3, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xF4, 0xFF, 0xC8, 0xFF,
+  0x71, 0x00, 0xF5, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xF6, 0xFF, 0xC8, 0xFF, 0x71, 0x00, 0xF7, 0xFF,
+  0xC7, 0xFF, 0x73, 0x00, 0xF8, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xF9, 0xFF, 0xC7, 0xFF, 0x73, 0x00,
+  0xFA, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xFB, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xFC, 0xFF, 0xC7, 0xFF,
+  0x73, 0x00, 0xFD, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xFE, 0xFF, 0xC7, 0xFF, 0x73, 0x00, 0xFF, 0xFF,
+  0xC7, 0xFF, 0x73, 0x00, 0x00, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x01, 0x00, 0xC7, 0xFF, 0x73, 0x00,
+  0x02, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x03, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x04, 0x00, 0xC7, 0xFF,
+  0x73, 0x00, 0x05, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x06, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x07, 0x00,
+  0xC7, 0xFF, 0x73, 0x00, 0x08, 0x00, 0xC7, 0xFF, 0x73, 0x00, 0x09, 0x00, 0xC7, 0xFF, 0x73, 0x00,
+  0x0A, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x0B, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x0C, 0x00, 0xC8, 0xFF,
+  0x71, 0x00, 0x0D, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x0E, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x0F, 0x00,
+  0xC8, 0xFF, 0x71, 0x00, 0x10, 0x00, 0xC8, 0xFF, 0x71, 0x00, 0x11, 0x00, 0xC9, 0xFF, 0x6F, 0x00,
+  0x12, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x13, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x14, 0x00, 0xC9, 0xFF,
+  0x6F, 0x00, 0x15, 0x00, 0xC9, 0xFF, 0x6F, 0x00, 0x16, 0x00, 0xCA, 0xFF, 0x6D, 0x00, 0x17, 0x00,
+  0xCA, 0xFF, 0x6D, 0x00, 0x18, 0x00, 0xCA, 0xFF, 0x6D, 0x00, 0x19, 0x00, 0xCB, 0xFF, 0x6B, 0x00,
+  0x1A, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x1B, 0x00, 0xCB, 0xFF, 0x6B, 0x00, 0x1C, 0x00, 0xCB, 0xFF,
+  0x6B, 0x00, 0x1D, 0x00, 0xCC, 0xFF, 0x69, 0x00, 0x1E, 0x00, 0xCC, 0xFF, 0x69, 0x00, 0x1F, 0x00,
+  0xCD, 0xFF, 0x67, 0x00, 0x20, 0x00, 0xCD, 0xFF, 0x67, 0x00, 0x21, 0x00, 0xCD, 0xFF, 0x67, 0x00,
+  0x22, 0x00, 0xCE, 0xFF, 0x65, 0x00, 0x23, 0x00, 0xCE, 0xFF, 0x65, 0x00, 0x24, 0x00, 0xCF, 0xFF,
+  0x63, 0x00, 0x25, 0x00, 0xCF, 0xFF, 0x63, 0x00, 0x26, 0x00, 0xD0, 0xFF, 0x61, 0x00, 0x27, 0x00,
+  0xD0, 0xFF, 0x61, 0x00, 0x28, 0x00, 0xD1, 0xFF, 0x5F, 0x00, 0x29, 0x00, 0xD1, 0xFF, 0x5F, 0x00,
+  0x2A, 0x00, 0xD2, 0xFF, 0x5D, 0x00, 0x2B, 0x00, 0xD2, 0xFF, 0x5D, 0x00, 0x2C, 0x00, 0xD3, 0xFF,
+  0x5B, 0x00, 0x2D, 0x00, 0xD4, 0xFF, 0x59, 0x00, 0x2E, 0x00, 0xD4, 0xFF, 0x59, 0x00, 0x2F, 0x00,
+  0xD5, 0xFF, 0x57, 0x00, 0x30, 0x00, 0xD6, 0xFF, 0x55, 0x00, 0x31, 0x00, 0xD6, 0xFF, 0x55, 0x00,
+  0x32, 0x00, 0xD7, 0xFF, 0x53, 0x00, 0x33, 0x00, 0xD8, 0xFF, 0x51, 0x00, 0x34, 0x00, 0xD9, 0xFF,
+  0x4F, 0x00, 0x35, 0x00, 0xD9, 0xFF, 0x4F, 0x00, 0x36, 0x00, 0xDA, 0xFF, 0x4D, 0x00, 0x37, 0x00,
+  0xDB, 0xFF, 0x4B, 0x00, 0x38, 0x00, 0xDC, 0xFF, 0x49, 0x00, 0x39, 0x00, 0xDD, 0xFF, 0x47, 0x00,
+  0x3A, 0x00, 0xDE, 0xFF, 0x45, 0x00, 0x3B, 0x00, 0xDF, 0xFF, 0x43, 0x00, 0x3C, 0x00, 0xE0, 0xFF,
+  0x41, 0x00, 0x3D, 0x00, 0xE2, 0xFF, 0x3D, 0x00, 0x3E, 0x00, 0xE3, 0xFF, 0x3B, 0x00, 0x3F, 0x00,
+  0xE4, 0xFF, 0x39, 0x00, 0x40, 0x00, 0xE6, 0xFF, 0x35, 0x00, 0x41, 0x00, 0xE7, 0xFF, 0x33, 0x00,
+  0x42, 0x00, 0xE9, 0xFF, 0x2F, 0x00, 0x43, 0x00, 0xEB, 0xFF, 0x2B, 0x00, 0x44, 0x00, 0xED, 0xFF,
+  0x27, 0x00, 0x45, 0x00, 0xF0, 0xFF, 0x21, 0x00, 0x46, 0x00, 0xF3, 0xFF, 0x1B, 0x00, 0x47, 0x00,
+  0xF7, 0xFF, 0x13, 0x00, 0x48, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xF3, 0xFF, 0x00, 0x00,
+  0x01, 0x00, 0xF4, 0xFF, 0xFC, 0xFF, 0x09, 0x00, 0xF5, 0xFF, 0xFB, 0xFF, 0x0B, 0x00, 0xF6, 0xFF,
+  0xFA, 0xFF, 0x0D, 0x00, 0xF7, 0xFF, 0xF9, 0xFF, 0x0F, 0x00, 0xF8, 0xFF, 0xF8, 0xFF, 0x11, 0x00,
+  0xF9, 0xFF, 0xF8, 0xFF, 0x11, 0x00, 0xFA, 0xFF, 0xF7, 0xFF, 0x13, 0x00, 0xFB, 0xFF, 0xF7, 0xFF,
+  0x13, 0x00, 0xFC, 0xFF, 0xF6, 0xFF, 0x15, 0x00, 0xFD, 0xFF, 0xF6, 0xFF, 0x15, 0x00, 0xFE, 0xFF,
+  0xF6, 0xFF, 0x15, 0x00, 0xFF, 0xFF, 0xF6, 0xFF, 0x15, 0x00, 0x00, 0x00, 0xF6, 0xFF, 0x15, 0x00,
+  0x01, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x02, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x03, 0x00, 0xF6, 0xFF,
+  0x15, 0x00, 0x04, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x05, 0x00, 0xF7, 0xFF, 0x13, 0x00, 0x06, 0x00,
+  0xF7, 0xFF, 0x13, 0x00, 0x07, 0x00, 0xF8, 0xFF, 0x11, 0x00, 0x08, 0x00, 0xF8, 0xFF, 0x11, 0x00,
+  0x09, 0x00, 0xF9, 0xFF, 0x0F, 0x00, 0x0A, 0x00, 0xFA, 0xFF, 0x0D, 0x00, 0x0B, 0x00, 0xFB, 0xFF,
+  0x0B, 0x00, 0x0C, 0x00, 0xFC, 0xFF, 0x09, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0xF3, 0xFF, 0x00, 0x00, 0x01, 0x00, 0xF4, 0xFF, 0xFC, 0xFF, 0x09, 0x00, 0xF5, 0xFF, 0xFB, 0xFF,
+  0x0B, 0x00, 0xF6, 0xFF, 0xFA, 0xFF, 0x0D, 0x00, 0xF7, 0xFF, 0xF9, 0xFF, 0x0F, 0x00, 0xF8, 0xFF,
+  0xF8, 0xFF, 0x11, 0x00, 0xF9, 0xFF, 0xF8, 0xFF, 0x11, 0x00, 0xFA, 0xFF, 0xF7, 0xFF, 0x13, 0x00,
+  0xFB, 0xFF, 0xF7, 0xFF, 0x13, 0x00, 0xFC, 0xFF, 0xF6, 0xFF, 0x15, 0x00, 0xFD, 0xFF, 0xF6, 0xFF,
+  0x15, 0x00, 0xFE, 0xFF, 0xF6, 0xFF, 0x15, 0x00, 0xFF, 0xFF, 0xF6, 0xFF, 0x15, 0x00, 0x00, 0x00,
+  0xF6, 0xFF, 0x15, 0x00, 0x01, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x02, 0x00, 0xF6, 0xFF, 0x15, 0x00,
+  0x03, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x04, 0x00, 0xF6, 0xFF, 0x15, 0x00, 0x05, 0x00, 0xF7, 0xFF,
+  0x13, 0x00, 0x06, 0x00, 0xF7, 0xFF, 0x13, 0x00, 0x07, 0x00, 0xF8, 0xFF, 0x11, 0x00, 0x08, 0x00,
+  0xF8, 0xFF, 0x11, 0x00, 0x09, 0x00, 0xF9, 0xFF, 0x0F, 0x00, 0x0A, 0x00, 0xFA, 0xFF, 0x0D, 0x00,
+  0x0B, 0x00, 0xFB, 0xFF, 0x0B, 0x00, 0x0C, 0x00, 0xFC, 0xFF, 0x09, 0x00, 0x0D, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0xF4, 0xFF, 0x00, 0x00, 0x01, 0x00, 0xF5, 0xFF, 0xFC, 0xFF, 0x09, 0x00,
+  0xF6, 0xFF, 0xFB, 0xFF, 0x0B, 0x00, 0xF7, 0xFF, 0xFA, 0xFF, 0x0D, 0x00, 0xF8, 0xFF, 0xF9, 0xFF,
+  0x0F, 0x00, 0xF9, 0xFF, 0xF9, 0xFF, 0x0F, 0x00, 0xFA, 0xFF, 0xF8, 0xFF, 0x11, 0x00, 0xFB, 0xFF,
+  0xF8, 0xFF, 0x11, 0x00, 0xFC, 0xFF, 0xF8, 0xFF, 0x11, 0x00, 0xFD, 0xFF, 0xF7, 0xFF, 0x13, 0x00,
+  0xFE, 0xFF, 0xF7, 0xFF, 0x13, 0x00, 0xFF, 0xFF, 0xF7, 0xFF, 0x13, 0x00, 0x00, 0x00, 0xF7, 0xFF,
+  0x13, 0x00, 0x01, 0x00, 0xF7, 0xFF, 0x13, 0x00, 0x02, 0x00, 0xF7, 0xFF, 0x13, 0x00, 0x03, 0x00,
+  0xF7, 0xFF, 0x13, 0x00, 0x04, 0x00, 0xF8, 0xFF, 0x11, 0x00, 0x05, 0x00, 0xF8, 0xFF, 0x11, 0x00,
+  0x06, 0x00, 0xF8, 0xFF, 0x11, 0x00, 0x07, 0x00, 0xF9, 0xFF, 0x0F, 0x00, 0x08, 0x00, 0xF9, 0xFF,
+  0x0F, 0x00, 0x09, 0x00, 0xFA, 0xFF, 0x0D, 0x00, 0x0A, 0x00, 0xFB, 0xFF, 0x0B, 0x00, 0x0B, 0x00,
+  0xFC, 0xFF, 0x09, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xF7, 0xFF, 0x00, 0x00,
+  0x01, 0x00, 0xF8, 0xFF, 0xFD, 0xFF, 0x07, 0x00, 0xF9, 0xFF, 0xFC, 0xFF, 0x09, 0x00, 0xFA, 0xFF,
+  0xFC, 0xFF, 0x09, 0x00, 0xFB, 0xFF, 0xFB, 0xFF, 0x0B, 0x00, 0xFC, 0xFF, 0xFB, 0xFF, 0x0B, 0x00,
+  0xFD, 0xFF, 0xFA, 0xFF, 0x0D, 0x00, 0xFE, 0xFF, 0xFA, 0xFF, 0x0D, 0x00, 0xFF, 0xFF, 0xFA, 0xFF,
+  0x0D, 0x00, 0x00, 0x00, 0xFA, 0xFF, 0x0D, 0x00, 0x01, 0x00, 0xFA, 0xFF, 0x0D, 0x00, 0x02, 0x00,
+  0xFA, 0xFF, 0x0D, 0x00, 0x03, 0x00, 0xFA, 0xFF, 0x0D, 0x00, 0x04, 0x00, 0xFB, 0xFF, 0x0B, 0x00,
+  0x05, 0x00, 0xFB, 0xFF, 0x0B, 0x00, 0x06, 0x00, 0xFC, 0xFF, 0x09, 0x00, 0x07, 0x00, 0xFC, 0xFF,
+  0x09, 0x00, 0x08, 0x00, 0xFD, 0xFF, 0x07, 0x00, 0x09, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0xF8, 0xFF, 0x00, 0x00, 0x01, 0x00, 0xF9, 0xFF, 0xFE, 0xFF, 0x05, 0x00, 0xFA, 0xFF, 0xFD, 0xFF,
+  0x07, 0x00, 0xFB, 0xFF, 0xFC, 0xFF, 0x09, 0x00, 0xFC, 0xFF, 0xFC, 0xFF, 0x09, 0x00, 0xFD, 0xFF,
+  0xFB, 0xFF, 0x0B, 0x00, 0xFE, 0xFF, 0xFB, 0xFF, 0x0B, 0x00, 0xFF, 0xFF, 0xFB, 0xFF, 0x0B, 0x00,
+  0x00, 0x00, 0xFB, 0xFF, 0x0B, 0x00, 0x01, 0x00, 0xFB, 0xFF, 0x0B, 0x00, 0x02, 0x00, 0xFB, 0xFF,
+  0x0B, 0x00, 0x03, 0x00, 0xFB, 0xFF, 0x0B, 0x00, 0x04, 0x00, 0xFC, 0xFF, 0x09, 0x00, 0x05, 0x00,
+  0xFC, 0xFF, 0x09, 0x00, 0x06, 0x00, 0xFD, 0xFF, 0x07, 0x00, 0x07, 0x00, 0xFE, 0xFF, 0x05, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+};
+
+const uint32_t EyeStyleData::DEFAULT_STYLE_SIZE = sizeof(EyeStyleData::DEFAULT_STYLE);
@@ -1,4 +1,7 @@
 #include "EyesAnimation.h"
+#include "BootProfiler.h"
+#include "MathLookup.h"
+#include "MemoryBudget.h"
 
 // Constants for blink state transitions
 static constexpr uint8_t BLINK_HALF_CLOSED_FRAME1 = 1;
@@ -6,84 +9,343 @@ static constexpr uint8_t BLINK_CLOSED_FRAME_START = 2;
 static constexpr uint8_t BLINK_CLOSED_FRAME_END = 5;
 static constexpr uint8_t BLINK_HALF_CLOSED_FRAME2 = 6;
 
+/**
+ * @brief State table
+ * 
+ * Order must match the EyeState enumeration.
+ */
+const EyesAnimation::StateDescriptor EyesAnimation::STATES[NUM_OF_STATES] = {
+  { EyeState::NORMAL,     "normal",     &EyesAnimation::updateTouch,      &EyesAnimation::renderNormal,     &EyesAnimation::idleExpressionMs,     AnimationLoad::IDLE },
+  { EyeState::GAZING,     "gazing",     &EyesAnimation::updateTouch,      &EyesAnimation::renderGazing,     nullptr,                              AnimationLoad::ACTIVE },
+  { EyeState::DIZZY,      "dizzy",      &EyesAnimation::drainTouch,       &EyesAnimation::drawDizzyEyes,    &EyesAnimation::dizzyDurationMs,      AnimationLoad::HEAVY },
+  { EyeState::EXPRESSION, "expression", &EyesAnimation::interruptOnTouch, &EyesAnimation::renderExpression, &EyesAnimation::expressionDurationMs, AnimationLoad::ACTIVE }
+};
+
+/**
+ * @brief Transition table
+ * 
+ * Events with no matching entry for the current state are ignored.
+ */
+const EyesAnimation::Transition EyesAnimation::TRANSITIONS[NUM_OF_TRANSITIONS] = {
+  { EyeState::NORMAL,     EyeEvent::SHAKE,         EyeState::DIZZY,      &EyesAnimation::redrawWhiteEyes },
+  { EyeState::GAZING,     EyeEvent::SHAKE,         EyeState::DIZZY,      &EyesAnimation::redrawWhiteEyes },
+  { EyeState::NORMAL,     EyeEvent::TOUCH_BEGIN,   EyeState::GAZING,     nullptr },
+  { EyeState::GAZING,     EyeEvent::TOUCH_RELEASE, EyeState::NORMAL,     &EyesAnimation::resetEyes },
+  { EyeState::DIZZY,      EyeEvent::TIMEOUT,       EyeState::NORMAL,     nullptr },
+  { EyeState::NORMAL,     EyeEvent::EXPRESSION,    EyeState::EXPRESSION, &EyesAnimation::startExpression },
+  { EyeState::EXPRESSION, EyeEvent::EXPRESSION,    EyeState::EXPRESSION, &EyesAnimation::startExpression },
+  { EyeState::NORMAL,     EyeEvent::TIMEOUT,       EyeState::EXPRESSION, &EyesAnimation::startIdleExpression },
+  { EyeState::EXPRESSION, EyeEvent::TIMEOUT,       EyeState::NORMAL,     &EyesAnimation::resetEyes },
+  { EyeState::EXPRESSION, EyeEvent::TOUCH_BEGIN,   EyeState::GAZING,     &EyesAnimation::resetEyes },
+  { EyeState::EXPRESSION, EyeEvent::SHAKE,         EyeState::DIZZY,      &EyesAnimation::resetEyes },
+  { EyeState::GAZING,     EyeEvent::LONG_PRESS,    EyeState::EXPRESSION, &EyesAnimation::startExpression },
+  { EyeState::NORMAL,     EyeEvent::FLICK,         EyeState::DIZZY,      &EyesAnimation::redrawWhiteEyes },
+  { EyeState::EXPRESSION, EyeEvent::FLICK,         EyeState::DIZZY,      &EyesAnimation::resetEyes },
+  { EyeState::NORMAL,     EyeEvent::STARTLE,       EyeState::EXPRESSION, &EyesAnimation::startExpression },
+  { EyeState::GAZING,     EyeEvent::STARTLE,       EyeState::EXPRESSION, &EyesAnimation::startExpression }
+};
+
 /**
  * @brief Constructor
+ * @param clock Time source shared with the touch handler (default: Arduino millis/micros)
+ * @param mount How the unit is mounted (default: LANDSCAPE)
  */
-EyesAnimation::EyesAnimation() 
-  : leftEye(
-      Eye::EYE_LEFT_X, 
-      Eye::EYE_BASE_Y, 
-      0, 
-      Eye::DISPLAY_BASE_Y,
-      7,
-      0
-    ),
-    rightEye(
-      Eye::EYE_RIGHT_X, 
-      Eye::EYE_BASE_Y, 
-      Eye::SPRITE_WIDTH, 
-      Eye::DISPLAY_BASE_Y,
-      -7,
-      0
-    ),
+EyesAnimation::EyesAnimation(const Clock& clock, MountRotation mount) 
+  : clock(clock),
+    layout(mount),
+    style(),
+    leftEye(layout, style, 0),
+    rightEye(layout, style, 1),
+    touchHandler(clock),
+    inputSampler(clock),
+    audioInput(),
+    inputMode(InputMode::SAMPLED),
+    shakePending(false),
+    displayOutput(true),
     state(EyeState::NORMAL),
-    degree(0.0F),
     blinkCounter(0),
-    blinkMaxCount(BLINK_INITIAL_MAX)
+    blinkMaxCount(BLINK_INITIAL_MAX),
+    frameTime(0),
+    lastFrameTime(0),
+    lastAccelCheckTime(0),
+    lastBlinkTime(0),
+    stateEnteredTime(0),
+    lastSaccadeTime(0),
+    lastSaccade(0, 0),
+    motionStepTime(0),
+    gazeArbiter(),
+    rng(),
+    eyeFrame(),
+    lcdSink(&M5.Display),
+    outputs(),
+    stateStats(),
+    frameTelemetry(),
+    deadline(),
+    frequencyPolicy(),
+    governor(),
+    tunables{ ACCELERATION_THRESHOLD, DIZZY_ROTATION_SPEED, BLINK_RANDOM_MIN, BLINK_RANDOM_MAX,
+              ANIMATION_DELAY_MS, style.getHeader().pupilMarginPercent, 0, IDLE_EXPRESSION_S,
+              PupilMotion::PURSUIT_RATE, TILT_GAZE_PX, GAZE_BLEND_MS, STARTLE_DB },
+    dizzyDurationMs(0),
+    expressions(),
+    expressionPlayer(),
+    pendingExpression(0),
+    expressionDurationMs(0),
+    idleExpressionMs(0),
+    gestureHook(nullptr),
+    gestureContext(nullptr),
+    parameters()
 {
+  gazeArbiter.configure(GazeArbiter::TOUCH, GAZE_TOUCH_PRIORITY, GAZE_TOUCH_EXPIRY_MS);
+  gazeArbiter.configure(GazeArbiter::EXTERNAL, GAZE_EXTERNAL_PRIORITY, GAZE_EXTERNAL_EXPIRY_MS);
+  gazeArbiter.configure(GazeArbiter::TILT, GAZE_TILT_PRIORITY, GAZE_TILT_EXPIRY_MS);
+  registerParameters();
+  applyParameters(this, 0);
+}
+
+/**
+ * @brief Register the tunable settings
+ */
+void EyesAnimation::registerParameters() {
+  parameters.add("accel_threshold_g", &tunables.accelerationThreshold, 1.0F, 4.0F);
+  parameters.add("dizzy_speed_deg", &tunables.dizzyRotationSpeed, 1.0F, 90.0F);
+  parameters.add("blink_min_frames", &tunables.blinkRandomMin, 1, 255);
+  parameters.add("blink_max_frames", &tunables.blinkRandomMax, 1, 255);
+  parameters.add("frame_delay_ms", &tunables.animationDelayMs, 5, 100);
+  parameters.add("pupil_margin_pct", &tunables.pupilMarginPercent, 10, 100);
+  parameters.add("display_delay_us", &tunables.displayDelayMicros, 0, 50000);
+  parameters.add("idle_expression_s", &tunables.idleExpressionSeconds, 0, 255);
+  parameters.add("pursuit_rate", &tunables.pursuitRate, 5.0F, 100.0F);
+  parameters.add("tilt_gaze_px", &tunables.tiltGazePx, 0, 1000);
+  parameters.add("gaze_blend_ms", &tunables.gazeBlendMs, 0, 2000);
+  parameters.add("startle_db", &tunables.startleDb, 3, LoudnessDetector::MAX_THRESHOLD_DB);
+  parameters.setChangeHook(applyParameters, this);
+}
+
+/**
+ * @brief Derive dependent values after a parameter write
+ * @param context Animation instance
+ * @param id Parameter ID
+ */
+void EyesAnimation::applyParameters(void* context, uint8_t id) {
+  EyesAnimation* self = static_cast<EyesAnimation*>(context);
+  Tunables& tunables = self->tunables;
+  
+  // Keep the blink interval range non-empty
+  if (tunables.blinkRandomMax < tunables.blinkRandomMin) {
+    tunables.blinkRandomMax = tunables.blinkRandomMin;
+  }
+  
+  // The dizzy state lasts for the whole rotation
+  self->dizzyDurationMs =
+    static_cast<uint32_t>(DIZZY_TOTAL_DEGREES / tunables.dizzyRotationSpeed) * tunables.animationDelayMs;
+  
+  // The normal state times out into an idle expression, or never
+  self->idleExpressionMs = (tunables.idleExpressionSeconds > 0) ? tunables.idleExpressionSeconds * 1000U : UINT32_MAX;
+  
+  self->leftEye.setPupilMargin(tunables.pupilMarginPercent);
+  self->rightEye.setPupilMargin(tunables.pupilMarginPercent);
+  self->leftEye.setPursuitRate(tunables.pursuitRate);
+  self->rightEye.setPursuitRate(tunables.pursuitRate);
+  self->gazeArbiter.setBlendTime(tunables.gazeBlendMs);
+  self->audioInput.setThresholdDb(tunables.startleDb);
 }
 
 /**
  * @brief Initialization process
+ * @param inputMode Where input comes from (default: SAMPLED)
  * @return Whether initialization was successful
  */
-bool EyesAnimation::setup() {
+bool EyesAnimation::setup(InputMode inputMode) {
+  this->inputMode = inputMode;
+  
+  // Lookup tables stay in flash, but are tracked for the heap report
+  MemoryBudget::trackStatic(sizeof(FastMath::SIN_TABLE) + sizeof(FastMath::COS_TABLE),
+                            "sin/cos tables");
+  
+  // Prefer a style written to its flash partition over the built-in one
+  if (style.mapPartition()) {
+    tunables.pupilMarginPercent = style.getHeader().pupilMarginPercent;
+    applyParameters(this, 0);
+    if (style.getHeader().scleraRadiusX > Eye::SCLERA_RADIUS_X ||
+        style.getHeader().scleraRadiusY > Eye::SCLERA_RADIUS_Y) {
+      Serial.println("Warning: Eye style is larger than the eye sprites. Its edges will be clipped.");
+    }
+  } else {
+    MemoryBudget::trackStatic(EyeStyleData::DEFAULT_STYLE_SIZE, "eye style (built-in)");
+  }
+  MemoryBudget::trackStatic(expressions.getSize(), "expressions (built-in)");
+  
+  // Eyes cannot be drawn without their sprite buffers
+  if (!leftEye.isReady() || !rightEye.isReady()) {
+    Serial.println("Error: Failed to allocate eye sprites.");
+    return false;
+  }
+  
+  // Every frame goes to the built-in LCD; more panels can be added through getDisplayOutputs()
+  outputs.add("lcd", PanelSink::write, &lcdSink);
+  
+  // Gaze following then costs a table lookup per frame
+  if (GAZE_TABLE_ENABLED &&
+      (!leftEye.enableGazeTable(Eye::GAZE_TABLE_CELL_SHIFT) || !rightEye.enableGazeTable(Eye::GAZE_TABLE_CELL_SHIFT))) {
+    Serial.println("Warning: Failed to allocate gaze tables. Computing gaze positions per frame.");
+  }
+  
   // Initial drawing
   resetEyes();
   
-  // Check IMU initialization
-  float ax, ay, az;
-  if (!M5.Imu.getAccel(&ax, &ay, &az)) {
+  // Fall back to drawing both eyes on this core if the worker cannot start
+  if (PARALLEL_RENDER && !forkJoin.begin()) {
+    Serial.println("Warning: Render worker failed to start. Drawing eyes sequentially.");
+  }
+  
+  // Injected input never touches the hardware
+  if (inputMode == InputMode::INJECTED) {
+    touchHandler.setQueueMode(true);
+    // Scripted runs must draw the same frames however fast the host is
+    deadline.setSheddingAllowed(false);
+    return true;
+  }
+  
+  // The IMU is probed here rather than in M5.begin() so that it does not delay the first frame
+  if (!M5.Imu.isEnabled() && !M5.Imu.begin(&M5.In_I2C, M5.getBoard())) {
     Serial.println("Warning: IMU initialization failed. Dizzy effect may not work.");
   }
   
+  // Start mirroring frames over Serial
+  if (FRAME_STREAM_ENABLED) {
+    // Packets are written whole, so a transmit buffer smaller than a keyframe would skip every keyframe
+    Serial.flush();
+    if (Serial.availableForWrite() < static_cast<int>(FrameStreamer::getMaxPacketBytes(Eye::SPRITE_BYTES))) {
+      Serial.println("Warning: Serial transmit buffer is smaller than a keyframe. Streaming disabled.");
+    } else if (frameStreamer.begin(Serial, FRAME_STREAM_BYTES_PER_SECOND, Eye::SPRITE_BYTES)) {
+      outputs.add("serial mirror", FrameStreamer::write, &frameStreamer);
+    } else {
+      Serial.println("Warning: Failed to allocate frame stream buffers. Streaming disabled.");
+    }
+  }
+  
+  // Lower the CPU clock while the animation is light
+  if (CPU_GOVERNOR_ENABLED) {
+    governor.begin(LoadFrequencyPolicy::decide, &frequencyPolicy);
+  }
+  
+  // Move touch and IMU sampling off the render loop
+  if (!inputSampler.begin(touchHandler)) {
+    Serial.println("Warning: Input sampler failed to start. Polling input from the render loop.");
+  }
+  
+  // Loud sounds are detected on their own task; the frame loop only takes the result
+  if (AUDIO_ENABLED && !audioInput.begin()) {
+    Serial.println("Warning: Microphone failed to start. Startle reactions disabled.");
+  }
+  
   return true;
 }
 
+/**
+ * @brief Draw the prerendered first frame straight to the display
+ */
+void EyesAnimation::showBootFrame() {
+  M5.Display.startWrite();
+  // Eye sprites only cover the scleras, so the surround is drawn here once and never pushed again
+  M5.Display.fillScreen(TFT_BLACK);
+  leftEye.renderBootFrame(&M5.Display);
+  rightEye.renderBootFrame(&M5.Display);
+  M5.Display.endWrite();
+}
+
 /**
  * @brief Main loop process
  */
 void EyesAnimation::loop() {
-  static uint32_t lastFrameTime = 0;
-  static uint32_t lastAccelCheckTime = 0;
-  static bool needsRedraw = true;
-  uint32_t currentTime = millis();
+  frameTime = clock.nowMillis();
   
   // Frame rate control (skip if not enough time has passed since last drawing)
-  if (currentTime - lastFrameTime < ANIMATION_DELAY_MS) {
+  if (frameTime - lastFrameTime < tunables.animationDelayMs) {
     return;
   }
   
-  lastFrameTime = currentTime;
+  uint32_t intervalMs = (frameTelemetry.frames > 0) ? frameTime - lastFrameTime : 0;
+  lastFrameTime = frameTime;
+  uint32_t frameStart = clock.nowMicros();
   
-  // Check accelerometer (30ms interval)
-  if (currentTime - lastAccelCheckTime > 30) {
-    lastAccelCheckTime = currentTime;
+  // Check accelerometer at its own interval
+  if (frameTime - lastAccelCheckTime > ACCEL_CHECK_INTERVAL_MS) {
+    lastAccelCheckTime = frameTime;
     if (checkAccelerationForDizzy()) {
-      needsRedraw = true;
+      dispatch(EyeEvent::SHAKE);
     }
   }
   
-  // Draw pupils according to state (redraw white parts only if necessary)
-  if (needsRedraw) {
-    redrawWhiteEyes();
-    needsRedraw = false;
+  // Loud sounds startle the eyes (dizziness takes precedence)
+  handleStartle();
+  
+  // Leave the current state once its time limit has elapsed
+  uint32_t EyesAnimation::* timeoutMs = STATES[static_cast<uint8_t>(state)].timeoutMs;
+  if (timeoutMs != nullptr && frameTime - stateEnteredTime >= this->*timeoutMs) {
+    dispatch(EyeEvent::TIMEOUT);
   }
   
   updateEyesBasedOnState();
   
   // Display sprites (update both eyes at once)
   renderEyes();
+  
+  // Close the startup timeline once real frames reach the display
+  if (frameTelemetry.frames == 0 && displayOutput) {
+    BootProfiler::mark("first animated frame");
+  }
+  
+  uint32_t frameMicros = clock.nowMicros() - frameStart;
+  uint32_t budgetMicros = tunables.animationDelayMs * 1000U;
+  recordFrameTime(frameMicros);
+  frameTelemetry.lastFrameMicros = frameMicros;
+  frameTelemetry.lastBudgetMicros = budgetMicros;
+  frameTelemetry.lastFrameMhz = governor.getFrequencyMhz();
+  deadline.recordFrame(frameMicros, intervalMs, budgetMicros);
+  governor.update(getLoad(), frameMicros, budgetMicros);
+}
+
+/**
+ * @brief Count a frame in the frame time histogram
+ * @param frameMicros Frame work time
+ */
+void EyesAnimation::recordFrameTime(uint32_t frameMicros) {
+  // Bucket 0 is below 1 ms, then one bucket per power of two milliseconds
+  uint32_t frameMillis = frameMicros / 1000;
+  uint8_t bucket = 0;
+  while (frameMillis > 0 && bucket < FrameTelemetry::HISTOGRAM_BUCKETS - 1) {
+    frameMillis >>= 1;
+    bucket++;
+  }
+  
+  frameTelemetry.frames++;
+  frameTelemetry.histogram[bucket]++;
+  if (frameMicros > frameTelemetry.maxFrameMicros) {
+    frameTelemetry.maxFrameMicros = frameMicros;
+  }
+}
+
+/**
+ * @brief Dispatch an event to the state machine
+ * @param event Event to dispatch
+ */
+void EyesAnimation::dispatch(EyeEvent event) {
+  for (const Transition& transition : TRANSITIONS) {
+    if (transition.from != state || transition.event != event) {
+      continue;
+    }
+    
+    state = transition.to;
+    stateEnteredTime = frameTime;
+    frameTelemetry.transitions++;
+    stateStats[static_cast<uint8_t>(state)].entries++;
+    if (transition.action != nullptr) {
+      (this->*transition.action)();
+    }
+    return;
+  }
 }
 
 /**
@@ -97,71 +359,171 @@ void EyesAnimation::redrawWhiteEyes() {
 }
 
 /**
- * @brief Check accelerometer values and determine whether to start dizzy effect
- * @return true if state changed
+ * @brief Check accelerometer values for a dizzy-inducing shake
+ * @return true if acceleration exceeds the threshold
  */
 bool EyesAnimation::checkAccelerationForDizzy() {
+  if (inputMode == InputMode::INJECTED) {
+    bool shake = shakePending;
+    shakePending = false;
+    return shake;
+  }
+  
+  // Peak since the previous check, so that short taps between checks are not missed
+  if (inputSampler.isRunning()) {
+    float peak;
+    return inputSampler.takePeakAcceleration(peak) && peak > tunables.accelerationThreshold;
+  }
+  
   float ax, ay, az;
   if (M5.Imu.getAccel(&ax, &ay, &az)) {
     float totalAcc = sqrt(ax * ax + ay * ay + az * az);
-    if (totalAcc > ACCELERATION_THRESHOLD && state != EyeState::DIZZY) {
-      state = EyeState::DIZZY;
-      degree = 0.0F;
-      return true;
-    }
+    return totalAcc > tunables.accelerationThreshold;
   }
   return false;
 }
 
 /**
- * @brief Update eyes based on current state
+ * @brief Run update and render hooks of the current state
  */
 void EyesAnimation::updateEyesBasedOnState() {
-  if (state == EyeState::DIZZY) {
-    drawDizzyEyes();
-  } else {
-    handleNormalState();
+  uint32_t startMicros = clock.nowMicros();
+  
+  // Update may dispatch events, so the render hook is looked up afterwards
+  Hook update = STATES[static_cast<uint8_t>(state)].update;
+  if (update != nullptr) {
+    (this->*update)();
+  }
+  
+  const StateDescriptor& descriptor = STATES[static_cast<uint8_t>(state)];
+  if (descriptor.render != nullptr) {
+    (this->*descriptor.render)();
+  }
+  drawQueuedFrame();
+  
+  // Charge the cost to the state that rendered this frame
+  uint32_t elapsedMicros = clock.nowMicros() - startMicros;
+  StateStats& stats = stateStats[static_cast<uint8_t>(descriptor.state)];
+  stats.frames++;
+  stats.totalMicros += elapsedMicros;
+  if (elapsedMicros > stats.maxMicros) {
+    stats.maxMicros = elapsedMicros;
   }
 }
 
 /**
- * @brief Handle normal state eyes
+ * @brief Update hook: dispatch touch events
  */
-void EyesAnimation::handleNormalState() {
-  static TouchState lastTouchState = TouchState::NONE;
-  static uint32_t lastBlinkTime = 0;
-  uint32_t currentTime = millis();
-  
-  // Process touch input
+void EyesAnimation::updateTouch() {
   TouchState touchState = touchHandler.update();
-  
-  // Process only if touch state has changed
-  if (touchState != lastTouchState) {
-    lastTouchState = touchState;
+  if (touchState == TouchState::TOUCHING || touchState == TouchState::MULTI_TOUCH) {
+    dispatch(EyeEvent::TOUCH_BEGIN);
+  } else {
+    dispatch(EyeEvent::TOUCH_RELEASE);
+  }
+  handleGestures(true);
+}
+
+/**
+ * @brief Update hook: let only new touches interrupt (a long press expression plays while held)
+ */
+void EyesAnimation::interruptOnTouch() {
+  touchHandler.update();
+  if (touchHandler.wasBegun()) {
+    dispatch(EyeEvent::TOUCH_BEGIN);
+  }
+  handleGestures(true);
+}
+
+/**
+ * @brief Update hook: consume touch samples without reacting to them
+ */
+void EyesAnimation::drainTouch() {
+  touchHandler.update();
+  handleGestures(false);
+}
+
+/**
+ * @brief Pass gestures to the hook, then react to long presses and flicks
+ * @param react false to only pass them to the hook
+ */
+void EyesAnimation::handleGestures(bool react) {
+  GestureEvent event;
+  while (touchHandler.takeGesture(event)) {
+    if (gestureHook != nullptr) {
+      gestureHook(gestureContext, event);
+    }
+    if (!react) {
+      continue;
+    }
     
-    if (touchState == TouchState::RELEASED) {
-      resetEyes();
-      return;
+    // Flicks come with the release, so the touch state has already gone back to normal
+    if (event.type == GestureType::LONG_PRESS) {
+      int16_t index = (LONG_PRESS_EXPRESSION != nullptr) ? expressions.find(LONG_PRESS_EXPRESSION) : -1;
+      if (index >= 0) {
+        pendingExpression = static_cast<uint8_t>(index);
+        dispatch(EyeEvent::LONG_PRESS);
+      }
+    } else if (event.type == GestureType::FLICK) {
+      dispatch(EyeEvent::FLICK);
     }
   }
-  
-  // Get blink state
-  BlinkState currentBlinkState = determineBlinkState();
-  
+}
+
+/**
+ * @brief React to a sudden loud sound picked up since the previous frame
+ */
+void EyesAnimation::handleStartle() {
+  // Taken in every state, so a sound during dizziness is not played afterwards
+  if (!audioInput.takeStartle()) {
+    return;
+  }
+  int16_t index = (STARTLE_EXPRESSION != nullptr) ? expressions.find(STARTLE_EXPRESSION) : -1;
+  if (index >= 0) {
+    pendingExpression = static_cast<uint8_t>(index);
+    dispatch(EyeEvent::STARTLE);
+  }
+}
+
+/**
+ * @brief Render hook: untouched pupils (external target, tilt or centered) with blinking
+ */
+void EyesAnimation::renderNormal() {
   // Process gaze only when not blinking
-  if (currentBlinkState == BlinkState::OPEN) {
-    // Follow gaze while touching
-    if (touchState == TouchState::TOUCHING) {
-      drawGazingEyes(touchHandler.getTouchPoint());
-    } else {
-      // Center gaze when not touching
-      drawCenterEyes();
-    }
+  if (determineBlinkState() == BlinkState::OPEN) {
+    drawArbitratedEyes(false);
   }
-  
-  // Update blink (50ms interval)
-  if (currentTime - lastBlinkTime >= 50) {
-    lastBlinkTime = currentTime;
+  updateBlink();
+}
+
+/**
+ * @brief Render hook: touch-following pupils with blinking
+ */
+void EyesAnimation::renderGazing() {
+  // Process gaze only when not blinking
+  if (determineBlinkState() == BlinkState::OPEN) {
+    drawArbitratedEyes(true);
+  }
+  updateBlink();
+}
+
+/**
+ * @brief Render hook: keyframed expression pose
+ */
+void EyesAnimation::renderExpression() {
+  // Unchanged poses draw nothing, so held expressions leave the sprites (and the display) alone
+  if (expressionPlayer.advance(frameTime)) {
+    eyeFrame.pupil = PupilAction::EXPRESSION;
+    eyeFrame.pose = expressionPlayer.getPose();
+  }
+}
+
+/**
+ * @brief Update blink at its own interval
+ */
+void EyesAnimation::updateBlink() {
+  if (frameTime - lastBlinkTime >= BLINK_INTERVAL_MS) {
+    lastBlinkTime = frameTime;
     drawBlink();
   }
 }
@@ -170,8 +532,26 @@ void EyesAnimation::handleNormalState() {
  * @brief Render both eyes to display
  */
 void EyesAnimation::renderEyes() {
-  leftEye.render(&M5.Display);
-  rightEye.render(&M5.Display);
+  // Collect changes even while not presenting, so nothing is lost when output resumes
+  outputs.markDirty(0, leftEye.takeDirtyRows());
+  outputs.markDirty(1, rightEye.takeDirtyRows());
+  if (!displayOutput) {
+    return;
+  }
+  
+  if (tunables.displayDelayMicros > 0) {
+    delayMicroseconds(tunables.displayDelayMicros);
+  }
+  
+  // Under load each eye is refreshed every other frame; its changes carry over
+  bool alternate = deadline.isShedding(Degradation::ALTERNATE_PUSH);
+  bool evenFrame = (frameTelemetry.frames & 1) == 0;
+  if (!alternate || evenFrame) {
+    outputs.present(0, leftEye, frameTime);
+  }
+  if (!alternate || !evenFrame) {
+    outputs.present(1, rightEye, frameTime);
+  }
 }
 
 /**
@@ -182,6 +562,203 @@ TouchHandler& EyesAnimation::getTouchHandler() {
   return touchHandler;
 }
 
+/**
+ * @brief Inject a touch sample (INJECTED input mode)
+ * @param sample Touch sample
+ * @return false if the touch queue is full
+ */
+bool EyesAnimation::injectTouch(const TouchSample& sample) {
+  return touchHandler.getQueue().push(sample);
+}
+
+/**
+ * @brief Inject a shake that starts the dizzy effect (INJECTED input mode)
+ */
+void EyesAnimation::injectShake() {
+  shakePending = true;
+}
+
+/**
+ * @brief Set a function receiving every touch gesture, before the built-in reactions
+ * @param hook Gesture receiver (nullptr: none)
+ * @param context Passed to the hook
+ */
+void EyesAnimation::setGestureHook(GestureHook hook, void* context) {
+  gestureHook = hook;
+  gestureContext = context;
+}
+
+/**
+ * @brief Play an expression from the expression library
+ * @param index Expression index
+ * @return false if there is no such expression or the current state does not allow one
+ */
+bool EyesAnimation::playExpression(uint8_t index) {
+  if (index >= expressions.getCount()) {
+    return false;
+  }
+  
+  // The transition action picks it up; states without an EXPRESSION transition ignore the request
+  pendingExpression = index;
+  dispatch(EyeEvent::EXPRESSION);
+  return state == EyeState::EXPRESSION;
+}
+
+/**
+ * @brief Get expression library
+ * @return Library the expressions are played from
+ */
+const ExpressionLibrary& EyesAnimation::getExpressions() const {
+  return expressions;
+}
+
+/**
+ * @brief Enable or disable pushing sprites to the display
+ * @param enabled false to render into the sprites only
+ */
+void EyesAnimation::setDisplayOutput(bool enabled) {
+  displayOutput = enabled;
+}
+
+/**
+ * @brief Get read-only view of an eye sprite
+ * @param index Eye index (0: left, 1: right)
+ * @return Sprite view
+ */
+SpriteView EyesAnimation::getEyeSpriteView(uint8_t index) const {
+  return (index == 0) ? leftEye.getSpriteView() : rightEye.getSpriteView();
+}
+
+/**
+ * @brief Seed the animation random number generator
+ * @param seed Seed value (the same seed reproduces the same animation)
+ */
+void EyesAnimation::setRandomSeed(uint32_t seed) {
+  rng.setSeed(seed);
+}
+
+/**
+ * @brief Get current state
+ * @return Current state
+ */
+EyeState EyesAnimation::getState() const {
+  return state;
+}
+
+/**
+ * @brief Get load implied by the current state
+ * @return Animation load
+ */
+AnimationLoad EyesAnimation::getLoad() const {
+  return STATES[static_cast<uint8_t>(state)].load;
+}
+
+/**
+ * @brief Get cost statistics of a state
+ * @param eyeState State to query
+ * @return Statistics of the state
+ */
+const StateStats& EyesAnimation::getStateStats(EyeState eyeState) const {
+  return stateStats[static_cast<uint8_t>(eyeState)];
+}
+
+/**
+ * @brief Get frame counters
+ * @return Frame counters since startup
+ */
+const FrameTelemetry& EyesAnimation::getFrameTelemetry() const {
+  return frameTelemetry;
+}
+
+/**
+ * @brief Get frame deadline monitor
+ * @return Deadline counters and current degradation level
+ */
+const FrameDeadline& EyesAnimation::getFrameDeadline() const {
+  return deadline;
+}
+
+/**
+ * @brief Get CPU frequency governor
+ * @return Governor (not running with injected input)
+ */
+const CpuGovernor& EyesAnimation::getCpuGovernor() const {
+  return governor;
+}
+
+/**
+ * @brief Get display sinks
+ * @return Outputs receiving eye frames (add extra panels or a memory sink here)
+ */
+DisplayOutputs& EyesAnimation::getDisplayOutputs() {
+  return outputs;
+}
+
+/**
+ * @brief Look at a point sent from outside (e.g. a host-side tracker)
+ * @param target Target in logical screen coordinates
+ */
+void EyesAnimation::lookAt(const Point& target) {
+  GazeTarget external = { target.x, target.y };
+  gazeArbiter.submit(GazeArbiter::EXTERNAL, external, external, clock.nowMillis());
+}
+
+/**
+ * @brief Stop looking at the point sent from outside before it expires
+ */
+void EyesAnimation::stopLooking() {
+  gazeArbiter.withdraw(GazeArbiter::EXTERNAL);
+}
+
+/**
+ * @brief Get gaze arbiter
+ * @return Arbiter
+ */
+GazeArbiter& EyesAnimation::getGazeArbiter() {
+  return gazeArbiter;
+}
+
+/**
+ * @brief Get input sampler
+ * @return Sampler (not running with injected input)
+ */
+InputSampler& EyesAnimation::getInputSampler() {
+  return inputSampler;
+}
+
+/**
+ * @brief Get microphone listener
+ * @return Listener (not running with injected input or AUDIO_ENABLED off)
+ */
+AudioInput& EyesAnimation::getAudioInput() {
+  return audioInput;
+}
+
+/**
+ * @brief Get number of touch samples the input sampler had to drop
+ * @return Dropped sample count
+ */
+uint32_t EyesAnimation::getDroppedTouchSamples() const {
+  return inputSampler.getDroppedTouchSamples();
+}
+
+/**
+ * @brief Get runtime-tunable parameters
+ * @return Parameter registry (read and write it from the loop thread only)
+ */
+ParameterRegistry& EyesAnimation::getParameters() {
+  return parameters;
+}
+
+/**
+ * @brief Get display name of a state
+ * @param eyeState State to query
+ * @return Name of the state
+ */
+const char* EyesAnimation::getStateName(EyeState eyeState) {
+  return STATES[static_cast<uint8_t>(eyeState)].name;
+}
+
 /**
  * @brief Reset eyes
  */
@@ -192,56 +769,215 @@ void EyesAnimation::resetEyes() {
   rightEye.drawWhite();
   leftEye.resetPupil();
   rightEye.resetPupil();
-  state = EyeState::NORMAL;
 }
 
 /**
- * @brief Draw pupils in the center
+ * @brief Queue pupils in the center
  */
 void EyesAnimation::drawCenterEyes() {
-  Point saccades = generateSaccades();
-  leftEye.drawCenterPupil(saccades);
-  rightEye.drawCenterPupil(saccades);
+  eyeFrame.pupil = PupilAction::CENTER;
+  eyeFrame.saccades = generateSaccades();
+  eyeFrame.motionSteps = PupilMotion::takeSteps(frameTime, motionStepTime);
 }
 
 /**
- * @brief Draw gaze-following pupils
- * @param touchPoint Touch coordinates
+ * @brief Queue gaze-following pupils
+ * @param leftTarget Target of the left eye
+ * @param rightTarget Target of the right eye
  */
-void EyesAnimation::drawGazingEyes(const Point& touchPoint) {
-  Point saccades = generateSaccades();
-  leftEye.drawGazingPupil(touchPoint, saccades);
-  rightEye.drawGazingPupil(touchPoint, saccades);
+void EyesAnimation::drawGazingEyes(const Point& leftTarget, const Point& rightTarget) {
+  eyeFrame.pupil = PupilAction::GAZING;
+  eyeFrame.targets[0] = leftTarget;
+  eyeFrame.targets[1] = rightTarget;
+  eyeFrame.saccades = generateSaccades();
+  eyeFrame.motionSteps = PupilMotion::takeSteps(frameTime, motionStepTime);
 }
 
 /**
- * @brief Draw dizzy effect pupils
+ * @brief Pick the touch point an eye follows
+ * @param touch Touch handler holding the points
+ * @param eye Eye to pick a target for
+ * @param policy How to pick among several points (GAZE_POLICY in the animation)
+ * @return Target point
  */
-void EyesAnimation::drawDizzyEyes() {
-  // Use different angle offsets for left and right eyes
-  leftEye.drawDizzyPupil(degree);
-  rightEye.drawDizzyPupil(degree, 180.0F);
+Point EyesAnimation::selectGazeTarget(const TouchHandler& touch, const Eye& eye, GazePolicy policy) const {
+  // Touch points are reported in panel coordinates, eyes are placed in logical ones
+  uint8_t count = touch.getTouchCount();
+  if (count <= 1) {
+    return layout.toLogical(touch.getTouchPoint());
+  }
+  
+  if (policy == GazePolicy::CENTROID) {
+    return layout.toLogical(touch.getCentroid());
+  }
   
-  // Progress and end determination of dizzy effect
-  degree += DIZZY_ROTATION_SPEED;
+  // Nearest touch point by squared distance
+  const Point& base = eye.getBasePoint();
+  uint8_t nearest = 0;
+  int32_t nearestDistance = INT32_MAX;
+  for (uint8_t i = 0; i < count; i++) {
+    Point diff = layout.toLogical(touch.getTouchPoint(i)) - base;
+    int32_t distance = static_cast<int32_t>(diff.x) * diff.x + static_cast<int32_t>(diff.y) * diff.y;
+    if (distance < nearestDistance) {
+      nearestDistance = distance;
+      nearest = i;
+    }
+  }
+  return layout.toLogical(touch.getTouchPoint(nearest));
+}
+
+/**
+ * @brief Get how far untouched eyes look downhill
+ * @param offset Receives the gaze target relative to each eye, in logical axes
+ * @return false if tilt gaze is off or there is no tilt estimate
+ */
+bool EyesAnimation::selectTiltOffset(Point& offset) const {
+  int16_t x, y;
+  if (tunables.tiltGazePx == 0 || !inputSampler.isRunning() || !inputSampler.getTilt(x, y)) {
+    return false;
+  }
+  
+  // The estimate points up, so downhill is the other way; tilt is in panel axes like touch points
+  Point downhill(static_cast<int16_t>((-x * tunables.tiltGazePx) >> TiltFilter::GRAVITY_BITS),
+                 static_cast<int16_t>((-y * tunables.tiltGazePx) >> TiltFilter::GRAVITY_BITS));
+  offset = layout.directionToLogical(downhill);
+  return true;
+}
+
+/**
+ * @brief Submit this frame's touch and tilt targets, then queue pupils for the arbitrated ones
+ * @param touching Whether touch points are live (gazing state)
+ */
+void EyesAnimation::drawArbitratedEyes(bool touching) {
+  // Local sources refresh every frame; others submit whenever they have something
+  if (touching) {
+    Point left = selectGazeTarget(touchHandler, leftEye, GAZE_POLICY);
+    Point right = selectGazeTarget(touchHandler, rightEye, GAZE_POLICY);
+    gazeArbiter.submit(GazeArbiter::TOUCH, { left.x, left.y }, { right.x, right.y }, frameTime);
+  }
+  Point offset;
+  if (selectTiltOffset(offset)) {
+    Point left = leftEye.getBasePoint() + offset;
+    Point right = rightEye.getBasePoint() + offset;
+    gazeArbiter.submit(GazeArbiter::TILT, { left.x, left.y }, { right.x, right.y }, frameTime);
+  }
+  
+  GazeTarget targets[2];
+  if (gazeArbiter.resolve(frameTime, targets)) {
+    drawGazingEyes(Point(targets[0].x, targets[0].y), Point(targets[1].x, targets[1].y));
+  } else {
+    drawCenterEyes();
+  }
+}
+
+/**
+ * @brief Queue dizzy effect pupils
+ */
+void EyesAnimation::drawDizzyEyes() {
+  // Progress from the time spent in the state (the state table ends it)
+  float degree = static_cast<float>(frameTime - stateEnteredTime) * tunables.dizzyRotationSpeed /
+                 tunables.animationDelayMs;
   if (degree >= DIZZY_TOTAL_DEGREES) {
-    degree = 0.0F;
-    state = EyeState::NORMAL;
+    degree = DIZZY_TOTAL_DEGREES - tunables.dizzyRotationSpeed;
   }
+  
+  eyeFrame.pupil = PupilAction::DIZZY;
+  eyeFrame.degree = degree;
 }
 
 /**
- * @brief Draw blink
+ * @brief Queue blink
  */
 void EyesAnimation::drawBlink() {
   BlinkState blinkState = determineBlinkState();
   
-  leftEye.drawBlink(blinkState);
-  rightEye.drawBlink(blinkState);
+  // Under load the eyelids go straight between open and closed
+  if (blinkState != BlinkState::HALF_CLOSED || !deadline.isShedding(Degradation::COARSE_BLINK)) {
+    eyeFrame.blink = true;
+    eyeFrame.blinkState = blinkState;
+  }
   
   updateBlinkCounter();
 }
 
+/**
+ * @brief Transition action: start the requested expression from a clean eye
+ */
+void EyesAnimation::startExpression() {
+  // Poses are drawn as changes from open eyes with a centered, style-sized pupil
+  resetEyes();
+  if (!expressionPlayer.start(expressions, pendingExpression, frameTime)) {
+    expressionPlayer.stop();
+  }
+  
+  // The state table returns to normal once the expression has been held for its duration
+  expressionDurationMs = expressionPlayer.getDurationMs();
+}
+
+/**
+ * @brief Transition action: start a random expression after the eyes were left alone
+ */
+void EyesAnimation::startIdleExpression() {
+  pendingExpression = rng.range(expressions.getCount());
+  startExpression();
+}
+
+/**
+ * @brief Draw the queued frame into both eyes and clear the queue
+ */
+void EyesAnimation::drawQueuedFrame() {
+  if (eyeFrame.pupil != PupilAction::NONE || eyeFrame.blink) {
+    forkJoin.run(drawEyeJob, this);
+  }
+  
+  eyeFrame.pupil = PupilAction::NONE;
+  eyeFrame.blink = false;
+}
+
+/**
+ * @brief Fork/join job drawing the queued frame into one eye
+ * @param context EyesAnimation instance
+ * @param index Eye index (0: left, 1: right)
+ */
+void EyesAnimation::drawEyeJob(void* context, uint8_t index) {
+  EyesAnimation* self = static_cast<EyesAnimation*>(context);
+  self->drawEye(index == 0 ? self->leftEye : self->rightEye, index);
+}
+
+/**
+ * @brief Draw the queued frame into one eye
+ * @param eye Eye to draw
+ * @param index Eye index (0: left, 1: right)
+ */
+void EyesAnimation::drawEye(Eye& eye, uint8_t index) {
+  switch (eyeFrame.pupil) {
+    case PupilAction::CENTER:
+      eye.drawCenterPupil(eyeFrame.saccades, eyeFrame.motionSteps);
+      break;
+      
+    case PupilAction::GAZING:
+      eye.drawGazingPupil(eyeFrame.targets[index], eyeFrame.saccades, eyeFrame.motionSteps);
+      break;
+      
+    case PupilAction::DIZZY:
+      // Use different angle offsets for left and right eyes
+      eye.drawDizzyPupil(eyeFrame.degree, index == 0 ? 0.0F : 180.0F);
+      break;
+      
+    case PupilAction::EXPRESSION:
+      eye.drawPose(eyeFrame.pose);
+      break;
+      
+    case PupilAction::NONE:
+    default:
+      break;
+  }
+  
+  if (eyeFrame.blink) {
+    eye.drawBlink(eyeFrame.blinkState);
+  }
+}
+
 /**
  * @brief Determine current blink state
  * @return Current blink state
@@ -265,7 +1001,7 @@ void EyesAnimation::updateBlinkCounter() {
   blinkCounter++;
   if (blinkCounter > blinkMaxCount) {
     blinkCounter = 0;
-    blinkMaxCount = random(BLINK_RANDOM_MIN, BLINK_RANDOM_MAX);
+    blinkMaxCount = rng.range(tunables.blinkRandomMin, tunables.blinkRandomMax);
   }
 }
 
@@ -274,18 +1010,14 @@ void EyesAnimation::updateBlinkCounter() {
  * @return Amount of small movements
  */
 Point EyesAnimation::generateSaccades() {
-  static uint32_t lastSaccadeTime = 0;
-  static Point lastSaccade(0, 0);
-  uint32_t currentTime = millis();
-  
-  // Limit saccade update frequency (50ms interval)
-  if (currentTime - lastSaccadeTime < 50) {
+  // Limit saccade update frequency, and hold them under load
+  if (frameTime - lastSaccadeTime < SACCADE_INTERVAL_MS || deadline.isShedding(Degradation::HOLD_SACCADES)) {
     return lastSaccade;
   }
   
-  lastSaccadeTime = currentTime;
-  lastSaccade.x = random(SACCADES_MAX) / SACCADES_DIVISOR;
-  lastSaccade.y = random(SACCADES_MAX) / SACCADES_DIVISOR;
+  lastSaccadeTime = frameTime;
+  lastSaccade.x = rng.range(SACCADES_MAX) / SACCADES_DIVISOR;
+  lastSaccade.y = rng.range(SACCADES_MAX) / SACCADES_DIVISOR;
   
   return lastSaccade;
 }
@@ -0,0 +1,362 @@
+#include "EyesDiagnostics.h"
+
+/**
+ * @brief Constructor
+ * @param eyes Animation to report on
+ */
+EyesDiagnostics::EyesDiagnostics(EyesAnimation& eyes)
+  : eyes(eyes) {
+}
+
+/**
+ * @brief Print memory cost and error against the exact path for each gaze table cell size
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printGazeTableReport(Print& out) {
+  out.printf("[gaze] table %s, cell %u px\n", EyesAnimation::GAZE_TABLE_ENABLED ? "enabled" : "disabled",
+             1U << Eye::GAZE_TABLE_CELL_SHIFT);
+  for (uint8_t shift = GazeTable::MIN_CELL_SHIFT; shift <= GazeTable::MAX_CELL_SHIFT; shift++) {
+    float leftError, rightError;
+    uint32_t leftMismatches, rightMismatches;
+    if (!eyes.leftEye.measureGazeTable(shift, leftError, leftMismatches) ||
+        !eyes.rightEye.measureGazeTable(shift, rightError, rightMismatches)) {
+      out.printf("[gaze]   cell %2u px: not enough memory\n", 1U << shift);
+      continue;
+    }
+    out.printf("[gaze]   cell %2u px: %6u B per eye, max error %.2f px, %u pixels off\n", 1U << shift,
+               static_cast<unsigned>(GazeTable::getBytes(eyes.layout.getWidth(), eyes.layout.getHeight(), shift)),
+               (leftError > rightError) ? leftError : rightError, static_cast<unsigned>(leftMismatches + rightMismatches));
+  }
+}
+
+/**
+ * @brief Print draw and push time of a pre-rotated eye sprite for each mount rotation
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printRotationBenchmark(Print& out) {
+  static constexpr uint16_t FRAMES = 100;
+  static constexpr float DEGREES_PER_FRAME = 10.0F;
+  
+  out.printf("[rotation] mounted %s, CPU %u MHz, %u frames each\n", ScreenLayout::getName(eyes.layout.getRotation()),
+             static_cast<unsigned>(getCpuFrequencyMhz()), FRAMES);
+  for (uint8_t i = 0; i < ScreenLayout::NUM_OF_ROTATIONS; i++) {
+    MountRotation rotation = static_cast<MountRotation>(i);
+    ScreenLayout rotatedLayout(rotation);
+    Eye eye(rotatedLayout, eyes.style, 0);
+    if (!eye.isReady()) {
+      out.printf("[rotation]   %-18s not enough memory\n", ScreenLayout::getName(rotation));
+      continue;
+    }
+    
+    // Circle the pupil as in the dizzy effect so every frame redraws it
+    eye.drawWhite();
+    uint32_t drawMicros = 0;
+    uint32_t pushMicros = 0;
+    for (uint16_t frame = 0; frame < FRAMES; frame++) {
+      uint32_t start = micros();
+      eye.drawDizzyPupil(frame * DEGREES_PER_FRAME);
+      uint32_t drawn = micros();
+      eye.render(&M5.Display);
+      M5.Display.waitDMA();
+      drawMicros += drawn - start;
+      pushMicros += micros() - drawn;
+    }
+    out.printf("[rotation]   %-18s draw %5u us, push %5u us per frame\n", ScreenLayout::getName(rotation),
+               static_cast<unsigned>(drawMicros / FRAMES), static_cast<unsigned>(pushMicros / FRAMES));
+  }
+  
+  // Put the surround back; the next frame pushes both eyes again
+  M5.Display.fillScreen(TFT_BLACK);
+  eyes.outputs.invalidate();
+}
+
+/**
+ * @brief Print sprite size, draw and push time of the mono and palette color modes
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printColorModeBenchmark(Print& out) {
+  static constexpr uint16_t FRAMES = 100;
+  static constexpr ColorMode MODES[] = { ColorMode::MONO, ColorMode::PALETTE };
+  
+  out.printf("[color] built for %s, CPU %u MHz, %u frames each, whole sprite pushed\n",
+             (Eye::COLOR_MODE == ColorMode::PALETTE) ? "palette" : "mono",
+             static_cast<unsigned>(getCpuFrequencyMhz()), FRAMES);
+  uint32_t frameMicros[2] = {};
+  for (uint8_t i = 0; i < 2; i++) {
+    bool palette = MODES[i] == ColorMode::PALETTE;
+    M5.Display.setColorDepth(palette ? 16 : 1);
+    uint32_t spriteBytes, drawMicros, pushMicros;
+    if (!eyes.leftEye.measureColorMode(MODES[i], &M5.Display, FRAMES, spriteBytes, drawMicros, pushMicros)) {
+      out.printf("[color]   %-7s not enough memory\n", palette ? "palette" : "mono");
+      continue;
+    }
+    frameMicros[i] = (drawMicros + pushMicros) / FRAMES;
+    out.printf("[color]   %-7s %5u B per eye, draw %5u us, push %5u us, frame %5u us\n",
+               palette ? "palette" : "mono", static_cast<unsigned>(spriteBytes),
+               static_cast<unsigned>(drawMicros / FRAMES), static_cast<unsigned>(pushMicros / FRAMES),
+               static_cast<unsigned>(frameMicros[i]));
+  }
+  if (frameMicros[0] > 0 && frameMicros[1] > 0) {
+    out.printf("[color]   palette costs x%.2f the mono frame time\n",
+               static_cast<float>(frameMicros[1]) / frameMicros[0]);
+  }
+  
+  // Back to the built-in depth with the surround redrawn; the next frame pushes both eyes again
+  M5.Display.setColorDepth(Eye::DISPLAY_COLOR_DEPTH);
+  M5.Display.fillScreen(TFT_BLACK);
+  eyes.outputs.invalidate();
+}
+
+/**
+ * @brief Print the expressions and their evaluation cost per frame next to the hard-coded states
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printExpressionReport(Print& out) {
+  static constexpr uint16_t PASSES = 50;
+  
+  out.printf("[expr] %u expressions (%s, %u bytes), idle expression after %u s\n", eyes.expressions.getCount(),
+             eyes.expressions.isBuiltIn() ? "built-in" : "loaded", static_cast<unsigned>(eyes.expressions.getSize()),
+             eyes.tunables.idleExpressionSeconds);
+  
+  // Evaluation only, at the current frame rate, with a player of its own
+  for (uint8_t i = 0; i < eyes.expressions.getCount(); i++) {
+    const ExpressionFormat::Expression& expression = eyes.expressions.getExpression(i);
+    const ExpressionFormat::Track* tracks = eyes.expressions.getTracks(expression);
+    uint32_t keys = 0;
+    for (uint8_t j = 0; j < expression.trackCount; j++) {
+      keys += tracks[j].keyCount;
+    }
+    
+    uint32_t frames = expression.durationMs / eyes.tunables.animationDelayMs + 1;
+    ExpressionPlayer player;
+    uint32_t start = micros();
+    for (uint16_t pass = 0; pass < PASSES; pass++) {
+      player.start(eyes.expressions, i, 0);
+      for (uint32_t frame = 0; frame < frames; frame++) {
+        player.advance(frame * eyes.tunables.animationDelayMs);
+      }
+    }
+    float perFrame = static_cast<float>(micros() - start) / (PASSES * frames);
+    out.printf("[expr]   %-11s %5u ms, %u tracks, %3u keys: %.2f us per frame\n", expression.name,
+               expression.durationMs, expression.trackCount, static_cast<unsigned>(keys), perFrame);
+  }
+  
+  // What the hard-coded normal and dizzy states decide per frame, evaluated the same way
+  FastRandom savedRng = eyes.rng;
+  Point savedSaccade = eyes.lastSaccade;
+  uint32_t savedSaccadeTime = eyes.lastSaccadeTime;
+  uint32_t savedMotionStepTime = eyes.motionStepTime;
+  uint32_t savedFrameTime = eyes.frameTime;
+  uint32_t savedEnteredTime = eyes.stateEnteredTime;
+  EyesAnimation::EyeFrame savedFrame = eyes.eyeFrame;
+  uint32_t frames = static_cast<uint32_t>(EyesAnimation::DIZZY_TOTAL_DEGREES / eyes.tunables.dizzyRotationSpeed);
+  
+  uint32_t start = micros();
+  for (uint16_t pass = 0; pass < PASSES; pass++) {
+    for (uint32_t frame = 0; frame < frames; frame++) {
+      eyes.frameTime = savedFrameTime + frame * eyes.tunables.animationDelayMs;
+      if (eyes.determineBlinkState() == BlinkState::OPEN) {
+        eyes.drawCenterEyes();
+      }
+    }
+  }
+  float normalPerFrame = static_cast<float>(micros() - start) / (PASSES * frames);
+  
+  eyes.stateEnteredTime = savedFrameTime;
+  start = micros();
+  for (uint16_t pass = 0; pass < PASSES; pass++) {
+    for (uint32_t frame = 0; frame < frames; frame++) {
+      eyes.frameTime = savedFrameTime + frame * eyes.tunables.animationDelayMs;
+      eyes.drawDizzyEyes();
+    }
+  }
+  float dizzyPerFrame = static_cast<float>(micros() - start) / (PASSES * frames);
+  
+  eyes.rng = savedRng;
+  eyes.lastSaccade = savedSaccade;
+  eyes.lastSaccadeTime = savedSaccadeTime;
+  eyes.motionStepTime = savedMotionStepTime;
+  eyes.frameTime = savedFrameTime;
+  eyes.stateEnteredTime = savedEnteredTime;
+  eyes.eyeFrame = savedFrame;
+  out.printf("[expr]   hard-coded normal: %.2f us, dizzy: %.2f us per frame\n", normalPerFrame, dizzyPerFrame);
+  
+  // Whole frames (update, evaluation and drawing) as measured while running
+  for (uint8_t i = 0; i < EyesAnimation::NUM_OF_STATES; i++) {
+    const StateStats& stats = eyes.stateStats[i];
+    out.printf("[expr]   %-10s frames %8u, %6u us per frame drawn\n", EyesAnimation::STATES[i].name, static_cast<unsigned>(stats.frames),
+               static_cast<unsigned>(stats.frames > 0 ? stats.totalMicros / stats.frames : 0));
+  }
+}
+
+/**
+ * @brief Print the tilt estimate and the cost of fusing it against the frame budget
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printTiltReport(Print& out) {
+  out.printf("[tilt] gaze %u px per g%s, fused every %u ms\n", eyes.tunables.tiltGazePx,
+             eyes.tunables.tiltGazePx == 0 ? " (off)" : "", InputSampler::SAMPLE_INTERVAL_MS);
+  
+  int16_t x, y;
+  Point offset;
+  if (!eyes.inputSampler.isRunning() || !eyes.inputSampler.getTilt(x, y)) {
+    out.printf("[tilt]   no estimate (sampler %s)\n", eyes.inputSampler.isRunning() ? "running" : "not running");
+    return;
+  }
+  bool gazing = eyes.selectTiltOffset(offset);
+  float scale = 1.0F / (1 << TiltFilter::GRAVITY_BITS);
+  out.printf("[tilt]   up x %+.3f g, y %+.3f g (panel), gaze offset %+d, %+d px\n", x * scale, y * scale,
+             gazing ? offset.x : 0, gazing ? offset.y : 0);
+  
+  // Cycles are converted at the current clock, which the governor may have changed meanwhile
+  uint32_t samples, averageCycles, maxCycles;
+  eyes.inputSampler.takeFusionCost(samples, averageCycles, maxCycles);
+  uint32_t mhz = getCpuFrequencyMhz();
+  float samplesPerFrame = static_cast<float>(eyes.tunables.animationDelayMs) / InputSampler::SAMPLE_INTERVAL_MS;
+  float microsPerFrame = samplesPerFrame * averageCycles / mhz;
+  out.printf("[tilt]   fusion %u samples: %u cycles (%.2f us) average, %u cycles (%.2f us) max at %u MHz\n",
+             static_cast<unsigned>(samples), static_cast<unsigned>(averageCycles),
+             static_cast<float>(averageCycles) / mhz, static_cast<unsigned>(maxCycles),
+             static_cast<float>(maxCycles) / mhz, static_cast<unsigned>(mhz));
+  out.printf("[tilt]   %.1f samples per frame: %.2f us, %.3f%% of the %u ms frame budget\n", samplesPerFrame,
+             microsPerFrame, microsPerFrame * 100.0F / (eyes.tunables.animationDelayMs * 1000.0F),
+             eyes.tunables.animationDelayMs);
+}
+
+/**
+ * @brief Print the gaze sources, what they last submitted and how often they won
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printGazeSourceReport(Print& out) {
+  static const char* const NAMES[GazeArbiter::USER] = { "touch", "external", "tilt" };
+  uint32_t nowMs = eyes.clock.nowMillis();
+  out.printf("[gaze] blend %u ms, %u winner switches, %u retried reads%s\n", eyes.tunables.gazeBlendMs,
+             static_cast<unsigned>(eyes.gazeArbiter.getSwitches()), static_cast<unsigned>(eyes.gazeArbiter.getRetries()),
+             eyes.gazeArbiter.isBlending() ? ", blending" : "");
+  for (uint8_t i = 0; i < GazeArbiter::MAX_SOURCES; i++) {
+    if (!eyes.gazeArbiter.isEnabled(i)) {
+      continue;
+    }
+    char name[12];
+    if (i < GazeArbiter::USER) {
+      snprintf(name, sizeof(name), "%s", NAMES[i]);
+    } else {
+      snprintf(name, sizeof(name), "user%u", i - GazeArbiter::USER);
+    }
+    out.printf("[gaze]   %-8s priority %u, expiry %5u ms, won %8u frames", name, eyes.gazeArbiter.getPriority(i),
+               eyes.gazeArbiter.getExpiry(i), static_cast<unsigned>(eyes.gazeArbiter.getWins(i)));
+    GazeArbiter::Submission submission;
+    if (eyes.gazeArbiter.peek(i, submission)) {
+      out.printf(", last (%d, %d) (%d, %d) %u ms ago\n", submission.targets[0].x, submission.targets[0].y,
+                 submission.targets[1].x, submission.targets[1].y,
+                 static_cast<unsigned>(nowMs - submission.timeMs));
+    } else {
+      out.printf(", nothing submitted\n");
+    }
+  }
+}
+
+/**
+ * @brief Print the microphone levels, onsets and the detector's cost against the frame budget
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printAudioReport(Print& out) {
+  out.printf("[audio] startle at %u dB above the floor, %u Hz in %u-sample blocks (%u ms)\n", eyes.tunables.startleDb,
+             static_cast<unsigned>(AudioInput::SAMPLE_RATE), AudioInput::BLOCK_SAMPLES,
+             static_cast<unsigned>(AudioInput::BLOCK_SAMPLES * 1000 / AudioInput::SAMPLE_RATE));
+  if (!eyes.audioInput.isRunning()) {
+    out.printf("[audio]   microphone not running\n");
+    return;
+  }
+  
+  // dB relative to full scale; 0 RMS is shown as -inf
+  uint16_t level, floor;
+  eyes.audioInput.getLevels(level, floor);
+  out.printf("[audio]   level %5u (%.1f dBFS), floor %5u (%.1f dBFS), %u onsets\n", level,
+             20.0F * log10f(level / 32767.0F), floor, 20.0F * log10f(floor / 32767.0F),
+             static_cast<unsigned>(eyes.audioInput.getOnsets()));
+  
+  // Cycles are converted at the current clock, which the governor may have changed meanwhile
+  uint32_t blocks, averageCycles, maxCycles;
+  eyes.audioInput.takeKernelCost(blocks, averageCycles, maxCycles);
+  uint32_t mhz = getCpuFrequencyMhz();
+  float blocksPerFrame = eyes.tunables.animationDelayMs * (AudioInput::SAMPLE_RATE / 1000.0F) / AudioInput::BLOCK_SAMPLES;
+  float microsPerFrame = blocksPerFrame * averageCycles / mhz;
+  out.printf("[audio]   detector %u blocks: %u cycles (%.2f us) average, %u cycles (%.2f us) max at %u MHz\n",
+             static_cast<unsigned>(blocks), static_cast<unsigned>(averageCycles),
+             static_cast<float>(averageCycles) / mhz, static_cast<unsigned>(maxCycles),
+             static_cast<float>(maxCycles) / mhz, static_cast<unsigned>(mhz));
+  out.printf("[audio]   %.2f blocks per frame: %.2f us, %.3f%% of the %u ms frame budget (on the sampler core)\n",
+             blocksPerFrame, microsPerFrame, microsPerFrame * 100.0F / (eyes.tunables.animationDelayMs * 1000.0F),
+             eyes.tunables.animationDelayMs);
+}
+
+/**
+ * @brief Print the cost of coalescing queued touch samples and picking gaze targets per frame
+ * @param out Output (e.g. Serial)
+ */
+void EyesDiagnostics::printTouchBenchmark(Print& out) {
+  static constexpr uint16_t FRAMES = 1000;
+  static constexpr uint8_t TOUCH_PERIOD_MS = InputSampler::SAMPLE_INTERVAL_MS * InputSampler::TOUCH_EVERY;
+  
+  struct Case {
+    const char* name;
+    uint8_t points;
+    GazePolicy policy;
+  };
+  static constexpr Case CASES[] = {
+    { "1 point", 1, GazePolicy::NEAREST },
+    { "2 points, nearest", 2, GazePolicy::NEAREST },
+    { "2 points, centroid", 2, GazePolicy::CENTROID },
+  };
+  
+  uint32_t mhz = getCpuFrequencyMhz();
+  uint8_t samplesPerFrame = (eyes.tunables.animationDelayMs + TOUCH_PERIOD_MS - 1) / TOUCH_PERIOD_MS;
+  out.printf("[touch] %u samples per frame (every %u ms), %u frames each, CPU %u MHz\n", samplesPerFrame,
+             TOUCH_PERIOD_MS, FRAMES, static_cast<unsigned>(mhz));
+  uint32_t singleCycles = 0;
+  for (const Case& benchCase : CASES) {
+    // A separate handler in queue mode, fed the way the input sampler feeds the live one
+    TouchHandler touch(eyes.clock);
+    touch.setQueueMode(true);
+    uint32_t sampleTime = 0;
+    uint32_t updateCycles = 0;
+    uint32_t targetCycles = 0;
+    int32_t checksum = 0;
+    for (uint16_t frame = 0; frame < FRAMES; frame++) {
+      for (uint8_t i = 0; i < samplesPerFrame; i++) {
+        // Fingers sweep across the panel in opposite directions
+        int16_t offset = static_cast<int16_t>((sampleTime / TOUCH_PERIOD_MS) % 200);
+        TouchSample sample = {};
+        sample.timeMs = sampleTime;
+        sample.state = TouchCoalescer::STATE_TOUCH;
+        sample.count = benchCase.points;
+        sample.points[0] = Point(static_cast<int16_t>(60 + offset), 80);
+        sample.points[1] = Point(static_cast<int16_t>(260 - offset), 160);
+        touch.getQueue().push(sample);
+        sampleTime += TOUCH_PERIOD_MS;
+      }
+      
+      uint32_t start = ESP.getCycleCount();
+      touch.update();
+      uint32_t updated = ESP.getCycleCount();
+      Point left = eyes.selectGazeTarget(touch, eyes.leftEye, benchCase.policy);
+      Point right = eyes.selectGazeTarget(touch, eyes.rightEye, benchCase.policy);
+      uint32_t selected = ESP.getCycleCount();
+      updateCycles += updated - start;
+      targetCycles += selected - updated;
+      checksum += left.x + right.y;
+    }
+    // Keeps the target selection from being optimised away
+    volatile int32_t keep = checksum;
+    (void)keep;
+    
+    uint32_t frameCycles = (updateCycles + targetCycles) / FRAMES;
+    if (singleCycles == 0) {
+      singleCycles = frameCycles;
+    }
+    out.printf("[touch]   %-18s coalesce %5u, targets %5u cycles per frame (%.2f us, x%.2f of 1 point)\n",
+               benchCase.name, static_cast<unsigned>(updateCycles / FRAMES), static_cast<unsigned>(targetCycles / FRAMES),
+               static_cast<float>(frameCycles) / mhz, static_cast<float>(frameCycles) / singleCycles);
+  }
+}
@@ -0,0 +1,174 @@
+#include "ForkJoin.h"
+
+#if defined(ARDUINO)
+
+/**
+ * @brief Constructor
+ */
+ForkJoin::ForkJoin()
+  : job(nullptr), context(nullptr), running(false), workerTask(nullptr), callerTask(nullptr) {
+}
+
+/**
+ * @brief Destructor
+ */
+ForkJoin::~ForkJoin() {
+  if (workerTask != nullptr) {
+    vTaskDelete(workerTask);
+  }
+}
+
+/**
+ * @brief Start the worker
+ * @return Whether the worker was started
+ */
+bool ForkJoin::begin() {
+  if (running) {
+    return true;
+  }
+  
+  running = xTaskCreatePinnedToCore(workerLoop, "ForkJoin", WORKER_STACK_SIZE, this,
+                                    WORKER_PRIORITY, &workerTask, WORKER_CORE) == pdPASS;
+  return running;
+}
+
+/**
+ * @brief Run a job for index 0 and 1 and wait for both
+ * @param job Job to run
+ * @param context Context passed to the job
+ */
+void ForkJoin::run(Job job, void* context) {
+  if (!running) {
+    job(context, 0);
+    job(context, 1);
+    return;
+  }
+  
+  // Fork: publish the job, then wake the worker
+  this->job = job;
+  this->context = context;
+  callerTask = xTaskGetCurrentTaskHandle();
+  xTaskNotifyGive(workerTask);
+  
+  job(context, 0);
+  
+  // Join: wait for the worker to finish index 1
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+/**
+ * @brief Worker task body
+ * @param param ForkJoin instance
+ */
+void ForkJoin::workerLoop(void* param) {
+  ForkJoin* self = static_cast<ForkJoin*>(param);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->job(self->context, 1);
+    xTaskNotifyGive(self->callerTask);
+  }
+}
+
+#else
+
+/**
+ * @brief Constructor
+ */
+ForkJoin::ForkJoin()
+  : job(nullptr), context(nullptr), running(false),
+    startGeneration(0), doneGeneration(0), stopping(false) {
+}
+
+/**
+ * @brief Destructor
+ */
+ForkJoin::~ForkJoin() {
+  if (running) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    signal.notify_all();
+    worker.join();
+  }
+}
+
+/**
+ * @brief Start the worker
+ * @return Whether the worker was started
+ */
+bool ForkJoin::begin() {
+  if (!running) {
+    worker = std::thread(&ForkJoin::workerLoop, this);
+    running = true;
+  }
+  return running;
+}
+
+/**
+ * @brief Run a job for index 0 and 1 and wait for both
+ * @param job Job to run
+ * @param context Context passed to the job
+ */
+void ForkJoin::run(Job job, void* context) {
+  if (!running) {
+    job(context, 0);
+    job(context, 1);
+    return;
+  }
+  
+  // Fork: publish the job, then wake the worker
+  uint32_t generation;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->job = job;
+    this->context = context;
+    generation = ++startGeneration;
+  }
+  signal.notify_all();
+  
+  job(context, 0);
+  
+  // Join: wait for the worker to finish index 1
+  std::unique_lock<std::mutex> lock(mutex);
+  signal.wait(lock, [this, generation] { return doneGeneration == generation; });
+}
+
+/**
+ * @brief Worker thread body
+ */
+void ForkJoin::workerLoop() {
+  uint32_t handled = 0;
+  for (;;) {
+    Job currentJob;
+    void* currentContext;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      signal.wait(lock, [this, handled] { return stopping || startGeneration != handled; });
+      if (stopping) {
+        return;
+      }
+      handled = startGeneration;
+      currentJob = job;
+      currentContext = context;
+    }
+    
+    currentJob(currentContext, 1);
+    
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      doneGeneration = handled;
+    }
+    signal.notify_all();
+  }
+}
+
+#endif
+
+/**
+ * @brief Check whether jobs run in parallel
+ * @return true if the worker is running
+ */
+bool ForkJoin::isParallel() const {
+  return running;
+}
@@ -0,0 +1,95 @@
+#include "FrameDeadline.h"
+
+/**
+ * @brief Constructor
+ */
+FrameDeadline::FrameDeadline()
+  : level(Degradation::NONE),
+    sheddingAllowed(true),
+    overrunStreak(0),
+    headroomStreak(0),
+    stats()
+{
+}
+
+/**
+ * @brief Record a frame and adjust the degradation level
+ * @param workMicros Time spent on the frame
+ * @param intervalMs Time since the start of the previous frame (0 for the first frame)
+ * @param budgetMicros Frame budget
+ */
+void FrameDeadline::recordFrame(uint32_t workMicros, uint32_t intervalMs, uint32_t budgetMicros) {
+  if (workMicros > stats.worstWorkMicros) {
+    stats.worstWorkMicros = workMicros;
+  }
+  if (intervalMs > stats.worstIntervalMs) {
+    stats.worstIntervalMs = intervalMs;
+  }
+  
+  if (workMicros > budgetMicros) {
+    // The next frame will start late
+    stats.missedDeadlines++;
+    headroomStreak = 0;
+    if (++overrunStreak < DEGRADE_AFTER_FRAMES) {
+      return;
+    }
+    overrunStreak = 0;
+    if (sheddingAllowed && level < MAX_LEVEL) {
+      level = static_cast<Degradation>(static_cast<uint8_t>(level) + 1);
+      stats.degradations++;
+    }
+    return;
+  }
+  
+  overrunStreak = 0;
+  if (workMicros >= budgetMicros / 100 * HEADROOM_PERCENT) {
+    // Within budget but too close to restore anything
+    headroomStreak = 0;
+    return;
+  }
+  
+  if (++headroomStreak < RESTORE_AFTER_FRAMES) {
+    return;
+  }
+  headroomStreak = 0;
+  if (level > Degradation::NONE) {
+    level = static_cast<Degradation>(static_cast<uint8_t>(level) - 1);
+    stats.restorations++;
+  }
+}
+
+/**
+ * @brief Allow or forbid shedding work (counters are kept either way)
+ * @param allowed false to stay at full quality
+ */
+void FrameDeadline::setSheddingAllowed(bool allowed) {
+  sheddingAllowed = allowed;
+  if (!allowed) {
+    level = Degradation::NONE;
+  }
+}
+
+/**
+ * @brief Check whether a kind of optional work is currently shed
+ * @param work Degradation level that sheds the work
+ * @return true if the work should be skipped this frame
+ */
+bool FrameDeadline::isShedding(Degradation work) const {
+  return level >= work;
+}
+
+/**
+ * @brief Get current degradation level
+ * @return Degradation level
+ */
+Degradation FrameDeadline::getLevel() const {
+  return level;
+}
+
+/**
+ * @brief Get deadline counters
+ * @return Counters since startup
+ */
+const DeadlineStats& FrameDeadline::getStats() const {
+  return stats;
+}
@@ -0,0 +1,262 @@
+#include "FrameStreamer.h"
+#include "MemoryBudget.h"
+
+namespace {
+  /**
+   * @brief Write a 16-bit value in little endian
+   * @param output Destination
+   * @param value Value to write
+   */
+  void writeU16(uint8_t* output, uint16_t value) {
+    output[0] = static_cast<uint8_t>(value);
+    output[1] = static_cast<uint8_t>(value >> 8);
+  }
+}
+
+/**
+ * @brief Constructor
+ */
+FrameStreamer::FrameStreamer()
+  : out(nullptr),
+    bytesPerSecond(0),
+    maxSpriteBytes(0),
+    references(),
+    packet(nullptr),
+    packetCapacity(0),
+    frameNumbers(),
+    keyframePending(),
+    blocking(false),
+    credit(0),
+    lastCreditTime(0),
+    sentFrames(0),
+    skippedFrames(0),
+    sentBytes(0),
+    rawBytes(0)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+FrameStreamer::~FrameStreamer() {
+  for (uint8_t i = 0; i < MAX_EYES; i++) {
+    MemoryBudget::release(references[i]);
+  }
+  MemoryBudget::release(packet);
+}
+
+/**
+ * @brief Allocate buffers and start streaming
+ * @param out Output stream
+ * @param bytesPerSecond Bandwidth budget
+ * @param maxSpriteBytes Largest sprite buffer that will be submitted
+ * @return Whether buffers were allocated
+ */
+bool FrameStreamer::begin(Print& out, uint32_t bytesPerSecond, uint32_t maxSpriteBytes) {
+  uint32_t capacity = getMaxPacketBytes(maxSpriteBytes);
+  
+  // References are read every frame, the scratch buffer only while encoding
+  packet = static_cast<uint8_t*>(MemoryBudget::allocate(capacity, MemoryPlacement::INTERNAL, "stream packet"));
+  if (packet == nullptr) {
+    return false;
+  }
+  for (uint8_t i = 0; i < MAX_EYES; i++) {
+    references[i] = static_cast<uint8_t*>(MemoryBudget::allocate(maxSpriteBytes, MemoryPlacement::INTERNAL, "stream reference"));
+    if (references[i] == nullptr) {
+      return false;
+    }
+    keyframePending[i] = true;
+  }
+  
+  this->out = &out;
+  this->bytesPerSecond = bytesPerSecond;
+  this->maxSpriteBytes = maxSpriteBytes;
+  packetCapacity = capacity;
+  credit = getBurst();  // Start with a full bucket
+  return true;
+}
+
+/**
+ * @brief Wait for the output instead of skipping frames
+ * @param enabled true to send every frame regardless of the budget
+ */
+void FrameStreamer::setBlocking(bool enabled) {
+  blocking = enabled;
+}
+
+/**
+ * @brief DisplaySink entry point (the XOR delta already skips unchanged rows)
+ * @param context FrameStreamer instance
+ * @param eyeIndex Eye index
+ * @param eye Eye to send
+ * @param rows Rows changed since the last frame sent (unused)
+ * @param nowMs Current time
+ * @return Whether the frame was sent
+ */
+bool FrameStreamer::write(void* context, uint8_t eyeIndex, Eye& eye, const DirtyRows& rows, uint32_t nowMs) {
+  return static_cast<FrameStreamer*>(context)->submit(eyeIndex, eye.getSpriteView(), nowMs);
+}
+
+/**
+ * @brief Encode and send one eye sprite if the budget allows
+ * @param eyeIndex Eye index (less than MAX_EYES)
+ * @param view Sprite to send
+ * @param nowMs Current time
+ * @return Whether the frame was sent
+ */
+bool FrameStreamer::submit(uint8_t eyeIndex, const SpriteView& view, uint32_t nowMs) {
+  if (out == nullptr || eyeIndex >= MAX_EYES || view.buffer == nullptr || view.length > maxSpriteBytes) {
+    return false;
+  }
+  
+  refillCredit(nowMs);
+  
+  // Encode against the last frame sent (or zeros for a keyframe)
+  bool keyframe = keyframePending[eyeIndex] || (frameNumbers[eyeIndex] % KEYFRAME_INTERVAL) == 0;
+  uint32_t payloadLength = encodeDelta(view.buffer, keyframe ? nullptr : references[eyeIndex],
+                                       view.length, packet + HEADER_SIZE);
+  uint32_t packetLength = HEADER_SIZE + payloadLength + 1;
+  
+  // Skip without blocking when over budget; the reference stays on the last frame sent
+  if (!blocking && (packetLength > credit || out->availableForWrite() < static_cast<int>(packetLength))) {
+    skippedFrames++;
+    return false;
+  }
+  
+  packet[0] = 'E';
+  packet[1] = 'F';
+  packet[2] = eyeIndex;
+  packet[3] = keyframe ? FLAG_KEYFRAME : 0;
+  writeU16(packet + 4, frameNumbers[eyeIndex]);
+  writeU16(packet + 6, static_cast<uint16_t>(view.x));
+  writeU16(packet + 8, static_cast<uint16_t>(view.y));
+  writeU16(packet + 10, view.width);
+  writeU16(packet + 12, view.height);
+  packet[14] = view.colorDepth;
+  writeU16(packet + 15, static_cast<uint16_t>(payloadLength));
+  
+  uint8_t checksum = 0;
+  for (uint32_t i = 0; i < packetLength - 1; i++) {
+    checksum += packet[i];
+  }
+  packet[packetLength - 1] = checksum;
+  
+  out->write(packet, packetLength);
+  memcpy(references[eyeIndex], view.buffer, view.length);
+  
+  credit = (packetLength > credit) ? 0 : credit - packetLength;
+  keyframePending[eyeIndex] = false;
+  frameNumbers[eyeIndex]++;
+  sentFrames++;
+  sentBytes += packetLength;
+  rawBytes += view.length;
+  return true;
+}
+
+/**
+ * @brief Force the next frame of every eye to be a keyframe
+ */
+void FrameStreamer::requestKeyframe() {
+  for (uint8_t i = 0; i < MAX_EYES; i++) {
+    keyframePending[i] = true;
+  }
+}
+
+/**
+ * @brief Get number of frames sent
+ * @return Sent frame count
+ */
+uint32_t FrameStreamer::getSentFrames() const {
+  return sentFrames;
+}
+
+/**
+ * @brief Get number of frames skipped for lack of bandwidth
+ * @return Skipped frame count
+ */
+uint32_t FrameStreamer::getSkippedFrames() const {
+  return skippedFrames;
+}
+
+/**
+ * @brief Get total bytes sent
+ * @return Sent byte count
+ */
+uint32_t FrameStreamer::getSentBytes() const {
+  return sentBytes;
+}
+
+/**
+ * @brief Get total raw sprite bytes of sent frames
+ * @return Raw byte count
+ */
+uint32_t FrameStreamer::getRawBytes() const {
+  return rawBytes;
+}
+
+/**
+ * @brief RLE-code the XOR of a frame and its reference
+ * @param frame Current frame
+ * @param reference Reference frame (nullptr for a keyframe)
+ * @param length Frame length
+ * @param output Destination of the tokens
+ * @return Number of bytes written
+ */
+uint32_t FrameStreamer::encodeDelta(const uint8_t* frame, const uint8_t* reference,
+                                    uint32_t length, uint8_t* output) {
+  uint32_t written = 0;
+  uint32_t i = 0;
+  
+  while (i < length) {
+    uint8_t delta = reference ? (frame[i] ^ reference[i]) : frame[i];
+    
+    if (delta == 0) {
+      // Run of unchanged bytes
+      uint32_t run = 1;
+      while (i + run < length && run < MAX_TOKEN_LENGTH &&
+             (reference ? (frame[i + run] ^ reference[i + run]) : frame[i + run]) == 0) {
+        run++;
+      }
+      output[written++] = static_cast<uint8_t>(run - 1);
+      i += run;
+    } else {
+      // Literal changed bytes up to the next unchanged byte
+      uint32_t tokenIndex = written++;
+      uint32_t count = 0;
+      while (i < length && count < MAX_TOKEN_LENGTH) {
+        delta = reference ? (frame[i] ^ reference[i]) : frame[i];
+        if (delta == 0) {
+          break;
+        }
+        output[written++] = delta;
+        i++;
+        count++;
+      }
+      output[tokenIndex] = static_cast<uint8_t>(0x7F + count);
+    }
+  }
+  
+  return written;
+}
+
+/**
+ * @brief Refill the token bucket
+ * @param nowMs Current time
+ */
+void FrameStreamer::refillCredit(uint32_t nowMs) {
+  uint32_t elapsed = nowMs - lastCreditTime;
+  lastCreditTime = nowMs;
+  
+  uint32_t burst = getBurst();
+  uint64_t refilled = credit + static_cast<uint64_t>(bytesPerSecond) * elapsed / 1000;
+  credit = (refilled > burst) ? burst : static_cast<uint32_t>(refilled);
+}
+
+/**
+ * @brief Get token bucket capacity
+ * @return Half a second of budget, but never less than one full packet
+ */
+uint32_t FrameStreamer::getBurst() const {
+  uint32_t burst = bytesPerSecond / 2;
+  return (burst < packetCapacity) ? packetCapacity : burst;
+}
@@ -0,0 +1,322 @@
+#include "GazeArbiter.h"
+
+/**
+ * @brief Constructor (all sources disabled until configured)
+ */
+GazeArbiter::GazeArbiter()
+  : slots(),
+    blendMs(BLEND_MS),
+    winners(0),
+    hasOutput(false),
+    output(),
+    blendFrom(),
+    blendStartMs(0),
+    blending(false),
+    switches(0),
+    retries(0) {
+  for (Slot& slot : slots) {
+    slot.sequence.store(0, std::memory_order_relaxed);
+    slot.left.store(0, std::memory_order_relaxed);
+    slot.right.store(0, std::memory_order_relaxed);
+    slot.timeMs.store(0, std::memory_order_relaxed);
+    slot.live.store(false, std::memory_order_relaxed);
+    slot.enabled = false;
+    slot.priority = 0;
+    slot.weight = 1;
+    slot.expiryMs = 0;
+    slot.wins = 0;
+  }
+}
+
+/**
+ * @brief Enable a source and set how it competes (consumer side)
+ * @param source Source slot
+ * @param priority Priority (higher wins)
+ * @param expiryMs How long a submission stays live
+ * @param weight Share when averaged with sources of the same priority (at least 1)
+ */
+void GazeArbiter::configure(uint8_t source, uint8_t priority, uint16_t expiryMs, uint8_t weight) {
+  if (source >= MAX_SOURCES) {
+    return;
+  }
+  Slot& slot = slots[source];
+  slot.priority = priority;
+  slot.expiryMs = expiryMs;
+  slot.weight = (weight > 0) ? weight : 1;
+  slot.enabled = true;
+}
+
+/**
+ * @brief Disable a source (consumer side)
+ * @param source Source slot
+ */
+void GazeArbiter::disable(uint8_t source) {
+  if (source < MAX_SOURCES) {
+    slots[source].enabled = false;
+  }
+}
+
+/**
+ * @brief Set how long the output takes to slide over to a new winner (consumer side)
+ * @param blendMs Blend time in milliseconds (0: jump)
+ */
+void GazeArbiter::setBlendTime(uint16_t blendMs) {
+  this->blendMs = blendMs;
+}
+
+/**
+ * @brief Submit targets for both eyes (producer side, one producer per source)
+ * @param source Source slot
+ * @param left Left eye target
+ * @param right Right eye target
+ * @param timeMs Time of the submission (on the consumer's clock)
+ */
+void GazeArbiter::submit(uint8_t source, const GazeTarget& left, const GazeTarget& right, uint32_t timeMs) {
+  if (source >= MAX_SOURCES) {
+    return;
+  }
+  Slot& slot = slots[source];
+  
+  // Odd sequence while writing; the release fence keeps the data stores after it
+  uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.left.store(pack(left), std::memory_order_relaxed);
+  slot.right.store(pack(right), std::memory_order_relaxed);
+  slot.timeMs.store(timeMs, std::memory_order_relaxed);
+  slot.live.store(true, std::memory_order_relaxed);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Withdraw the source's targets before they expire (producer side)
+ * @param source Source slot
+ */
+void GazeArbiter::withdraw(uint8_t source) {
+  if (source >= MAX_SOURCES) {
+    return;
+  }
+  Slot& slot = slots[source];
+  uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.live.store(false, std::memory_order_relaxed);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Choose this frame's targets (consumer side)
+ * @param nowMs Current time
+ * @param targets Receives the left and right eye targets
+ * @return false if no source is live (the eyes look ahead)
+ */
+bool GazeArbiter::resolve(uint32_t nowMs, GazeTarget targets[2]) {
+  // Live submissions, and the highest priority among them
+  Submission submissions[MAX_SOURCES];
+  uint8_t liveMask = 0;
+  uint8_t topPriority = 0;
+  for (uint8_t i = 0; i < MAX_SOURCES; i++) {
+    const Slot& slot = slots[i];
+    bool live;
+    if (!slot.enabled || !read(slot, submissions[i], live) || !live) {
+      continue;
+    }
+    // Producers on other tasks may stamp a little after the frame started
+    int32_t ageMs = static_cast<int32_t>(nowMs - submissions[i].timeMs);
+    if (ageMs >= slot.expiryMs) {
+      continue;
+    }
+    if (liveMask == 0 || slot.priority > topPriority) {
+      topPriority = slot.priority;
+    }
+    liveMask |= 1 << i;
+  }
+  
+  if (liveMask == 0) {
+    winners = 0;
+    hasOutput = false;
+    blending = false;
+    return false;
+  }
+  
+  // Weighted average of the sources sharing the top priority
+  int32_t sums[2][2] = {};
+  int32_t totalWeight = 0;
+  uint8_t mask = 0;
+  for (uint8_t i = 0; i < MAX_SOURCES; i++) {
+    Slot& slot = slots[i];
+    if ((liveMask & (1 << i)) == 0 || slot.priority != topPriority) {
+      continue;
+    }
+    for (uint8_t eye = 0; eye < 2; eye++) {
+      sums[eye][0] += submissions[i].targets[eye].x * slot.weight;
+      sums[eye][1] += submissions[i].targets[eye].y * slot.weight;
+    }
+    totalWeight += slot.weight;
+    slot.wins++;
+    mask |= 1 << i;
+  }
+  GazeTarget resolved[2];
+  for (uint8_t eye = 0; eye < 2; eye++) {
+    resolved[eye].x = static_cast<int16_t>(sums[eye][0] / totalWeight);
+    resolved[eye].y = static_cast<int16_t>(sums[eye][1] / totalWeight);
+  }
+  
+  // A new winner starts a blend from wherever the previous one left the output
+  if (mask != winners) {
+    if (winners != 0) {
+      switches++;
+    }
+    if (hasOutput && blendMs > 0) {
+      blendFrom[0] = output[0];
+      blendFrom[1] = output[1];
+      blendStartMs = nowMs;
+      blending = true;
+    }
+    winners = mask;
+  }
+  
+  uint32_t elapsedMs = nowMs - blendStartMs;
+  if (blending && elapsedMs >= blendMs) {
+    blending = false;
+  }
+  for (uint8_t eye = 0; eye < 2; eye++) {
+    if (blending) {
+      int32_t dx = resolved[eye].x - blendFrom[eye].x;
+      int32_t dy = resolved[eye].y - blendFrom[eye].y;
+      output[eye].x = static_cast<int16_t>(blendFrom[eye].x + dx * static_cast<int32_t>(elapsedMs) / blendMs);
+      output[eye].y = static_cast<int16_t>(blendFrom[eye].y + dy * static_cast<int32_t>(elapsedMs) / blendMs);
+    } else {
+      output[eye] = resolved[eye];
+    }
+    targets[eye] = output[eye];
+  }
+  hasOutput = true;
+  return true;
+}
+
+/**
+ * @brief Read what a source last submitted (consumer side)
+ * @param source Source slot
+ * @param submission Receives the submission
+ * @return false if the source has nothing submitted or is being written
+ */
+bool GazeArbiter::peek(uint8_t source, Submission& submission) const {
+  bool live;
+  return source < MAX_SOURCES && read(slots[source], submission, live);
+}
+
+/**
+ * @brief Check whether a source is enabled
+ * @param source Source slot
+ * @return true if configured and not disabled
+ */
+bool GazeArbiter::isEnabled(uint8_t source) const {
+  return source < MAX_SOURCES && slots[source].enabled;
+}
+
+/**
+ * @brief Get a source's priority
+ * @param source Source slot
+ * @return Priority (higher wins)
+ */
+uint8_t GazeArbiter::getPriority(uint8_t source) const {
+  return (source < MAX_SOURCES) ? slots[source].priority : 0;
+}
+
+/**
+ * @brief Get how long a source's submissions stay live
+ * @param source Source slot
+ * @return Expiry in milliseconds
+ */
+uint16_t GazeArbiter::getExpiry(uint8_t source) const {
+  return (source < MAX_SOURCES) ? slots[source].expiryMs : 0;
+}
+
+/**
+ * @brief Get number of frames a source contributed to the output
+ * @param source Source slot
+ * @return Frame count
+ */
+uint32_t GazeArbiter::getWins(uint8_t source) const {
+  return (source < MAX_SOURCES) ? slots[source].wins : 0;
+}
+
+/**
+ * @brief Get number of times the winning sources changed
+ * @return Switch count
+ */
+uint32_t GazeArbiter::getSwitches() const {
+  return switches;
+}
+
+/**
+ * @brief Get number of slot reads that found a submission half written
+ * @return Retry count
+ */
+uint32_t GazeArbiter::getRetries() const {
+  return retries;
+}
+
+/**
+ * @brief Check whether the output is sliding over to a new winner
+ * @return true while blending
+ */
+bool GazeArbiter::isBlending() const {
+  return blending;
+}
+
+/**
+ * @brief Read a slot consistently
+ * @param slot Slot to read
+ * @param submission Receives the submission
+ * @param live Receives whether it was not withdrawn
+ * @return false if nothing is submitted or it kept changing while read
+ */
+bool GazeArbiter::read(const Slot& slot, Submission& submission, bool& live) const {
+  for (uint8_t attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+    uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before == 0) {
+      return false;
+    }
+    if ((before & 1) == 0) {
+      uint32_t left = slot.left.load(std::memory_order_relaxed);
+      uint32_t right = slot.right.load(std::memory_order_relaxed);
+      uint32_t timeMs = slot.timeMs.load(std::memory_order_relaxed);
+      bool isLive = slot.live.load(std::memory_order_relaxed);
+  
+      // The acquire fence keeps the data loads before the second sequence read
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == before) {
+        submission.targets[0] = unpack(left);
+        submission.targets[1] = unpack(right);
+        submission.timeMs = timeMs;
+        live = isLive;
+        return true;
+      }
+    }
+    retries++;
+  }
+  return false;
+}
+
+/**
+ * @brief Pack a target into one word
+ * @param target Target to pack
+ * @return x in the low, y in the high half
+ */
+uint32_t GazeArbiter::pack(const GazeTarget& target) {
+  return static_cast<uint16_t>(target.x) | (static_cast<uint32_t>(static_cast<uint16_t>(target.y)) << 16);
+}
+
+/**
+ * @brief Unpack a target from one word
+ * @param value x in the low, y in the high half
+ * @return Target
+ */
+GazeTarget GazeArbiter::unpack(uint32_t value) {
+  GazeTarget target;
+  target.x = static_cast<int16_t>(value & 0xFFFF);
+  target.y = static_cast<int16_t>(value >> 16);
+  return target;
+}
@@ -0,0 +1,134 @@
+#include "GazeTable.h"
+#include "MemoryBudget.h"
+
+/**
+ * @brief Constructor
+ */
+GazeTable::GazeTable()
+  : nodes(nullptr),
+    mapping(nullptr),
+    context(nullptr),
+    width(0),
+    height(0),
+    columns(0),
+    rows(0),
+    cellShift(0)
+{
+}
+
+/**
+ * @brief Destructor
+ */
+GazeTable::~GazeTable() {
+  release();
+}
+
+/**
+ * @brief Allocate the grid and sample the exact mapping at every node
+ * @param width Screen width in pixels
+ * @param height Screen height in pixels
+ * @param cellShift Cell size as a power of two (MIN_CELL_SHIFT to MAX_CELL_SHIFT)
+ * @param mapping Exact mapping
+ * @param context Passed to the mapping (must outlive the table)
+ * @return false if the arguments are invalid or the grid cannot be allocated
+ */
+bool GazeTable::build(uint16_t width, uint16_t height, uint8_t cellShift, ExactMapping mapping,
+                      const void* context) {
+  release();
+  if (width == 0 || height == 0 || mapping == nullptr ||
+      cellShift < MIN_CELL_SHIFT || cellShift > MAX_CELL_SHIFT) {
+    return false;
+  }
+  
+  nodes = static_cast<int16_t*>(MemoryBudget::allocate(getBytes(width, height, cellShift),
+                                                       MemoryPlacement::INTERNAL, "gaze table"));
+  if (nodes == nullptr) {
+    return false;
+  }
+  
+  this->width = width;
+  this->height = height;
+  this->cellShift = cellShift;
+  this->mapping = mapping;
+  this->context = context;
+  // One extra node past the last pixel so every pixel has four surrounding nodes
+  columns = ((width - 1) >> cellShift) + 2;
+  rows = ((height - 1) >> cellShift) + 2;
+  refresh();
+  return true;
+}
+
+/**
+ * @brief Sample the exact mapping again after its inputs changed
+ */
+void GazeTable::refresh() {
+  if (nodes == nullptr) {
+    return;
+  }
+  
+  constexpr float SCALE = 1 << FRACTION_BITS;
+  int16_t* node = nodes;
+  for (uint16_t row = 0; row < rows; row++) {
+    for (uint16_t column = 0; column < columns; column++) {
+      float offsetX, offsetY;
+      mapping(context, column << cellShift, row << cellShift, offsetX, offsetY);
+      *node++ = static_cast<int16_t>(lroundf(offsetX * SCALE));
+      *node++ = static_cast<int16_t>(lroundf(offsetY * SCALE));
+    }
+  }
+}
+
+/**
+ * @brief Release the grid
+ */
+void GazeTable::release() {
+  MemoryBudget::release(nodes);
+  nodes = nullptr;
+}
+
+/**
+ * @brief Check whether the grid was built
+ * @return true if lookup() can be used
+ */
+bool GazeTable::isReady() const {
+  return nodes != nullptr;
+}
+
+/**
+ * @brief Look up the clamped pupil offset for a screen point
+ * @param screenPoint Screen coordinates (clamped to the screen)
+ * @return Pupil offset from the eye center, truncated toward zero like the exact path
+ */
+Point GazeTable::lookup(const Point& screenPoint) const {
+  int32_t x = constrain(screenPoint.x, 0, static_cast<int32_t>(width) - 1);
+  int32_t y = constrain(screenPoint.y, 0, static_cast<int32_t>(height) - 1);
+  
+  // Surrounding nodes and the weights of the far ones (0 to cell size - 1)
+  const int32_t cell = 1 << cellShift;
+  const int32_t fractionX = x & (cell - 1);
+  const int32_t fractionY = y & (cell - 1);
+  const int16_t* top = nodes + ((y >> cellShift) * columns + (x >> cellShift)) * 2;
+  const int16_t* bottom = top + columns * 2;
+  
+  // Weights sum to cell², so the result carries 2 * cellShift extra fraction bits
+  int32_t value[2];
+  for (uint8_t i = 0; i < 2; i++) {
+    int32_t upper = top[i] * (cell - fractionX) + top[i + 2] * fractionX;
+    int32_t lower = bottom[i] * (cell - fractionX) + bottom[i + 2] * fractionX;
+    value[i] = (upper * (cell - fractionY) + lower * fractionY) / (1 << (2 * cellShift + FRACTION_BITS));
+  }
+  return Point(static_cast<int16_t>(value[0]), static_cast<int16_t>(value[1]));
+}
+
+/**
+ * @brief Get grid size for a screen and cell size
+ * @param width Screen width in pixels
+ * @param height Screen height in pixels
+ * @param cellShift Cell size as a power of two
+ * @return Grid size in bytes
+ */
+size_t GazeTable::getBytes(uint16_t width, uint16_t height, uint8_t cellShift) {
+  size_t columns = ((width - 1) >> cellShift) + 2;
+  size_t rows = ((height - 1) >> cellShift) + 2;
+  return columns * rows * 2 * sizeof(int16_t);
+}
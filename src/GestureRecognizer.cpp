@@ -0,0 +1,265 @@
+#include "GestureRecognizer.h"
+
+namespace {
+  /**
+   * @brief Clamp a value to the int16_t range
+   * @param value Value to clamp
+   * @return Clamped value
+   */
+  int16_t clampToInt16(int32_t value) {
+    return static_cast<int16_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+  }
+}
+
+/**
+ * @brief Constructor
+ */
+GestureRecognizer::GestureRecognizer()
+  : phase(Phase::IDLE),
+    pressTimeMs(0),
+    pressX(0),
+    pressY(0),
+    tapPending(false),
+    tapReleaseMs(0),
+    tapX(0),
+    tapY(0),
+    history(),
+    historyCount(0),
+    historyHead(0),
+    events(),
+    eventHead(0),
+    eventCount(0),
+    droppedEvents(0) {
+}
+
+/**
+ * @brief Forget the gesture in progress and the queued events
+ */
+void GestureRecognizer::reset() {
+  phase = Phase::IDLE;
+  tapPending = false;
+  historyCount = 0;
+  eventCount = 0;
+}
+
+/**
+ * @brief Handle one touch sample
+ * @param timeMs Sampling time (not earlier than the previous sample)
+ * @param touching Whether the screen is touched
+ * @param count Number of touch points (a second one cancels the gesture)
+ * @param x X of the first touch point
+ * @param y Y of the first touch point
+ */
+void GestureRecognizer::addSample(uint32_t timeMs, bool touching, uint8_t count, int16_t x, int16_t y) {
+  if (!touching) {
+    if (phase != Phase::IDLE) {
+      release(timeMs);
+    }
+    return;
+  }
+  
+  if (phase == Phase::IDLE) {
+    phase = Phase::PRESSED;
+    pressTimeMs = timeMs;
+    pressX = x;
+    pressY = y;
+    historyCount = 0;
+  
+    // Too long after the previous tap to pair with it
+    if (tapPending && timeMs - tapReleaseMs > DOUBLE_TAP_MS) {
+      tapPending = false;
+    }
+  }
+  if (phase == Phase::CANCELLED) {
+    return;
+  }
+  if (count > 1) {
+    // Keep drag begin and end paired
+    if (phase == Phase::DRAGGING) {
+      queue(GestureType::DRAG_END, timeMs, x, y, true);
+    }
+    phase = Phase::CANCELLED;
+    tapPending = false;
+    return;
+  }
+  
+  history[historyHead] = { timeMs, x, y };
+  historyHead = (historyHead + 1) & (HISTORY_SIZE - 1);
+  if (historyCount < HISTORY_SIZE) {
+    historyCount++;
+  }
+  
+  switch (phase) {
+    case Phase::PRESSED:
+      if (!withinSlop(x, y, pressX, pressY)) {
+        phase = Phase::DRAGGING;
+        tapPending = false;
+        queue(GestureType::DRAG_BEGIN, timeMs, x, y, true);
+      } else if (timeMs - pressTimeMs >= LONG_PRESS_MS) {
+        phase = Phase::HELD;
+        tapPending = false;
+        queue(GestureType::LONG_PRESS, timeMs, pressX, pressY, false);
+      }
+      break;
+    case Phase::DRAGGING:
+      queue(GestureType::DRAG, timeMs, x, y, true);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Complete gestures that only need time to pass (long press without new samples)
+ * @param nowMs Current time (not earlier than the latest sample)
+ */
+void GestureRecognizer::advance(uint32_t nowMs) {
+  if (phase == Phase::PRESSED && static_cast<int32_t>(nowMs - pressTimeMs) >= LONG_PRESS_MS) {
+    phase = Phase::HELD;
+    tapPending = false;
+    queue(GestureType::LONG_PRESS, nowMs, pressX, pressY, false);
+  }
+}
+
+/**
+ * @brief Take the oldest queued event
+ * @param event Receives the event
+ * @return false if there is none
+ */
+bool GestureRecognizer::takeEvent(GestureEvent& event) {
+  if (eventCount == 0) {
+    return false;
+  }
+  event = events[eventHead];
+  eventHead = (eventHead + 1) % EVENT_CAPACITY;
+  eventCount--;
+  return true;
+}
+
+/**
+ * @brief Get number of events dropped because nobody took them
+ * @return Dropped event count
+ */
+uint32_t GestureRecognizer::getDroppedEvents() const {
+  return droppedEvents;
+}
+
+/**
+ * @brief Estimate the velocity from the history
+ * @param velocityX Receives the x velocity in pixels per second
+ * @param velocityY Receives the y velocity in pixels per second
+ */
+void GestureRecognizer::estimateVelocity(int16_t& velocityX, int16_t& velocityY) const {
+  velocityX = 0;
+  velocityY = 0;
+  if (historyCount < 2) {
+    return;
+  }
+  
+  // Oldest sample within the window, walking back from the newest
+  const HistorySample& newest = history[(historyHead - 1) & (HISTORY_SIZE - 1)];
+  const HistorySample* oldest = &newest;
+  for (uint8_t i = 2; i <= historyCount; i++) {
+    const HistorySample& sample = history[(historyHead - i) & (HISTORY_SIZE - 1)];
+    if (newest.timeMs - sample.timeMs > VELOCITY_WINDOW_MS) {
+      break;
+    }
+    oldest = &sample;
+  }
+  int32_t dt = static_cast<int32_t>(newest.timeMs - oldest->timeMs);
+  if (dt <= 0) {
+    return;
+  }
+  velocityX = clampToInt16((newest.x - oldest->x) * 1000 / dt);
+  velocityY = clampToInt16((newest.y - oldest->y) * 1000 / dt);
+}
+
+/**
+ * @brief Queue an event (a DRAG replaces a DRAG still queued)
+ * @param type Gesture
+ * @param timeMs Time of completion
+ * @param x X position
+ * @param y Y position
+ * @param withVelocity Whether to fill in the velocity and direction
+ */
+void GestureRecognizer::queue(GestureType type, uint32_t timeMs, int16_t x, int16_t y, bool withVelocity) {
+  GestureEvent event = { type, GestureDirection::NONE, timeMs, x, y, 0, 0 };
+  if (withVelocity) {
+    estimateVelocity(event.velocityX, event.velocityY);
+    event.direction = directionOf(event.velocityX, event.velocityY);
+  }
+  
+  if (type == GestureType::DRAG && eventCount > 0) {
+    GestureEvent& last = events[(eventHead + eventCount - 1) % EVENT_CAPACITY];
+    if (last.type == GestureType::DRAG) {
+      last = event;
+      return;
+    }
+  }
+  if (eventCount == EVENT_CAPACITY) {
+    droppedEvents++;
+    return;
+  }
+  events[(eventHead + eventCount) % EVENT_CAPACITY] = event;
+  eventCount++;
+}
+
+/**
+ * @brief Handle the release of the touch in progress
+ * @param timeMs Release time
+ */
+void GestureRecognizer::release(uint32_t timeMs) {
+  if (phase == Phase::PRESSED && timeMs - pressTimeMs <= TAP_MAX_MS) {
+    if (tapPending && withinSlop(pressX, pressY, tapX, tapY)) {
+      queue(GestureType::DOUBLE_TAP, timeMs, pressX, pressY, false);
+      tapPending = false;
+    } else {
+      queue(GestureType::TAP, timeMs, pressX, pressY, false);
+      tapPending = true;
+      tapReleaseMs = timeMs;
+      tapX = pressX;
+      tapY = pressY;
+    }
+  } else if (phase == Phase::DRAGGING) {
+    // Release samples repeat the last position, so the velocity comes from the touching ones
+    const HistorySample& last = history[(historyHead - 1) & (HISTORY_SIZE - 1)];
+    queue(GestureType::DRAG_END, timeMs, last.x, last.y, true);
+    int16_t velocityX, velocityY;
+    estimateVelocity(velocityX, velocityY);
+    int32_t speedSquared = static_cast<int32_t>(velocityX) * velocityX + static_cast<int32_t>(velocityY) * velocityY;
+    if (speedSquared >= static_cast<int32_t>(FLICK_MIN_SPEED) * FLICK_MIN_SPEED) {
+      queue(GestureType::FLICK, timeMs, last.x, last.y, true);
+    }
+  } else {
+    tapPending = false;
+  }
+  phase = Phase::IDLE;
+}
+
+/**
+ * @brief Get the dominant direction of a velocity
+ * @param velocityX X velocity
+ * @param velocityY Y velocity
+ * @return Direction (NONE if not moving)
+ */
+GestureDirection GestureRecognizer::directionOf(int16_t velocityX, int16_t velocityY) {
+  if (velocityX == 0 && velocityY == 0) {
+    return GestureDirection::NONE;
+  }
+  int32_t absX = velocityX < 0 ? -velocityX : velocityX;
+  int32_t absY = velocityY < 0 ? -velocityY : velocityY;
+  if (absX >= absY) {
+    return velocityX < 0 ? GestureDirection::LEFT : GestureDirection::RIGHT;
+  }
+  return velocityY < 0 ? GestureDirection::UP : GestureDirection::DOWN;
+}
+
+/**
+ * @brief Check whether a position is within the slop of another
+ * @return true if neither coordinate differs by more than SLOP_PX
+ */
+bool GestureRecognizer::withinSlop(int16_t x, int16_t y, int16_t originX, int16_t originY) {
+  int32_t dx = x - originX;
+  int32_t dy = y - originY;
+  return dx <= SLOP_PX && dx >= -SLOP_PX && dy <= SLOP_PX && dy >= -SLOP_PX;
+}
@@ -0,0 +1,85 @@
+#include "GovernorPolicy.h"
+
+/**
+ * @brief Constructor
+ * @param mhz Frequency to ask for
+ */
+FixedFrequencyPolicy::FixedFrequencyPolicy(uint16_t mhz)
+  : mhz(mhz)
+{
+}
+
+/**
+ * @brief FrequencyPolicy entry point
+ * @param context FixedFrequencyPolicy instance
+ * @param sample Finished frame
+ * @return Frequency for the following frames
+ */
+uint16_t FixedFrequencyPolicy::decide(void* context, const GovernorSample& /*sample*/) {
+  return static_cast<FixedFrequencyPolicy*>(context)->mhz;
+}
+
+/**
+ * @brief Constructor
+ */
+LoadFrequencyPolicy::LoadFrequencyPolicy()
+  : raiseStreak(0),
+    lowerStreak(0)
+{
+}
+
+/**
+ * @brief FrequencyPolicy entry point
+ * @param context LoadFrequencyPolicy instance
+ * @param sample Finished frame
+ * @return Frequency for the following frames
+ */
+uint16_t LoadFrequencyPolicy::decide(void* context, const GovernorSample& sample) {
+  return static_cast<LoadFrequencyPolicy*>(context)->choose(sample);
+}
+
+/**
+ * @brief Pick the frequency for the following frames
+ * @param sample Finished frame
+ * @return Frequency for the following frames
+ */
+uint16_t LoadFrequencyPolicy::choose(const GovernorSample& sample) {
+  // Start from the step the frame actually ran at, so a rejected switch is not assumed
+  uint8_t step = 0;
+  while (step < NUM_OF_STEPS - 1 && STEPS_MHZ[step + 1] <= sample.currentMhz) {
+    step++;
+  }
+  
+  uint8_t floorStep = LOAD_FLOOR_STEP[static_cast<uint8_t>(sample.load)];
+  if (step < floorStep) {
+    raiseStreak = 0;
+    lowerStreak = 0;
+    return STEPS_MHZ[floorStep];
+  }
+  
+  uint64_t scaledWork = static_cast<uint64_t>(sample.workMicros) * 100;
+  if (scaledWork > static_cast<uint64_t>(sample.budgetMicros) * RAISE_PERCENT) {
+    lowerStreak = 0;
+    if (raiseStreak < RAISE_AFTER_FRAMES) {
+      raiseStreak++;
+    }
+    if (raiseStreak >= RAISE_AFTER_FRAMES && step < NUM_OF_STEPS - 1) {
+      raiseStreak = 0;
+      step++;
+    }
+  } else if (scaledWork < static_cast<uint64_t>(sample.budgetMicros) * LOWER_PERCENT) {
+    raiseStreak = 0;
+    if (lowerStreak < LOWER_AFTER_FRAMES) {
+      lowerStreak++;
+    }
+    if (lowerStreak >= LOWER_AFTER_FRAMES && step > floorStep) {
+      lowerStreak = 0;
+      step--;
+    }
+  } else {
+    raiseStreak = 0;
+    lowerStreak = 0;
+  }
+  
+  return STEPS_MHZ[step];
+}
@@ -0,0 +1,234 @@
+#include "InputSampler.h"
+
+namespace {
+  /**
+   * @brief Convert a reading to a saturated integer
+   * @param value Reading
+   * @param scale Units per reading unit
+   * @return Scaled reading
+   */
+  int16_t toFixed(float value, float scale) {
+    float scaled = value * scale;
+    return static_cast<int16_t>(scaled > 32767.0F ? 32767.0F : scaled < -32767.0F ? -32767.0F : scaled);
+  }
+  
+  /**
+   * @brief Saturate a tilt component to 16 bits
+   * @param value Component in Q14
+   * @return Component limited to just under 2 g
+   */
+  uint16_t packTilt(int32_t value) {
+    return static_cast<uint16_t>(value > 32767 ? 32767 : value < -32767 ? -32767 : value);
+  }
+}
+
+/**
+ * @brief Constructor
+ * @param clock Time source used to stamp samples
+ */
+InputSampler::InputSampler(const Clock& clock)
+  : clock(clock),
+    touchQueue(nullptr),
+    task(nullptr),
+    lastTouchState(m5::touch_state_t::none),
+    peakAccelMilliG(0),
+    droppedTouchSamples(0),
+    touchCountdown(0),
+    tiltFilter(),
+    tilt(0),
+    tiltValid(false),
+    fusionSamples(0),
+    fusionCycles(0),
+    fusionMaxCycles(0),
+    imuTraceLeft(0),
+    imuTrace()
+{
+}
+
+/**
+ * @brief Start the sampler task
+ * @param touchHandler Touch handler receiving samples (switched to queue mode)
+ * @return Whether the task was started
+ */
+bool InputSampler::begin(TouchHandler& touchHandler) {
+  if (task != nullptr) {
+    return true;
+  }
+  
+  touchQueue = &touchHandler.getQueue();
+  if (xTaskCreatePinnedToCore(taskLoop, "InputSampler", TASK_STACK_SIZE, this,
+                              TASK_PRIORITY, &task, TASK_CORE) != pdPASS) {
+    task = nullptr;
+    return false;
+  }
+  
+  touchHandler.setQueueMode(true);
+  return true;
+}
+
+/**
+ * @brief Check whether the sampler task is running
+ * @return true if running
+ */
+bool InputSampler::isRunning() const {
+  return task != nullptr;
+}
+
+/**
+ * @brief Take the peak acceleration since the previous call
+ * @param magnitude Receives the peak magnitude in g
+ * @return false if no acceleration was sampled since the previous call
+ */
+bool InputSampler::takePeakAcceleration(float& magnitude) {
+  uint32_t peak = peakAccelMilliG.exchange(0, std::memory_order_acquire);
+  if (peak == 0) {
+    return false;
+  }
+  magnitude = peak / 1000.0F;
+  return true;
+}
+
+/**
+ * @brief Get number of touch samples dropped because the queue was full
+ * @return Dropped sample count
+ */
+uint32_t InputSampler::getDroppedTouchSamples() const {
+  return droppedTouchSamples.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the latest tilt estimate
+ * @param x Receives the reaction to gravity along the panel's x axis (Q14, 1 g = 16384)
+ * @param y Receives the reaction to gravity along the panel's y axis
+ * @return false if no estimate is available
+ */
+bool InputSampler::getTilt(int16_t& x, int16_t& y) const {
+  if (!tiltValid.load(std::memory_order_acquire)) {
+    return false;
+  }
+  uint32_t packed = tilt.load(std::memory_order_relaxed);
+  x = static_cast<int16_t>(packed & 0xFFFF);
+  y = static_cast<int16_t>(packed >> 16);
+  return true;
+}
+
+/**
+ * @brief Take the cost of fusing IMU samples since the previous call
+ * @param samples Receives the number of samples fused
+ * @param averageCycles Receives the average CPU cycles per sample
+ * @param maxCycles Receives the largest CPU cycles for one sample
+ */
+void InputSampler::takeFusionCost(uint32_t& samples, uint32_t& averageCycles, uint32_t& maxCycles) {
+  samples = fusionSamples.exchange(0, std::memory_order_relaxed);
+  uint32_t cycles = fusionCycles.exchange(0, std::memory_order_relaxed);
+  averageCycles = (samples > 0) ? cycles / samples : 0;
+  maxCycles = fusionMaxCycles.exchange(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Start queueing raw IMU samples for takeImuSample()
+ * @param samples Number of samples to queue (0 stops)
+ */
+void InputSampler::traceImu(uint16_t samples) {
+  imuTraceLeft.store(samples, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Take a queued IMU sample
+ * @param sample Receives the sample
+ * @return false if none is queued
+ */
+bool InputSampler::takeImuSample(ImuSample& sample) {
+  return imuTrace.pop(sample);
+}
+
+/**
+ * @brief Sampler task body
+ * @param param InputSampler instance
+ */
+void InputSampler::taskLoop(void* param) {
+  InputSampler* self = static_cast<InputSampler*>(param);
+  TickType_t lastWake = xTaskGetTickCount();
+  for (;;) {
+    self->sample();
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SAMPLE_INTERVAL_MS));
+  }
+}
+
+/**
+ * @brief Take one sample of every input
+ */
+void InputSampler::sample() {
+  uint32_t now = clock.nowMillis();
+  
+  // Touch: every sample while touched, otherwise only state changes
+  if (touchCountdown == 0) {
+    touchCountdown = TOUCH_EVERY;
+    M5.update();
+    TouchSample touchSample = TouchHandler::readSample(now);
+    if (touchSample.count > 0 || touchSample.state != lastTouchState) {
+      lastTouchState = touchSample.state;
+      if (!touchQueue->push(touchSample)) {
+        droppedTouchSamples.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+  touchCountdown--;
+  
+  sampleImu(now);
+}
+
+/**
+ * @brief Read the IMU, keep the peak acceleration and fuse the tilt
+ * @param now Time of the sample
+ */
+void InputSampler::sampleImu(uint32_t now) {
+  float ax, ay, az;
+  if (!M5.Imu.getAccel(&ax, &ay, &az)) {
+    return;
+  }
+  
+  // Acceleration: keep the peak until the animation takes it (stored +1 so that 0 means none)
+  uint32_t magnitude = static_cast<uint32_t>(sqrtf(ax * ax + ay * ay + az * az) * 1000.0F) + 1;
+  uint32_t peak = peakAccelMilliG.load(std::memory_order_relaxed);
+  while (magnitude > peak &&
+         !peakAccelMilliG.compare_exchange_weak(peak, magnitude, std::memory_order_release)) {
+  }
+  
+  float gx, gy, gz;
+  if (!M5.Imu.getGyro(&gx, &gy, &gz)) {
+    return;
+  }
+  
+  // The IMU's y axis points up the landscape panel and z towards the viewer; flip both into panel axes
+  ImuSample imuSample;
+  imuSample.timeMs = now;
+  imuSample.accel[0] = toFixed(ax, 1000.0F);
+  imuSample.accel[1] = toFixed(-ay, 1000.0F);
+  imuSample.accel[2] = toFixed(-az, 1000.0F);
+  imuSample.gyro[0] = toFixed(gx, 10.0F);
+  imuSample.gyro[1] = toFixed(-gy, 10.0F);
+  imuSample.gyro[2] = toFixed(-gz, 10.0F);
+  
+  uint32_t start = ESP.getCycleCount();
+  tiltFilter.update(imuSample);
+  uint32_t cycles = ESP.getCycleCount() - start;
+  
+  tilt.store(packTilt(tiltFilter.get(0)) | (static_cast<uint32_t>(packTilt(tiltFilter.get(1))) << 16),
+             std::memory_order_relaxed);
+  tiltValid.store(true, std::memory_order_release);
+  
+  // Readers take the counters; they may see them a sample apart
+  fusionSamples.fetch_add(1, std::memory_order_relaxed);
+  fusionCycles.fetch_add(cycles, std::memory_order_relaxed);
+  uint32_t maxCycles = fusionMaxCycles.load(std::memory_order_relaxed);
+  while (cycles > maxCycles &&
+         !fusionMaxCycles.compare_exchange_weak(maxCycles, cycles, std::memory_order_relaxed)) {
+  }
+  
+  // A full trace queue drops samples rather than delaying input
+  uint16_t traceLeft = imuTraceLeft.load(std::memory_order_relaxed);
+  if (traceLeft > 0 && imuTrace.push(imuSample)) {
+    imuTraceLeft.compare_exchange_strong(traceLeft, traceLeft - 1, std::memory_order_relaxed);
+  }
+}
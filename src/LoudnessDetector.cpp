@@ -0,0 +1,169 @@
+#include "LoudnessDetector.h"
+
+namespace {
+  constexpr uint32_t DECIBEL_RATIO_Q16 = 82503;  // 10^(1/10): power ratio of 1 dB
+}
+
+/**
+ * @brief Constructor
+ * @param sampleRate Sample rate in Hz
+ */
+LoudnessDetector::LoudnessDetector(uint32_t sampleRate)
+  : sampleRate(sampleRate),
+    thresholdDb(0),
+    thresholdRatio(0),
+    started(false),
+    dcOffset(0),
+    meanSquare(0),
+    floorMeanSquare(0),
+    armed(true),
+    samplesSinceOnset(0),
+    warmupSamples(0),
+    onsets(0) {
+  setThresholdDb(THRESHOLD_DB);
+  reset();
+}
+
+/**
+ * @brief Forget the floor, the DC offset and the onset in progress
+ */
+void LoudnessDetector::reset() {
+  started = false;
+  dcOffset = 0;
+  meanSquare = 0;
+  floorMeanSquare = 0;
+  armed = true;
+  samplesSinceOnset = UINT32_MAX;
+  warmupSamples = sampleRate * WARMUP_MS / 1000;
+}
+
+/**
+ * @brief Set how far above the floor a block must be to start an onset
+ * @param thresholdDb Threshold in dB (limited to MAX_THRESHOLD_DB)
+ */
+void LoudnessDetector::setThresholdDb(uint8_t thresholdDb) {
+  this->thresholdDb = (thresholdDb > MAX_THRESHOLD_DB) ? MAX_THRESHOLD_DB : thresholdDb;
+  
+  // 10^(dB/10) in Q16 by repeated multiplication, then down to Q8 (at most 10^4 * 256)
+  uint64_t ratio = 1 << 16;
+  for (uint8_t i = 0; i < this->thresholdDb; i++) {
+    ratio = (ratio * DECIBEL_RATIO_Q16 + (1 << 15)) >> 16;
+  }
+  thresholdRatio = static_cast<uint32_t>(ratio >> 8);
+}
+
+/**
+ * @brief Get the onset threshold
+ * @return Threshold in dB
+ */
+uint8_t LoudnessDetector::getThresholdDb() const {
+  return thresholdDb;
+}
+
+/**
+ * @brief Process one block of mono samples
+ * @param samples Samples
+ * @param count Number of samples (at most 65536)
+ * @return true if the block starts an onset
+ */
+bool LoudnessDetector::process(const int16_t* samples, size_t count) {
+  if (count == 0) {
+    return false;
+  }
+  bool first = !started;
+  if (first) {
+    dcOffset = static_cast<int32_t>(samples[0]) << 8;
+    started = true;
+  }
+  
+  // One-pole DC tracker; the remainder is clamped to 16 bits so that squares stay 32-bit multiplies
+  uint64_t sum = 0;
+  for (size_t i = 0; i < count; i++) {
+    int32_t sample = static_cast<int32_t>(samples[i]) << 8;
+    dcOffset += (sample - dcOffset) >> DC_SHIFT;
+    int32_t ac = (sample - dcOffset) >> 8;
+    ac = (ac > INT16_MAX) ? INT16_MAX : (ac < -INT16_MAX ? -INT16_MAX : ac);
+    sum += static_cast<uint32_t>(ac * ac);
+  }
+  meanSquare = static_cast<uint32_t>(sum / count);
+  uint64_t levelQ8 = static_cast<uint64_t>(meanSquare) << 8;
+  if (first) {
+    floorMeanSquare = levelQ8;
+  }
+  
+  // Against the floor before this block: level^2 * 2^16 against floor (Q8) * ratio (Q8)
+  bool above = (levelQ8 << 8) > floorMeanSquare * thresholdRatio &&
+               meanSquare > static_cast<uint32_t>(MIN_RMS) * MIN_RMS;
+  
+  // The floor rises slowly and falls fast
+  if (levelQ8 > floorMeanSquare) {
+    floorMeanSquare += (levelQ8 - floorMeanSquare) >> FLOOR_RISE_SHIFT;
+  } else {
+    floorMeanSquare -= (floorMeanSquare - levelQ8) >> FLOOR_FALL_SHIFT;
+  }
+  
+  samplesSinceOnset = (samplesSinceOnset > UINT32_MAX - count) ? UINT32_MAX : samplesSinceOnset + count;
+  if (warmupSamples > 0) {
+    warmupSamples = (warmupSamples > count) ? warmupSamples - count : 0;
+    return false;
+  }
+  if (!above) {
+    armed = true;
+    return false;
+  }
+  if (!armed || samplesSinceOnset < sampleRate * REFRACTORY_MS / 1000) {
+    return false;
+  }
+  armed = false;
+  samplesSinceOnset = 0;
+  onsets++;
+  return true;
+}
+
+/**
+ * @brief Get the RMS level of the latest block
+ * @return RMS after DC removal (full scale 32767)
+ */
+uint16_t LoudnessDetector::getLevel() const {
+  return static_cast<uint16_t>(squareRoot(meanSquare));
+}
+
+/**
+ * @brief Get the RMS level of the noise floor
+ * @return RMS (full scale 32767)
+ */
+uint16_t LoudnessDetector::getFloor() const {
+  return static_cast<uint16_t>(squareRoot(floorMeanSquare >> 8));
+}
+
+/**
+ * @brief Get number of onsets since construction
+ * @return Onset count
+ */
+uint32_t LoudnessDetector::getOnsets() const {
+  return onsets;
+}
+
+/**
+ * @brief Get the integer square root
+ * @param value Value
+ * @return Largest integer whose square does not exceed value
+ */
+uint32_t LoudnessDetector::squareRoot(uint64_t value) {
+  // Digit-by-digit, two bits of the value per result bit
+  uint64_t root = 0;
+  uint64_t bit = static_cast<uint64_t>(1) << 62;
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint32_t>(root);
+}
@@ -0,0 +1,215 @@
+#include "MemoryBudget.h"
+#include <esp_heap_caps.h>
+
+namespace {
+  /**
+   * @brief Tracked allocation record
+   */
+  struct Entry {
+    const char* tag;
+    const void* buffer;
+    uint32_t bytes;
+    MemoryPlacement placement;
+  };
+  
+  // Plain arrays so that tracking works from global constructors
+  Entry entries[MemoryBudget::MAX_ENTRIES];
+  uint8_t entryCount;
+  uint8_t failureCount;
+  
+  /**
+   * @brief Record an allocation
+   * @param tag Name shown in the heap report
+   * @param buffer Allocated buffer
+   * @param bytes Buffer size
+   * @param placement Actual placement
+   */
+  void record(const char* tag, const void* buffer, size_t bytes, MemoryPlacement placement) {
+    if (entryCount < MemoryBudget::MAX_ENTRIES) {
+      entries[entryCount++] = { tag, buffer, static_cast<uint32_t>(bytes), placement };
+    }
+  }
+  
+  /**
+   * @brief Stop tracking an allocation
+   * @param buffer Allocated buffer
+   */
+  void forget(const void* buffer) {
+    for (uint8_t i = 0; i < entryCount; i++) {
+      if (entries[i].buffer == buffer) {
+        entries[i] = entries[--entryCount];
+        return;
+      }
+    }
+  }
+  
+  /**
+   * @brief Get display name of a placement
+   * @param placement Placement
+   * @return Display name
+   */
+  const char* placementName(MemoryPlacement placement) {
+    switch (placement) {
+      case MemoryPlacement::PSRAM:
+        return "psram";
+      case MemoryPlacement::FLASH:
+        return "flash";
+      case MemoryPlacement::INTERNAL:
+      default:
+        return "internal";
+    }
+  }
+}
+
+/**
+ * @brief Create a sprite buffer according to a placement policy
+ * @param canvas Canvas to create the sprite on
+ * @param width Sprite width
+ * @param height Sprite height
+ * @param colorDepth Sprite color depth in bits
+ * @param placement Requested placement (PSRAM falls back to internal RAM)
+ * @param tag Name shown in the heap report
+ * @return Whether the sprite buffer was allocated
+ */
+bool MemoryBudget::createSprite(M5Canvas& canvas, int32_t width, int32_t height, uint8_t colorDepth,
+                                MemoryPlacement placement, const char* tag) {
+  bool usePsram = (placement == MemoryPlacement::PSRAM) && psramFound();
+  
+  canvas.setColorDepth(colorDepth);
+  canvas.setPsram(usePsram);
+  void* buffer = canvas.createSprite(width, height);
+  
+  // Fall back to internal RAM when PSRAM is exhausted
+  if (buffer == nullptr && usePsram) {
+    usePsram = false;
+    canvas.setPsram(false);
+    buffer = canvas.createSprite(width, height);
+  }
+  
+  if (buffer == nullptr) {
+    failureCount++;
+    return false;
+  }
+  
+  record(tag, buffer, canvas.bufferLength(),
+         usePsram ? MemoryPlacement::PSRAM : MemoryPlacement::INTERNAL);
+  return true;
+}
+
+/**
+ * @brief Delete a sprite buffer created with createSprite()
+ * @param canvas Canvas to delete the sprite of
+ */
+void MemoryBudget::deleteSprite(M5Canvas& canvas) {
+  forget(canvas.getBuffer());
+  canvas.deleteSprite();
+}
+
+/**
+ * @brief Allocate a raw buffer according to a placement policy
+ * @param bytes Buffer size
+ * @param placement Requested placement (PSRAM falls back to internal RAM)
+ * @param tag Name shown in the heap report
+ * @return Buffer, or nullptr if allocation failed
+ */
+void* MemoryBudget::allocate(size_t bytes, MemoryPlacement placement, const char* tag) {
+  void* buffer = nullptr;
+  MemoryPlacement actual = MemoryPlacement::INTERNAL;
+  
+  if (placement == MemoryPlacement::PSRAM && psramFound()) {
+    buffer = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    actual = MemoryPlacement::PSRAM;
+  }
+  
+  // Fall back to internal RAM when PSRAM is unavailable or exhausted
+  if (buffer == nullptr) {
+    buffer = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    actual = MemoryPlacement::INTERNAL;
+  }
+  
+  if (buffer == nullptr) {
+    failureCount++;
+    return nullptr;
+  }
+  
+  record(tag, buffer, bytes, actual);
+  return buffer;
+}
+
+/**
+ * @brief Release a buffer obtained from allocate()
+ * @param buffer Buffer to release
+ */
+void MemoryBudget::release(void* buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  
+  forget(buffer);
+  heap_caps_free(buffer);
+}
+
+/**
+ * @brief Record a read-only table that lives in flash
+ * @param bytes Table size
+ * @param tag Name shown in the heap report
+ */
+void MemoryBudget::trackStatic(size_t bytes, const char* tag) {
+  // Tables are shared, so track each one once however many users register it
+  for (uint8_t i = 0; i < entryCount; i++) {
+    if (entries[i].placement == MemoryPlacement::FLASH && entries[i].tag == tag) {
+      return;
+    }
+  }
+  record(tag, nullptr, bytes, MemoryPlacement::FLASH);
+}
+
+/**
+ * @brief Get total tracked bytes for a placement
+ * @param placement Placement to sum
+ * @return Tracked bytes
+ */
+size_t MemoryBudget::getUsage(MemoryPlacement placement) {
+  size_t total = 0;
+  for (uint8_t i = 0; i < entryCount; i++) {
+    if (entries[i].placement == placement) {
+      total += entries[i].bytes;
+    }
+  }
+  return total;
+}
+
+/**
+ * @brief Get number of failed allocations
+ * @return Failed allocation count
+ */
+uint8_t MemoryBudget::getFailureCount() {
+  return failureCount;
+}
+
+/**
+ * @brief Print heap and tracked allocation report
+ * @param out Output stream
+ */
+void MemoryBudget::printReport(Print& out) {
+  out.printf("[memory] internal: free %u B, largest block %u B, min free %u B\n",
+             static_cast<unsigned>(heap_caps_get_free_size(MALLOC_CAP_INTERNAL)),
+             static_cast<unsigned>(heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL)),
+             static_cast<unsigned>(heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL)));
+  if (psramFound()) {
+    out.printf("[memory] psram: free %u B, largest block %u B\n",
+               static_cast<unsigned>(heap_caps_get_free_size(MALLOC_CAP_SPIRAM)),
+               static_cast<unsigned>(heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM)));
+  } else {
+    out.println("[memory] psram: not available");
+  }
+  out.printf("[memory] tracked: internal %u B, psram %u B, flash %u B, failed %u\n",
+             static_cast<unsigned>(getUsage(MemoryPlacement::INTERNAL)),
+             static_cast<unsigned>(getUsage(MemoryPlacement::PSRAM)),
+             static_cast<unsigned>(getUsage(MemoryPlacement::FLASH)),
+             failureCount);
+  for (uint8_t i = 0; i < entryCount; i++) {
+    out.printf("[memory]   %-20s %6u B  %s\n",
+               entries[i].tag, static_cast<unsigned>(entries[i].bytes), placementName(entries[i].placement));
+  }
+}
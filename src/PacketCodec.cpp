@@ -0,0 +1,269 @@
+#include "PacketCodec.h"
+#include <string.h>
+
+/**
+ * @brief Constructor
+ */
+PacketCodec::PacketCodec()
+  : parseState(ParseState::SYNC),
+    command(0),
+    length(0),
+    received(0),
+    checksum(0),
+    payload(),
+    reply(),
+    replyLength(0),
+    badPackets(0)
+{
+}
+
+/**
+ * @brief Feed one received byte to the request parser
+ * @param value Received byte
+ * @return true if the byte completed a request with a valid checksum
+ */
+bool PacketCodec::parse(uint8_t value) {
+  switch (parseState) {
+    case ParseState::SYNC:
+      // Anything between packets is ignored
+      if (value == SYNC_REQUEST) {
+        checksum = value;
+        parseState = ParseState::COMMAND;
+      }
+      return false;
+  
+    case ParseState::COMMAND:
+      command = value;
+      parseState = ParseState::LENGTH;
+      break;
+  
+    case ParseState::LENGTH:
+      if (value > MAX_REQUEST_PAYLOAD) {
+        badPackets++;
+        parseState = ParseState::SYNC;
+        return false;
+      }
+      length = value;
+      received = 0;
+      parseState = (length > 0) ? ParseState::PAYLOAD : ParseState::CHECKSUM;
+      break;
+  
+    case ParseState::PAYLOAD:
+      payload[received++] = value;
+      if (received == length) {
+        parseState = ParseState::CHECKSUM;
+      }
+      break;
+  
+    case ParseState::CHECKSUM:
+      parseState = ParseState::SYNC;
+      if (value != checksum) {
+        badPackets++;
+        return false;
+      }
+      return true;
+  }
+  
+  checksum += value;
+  return false;
+}
+
+/**
+ * @brief Get command of the latest complete request
+ * @return Command byte
+ */
+uint8_t PacketCodec::getCommand() const {
+  return command;
+}
+
+/**
+ * @brief Get payload length of the latest complete request
+ * @return Payload length
+ */
+uint8_t PacketCodec::getLength() const {
+  return length;
+}
+
+/**
+ * @brief Get payload of the latest complete request
+ * @return Payload (getLength() bytes, valid until the next parse())
+ */
+const uint8_t* PacketCodec::getPayload() const {
+  return payload;
+}
+
+/**
+ * @brief Get number of malformed request packets
+ * @return Bad packet count
+ */
+uint32_t PacketCodec::getBadPackets() const {
+  return badPackets;
+}
+
+/**
+ * @brief Answer the latest request if it is PING or a parameter request
+ * @param parameters Registry the request refers to
+ * @return false if the request is of another kind (nothing is framed)
+ */
+bool PacketCodec::answerParameterRequest(ParameterRegistry& parameters) {
+  switch (command) {
+    case PING: {
+      uint8_t* out = reply + PAYLOAD_OFFSET;
+      out[0] = OK;
+      out[1] = VERSION;
+      out[2] = parameters.getCount();
+      frame(PING | REPLY_FLAG, 3);
+      return true;
+    }
+  
+    case PARAM_INFO:
+    case PARAM_GET:
+      if (length != 1) {
+        frameStatus(BAD_LENGTH);
+        return true;
+      }
+      frameParameter(parameters, payload[0], command == PARAM_INFO);
+      return true;
+  
+    case PARAM_SET: {
+      if (length != 5) {
+        frameStatus(BAD_LENGTH);
+        return true;
+      }
+      uint8_t id = payload[0];
+      if (parameters.get(id) == nullptr) {
+        frameStatus(UNKNOWN_PARAMETER);
+        return true;
+      }
+      if (!parameters.write(id, readU32(payload + 1))) {
+        frameStatus(OUT_OF_RANGE);
+        return true;
+      }
+      frameParameter(parameters, id, false);
+      return true;
+    }
+  
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Frame a reply to the latest request with a bare status
+ * @param status Status code
+ */
+void PacketCodec::frameStatus(Status status) {
+  reply[PAYLOAD_OFFSET] = status;
+  frame(command | REPLY_FLAG, 1);
+}
+
+/**
+ * @brief Frame a packet whose payload is already in the reply payload buffer
+ * @param packetCommand Command byte
+ * @param payloadLength Payload length (at most MAX_REPLY_PAYLOAD)
+ */
+void PacketCodec::frame(uint8_t packetCommand, uint8_t payloadLength) {
+  reply[0] = SYNC_REPLY;
+  reply[1] = packetCommand;
+  reply[2] = payloadLength;
+  uint8_t sum = 0;
+  for (uint8_t i = 0; i < PAYLOAD_OFFSET + payloadLength; i++) {
+    sum += reply[i];
+  }
+  reply[PAYLOAD_OFFSET + payloadLength] = sum;
+  replyLength = payloadLength + OVERHEAD;
+}
+
+/**
+ * @brief Get the reply payload buffer to fill before frame()
+ * @return MAX_REPLY_PAYLOAD bytes
+ */
+uint8_t* PacketCodec::getReplyPayload() {
+  return reply + PAYLOAD_OFFSET;
+}
+
+/**
+ * @brief Get the most recently framed packet
+ * @return Packet (getPacketLength() bytes)
+ */
+const uint8_t* PacketCodec::getPacket() const {
+  return reply;
+}
+
+/**
+ * @brief Get length of the most recently framed packet
+ * @return Packet length including the overhead
+ */
+uint8_t PacketCodec::getPacketLength() const {
+  return replyLength;
+}
+
+/**
+ * @brief Write a 16-bit value in little endian
+ * @param output Destination
+ * @param value Value to write
+ */
+void PacketCodec::writeU16(uint8_t* output, uint16_t value) {
+  output[0] = static_cast<uint8_t>(value);
+  output[1] = static_cast<uint8_t>(value >> 8);
+}
+
+/**
+ * @brief Write a 32-bit value in little endian
+ * @param output Destination
+ * @param value Value to write
+ */
+void PacketCodec::writeU32(uint8_t* output, uint32_t value) {
+  writeU16(output, static_cast<uint16_t>(value));
+  writeU16(output + 2, static_cast<uint16_t>(value >> 16));
+}
+
+/**
+ * @brief Read a 16-bit value in little endian
+ * @param input Source
+ * @return Value
+ */
+uint16_t PacketCodec::readU16(const uint8_t* input) {
+  return static_cast<uint16_t>(input[0] | (input[1] << 8));
+}
+
+/**
+ * @brief Read a 32-bit value in little endian
+ * @param input Source
+ * @return Value
+ */
+uint32_t PacketCodec::readU32(const uint8_t* input) {
+  return readU16(input) | (static_cast<uint32_t>(readU16(input + 2)) << 16);
+}
+
+/**
+ * @brief Frame a parameter reply
+ * @param parameters Registry holding the parameter
+ * @param id Parameter ID
+ * @param withInfo true to include type, limits and name
+ */
+void PacketCodec::frameParameter(const ParameterRegistry& parameters, uint8_t id, bool withInfo) {
+  const Parameter* parameter = parameters.get(id);
+  uint32_t value;
+  if (parameter == nullptr || !parameters.read(id, value)) {
+    frameStatus(UNKNOWN_PARAMETER);
+    return;
+  }
+  
+  uint8_t* out = reply + PAYLOAD_OFFSET;
+  out[0] = OK;
+  out[1] = id;
+  if (!withInfo) {
+    writeU32(out + 2, value);
+    frame(command | REPLY_FLAG, 6);
+    return;
+  }
+  
+  out[2] = static_cast<uint8_t>(parameter->type);
+  writeU32(out + 3, parameter->minValue);
+  writeU32(out + 7, parameter->maxValue);
+  writeU32(out + 11, value);
+  size_t nameLength = strnlen(parameter->name, ParameterRegistry::MAX_NAME_LENGTH);
+  memcpy(out + 15, parameter->name, nameLength);
+  frame(command | REPLY_FLAG, static_cast<uint8_t>(15 + nameLength));
+}
@@ -0,0 +1,196 @@
+#include "ParameterRegistry.h"
+#include <string.h>
+
+/**
+ * @brief Constructor
+ */
+ParameterRegistry::ParameterRegistry()
+  : parameters(),
+    count(0),
+    changeHook(nullptr),
+    changeContext(nullptr)
+{
+}
+
+/**
+ * @brief Register an 8-bit parameter
+ * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+ * @param value Storage
+ * @param minValue Lower limit
+ * @param maxValue Upper limit
+ * @return Parameter ID, or -1 if the table is full
+ */
+int16_t ParameterRegistry::add(const char* name, uint8_t* value, uint8_t minValue, uint8_t maxValue) {
+  return append(name, ParameterType::UINT8, value, minValue, maxValue);
+}
+
+/**
+ * @brief Register a 16-bit parameter
+ * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+ * @param value Storage
+ * @param minValue Lower limit
+ * @param maxValue Upper limit
+ * @return Parameter ID, or -1 if the table is full
+ */
+int16_t ParameterRegistry::add(const char* name, uint16_t* value, uint16_t minValue, uint16_t maxValue) {
+  return append(name, ParameterType::UINT16, value, minValue, maxValue);
+}
+
+/**
+ * @brief Register a 32-bit parameter
+ * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+ * @param value Storage
+ * @param minValue Lower limit
+ * @param maxValue Upper limit
+ * @return Parameter ID, or -1 if the table is full
+ */
+int16_t ParameterRegistry::add(const char* name, uint32_t* value, uint32_t minValue, uint32_t maxValue) {
+  return append(name, ParameterType::UINT32, value, minValue, maxValue);
+}
+
+/**
+ * @brief Register a floating-point parameter
+ * @param name Display name (static string, at most MAX_NAME_LENGTH characters)
+ * @param value Storage
+ * @param minValue Lower limit
+ * @param maxValue Upper limit
+ * @return Parameter ID, or -1 if the table is full
+ */
+int16_t ParameterRegistry::add(const char* name, float* value, float minValue, float maxValue) {
+  return append(name, ParameterType::FLOAT, value, encodeFloat(minValue), encodeFloat(maxValue));
+}
+
+/**
+ * @brief Set the hook run after a successful write
+ * @param hook Hook (nullptr for none)
+ * @param context Passed to the hook
+ */
+void ParameterRegistry::setChangeHook(ChangeHook hook, void* context) {
+  changeHook = hook;
+  changeContext = context;
+}
+
+/**
+ * @brief Get number of registered parameters
+ * @return Parameter count
+ */
+uint8_t ParameterRegistry::getCount() const {
+  return count;
+}
+
+/**
+ * @brief Get a parameter description
+ * @param id Parameter ID
+ * @return Parameter, or nullptr if the ID is unknown
+ */
+const Parameter* ParameterRegistry::get(uint8_t id) const {
+  return (id < count) ? &parameters[id] : nullptr;
+}
+
+/**
+ * @brief Read the encoded value of a parameter
+ * @param id Parameter ID
+ * @param encoded Receives the value
+ * @return false if the ID is unknown
+ */
+bool ParameterRegistry::read(uint8_t id, uint32_t& encoded) const {
+  if (id >= count) {
+    return false;
+  }
+  
+  const Parameter& parameter = parameters[id];
+  switch (parameter.type) {
+    case ParameterType::UINT8:
+      encoded = *static_cast<const uint8_t*>(parameter.value);
+      break;
+    case ParameterType::UINT16:
+      encoded = *static_cast<const uint16_t*>(parameter.value);
+      break;
+    case ParameterType::UINT32:
+      encoded = *static_cast<const uint32_t*>(parameter.value);
+      break;
+    case ParameterType::FLOAT:
+      encoded = encodeFloat(*static_cast<const float*>(parameter.value));
+      break;
+  }
+  return true;
+}
+
+/**
+ * @brief Write the encoded value of a parameter
+ * @param id Parameter ID
+ * @param encoded New value
+ * @return false if the ID is unknown or the value is out of range
+ */
+bool ParameterRegistry::write(uint8_t id, uint32_t encoded) {
+  if (id >= count) {
+    return false;
+  }
+  
+  Parameter& parameter = parameters[id];
+  if (parameter.type == ParameterType::FLOAT) {
+    float value = decodeFloat(encoded);
+    // Written this way round so that NaN is rejected too
+    if (!(value >= decodeFloat(parameter.minValue) && value <= decodeFloat(parameter.maxValue))) {
+      return false;
+    }
+    *static_cast<float*>(parameter.value) = value;
+  } else {
+    if (encoded < parameter.minValue || encoded > parameter.maxValue) {
+      return false;
+    }
+    if (parameter.type == ParameterType::UINT8) {
+      *static_cast<uint8_t*>(parameter.value) = static_cast<uint8_t>(encoded);
+    } else if (parameter.type == ParameterType::UINT16) {
+      *static_cast<uint16_t*>(parameter.value) = static_cast<uint16_t>(encoded);
+    } else {
+      *static_cast<uint32_t*>(parameter.value) = encoded;
+    }
+  }
+  
+  if (changeHook != nullptr) {
+    changeHook(changeContext, id);
+  }
+  return true;
+}
+
+/**
+ * @brief Encode a float as a 32-bit word
+ * @param value Value
+ * @return Encoded value
+ */
+uint32_t ParameterRegistry::encodeFloat(float value) {
+  uint32_t encoded;
+  memcpy(&encoded, &value, sizeof(encoded));
+  return encoded;
+}
+
+/**
+ * @brief Decode a 32-bit word as a float
+ * @param encoded Encoded value
+ * @return Value
+ */
+float ParameterRegistry::decodeFloat(uint32_t encoded) {
+  float value;
+  memcpy(&value, &encoded, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief Append a parameter to the table
+ * @param name Display name
+ * @param type Storage type
+ * @param value Storage
+ * @param minValue Lower limit (encoded)
+ * @param maxValue Upper limit (encoded)
+ * @return Parameter ID, or -1 if the table is full
+ */
+int16_t ParameterRegistry::append(const char* name, ParameterType type, void* value,
+                                  uint32_t minValue, uint32_t maxValue) {
+  if (count >= MAX_PARAMETERS) {
+    return -1;
+  }
+  
+  parameters[count] = { name, type, value, minValue, maxValue };
+  return count++;
+}
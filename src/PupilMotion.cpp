@@ -0,0 +1,221 @@
+#include "PupilMotion.h"
+#include <math.h>
+
+// Fixed-point scales
+static constexpr int32_t ONE = 1 << PupilMotion::FRACTION_BITS;
+static constexpr int32_t COEFFICIENT_ONE = 1 << PupilMotion::COEFFICIENT_BITS;
+static constexpr int32_t PROGRESS_ONE = 256;
+
+// Indices into the pursuit step matrix
+enum Coefficient : uint8_t {
+  OFFSET_FROM_OFFSET = 0,
+  OFFSET_FROM_VELOCITY = 1,
+  VELOCITY_FROM_OFFSET = 2,
+  VELOCITY_FROM_VELOCITY = 3
+};
+
+/**
+ * @brief Multiply by a step coefficient
+ * @param value Fixed-point value
+ * @param coefficient Coefficient (COEFFICIENT_BITS fractional bits)
+ * @return Rounded product
+ */
+static inline int32_t scale(int32_t value, int32_t coefficient) {
+  return static_cast<int32_t>((static_cast<int64_t>(value) * coefficient + COEFFICIENT_ONE / 2) >>
+    PupilMotion::COEFFICIENT_BITS);
+}
+
+/**
+ * @brief Constructor (at rest at the origin)
+ * @param rate Pursuit spring rate in 1/s
+ */
+PupilMotion::PupilMotion(float rate)
+  : axes(),
+    coefficients(),
+    saccadeSteps(0),
+    saccadeStep(0) {
+  setRate(rate);
+}
+
+/**
+ * @brief Set the pursuit spring rate
+ * @param rate Spring rate in 1/s (higher follows faster)
+ */
+void PupilMotion::setRate(float rate) {
+  // Exact step of x'' = -w²(x - T) - 2w x' over h, with velocity kept as distance per step (v h):
+  //   e' = E ((1 + wh) e + u)
+  //   u' = E ((1 - wh) u - (wh)² e)      where e = x - T, u = v h and E = exp(-wh)
+  float wh = rate * STEP_MS / 1000.0F;
+  float decay = expf(-wh);
+  coefficients[OFFSET_FROM_OFFSET] = lroundf(decay * (1.0F + wh) * COEFFICIENT_ONE);
+  coefficients[OFFSET_FROM_VELOCITY] = lroundf(decay * COEFFICIENT_ONE);
+  coefficients[VELOCITY_FROM_OFFSET] = lroundf(-decay * wh * wh * COEFFICIENT_ONE);
+  coefficients[VELOCITY_FROM_VELOCITY] = lroundf(decay * (1.0F - wh) * COEFFICIENT_ONE);
+}
+
+/**
+ * @brief Put the pupil at a position, at rest, with no saccade in flight
+ * @param x X coordinate in pixels
+ * @param y Y coordinate in pixels
+ */
+void PupilMotion::reset(int16_t x, int16_t y) {
+  int16_t positions[2] = { x, y };
+  for (uint8_t i = 0; i < 2; i++) {
+    Axis& axis = axes[i];
+    axis.position = positions[i] * ONE;
+    axis.velocity = 0;
+    axis.target = axis.position;
+  }
+  saccadeSteps = 0;
+}
+
+/**
+ * @brief Set the position to move towards
+ * @param x X coordinate in pixels
+ * @param y Y coordinate in pixels
+ */
+void PupilMotion::setTarget(int16_t x, int16_t y) {
+  axes[0].target = x * ONE;
+  axes[1].target = y * ONE;
+  
+  // A saccade in flight is ballistic: the new target is taken up when it lands
+  if (saccadeSteps == 0) {
+    startSaccadeIfFar();
+  }
+}
+
+/**
+ * @brief Advance by whole timesteps
+ * @param count Number of STEP_MS steps
+ */
+void PupilMotion::step(uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    if (saccadeSteps == 0) {
+      pursue(axes[0]);
+      pursue(axes[1]);
+      continue;
+    }
+  
+    saccadeStep++;
+    int32_t shape = smoothstep(saccadeStep * PROGRESS_ONE / saccadeSteps);
+    for (Axis& axis : axes) {
+      axis.position = axis.saccadeFrom +
+        static_cast<int32_t>(static_cast<int64_t>(axis.saccadeTo - axis.saccadeFrom) * shape / PROGRESS_ONE);
+    }
+  
+    // Land at rest, then follow wherever the target went meanwhile
+    if (saccadeStep >= saccadeSteps) {
+      saccadeSteps = 0;
+      startSaccadeIfFar();
+    }
+  }
+}
+
+/**
+ * @brief Get X coordinate
+ * @return Fixed-point X coordinate (FRACTION_BITS fractional bits)
+ */
+int32_t PupilMotion::getX() const {
+  return axes[0].position;
+}
+
+/**
+ * @brief Get Y coordinate
+ * @return Fixed-point Y coordinate (FRACTION_BITS fractional bits)
+ */
+int32_t PupilMotion::getY() const {
+  return axes[1].position;
+}
+
+/**
+ * @brief Get X coordinate rounded to a pixel
+ * @return X coordinate in pixels
+ */
+int16_t PupilMotion::getPixelX() const {
+  return static_cast<int16_t>((axes[0].position + ONE / 2) >> FRACTION_BITS);
+}
+
+/**
+ * @brief Get Y coordinate rounded to a pixel
+ * @return Y coordinate in pixels
+ */
+int16_t PupilMotion::getPixelY() const {
+  return static_cast<int16_t>((axes[1].position + ONE / 2) >> FRACTION_BITS);
+}
+
+/**
+ * @brief Check whether a saccade is in flight
+ * @return true until the saccade has landed
+ */
+bool PupilMotion::isSaccading() const {
+  return saccadeSteps != 0;
+}
+
+/**
+ * @brief Count the timesteps elapsed on a clock
+ * @param nowMs Current time
+ * @param stepTimeMs Time up to which steps were taken (advanced by the steps returned)
+ * @return Number of steps to take (at most MAX_STEPS; time beyond that is dropped)
+ */
+uint8_t PupilMotion::takeSteps(uint32_t nowMs, uint32_t& stepTimeMs) {
+  uint32_t elapsedMs = nowMs - stepTimeMs;
+  uint32_t count = elapsedMs / STEP_MS;
+  if (count > MAX_STEPS) {
+    // Keep the phase of the clock, so the steps after the gap stay evenly spaced
+    stepTimeMs = nowMs - elapsedMs % STEP_MS;
+    return MAX_STEPS;
+  }
+  stepTimeMs += count * STEP_MS;
+  return static_cast<uint8_t>(count);
+}
+
+/**
+ * @brief Start a saccade if the target is too far for pursuit
+ */
+void PupilMotion::startSaccadeIfFar() {
+  int32_t distance = 0;
+  for (const Axis& axis : axes) {
+    int32_t offset = axis.target - axis.position;
+    if (offset < 0) {
+      offset = -offset;
+    }
+    if (offset > distance) {
+      distance = offset;
+    }
+  }
+  if (distance <= SACCADE_THRESHOLD * ONE) {
+    return;
+  }
+  
+  // Longer saccades take longer, but far less than proportionally
+  uint32_t durationMs = SACCADE_BASE_MS + (distance >> FRACTION_BITS) * SACCADE_MS_PER_8PX / 8;
+  saccadeSteps = static_cast<uint16_t>((durationMs + STEP_MS - 1) / STEP_MS);
+  saccadeStep = 0;
+  for (Axis& axis : axes) {
+    axis.saccadeFrom = axis.position;
+    axis.saccadeTo = axis.target;
+    axis.velocity = 0;
+  }
+}
+
+/**
+ * @brief Advance one axis by one pursuit step
+ * @param axis Axis
+ */
+void PupilMotion::pursue(Axis& axis) const {
+  int32_t offset = axis.position - axis.target;
+  int32_t velocity = axis.velocity;
+  axis.position = axis.target + scale(offset, coefficients[OFFSET_FROM_OFFSET]) +
+    scale(velocity, coefficients[OFFSET_FROM_VELOCITY]);
+  axis.velocity = scale(offset, coefficients[VELOCITY_FROM_OFFSET]) +
+    scale(velocity, coefficients[VELOCITY_FROM_VELOCITY]);
+}
+
+/**
+ * @brief Shape a saccade
+ * @param progress Progress (0 .. 256)
+ * @return Smoothstep of the progress (0 .. 256)
+ */
+int32_t PupilMotion::smoothstep(int32_t progress) {
+  return progress * progress * (3 * PROGRESS_ONE - 2 * progress) / (PROGRESS_ONE * PROGRESS_ONE);
+}
@@ -0,0 +1,191 @@
+#include "ScreenLayout.h"
+#include <stdlib.h>
+
+namespace {
+  const char* const ROTATION_NAMES[ScreenLayout::NUM_OF_ROTATIONS] = {
+    "landscape", "portrait", "landscape flipped", "portrait flipped"
+  };
+  
+  /**
+   * @brief Check whether a rotation swaps width and height
+   * @param rotation Mount rotation
+   * @return true for portrait mounts
+   */
+  bool isQuarterTurn(MountRotation rotation) {
+    return rotation == MountRotation::PORTRAIT || rotation == MountRotation::PORTRAIT_FLIPPED;
+  }
+}
+
+/**
+ * @brief Constructor
+ * @param rotation How the unit is mounted
+ */
+ScreenLayout::ScreenLayout(MountRotation rotation)
+  : rotation(rotation),
+    width(isQuarterTurn(rotation) ? PANEL_HEIGHT : PANEL_WIDTH),
+    height(isQuarterTurn(rotation) ? PANEL_WIDTH : PANEL_HEIGHT)
+{
+}
+
+/**
+ * @brief Get how the unit is mounted
+ * @return Mount rotation
+ */
+MountRotation ScreenLayout::getRotation() const {
+  return rotation;
+}
+
+/**
+ * @brief Get logical screen width
+ * @return Width in pixels as seen by the viewer
+ */
+uint16_t ScreenLayout::getWidth() const {
+  return width;
+}
+
+/**
+ * @brief Get logical screen height
+ * @return Height in pixels as seen by the viewer
+ */
+uint16_t ScreenLayout::getHeight() const {
+  return height;
+}
+
+/**
+ * @brief Get center of an eye in logical coordinates
+ * @param side Which eye (0: left, 1: right, as seen by the viewer)
+ * @return Eye center
+ */
+Point ScreenLayout::getEyeCenter(uint8_t side) const {
+  // Eyes sit at a quarter and three quarters of the width, vertically centered
+  return Point((side == 0 ? width : width * 3) / 4, height / 2);
+}
+
+/**
+ * @brief Convert logical screen coordinates to panel coordinates
+ * @param logical Logical coordinates
+ * @return Panel coordinates
+ */
+Point ScreenLayout::toPanel(const Point& logical) const {
+  return rotate(rotation, logical, width, height);
+}
+
+/**
+ * @brief Convert panel coordinates (e.g. touch points) to logical screen coordinates
+ * @param panel Panel coordinates
+ * @return Logical coordinates
+ */
+Point ScreenLayout::toLogical(const Point& panel) const {
+  switch (rotation) {
+    case MountRotation::PORTRAIT:
+      return Point(width - 1 - panel.y, panel.x);
+    case MountRotation::LANDSCAPE_FLIPPED:
+      return Point(width - 1 - panel.x, height - 1 - panel.y);
+    case MountRotation::PORTRAIT_FLIPPED:
+      return Point(panel.y, height - 1 - panel.x);
+    default:
+      return panel;
+  }
+}
+
+/**
+ * @brief Convert a direction on the panel (e.g. a tilt) to logical screen axes
+ * @param panel Vector in panel axes
+ * @return Vector in logical axes
+ */
+Point ScreenLayout::directionToLogical(const Point& panel) const {
+  // Same turn as toLogical(), without moving the origin
+  switch (rotation) {
+    case MountRotation::PORTRAIT:
+      return Point(-panel.y, panel.x);
+    case MountRotation::LANDSCAPE_FLIPPED:
+      return Point(-panel.x, -panel.y);
+    case MountRotation::PORTRAIT_FLIPPED:
+      return Point(panel.y, -panel.x);
+    default:
+      return panel;
+  }
+}
+
+/**
+ * @brief Get display name of a mount rotation
+ * @param rotation Mount rotation
+ * @return Display name
+ */
+const char* ScreenLayout::getName(MountRotation rotation) {
+  return ROTATION_NAMES[static_cast<uint8_t>(rotation) % NUM_OF_ROTATIONS];
+}
+
+/**
+ * @brief Rotate a point of a logical area into the area's panel scan order
+ * @param rotation Mount rotation
+ * @param point Point in the logical area
+ * @param width Logical area width
+ * @param height Logical area height
+ * @return Point in the rotated area
+ */
+Point ScreenLayout::rotate(MountRotation rotation, const Point& point, int32_t width, int32_t height) {
+  // Turning the unit clockwise moves the viewer's top to the panel's left edge
+  switch (rotation) {
+    case MountRotation::PORTRAIT:
+      return Point(point.y, width - 1 - point.x);
+    case MountRotation::LANDSCAPE_FLIPPED:
+      return Point(width - 1 - point.x, height - 1 - point.y);
+    case MountRotation::PORTRAIT_FLIPPED:
+      return Point(height - 1 - point.y, point.x);
+    default:
+      return point;
+  }
+}
+
+/**
+ * @brief Rotate a rectangle of a logical area into the area's panel scan order
+ * @param rotation Mount rotation
+ * @param width Logical area width
+ * @param height Logical area height
+ * @param x Rectangle X (replaced by the rotated rectangle's)
+ * @param y Rectangle Y (replaced)
+ * @param w Rectangle width (replaced)
+ * @param h Rectangle height (replaced)
+ */
+void ScreenLayout::rotateRect(MountRotation rotation, int32_t width, int32_t height,
+                              int32_t& x, int32_t& y, int32_t& w, int32_t& h) {
+  // Spans stay horizontal runs when no rotation is needed
+  if (rotation == MountRotation::LANDSCAPE || w <= 0 || h <= 0) {
+    return;
+  }
+  
+  // Opposite corners land on opposite corners of the rotated rectangle
+  Point first = rotate(rotation, Point(x, y), width, height);
+  Point last = rotate(rotation, Point(x + w - 1, y + h - 1), width, height);
+  x = (first.x < last.x) ? first.x : last.x;
+  y = (first.y < last.y) ? first.y : last.y;
+  w = abs(last.x - first.x) + 1;
+  h = abs(last.y - first.y) + 1;
+}
+
+#if defined(ARDUINO)
+
+/**
+ * @brief Fill a rectangle given in logical coordinates of a pre-rotated area
+ * @param target Canvas or display holding the area in panel scan order
+ * @param rotation Mount rotation
+ * @param width Logical area width
+ * @param height Logical area height
+ * @param x Rectangle X in the logical area
+ * @param y Rectangle Y in the logical area
+ * @param w Rectangle width
+ * @param h Rectangle height
+ * @param color Fill color
+ */
+void ScreenLayout::fillRect(lgfx::LovyanGFX& target, MountRotation rotation, int32_t width, int32_t height,
+                            int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  
+  rotateRect(rotation, width, height, x, y, w, h);
+  target.fillRect(x, y, w, h, color);
+}
+
+#endif
@@ -0,0 +1,333 @@
+#include "SerialProtocol.h"
+#include "BatchRenderer.h"
+#include "BootProfiler.h"
+#include "MemoryBudget.h"
+#include <string.h>
+
+namespace {
+  /**
+   * @brief Saturate a counter to 16 bits
+   * @param value Counter
+   * @return Value clamped to 0xFFFF
+   */
+  uint16_t saturateU16(uint32_t value) {
+    return (value > 0xFFFF) ? 0xFFFF : static_cast<uint16_t>(value);
+  }
+}
+
+/**
+ * @brief Constructor
+ * @param io Serial stream carrying the protocol
+ * @param eyes Animation providing the parameters and telemetry
+ */
+SerialProtocol::SerialProtocol(Stream& io, EyesAnimation& eyes)
+  : io(io),
+    eyes(eyes),
+    codec(),
+    diagnostics(eyes),
+    telemetryIntervalMs(0),
+    lastTelemetryTime(0),
+    lastTelemetryFrames(0),
+    lastHistogram(),
+    traceFramesLeft(0),
+    lastTracedFrame(0),
+    droppedReplies(0)
+{
+}
+
+/**
+ * @brief Parse received bytes and send telemetry when due
+ * @param nowMs Current time
+ */
+void SerialProtocol::poll(uint32_t nowMs) {
+  for (uint8_t i = 0; i < MAX_BYTES_PER_POLL && io.available() > 0; i++) {
+    if (codec.parse(static_cast<uint8_t>(io.read()))) {
+      handleRequest(nowMs);
+    }
+  }
+  
+  if (telemetryIntervalMs > 0 && nowMs - lastTelemetryTime >= telemetryIntervalMs) {
+    sendTelemetry(nowMs);
+  }
+  
+  // At most one frame is drawn between two polls
+  if (traceFramesLeft > 0 && eyes.getFrameTelemetry().frames != lastTracedFrame) {
+    sendFrameTrace();
+  }
+  
+  sendImuTrace();
+}
+
+/**
+ * @brief Get number of malformed request packets
+ * @return Bad packet count
+ */
+uint32_t SerialProtocol::getBadPackets() const {
+  return codec.getBadPackets();
+}
+
+/**
+ * @brief Get number of replies dropped for lack of transmit space
+ * @return Dropped reply count
+ */
+uint32_t SerialProtocol::getDroppedReplies() const {
+  return droppedReplies;
+}
+
+/**
+ * @brief Execute a complete request
+ * @param nowMs Current time
+ */
+void SerialProtocol::handleRequest(uint32_t nowMs) {
+  if (codec.answerParameterRequest(eyes.getParameters())) {
+    transmit();
+    return;
+  }
+  
+  uint8_t length = codec.getLength();
+  const uint8_t* payload = codec.getPayload();
+  switch (codec.getCommand()) {
+    case PacketCodec::TELEMETRY:
+      if (length != 2) {
+        replyStatus(PacketCodec::BAD_LENGTH);
+        return;
+      }
+      telemetryIntervalMs = PacketCodec::readU16(payload);
+      lastTelemetryTime = nowMs;
+      lastTelemetryFrames = eyes.getFrameTelemetry().frames;
+      memcpy(lastHistogram, eyes.getFrameTelemetry().histogram, sizeof(lastHistogram));
+      replyStatus(PacketCodec::OK);
+      return;
+  
+    case PacketCodec::MEMORY_REPORT:
+      replyStatus(PacketCodec::OK);
+      MemoryBudget::printReport(io);
+      return;
+  
+    case PacketCodec::BOOT_REPORT:
+      replyStatus(PacketCodec::OK);
+      BootProfiler::printReport(io);
+      return;
+  
+    case PacketCodec::GAZE_REPORT:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printGazeTableReport(io);
+      return;
+  
+    case PacketCodec::ROTATION_BENCH:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printRotationBenchmark(io);
+      return;
+  
+    case PacketCodec::SINK_REPORT:
+      replyStatus(PacketCodec::OK);
+      eyes.getDisplayOutputs().printReport(io);
+      return;
+  
+    case PacketCodec::IMU_TRACE:
+      if (length != 2) {
+        replyStatus(PacketCodec::BAD_LENGTH);
+        return;
+      }
+      if (!eyes.getInputSampler().isRunning()) {
+        replyStatus(PacketCodec::FAILED);
+        return;
+      }
+      eyes.getInputSampler().traceImu(PacketCodec::readU16(payload));
+      replyStatus(PacketCodec::OK);
+      return;
+  
+    case PacketCodec::TILT_REPORT:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printTiltReport(io);
+      return;
+  
+    case PacketCodec::LOOK_AT:
+      if (length == 0) {
+        eyes.stopLooking();
+      } else if (length == 4) {
+        eyes.lookAt(Point(static_cast<int16_t>(PacketCodec::readU16(payload)), static_cast<int16_t>(PacketCodec::readU16(payload + 2))));
+      } else {
+        replyStatus(PacketCodec::BAD_LENGTH);
+        return;
+      }
+      replyStatus(PacketCodec::OK);
+      return;
+  
+    case PacketCodec::GAZE_SOURCE_REPORT:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printGazeSourceReport(io);
+      return;
+  
+    case PacketCodec::AUDIO_REPORT:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printAudioReport(io);
+      return;
+  
+    case PacketCodec::EXPRESSION:
+      if (length != 1) {
+        replyStatus(PacketCodec::BAD_LENGTH);
+        return;
+      }
+      replyStatus(eyes.playExpression(payload[0]) ? PacketCodec::OK : PacketCodec::FAILED);
+      return;
+  
+    case PacketCodec::EXPRESSION_REPORT:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printExpressionReport(io);
+      return;
+  
+    case PacketCodec::FRAME_TRACE:
+      if (length != 2) {
+        replyStatus(PacketCodec::BAD_LENGTH);
+        return;
+      }
+      traceFramesLeft = PacketCodec::readU16(payload);
+      lastTracedFrame = eyes.getFrameTelemetry().frames;
+      replyStatus(PacketCodec::OK);
+      return;
+  
+    case PacketCodec::TOUCH_BENCH:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printTouchBenchmark(io);
+      return;
+  
+    case PacketCodec::COLOR_BENCH:
+      replyStatus(PacketCodec::OK);
+      diagnostics.printColorModeBenchmark(io);
+      return;
+  
+    case PacketCodec::INSTANCE_BENCH: {
+      // Blocks the loop for one batch run per instance count
+      BatchRenderer batch;
+      replyStatus(batch.printInstanceBenchmark(io) ? PacketCodec::OK : PacketCodec::FAILED);
+      return;
+    }
+  
+    case PacketCodec::BATCH_RENDER: {
+      if (length != 4) {
+        replyStatus(PacketCodec::BAD_LENGTH);
+        return;
+      }
+      // Blocks the loop until the whole timeline has been streamed
+      BatchRenderer batch;
+      bool completed = batch.run(&io, PacketCodec::readU32(payload));
+      replyStatus(completed ? PacketCodec::OK : PacketCodec::FAILED);
+      if (completed) {
+        batch.printReport(io);
+      }
+      return;
+    }
+  
+    default:
+      replyStatus(PacketCodec::UNKNOWN_COMMAND);
+      return;
+  }
+}
+
+/**
+ * @brief Reply with a bare status
+ * @param status Status code
+ */
+void SerialProtocol::replyStatus(PacketCodec::Status status) {
+  codec.frameStatus(status);
+  transmit();
+}
+
+/**
+ * @brief Send a telemetry report
+ * @param nowMs Current time
+ */
+void SerialProtocol::sendTelemetry(uint32_t nowMs) {
+  const FrameTelemetry& telemetry = eyes.getFrameTelemetry();
+  uint32_t elapsed = nowMs - lastTelemetryTime;
+  uint32_t frames = telemetry.frames - lastTelemetryFrames;
+  
+  uint8_t* out = codec.getReplyPayload();
+  PacketCodec::writeU32(out, nowMs);
+  PacketCodec::writeU32(out + 4, telemetry.frames);
+  PacketCodec::writeU16(out + 8, saturateU16(elapsed > 0 ? frames * 10000 / elapsed : 0));
+  out[10] = static_cast<uint8_t>(eyes.getState());
+  PacketCodec::writeU32(out + 11, telemetry.transitions);
+  for (uint8_t i = 0; i < FrameTelemetry::HISTOGRAM_BUCKETS; i++) {
+    PacketCodec::writeU16(out + 15 + i * 2, saturateU16(telemetry.histogram[i] - lastHistogram[i]));
+  }
+  PacketCodec::writeU32(out + 31, telemetry.maxFrameMicros);
+  PacketCodec::writeU32(out + 35, eyes.getDroppedTouchSamples());
+  PacketCodec::writeU16(out + 39, saturateU16(codec.getBadPackets()));
+  out[41] = static_cast<uint8_t>(eyes.getFrameDeadline().getLevel());
+  PacketCodec::writeU32(out + 42, eyes.getFrameDeadline().getStats().missedDeadlines);
+  PacketCodec::writeU16(out + 46, eyes.getCpuGovernor().getFrequencyMhz());
+  
+  // A dropped report is retried on the next poll; counters stay cumulative
+  if (!send(PacketCodec::TELEMETRY_REPORT, 48)) {
+    return;
+  }
+  lastTelemetryTime = nowMs;
+  lastTelemetryFrames = telemetry.frames;
+  memcpy(lastHistogram, telemetry.histogram, sizeof(lastHistogram));
+}
+
+/**
+ * @brief Send a trace report for the most recent frame
+ */
+void SerialProtocol::sendFrameTrace() {
+  const FrameTelemetry& telemetry = eyes.getFrameTelemetry();
+  
+  uint8_t* out = codec.getReplyPayload();
+  out[0] = static_cast<uint8_t>(eyes.getState());
+  out[1] = static_cast<uint8_t>(eyes.getLoad());
+  PacketCodec::writeU32(out + 2, telemetry.lastFrameMicros);
+  PacketCodec::writeU16(out + 6, telemetry.lastFrameMhz);
+  PacketCodec::writeU16(out + 8, saturateU16(telemetry.lastBudgetMicros / 1000));
+  
+  // A dropped report leaves a gap in the trace rather than stalling the loop
+  send(PacketCodec::FRAME_TRACE_REPORT, 10);
+  lastTracedFrame = telemetry.frames;
+  traceFramesLeft--;
+}
+
+/**
+ * @brief Send trace reports for the IMU samples queued by the input sampler
+ */
+void SerialProtocol::sendImuTrace() {
+  InputSampler& sampler = eyes.getInputSampler();
+  ImuSample sample;
+  for (uint8_t i = 0; i < MAX_IMU_REPORTS_PER_POLL && sampler.takeImuSample(sample); i++) {
+    uint8_t* out = codec.getReplyPayload();
+    PacketCodec::writeU32(out, sample.timeMs);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      PacketCodec::writeU16(out + 4 + axis * 2, static_cast<uint16_t>(sample.accel[axis]));
+      PacketCodec::writeU16(out + 10 + axis * 2, static_cast<uint16_t>(sample.gyro[axis]));
+    }
+    
+    // Like frame traces, a dropped report leaves a gap (tools/tilt_check integrates across it)
+    send(PacketCodec::IMU_TRACE_REPORT, 16);
+  }
+}
+
+/**
+ * @brief Frame and send a packet whose payload is already in the codec's reply buffer
+ * @param packetCommand Command byte
+ * @param payloadLength Payload length
+ * @return false if the packet did not fit in the transmit buffer
+ */
+bool SerialProtocol::send(uint8_t packetCommand, uint8_t payloadLength) {
+  codec.frame(packetCommand, payloadLength);
+  return transmit();
+}
+
+/**
+ * @brief Send the packet most recently framed by the codec
+ * @return false if the packet did not fit in the transmit buffer
+ */
+bool SerialProtocol::transmit() {
+  uint8_t packetLength = codec.getPacketLength();
+  if (io.availableForWrite() < packetLength) {
+    droppedReplies++;
+    return false;
+  }
+  
+  io.write(codec.getPacket(), packetLength);
+  return true;
+}
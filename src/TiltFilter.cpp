@@ -0,0 +1,114 @@
+#include "TiltFilter.h"
+
+// 1 g in Q14, and the largest reading taken at face value
+static constexpr int32_t GRAVITY_ONE = 1 << TiltFilter::GRAVITY_BITS;
+static constexpr int32_t GRAVITY_LIMIT = 2 * GRAVITY_ONE;
+
+// One 0.1 deg/s over one millisecond is 1.7453e-6 rad: in rad Q16, scaled by 2^16 for two 8-bit shifts
+static constexpr int32_t RATE_MS_TO_ANGLE = 7496;
+
+/**
+ * @brief Constructor (no estimate until the first reading)
+ * @param timeConstantMs How long the accelerometer takes to pull the estimate over
+ */
+TiltFilter::TiltFilter(uint16_t timeConstantMs)
+  : gravity(),
+    weightPerMs(0),
+    lastTimeMs(0),
+    estimated(false) {
+  setTimeConstant(timeConstantMs);
+}
+
+/**
+ * @brief Set how long the accelerometer takes to pull the estimate over
+ * @param timeConstantMs Time constant in milliseconds (longer trusts the gyro more)
+ */
+void TiltFilter::setTimeConstant(uint16_t timeConstantMs) {
+  // Never more than the whole difference in one reading
+  weightPerMs = (timeConstantMs > MAX_STEP_MS) ? 65536 / timeConstantMs : 65536 / MAX_STEP_MS;
+}
+
+/**
+ * @brief Forget the estimate (the next reading starts a new one)
+ */
+void TiltFilter::reset() {
+  estimated = false;
+}
+
+/**
+ * @brief Fuse one reading
+ * @param sample Reading (not older than the previous one)
+ */
+void TiltFilter::update(const ImuSample& sample) {
+  int32_t accel[3] = { toGravity(sample.accel[0]), toGravity(sample.accel[1]), toGravity(sample.accel[2]) };
+  if (!estimated) {
+    gravity[0] = accel[0];
+    gravity[1] = accel[1];
+    gravity[2] = accel[2];
+    lastTimeMs = sample.timeMs;
+    estimated = true;
+    return;
+  }
+  
+  uint32_t stepMs = sample.timeMs - lastTimeMs;
+  lastTimeMs = sample.timeMs;
+  if (stepMs > MAX_STEP_MS) {
+    stepMs = MAX_STEP_MS;
+  }
+  
+  // Gyro: gravity stays put while the unit turns, so it turns the other way in panel axes
+  int32_t angle[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    int32_t value = (((sample.gyro[i] * RATE_MS_TO_ANGLE) >> 8) * static_cast<int32_t>(stepMs)) >> 8;
+    angle[i] = (value > MAX_STEP_ANGLE) ? MAX_STEP_ANGLE : (value < -MAX_STEP_ANGLE) ? -MAX_STEP_ANGLE : value;
+  }
+  int32_t x = gravity[0];
+  int32_t y = gravity[1];
+  int32_t z = gravity[2];
+  gravity[0] = x + ((y * angle[2] - z * angle[1]) >> 16);
+  gravity[1] = y + ((z * angle[0] - x * angle[2]) >> 16);
+  gravity[2] = z + ((x * angle[1] - y * angle[0]) >> 16);
+  
+  // Accelerometer: only readings that look like gravity alone
+  uint32_t magnitude = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    magnitude += static_cast<uint32_t>(sample.accel[i] * sample.accel[i]);
+  }
+  static constexpr uint32_t LOW = (1000U - ACCEL_GATE_MILLI_G) * (1000U - ACCEL_GATE_MILLI_G);
+  static constexpr uint32_t HIGH = (1000U + ACCEL_GATE_MILLI_G) * (1000U + ACCEL_GATE_MILLI_G);
+  if (magnitude < LOW || magnitude > HIGH) {
+    return;
+  }
+  int64_t weight = static_cast<int64_t>(weightPerMs) * stepMs;
+  for (uint8_t i = 0; i < 3; i++) {
+    gravity[i] += static_cast<int32_t>(((accel[i] - gravity[i]) * weight) >> 16);
+  }
+}
+
+/**
+ * @brief Check whether there is an estimate
+ * @return true after the first reading
+ */
+bool TiltFilter::hasEstimate() const {
+  return estimated;
+}
+
+/**
+ * @brief Get the estimated reaction to gravity (points up, like a resting accelerometer)
+ * @param axis Axis (0: x, 1: y, 2: z)
+ * @return Component in Q14 (1 g = 16384)
+ */
+int32_t TiltFilter::get(uint8_t axis) const {
+  return gravity[axis];
+}
+
+/**
+ * @brief Convert an acceleration reading to the vector's scale
+ * @param milliG Acceleration in milli-g
+ * @return Acceleration in Q14, limited to 2 g
+ */
+int32_t TiltFilter::toGravity(int16_t milliG) {
+  // 16384 / 1000 is 16777 / 1024 to within 0.003 %
+  int32_t value = (milliG * 16777) >> 10;
+  return (value > GRAVITY_LIMIT) ? GRAVITY_LIMIT : (value < -GRAVITY_LIMIT) ? -GRAVITY_LIMIT : value;
+}
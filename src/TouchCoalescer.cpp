@@ -0,0 +1,193 @@
+#include "TouchCoalescer.h"
+
+namespace {
+  /**
+   * @brief Clamp a value to the int16_t range
+   * @param value Value to clamp
+   * @return Clamped value
+   */
+  int16_t clampToInt16(int32_t value) {
+    return static_cast<int16_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+  }
+}
+
+/**
+ * @brief Constructor
+ */
+TouchCoalescer::TouchCoalescer()
+  : touchPoints(), touchCount(0), touching(false), begun(false), ended(false), velocity(0, 0),
+    lastSampleTime(0), gestures() {
+}
+
+/**
+ * @brief Start a batch of samples (clears the begin/end edges)
+ */
+void TouchCoalescer::beginBatch() {
+  begun = false;
+  ended = false;
+}
+
+/**
+ * @brief Coalesce one sample into the current touch state
+ * @param sample Touch sample
+ * @return Touch state of the sample
+ */
+TouchState TouchCoalescer::apply(const TouchSample& sample) {
+  TouchState sampleState = interpretTouchState(sample.state);
+  bool sampleTouching = (sampleState == TouchState::TOUCHING);
+  gestures.addSample(sample.timeMs, sampleTouching, sample.count, sample.points[0].x, sample.points[0].y);
+  
+  if (sampleTouching) {
+    uint8_t count = (sample.count > 0) ? sample.count : 1;
+  
+    // Velocity from consecutive touching samples
+    if (touching && sample.timeMs != lastSampleTime) {
+      int32_t dt = sample.timeMs - lastSampleTime;
+      velocity.x = clampToInt16((sample.points[0].x - touchPoints[0].x) * 1000 / dt);
+      velocity.y = clampToInt16((sample.points[0].y - touchPoints[0].y) * 1000 / dt);
+    } else if (!touching) {
+      velocity = Point(0, 0);
+      begun = true;
+    }
+  
+    for (uint8_t i = 0; i < count; i++) {
+      touchPoints[i] = sample.points[i];
+    }
+    touchCount = count;
+    lastSampleTime = sample.timeMs;
+  
+    if (touchCount > 1) {
+      sampleState = TouchState::MULTI_TOUCH;
+    }
+  } else {
+    // Keep the last position on release
+    if (touching) {
+      ended = true;
+    }
+    touchCount = 0;
+  }
+  
+  touching = sampleTouching;
+  return sampleState;
+}
+
+/**
+ * @brief Finish a batch of samples
+ * @param state Touch state of the batch so far
+ * @param nowMs Current time (completes long presses without new samples)
+ * @return Touch state of the batch (RELEASED if the touch ended within it)
+ */
+TouchState TouchCoalescer::endBatch(TouchState state, uint32_t nowMs) {
+  // A touch that ended within this batch is reported as a release
+  if (!touching && ended) {
+    state = TouchState::RELEASED;
+  }
+  
+  // Long presses complete even when no sample arrives
+  gestures.advance(nowMs);
+  return state;
+}
+
+/**
+ * @brief Let time pass without a batch (completes long presses)
+ * @param nowMs Current time
+ */
+void TouchCoalescer::advance(uint32_t nowMs) {
+  gestures.advance(nowMs);
+}
+
+/**
+ * @brief Check whether a touch began during the last batch
+ * @return true if a touch began
+ */
+bool TouchCoalescer::wasBegun() const {
+  return begun;
+}
+
+/**
+ * @brief Check whether a touch ended during the last batch
+ * @return true if a touch ended
+ */
+bool TouchCoalescer::wasEnded() const {
+  return ended;
+}
+
+/**
+ * @brief Get velocity of the first touch point
+ * @return Velocity in pixels per second
+ */
+const Point& TouchCoalescer::getVelocity() const {
+  return velocity;
+}
+
+/**
+ * @brief Get a touch position
+ * @param index Touch point index (less than getTouchCount())
+ * @return Touch position
+ */
+const Point& TouchCoalescer::getTouchPoint(uint8_t index) const {
+  return touchPoints[index < TouchSample::MAX_POINTS ? index : 0];
+}
+
+/**
+ * @brief Get number of current touch points
+ * @return Number of touch points
+ */
+uint8_t TouchCoalescer::getTouchCount() const {
+  return touchCount;
+}
+
+/**
+ * @brief Get centroid of current touch points
+ * @return Centroid, or the first touch position if there is no touch point
+ */
+Point TouchCoalescer::getCentroid() const {
+  if (touchCount <= 1) {
+    return touchPoints[0];
+  }
+  
+  int32_t sumX = 0;
+  int32_t sumY = 0;
+  for (uint8_t i = 0; i < touchCount; i++) {
+    sumX += touchPoints[i].x;
+    sumY += touchPoints[i].y;
+  }
+  return Point(sumX / touchCount, sumY / touchCount);
+}
+
+/**
+ * @brief Take the oldest gesture recognised from the samples
+ * @param event Receives the gesture (positions in panel coordinates)
+ * @return false if there is none
+ */
+bool TouchCoalescer::takeGesture(GestureEvent& event) {
+  return gestures.takeEvent(event);
+}
+
+/**
+ * @brief Interpret M5Stack touch state
+ * @param state M5Stack touch state
+ * @return Interpreted touch state
+ */
+TouchState TouchCoalescer::interpretTouchState(uint8_t state) {
+  // Determine touch state
+  switch (state) {
+    case STATE_TOUCH:
+    case STATE_TOUCH_BEGIN:
+    case STATE_HOLD:
+    case STATE_HOLD_BEGIN:
+    case STATE_FLICK:
+    case STATE_FLICK_BEGIN:
+    case STATE_DRAG:
+    case STATE_DRAG_BEGIN:  // Finger starts moving after a hold: still the same touch
+      return TouchState::TOUCHING;
+    case STATE_TOUCH_END:
+    case STATE_HOLD_END:
+    case STATE_FLICK_END:
+    case STATE_DRAG_END:
+      return TouchState::RELEASED;
+    case STATE_NONE:
+    default:
+      return TouchState::NONE;
+  }
+}
@@ -1,9 +1,26 @@
 #include "TouchHandler.h"
 
+// TouchCoalescer interprets the states without M5Unified
+static_assert(TouchCoalescer::STATE_NONE == m5::touch_state_t::none, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_TOUCH == m5::touch_state_t::touch, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_TOUCH_END == m5::touch_state_t::touch_end, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_TOUCH_BEGIN == m5::touch_state_t::touch_begin, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_HOLD == m5::touch_state_t::hold, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_HOLD_END == m5::touch_state_t::hold_end, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_HOLD_BEGIN == m5::touch_state_t::hold_begin, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_FLICK == m5::touch_state_t::flick, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_FLICK_END == m5::touch_state_t::flick_end, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_FLICK_BEGIN == m5::touch_state_t::flick_begin, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_DRAG == m5::touch_state_t::drag, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_DRAG_END == m5::touch_state_t::drag_end, "touch state mismatch");
+static_assert(TouchCoalescer::STATE_DRAG_BEGIN == m5::touch_state_t::drag_begin, "touch state mismatch");
+
 /**
  * @brief Constructor
+ * @param clock Time source (default: Arduino millis/micros)
  */
-TouchHandler::TouchHandler() : lastTouchState(TouchState::NONE), touchPoint(0, 0) {
+TouchHandler::TouchHandler(const Clock& clock)
+  : clock(clock), lastTouchState(TouchState::NONE), lastUpdateTime(0), queueMode(false), coalescer() {
 }
 
 /**
@@ -11,25 +28,34 @@ TouchHandler::TouchHandler() : lastTouchState(TouchState::NONE), touchPoint(0, 0
  * @return Current touch state
  */
 TouchState TouchHandler::update() {
-  static uint32_t lastUpdateTime = 0;
-  uint32_t currentTime = millis();
+  coalescer.beginBatch();
   
-  // Limit touch update frequency (25ms interval)
-  if (currentTime - lastUpdateTime < 25) {
-    return lastTouchState;
+  TouchState currentState;
+  if (queueMode) {
+    // Nothing new: keep touching, but report a release only once
+    TouchSample sample;
+    if (!queue.pop(sample)) {
+      currentState = (lastTouchState == TouchState::RELEASED) ? TouchState::NONE : lastTouchState;
+    } else {
+      do {
+        currentState = coalescer.apply(sample);
+      } while (queue.pop(sample));
+    }
+  } else {
+    uint32_t currentTime = clock.nowMillis();
+    
+    // Limit touch update frequency
+    if (currentTime - lastUpdateTime < UPDATE_INTERVAL_MS) {
+      coalescer.advance(currentTime);
+      return lastTouchState;
+    }
+    
+    lastUpdateTime = currentTime;
+    M5.update();
+    currentState = coalescer.apply(readSample(currentTime));
   }
   
-  lastUpdateTime = currentTime;
-  M5.update();
-  auto touch = M5.Touch.getDetail();
-  
-  TouchState currentState = interpretTouchState(touch.state);
-  
-  // Update touch position (only when touching)
-  if (currentState == TouchState::TOUCHING) {
-    touchPoint.x = touch.x;
-    touchPoint.y = touch.y;
-  }
+  currentState = coalescer.endBatch(currentState, clock.nowMillis());
   
   // Save previous state
   lastTouchState = currentState;
@@ -37,12 +63,109 @@ TouchState TouchHandler::update() {
   return currentState;
 }
 
+/**
+ * @brief Read a touch sample from M5.Touch (call after M5.update())
+ * @param timeMs Sampling time
+ * @return Touch sample
+ */
+TouchSample TouchHandler::readSample(uint32_t timeMs) {
+  TouchSample sample;
+  const auto& touch = M5.Touch.getDetail();
+  sample.timeMs = timeMs;
+  sample.state = touch.state;
+  
+  uint8_t count = M5.Touch.getCount();
+  if (count > MAX_TOUCH_POINTS) {
+    count = MAX_TOUCH_POINTS;
+  }
+  
+  if (count == 0) {
+    // Keep the position of the first point for release states
+    sample.points[0].x = touch.x;
+    sample.points[0].y = touch.y;
+  } else {
+    for (uint8_t i = 0; i < count; i++) {
+      const auto& detail = M5.Touch.getDetail(i);
+      sample.points[i].x = detail.x;
+      sample.points[i].y = detail.y;
+    }
+  }
+  sample.count = count;
+  
+  return sample;
+}
+
+/**
+ * @brief Get sample queue for a producer task
+ * @return Sample queue
+ */
+TouchHandler::TouchQueue& TouchHandler::getQueue() {
+  return queue;
+}
+
+/**
+ * @brief Switch between consuming the sample queue and polling
+ * @param enabled true to consume samples from the queue
+ */
+void TouchHandler::setQueueMode(bool enabled) {
+  queueMode = enabled;
+}
+
+/**
+ * @brief Check whether a touch began during the last update
+ * @return true if a touch began
+ */
+bool TouchHandler::wasBegun() const {
+  return coalescer.wasBegun();
+}
+
+/**
+ * @brief Check whether a touch ended during the last update
+ * @return true if a touch ended
+ */
+bool TouchHandler::wasEnded() const {
+  return coalescer.wasEnded();
+}
+
+/**
+ * @brief Get velocity of the first touch point
+ * @return Velocity in pixels per second
+ */
+const Point& TouchHandler::getVelocity() const {
+  return coalescer.getVelocity();
+}
+
 /**
  * @brief Get current touch position
- * @return Touch position
+ * @return Touch position of the first touch point
  */
 const Point& TouchHandler::getTouchPoint() const {
-  return touchPoint;
+  return coalescer.getTouchPoint(0);
+}
+
+/**
+ * @brief Get a touch position
+ * @param index Touch point index (less than getTouchCount())
+ * @return Touch position
+ */
+const Point& TouchHandler::getTouchPoint(uint8_t index) const {
+  return coalescer.getTouchPoint(index);
+}
+
+/**
+ * @brief Get number of current touch points
+ * @return Number of touch points
+ */
+uint8_t TouchHandler::getTouchCount() const {
+  return coalescer.getTouchCount();
+}
+
+/**
+ * @brief Get centroid of current touch points
+ * @return Centroid, or the first touch position if there is no touch point
+ */
+Point TouchHandler::getCentroid() const {
+  return coalescer.getCentroid();
 }
 
 /**
@@ -54,28 +177,10 @@ TouchState TouchHandler::getLastTouchState() const {
 }
 
 /**
- * @brief Interpret M5Stack touch state
- * @param state M5Stack touch state
- * @return Interpreted touch state
+ * @brief Take the oldest gesture recognised by update()
+ * @param event Receives the gesture (positions in panel coordinates)
+ * @return false if there is none
  */
-TouchState TouchHandler::interpretTouchState(uint8_t state) {
-  // Determine touch state
-  switch (state) {
-    case m5::touch_state_t::touch:
-    case m5::touch_state_t::touch_begin:
-    case m5::touch_state_t::hold:
-    case m5::touch_state_t::hold_begin:
-    case m5::touch_state_t::flick:
-    case m5::touch_state_t::flick_begin:
-    case m5::touch_state_t::drag:
-      return TouchState::TOUCHING;
-    case m5::touch_state_t::mask_change :
-    case m5::touch_state_t::hold_end:
-    case m5::touch_state_t::flick_end:
-    case m5::touch_state_t::drag_end:
-      return TouchState::RELEASED;
-    case m5::touch_state_t::none:
-    default:
-      return TouchState::NONE;
-  }
+bool TouchHandler::takeGesture(GestureEvent& event) {
+  return coalescer.takeGesture(event);
 }
@@ -1,37 +1,70 @@
 #include <M5Unified.h>
+#include "BootProfiler.h"
 #include "EyesAnimation.h"
+#include "MemoryBudget.h"
+#include "ScreenLayout.h"
+#include "SerialProtocol.h"
 
 /**
  * @brief Display settings
  */
-static constexpr uint8_t DISPLAY_ROTATION = 1;      // Landscape orientation
+static constexpr MountRotation MOUNT_ROTATION = MountRotation::LANDSCAPE;  // How the unit is mounted
 static constexpr uint8_t DISPLAY_BRIGHTNESS = 128;  // Brightness (0-255)
 
 /**
  * @brief Eye animation instance
  */
-EyesAnimation eyes;
+EyesAnimation eyes(Clock(), MOUNT_ROTATION);
+
+/**
+ * @brief Tuning and telemetry protocol (see tools/eyes_tune.cpp)
+ */
+SerialProtocol protocol(Serial, eyes);
 
 /**
  * @brief Initialization process
+ * 
+ * Ordered so that eyes are visible as early as possible: the prerendered
+ * frame is drawn right after the display comes up, and slower peripherals
+ * (IMU, input task) start afterwards in eyes.setup().
  */
 void setup() {
-  // Initialize M5Stack
+  // Eye sprites are created by the global constructors
+  BootProfiler::mark("global constructors");
+  
+  // The frame stream writes whole keyframes; the UART FIFO alone holds 128 bytes
+  if (EyesAnimation::FRAME_STREAM_ENABLED) {
+    Serial.setTxBufferSize(EyesAnimation::FRAME_STREAM_TX_BUFFER_BYTES);
+  }
+  
+  // Initialize M5Stack (also initializes and clears the display, starts Serial)
   auto cfg = M5.config();
-  cfg.internal_imu = true;  // Enable IMU (accelerometer)
+  cfg.internal_imu = false;  // Started by eyes.setup() after the first frame
+  cfg.internal_rtc = false;  // Not used
   M5.begin(cfg);
+  BootProfiler::mark("M5.begin");
   
-  // Initialize random seed using hardware RNG
-  randomSeed(esp_random());
-  
-  // Initialize display and optimize settings
-  M5.Display.init();
-  M5.Display.setRotation(DISPLAY_ROTATION);
+  // Optimize display settings
+  M5.Display.setRotation(ScreenLayout::PANEL_ROTATION);  // Mounting is handled in the eye raster
   M5.Display.setBrightness(DISPLAY_BRIGHTNESS);
-  M5.Display.setColorDepth(1);  // Set to 1-bit color depth
-
+  M5.Display.setColorDepth(Eye::DISPLAY_COLOR_DEPTH);  // 1-bit unless palette mode is enabled
+  
+  // Show eyes before anything else is initialized
+  eyes.showBootFrame();
+  BootProfiler::mark("first frame");
+  
+  // Seed the animation with the hardware RNG (use a fixed seed to reproduce a run)
+  eyes.setRandomSeed(esp_random());
+  
   // Initialize eye animation
-  eyes.setup();
+  if (!eyes.setup()) {
+    Serial.println("Error: Eye animation setup failed.");
+  }
+  BootProfiler::mark("animation setup");
+  
+  // Report startup timing and memory usage at boot
+  BootProfiler::printReport(Serial);
+  MemoryBudget::printReport(Serial);
 
   // Start drawing (continuous drawing mode)
   M5.Display.startWrite();
@@ -41,5 +74,8 @@ void setup() {
  * @brief Main loop process
  */
 void loop() {
+  // Handle tuning requests between frames
+  protocol.poll(millis());
+  
   eyes.loop();
 }
@@ -0,0 +1,330 @@
+/**
+ * @brief Host-side compiler for expression libraries
+ *
+ * Reads a text description of keyframed expressions and writes the binary
+ * library described in include/ExpressionFormat.h or the C++ source of the
+ * built-in library. --bench plays every expression with the firmware's
+ * evaluator (src/ExpressionTimeline.cpp) and prints its cost per frame.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o expression_compiler tools/expression_compiler.cpp
+ *             src/ExpressionTimeline.cpp src/ExpressionDefault.cpp
+ * Usage:  expression_compiler <expressions.txt> <expressions.bin>
+ *         expression_compiler --cpp <expressions.txt> <ExpressionDefault.cpp>
+ *         expression_compiler --bench <expressions.txt> [frame-ms]
+ *
+ * Description syntax ('#' starts a comment):
+ *   expression <name> <duration-ms>     starts an expression (name up to 11 characters)
+ *   track <channel>                     starts a track of the current expression
+ *   key <time-ms> <value> [easing]      adds a key to the current track (ascending time)
+ *
+ * Channels: pupil_x, pupil_y (-100..100, percent of the pupil travel range),
+ * lid_top, lid_bottom (0..100, percent of the way to the eye center),
+ * pupil_scale (25..200, percent of the style's pupil size).
+ * Easings: step, linear (default), in, out, in_out.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "EyeStyleFormat.h"
+#include "ExpressionFormat.h"
+#include "ExpressionTimeline.h"
+
+namespace {
+  const char* const CHANNEL_NAMES[] = { "pupil_x", "pupil_y", "lid_top", "lid_bottom", "pupil_scale" };
+  const char* const EASING_NAMES[] = { "step", "linear", "in", "out", "in_out" };
+  
+  // Frames evaluated per expression by --bench
+  constexpr uint32_t BENCH_PASSES = 20000;
+  
+  /**
+   * @brief Structure holding a parsed track
+   */
+  struct TrackSource {
+    ExpressionFormat::Track track;
+    std::vector<ExpressionFormat::Key> keys;
+  };
+  
+  /**
+   * @brief Structure holding a parsed expression
+   */
+  struct ExpressionSource {
+    ExpressionFormat::Expression expression;
+    std::vector<TrackSource> tracks;
+  };
+  
+  /**
+   * @brief Report a syntax error and exit
+   * @param line Line number
+   * @param message Error message
+   */
+  [[noreturn]] void fail(int line, const std::string& message) {
+    fprintf(stderr, "line %d: %s\n", line, message.c_str());
+    exit(1);
+  }
+  
+  /**
+   * @brief Look up a name in a table
+   * @param names Table of names
+   * @param count Number of names
+   * @param name Name to find
+   * @return Index, or -1 if not found
+   */
+  int lookup(const char* const* names, int count, const std::string& name) {
+    for (int i = 0; i < count; i++) {
+      if (name == names[i]) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  
+  /**
+   * @brief Append raw bytes to a buffer, padded to an alignment
+   * @param out Buffer
+   * @param data Bytes
+   * @param length Number of bytes
+   */
+  void append(std::vector<uint8_t>& out, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + length);
+    while (out.size() % 4 != 0) {
+      out.push_back(0);
+    }
+  }
+  
+  /**
+   * @brief Parse a description
+   * @param input Description text
+   * @param expressions Destination
+   */
+  void parse(std::istream& input, std::vector<ExpressionSource>& expressions) {
+    std::string text;
+    int lineNumber = 0;
+    while (std::getline(input, text)) {
+      lineNumber++;
+      text = text.substr(0, text.find('#'));
+      std::istringstream line(text);
+      std::string keyword;
+      if (!(line >> keyword)) {
+        continue;
+      }
+  
+      if (keyword == "expression") {
+        std::string name;
+        long duration;
+        if (!(line >> name >> duration) || name.size() >= ExpressionFormat::NAME_LENGTH ||
+            duration <= 0 || duration > UINT16_MAX) {
+          fail(lineNumber, "expected a name of up to 11 characters and a duration in 1..65535 ms");
+        }
+        ExpressionSource source = {};
+        memcpy(source.expression.name, name.c_str(), name.size());
+        source.expression.durationMs = static_cast<uint16_t>(duration);
+        expressions.push_back(source);
+      } else if (keyword == "track") {
+        std::string channel;
+        if (expressions.empty() || !(line >> channel)) {
+          fail(lineNumber, "expected a channel inside an expression");
+        }
+        int index = lookup(CHANNEL_NAMES, ExpressionFormat::CHANNEL_COUNT, channel);
+        if (index < 0) {
+          fail(lineNumber, "unknown channel " + channel);
+        }
+        for (const TrackSource& other : expressions.back().tracks) {
+          if (other.track.channel == index) {
+            fail(lineNumber, "channel " + channel + " already has a track");
+          }
+        }
+        TrackSource source = {};
+        source.track.channel = static_cast<uint8_t>(index);
+        expressions.back().tracks.push_back(source);
+      } else if (keyword == "key") {
+        long time, value;
+        if (expressions.empty() || expressions.back().tracks.empty() || !(line >> time >> value)) {
+          fail(lineNumber, "expected a time and a value inside a track");
+        }
+        std::string easingName = "linear";
+        line >> easingName;
+        int easing = lookup(EASING_NAMES, ExpressionFormat::EASE_COUNT, easingName);
+        if (easing < 0) {
+          fail(lineNumber, "unknown easing " + easingName);
+        }
+  
+        TrackSource& track = expressions.back().tracks.back();
+        int16_t minValue, maxValue;
+        ExpressionFormat::getRange(track.track.channel, minValue, maxValue);
+        if (value < minValue || value > maxValue) {
+          fail(lineNumber, "value out of range " + std::to_string(minValue) + ".." + std::to_string(maxValue));
+        }
+        if (time < 0 || time > expressions.back().expression.durationMs ||
+            (!track.keys.empty() && time < track.keys.back().timeMs)) {
+          fail(lineNumber, "key times must ascend and lie within the expression");
+        }
+        track.keys.push_back({ static_cast<uint16_t>(time), static_cast<int16_t>(value),
+                               static_cast<uint8_t>(easing), 0 });
+      } else {
+        fail(lineNumber, "unknown keyword " + keyword);
+      }
+    }
+  
+    if (expressions.empty() || expressions.size() > UINT8_MAX) {
+      fail(lineNumber, "expected 1..255 expressions");
+    }
+    for (const ExpressionSource& expression : expressions) {
+      for (const TrackSource& track : expression.tracks) {
+        if (track.keys.empty() || track.keys.size() > UINT16_MAX) {
+          fail(lineNumber, std::string("track without keys in ") + expression.expression.name);
+        }
+      }
+    }
+  }
+  
+  /**
+   * @brief Lay out a library
+   * @param expressions Parsed expressions
+   * @return Library bytes
+   */
+  std::vector<uint8_t> build(std::vector<ExpressionSource>& expressions) {
+    // Header, expression table, then per expression its track table and the keys of each track
+    ExpressionFormat::Header header = {};
+    memcpy(header.magic, ExpressionFormat::MAGIC, sizeof(header.magic));
+    header.version = ExpressionFormat::VERSION;
+    header.headerSize = sizeof(header);
+    header.expressionCount = static_cast<uint8_t>(expressions.size());
+    header.expressionOffset = sizeof(header);
+  
+    uint32_t offset = header.expressionOffset +
+                      static_cast<uint32_t>(expressions.size() * sizeof(ExpressionFormat::Expression));
+    for (ExpressionSource& source : expressions) {
+      source.expression.trackCount = static_cast<uint8_t>(source.tracks.size());
+      source.expression.trackOffset = offset;
+      offset += static_cast<uint32_t>(source.tracks.size() * sizeof(ExpressionFormat::Track));
+      for (TrackSource& track : source.tracks) {
+        track.track.keyCount = static_cast<uint16_t>(track.keys.size());
+        track.track.keyOffset = offset;
+        offset += static_cast<uint32_t>(track.keys.size() * sizeof(ExpressionFormat::Key));
+        offset = (offset + 3) & ~3U;
+      }
+    }
+  
+    std::vector<uint8_t> library;
+    append(library, &header, sizeof(header));
+    for (const ExpressionSource& source : expressions) {
+      append(library, &source.expression, sizeof(source.expression));
+    }
+    for (const ExpressionSource& source : expressions) {
+      for (const TrackSource& track : source.tracks) {
+        append(library, &track.track, sizeof(track.track));
+      }
+      for (const TrackSource& track : source.tracks) {
+        append(library, track.keys.data(), track.keys.size() * sizeof(ExpressionFormat::Key));
+      }
+    }
+  
+    ExpressionFormat::Header* finalHeader = reinterpret_cast<ExpressionFormat::Header*>(library.data());
+    finalHeader->totalSize = static_cast<uint32_t>(library.size());
+    finalHeader->checksum = EyeStyleFormat::checksum(library.data() + sizeof(header),
+                                                     finalHeader->totalSize - sizeof(header));
+    return library;
+  }
+  
+  /**
+   * @brief Play every expression with the firmware's evaluator and print its cost
+   * @param library Library bytes
+   * @param frameMs Frame interval
+   * @return Process exit code
+   */
+  int bench(const std::vector<uint8_t>& library, uint32_t frameMs) {
+    // Word-aligned like mapped flash
+    std::vector<uint32_t> aligned((library.size() + 3) / 4);
+    memcpy(aligned.data(), library.data(), library.size());
+    ExpressionLibrary expressions;
+    if (!expressions.load(reinterpret_cast<const uint8_t*>(aligned.data()), static_cast<uint32_t>(library.size()))) {
+      fprintf(stderr, "library failed validation\n");
+      return 1;
+    }
+  
+    printf("%-12s %8s %7s %10s %12s\n", "expression", "frames", "tracks", "changed", "ns/frame");
+    for (uint8_t i = 0; i < expressions.getCount(); i++) {
+      const ExpressionFormat::Expression& expression = expressions.getExpression(i);
+      uint32_t framesPerPlay = expression.durationMs / frameMs + 1;
+      uint32_t plays = (BENCH_PASSES + framesPerPlay - 1) / framesPerPlay;
+  
+      ExpressionPlayer player;
+      uint32_t changed = 0;
+      int32_t checksum = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (uint32_t play = 0; play < plays; play++) {
+        player.start(expressions, i, 0);
+        for (uint32_t frame = 0; frame < framesPerPlay; frame++) {
+          changed += player.advance(frame * frameMs) ? 1 : 0;
+          checksum += player.getPose().values[frame % ExpressionFormat::CHANNEL_COUNT];
+        }
+      }
+      double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  
+      // Reading the pose keeps the evaluation from being optimised away
+      volatile int32_t sink = checksum;
+      (void)sink;
+      printf("%-12s %8u %7u %9.0f%% %12.1f\n", expression.name, framesPerPlay, expression.trackCount,
+             100.0 * changed / (static_cast<double>(plays) * framesPerPlay),
+             elapsedNs / (static_cast<double>(plays) * framesPerPlay));
+    }
+    return 0;
+  }
+}
+
+int main(int argc, char** argv) {
+  bool emitCpp = argc == 4 && strcmp(argv[1], "--cpp") == 0;
+  bool runBench = (argc == 3 || argc == 4) && strcmp(argv[1], "--bench") == 0;
+  if (argc != 3 && !emitCpp && !runBench) {
+    fprintf(stderr, "usage: %s [--cpp] <expressions.txt> <output>\n"
+                    "       %s --bench <expressions.txt> [frame-ms]\n", argv[0], argv[0]);
+    return 1;
+  }
+  const char* inputPath = runBench ? argv[2] : argv[argc - 2];
+  const char* outputPath = argv[argc - 1];
+  
+  std::ifstream input(inputPath);
+  if (!input) {
+    perror(inputPath);
+    return 1;
+  }
+  std::vector<ExpressionSource> expressions;
+  parse(input, expressions);
+  std::vector<uint8_t> library = build(expressions);
+  
+  if (runBench) {
+    uint32_t frameMs = (argc == 4) ? static_cast<uint32_t>(strtoul(argv[3], nullptr, 0)) : 20;
+    return bench(library, (frameMs > 0) ? frameMs : 20);
+  }
+  
+  FILE* output = fopen(outputPath, emitCpp ? "w" : "wb");
+  if (output == nullptr) {
+    perror(outputPath);
+    return 1;
+  }
+  if (emitCpp) {
+    fprintf(output, "// Generated by tools/expression_compiler from %s. Do not edit.\n", inputPath);
+    fprintf(output, "#include \"ExpressionTimeline.h\"\n\n");
+    fprintf(output, "alignas(4) const uint8_t ExpressionData::DEFAULT_EXPRESSIONS[] = {");
+    for (size_t i = 0; i < library.size(); i++) {
+      fprintf(output, "%s0x%02X,", (i % 16 == 0) ? "\n  " : " ", library[i]);
+    }
+    fprintf(output, "\n};\n\n");
+    fprintf(output, "const uint32_t ExpressionData::DEFAULT_EXPRESSIONS_SIZE = "
+                    "sizeof(ExpressionData::DEFAULT_EXPRESSIONS);\n");
+  } else {
+    fwrite(library.data(), 1, library.size(), output);
+  }
+  fclose(output);
+  
+  printf("%s: %u expressions, %u bytes\n", outputPath, static_cast<unsigned>(expressions.size()),
+         static_cast<unsigned>(library.size()));
+  return 0;
+}
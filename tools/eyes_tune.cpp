@@ -0,0 +1,565 @@
+/**
+ * @brief Host-side client for the SerialProtocol tuning and telemetry protocol
+ *
+ * Build:  g++ -std=c++17 -O2 -o eyes_tune tools/eyes_tune.cpp
+ * Usage:  eyes_tune <device> ping
+ *         eyes_tune <device> list
+ *         eyes_tune <device> get <name>
+ *         eyes_tune <device> set <name> <value>
+ *         eyes_tune <device> telemetry <interval-ms> [count]
+ *         eyes_tune <device> memory
+ *         eyes_tune <device> boot
+ *         eyes_tune <device> gaze
+ *         eyes_tune <device> rotation
+ *         eyes_tune <device> sinks
+ *         eyes_tune <device> expression <index>
+ *         eyes_tune <device> expressions
+ *         eyes_tune <device> tilt
+ *         eyes_tune <device> imu <samples> <trace-file>
+ *         eyes_tune <device> look <x> <y> | off
+ *         eyes_tune <device> track <seconds> [rate-hz]
+ *         eyes_tune <device> sources
+ *         eyes_tune <device> audio
+ *         eyes_tune <device> instances
+ *         eyes_tune <device> touchbench
+ *         eyes_tune <device> colors
+ *         eyes_tune <device> trace <frames> <trace-file>
+ *         eyes_tune <device> batch <capture-file> [seed]
+ *
+ * <device> is a serial port or any other character device, e.g. one end of
+ * a pty pair (socat -d -d pty,raw,echo=0 pty,raw,echo=0) attached to a
+ * simulator or a recorded session. Terminals are switched to raw 115200 baud.
+ * Bytes outside reply packets (text reports, frame streams) are passed
+ * through to stdout, or to the capture file for "batch"; decode a capture
+ * with tools/frame_decoder. Replay a trace with tools/governor_sim, or an
+ * IMU trace with tools/tilt_check. "track" stands in for a host-side
+ * tracker, sending a target that circles the screen for the eyes to follow.
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+  // Must match PacketCodec
+  constexpr uint8_t SYNC_REQUEST = 0xA5;
+  constexpr uint8_t SYNC_REPLY = 0x5A;
+  constexpr uint8_t REPLY_FLAG = 0x80;
+  constexpr uint8_t PING = 0x00;
+  constexpr uint8_t PARAM_INFO = 0x01;
+  constexpr uint8_t PARAM_GET = 0x02;
+  constexpr uint8_t PARAM_SET = 0x03;
+  constexpr uint8_t TELEMETRY = 0x04;
+  constexpr uint8_t MEMORY_REPORT = 0x05;
+  constexpr uint8_t BATCH_RENDER = 0x06;
+  constexpr uint8_t BOOT_REPORT = 0x07;
+  constexpr uint8_t FRAME_TRACE = 0x08;
+  constexpr uint8_t GAZE_REPORT = 0x09;
+  constexpr uint8_t ROTATION_BENCH = 0x0A;
+  constexpr uint8_t SINK_REPORT = 0x0B;
+  constexpr uint8_t EXPRESSION = 0x0C;
+  constexpr uint8_t EXPRESSION_REPORT = 0x0D;
+  constexpr uint8_t IMU_TRACE = 0x0E;
+  constexpr uint8_t TILT_REPORT = 0x0F;
+  constexpr uint8_t LOOK_AT = 0x10;
+  constexpr uint8_t GAZE_SOURCE_REPORT = 0x11;
+  constexpr uint8_t AUDIO_REPORT = 0x12;
+  constexpr uint8_t INSTANCE_BENCH = 0x13;
+  constexpr uint8_t TOUCH_BENCH = 0x14;
+  constexpr uint8_t COLOR_BENCH = 0x15;
+  constexpr uint8_t TELEMETRY_REPORT = 0x70;
+  constexpr uint8_t FRAME_TRACE_REPORT = 0x71;
+  constexpr uint8_t IMU_TRACE_REPORT = 0x72;
+  constexpr uint8_t HISTOGRAM_BUCKETS = 8;
+  
+  // Path of the stand-in tracker's target (logical coordinates of the landscape mount)
+  constexpr double TRACK_CENTER_X = 160.0;
+  constexpr double TRACK_CENTER_Y = 120.0;
+  constexpr double TRACK_RADIUS_X = 140.0;
+  constexpr double TRACK_RADIUS_Y = 100.0;
+  constexpr double TRACK_PERIOD_S = 4.0;
+  
+  const char* const STATUS_NAMES[] = {
+    "ok", "unknown command", "bad length", "unknown parameter", "out of range", "failed"
+  };
+  const char* const STATE_NAMES[] = { "normal", "gazing", "dizzy", "expression" };
+  constexpr uint8_t NUM_OF_STATES = sizeof(STATE_NAMES) / sizeof(STATE_NAMES[0]);
+  
+  /**
+   * @brief Structure holding a parameter description
+   */
+  struct ParameterInfo {
+    uint8_t id;
+    uint8_t type;       // 0: uint8, 1: uint16, 2: uint32, 3: float
+    uint32_t minValue;
+    uint32_t maxValue;
+    uint32_t value;
+    std::string name;
+  };
+  
+  int device = -1;
+  std::vector<uint8_t> pending;   // Received bytes not yet consumed
+  FILE* passthrough = stdout;     // Destination of bytes outside reply packets
+  
+  /**
+   * @brief Get a monotonic time stamp
+   * @return Milliseconds
+   */
+  uint64_t nowMillis() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+  }
+  
+  uint32_t readU32(const uint8_t* input) {
+    return input[0] | (input[1] << 8) | (input[2] << 16) | (static_cast<uint32_t>(input[3]) << 24);
+  }
+  
+  uint16_t readU16(const uint8_t* input) {
+    return static_cast<uint16_t>(input[0] | (input[1] << 8));
+  }
+  
+  /**
+   * @brief Send a request packet
+   * @param command Command
+   * @param payload Payload bytes
+   */
+  void sendRequest(uint8_t command, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> packet = { SYNC_REQUEST, command, static_cast<uint8_t>(payload.size()) };
+    packet.insert(packet.end(), payload.begin(), payload.end());
+    uint8_t sum = 0;
+    for (uint8_t value : packet) {
+      sum += value;
+    }
+    packet.push_back(sum);
+    if (write(device, packet.data(), packet.size()) != static_cast<ssize_t>(packet.size())) {
+      perror("write");
+      exit(1);
+    }
+  }
+  
+  /**
+   * @brief Wait for a reply packet, passing other bytes through
+   * @param command Expected packet command
+   * @param timeoutMs Time to wait (0: forever)
+   * @param payload Receives the payload
+   * @return false on timeout
+   */
+  bool receive(uint8_t command, uint64_t timeoutMs, std::vector<uint8_t>& payload) {
+    uint64_t deadline = nowMillis() + timeoutMs;
+    while (true) {
+      // Consume everything that cannot start the expected packet
+      size_t start = 0;
+      while (start < pending.size()) {
+        if (pending[start] != SYNC_REPLY) {
+          start++;
+          continue;
+        }
+        if (pending.size() - start < 3) {
+          break;
+        }
+        size_t length = pending[start + 2];
+        if (pending.size() - start < length + 4) {
+          break;
+        }
+        uint8_t sum = 0;
+        for (size_t i = start; i < start + 3 + length; i++) {
+          sum += pending[i];
+        }
+        uint8_t packetCommand = pending[start + 1];
+        bool isReply = (packetCommand & REPLY_FLAG) != 0 || packetCommand == TELEMETRY_REPORT ||
+                       packetCommand == FRAME_TRACE_REPORT;
+        if (!isReply || pending[start + 3 + length] != sum) {
+          start++;
+          continue;
+        }
+        if (packetCommand != command) {
+          // Another reply (e.g. a telemetry report while waiting for a parameter)
+          fwrite(pending.data(), 1, start, passthrough);
+          pending.erase(pending.begin(), pending.begin() + start + 4 + length);
+          start = 0;
+          continue;
+        }
+  
+        fwrite(pending.data(), 1, start, passthrough);
+        payload.assign(pending.begin() + start + 3, pending.begin() + start + 3 + length);
+        pending.erase(pending.begin(), pending.begin() + start + 4 + length);
+        return true;
+      }
+      fwrite(pending.data(), 1, start, passthrough);
+      pending.erase(pending.begin(), pending.begin() + start);
+      fflush(passthrough);
+  
+      int waitMs = 100;
+      if (timeoutMs > 0) {
+        uint64_t now = nowMillis();
+        if (now >= deadline) {
+          return false;
+        }
+        waitMs = static_cast<int>(std::min<uint64_t>(deadline - now, 100));
+      }
+      pollfd descriptor = { device, POLLIN, 0 };
+      if (poll(&descriptor, 1, waitMs) > 0) {
+        uint8_t buffer[4096];
+        ssize_t count = read(device, buffer, sizeof(buffer));
+        if (count < 0 && errno != EAGAIN && errno != EINTR) {
+          perror("read");
+          exit(1);
+        }
+        if (count > 0) {
+          pending.insert(pending.end(), buffer, buffer + count);
+        }
+      }
+    }
+  }
+  
+  /**
+   * @brief Send a request and wait for its reply
+   * @param command Command
+   * @param request Request payload
+   * @param reply Receives the reply payload (starting with the status byte)
+   * @param timeoutMs Time to wait
+   */
+  void transact(uint8_t command, const std::vector<uint8_t>& request, std::vector<uint8_t>& reply,
+                uint64_t timeoutMs = 1000) {
+    sendRequest(command, request);
+    if (!receive(command | REPLY_FLAG, timeoutMs, reply) || reply.empty()) {
+      fprintf(stderr, "no reply to command 0x%02X\n", command);
+      exit(1);
+    }
+    if (reply[0] != 0) {
+      fprintf(stderr, "error: %s\n", reply[0] < 6 ? STATUS_NAMES[reply[0]] : "unknown status");
+      exit(1);
+    }
+  }
+  
+  /**
+   * @brief Drain the device for a while, passing bytes through
+   * @param durationMs Time to keep reading
+   */
+  void drain(uint64_t durationMs) {
+    std::vector<uint8_t> ignored;
+    receive(0xFF, durationMs, ignored);
+    fwrite(pending.data(), 1, pending.size(), passthrough);
+    pending.clear();
+    fflush(passthrough);
+  }
+  
+  /**
+   * @brief Fetch the description of a parameter
+   * @param id Parameter ID
+   * @return Parameter description
+   */
+  ParameterInfo fetchInfo(uint8_t id) {
+    std::vector<uint8_t> reply;
+    transact(PARAM_INFO, { id }, reply);
+    if (reply.size() < 15) {
+      fprintf(stderr, "short PARAM_INFO reply\n");
+      exit(1);
+    }
+    ParameterInfo info;
+    info.id = reply[1];
+    info.type = reply[2];
+    info.minValue = readU32(&reply[3]);
+    info.maxValue = readU32(&reply[7]);
+    info.value = readU32(&reply[11]);
+    info.name.assign(reply.begin() + 15, reply.end());
+    return info;
+  }
+  
+  /**
+   * @brief Find a parameter by name
+   * @param name Parameter name
+   * @return Parameter description
+   */
+  ParameterInfo findParameter(const std::string& name) {
+    std::vector<uint8_t> reply;
+    transact(PING, {}, reply);
+    uint8_t count = reply.size() > 2 ? reply[2] : 0;
+    for (uint8_t id = 0; id < count; id++) {
+      ParameterInfo info = fetchInfo(id);
+      if (info.name == name) {
+        return info;
+      }
+    }
+    fprintf(stderr, "unknown parameter %s\n", name.c_str());
+    exit(1);
+  }
+  
+  /**
+   * @brief Format an encoded value
+   * @param type Parameter type
+   * @param value Encoded value
+   * @return Text
+   */
+  std::string formatValue(uint8_t type, uint32_t value) {
+    char text[32];
+    if (type == 3) {
+      float number;
+      memcpy(&number, &value, sizeof(number));
+      snprintf(text, sizeof(text), "%g", number);
+    } else {
+      snprintf(text, sizeof(text), "%u", value);
+    }
+    return text;
+  }
+  
+  /**
+   * @brief Print a telemetry report
+   * @param report Report payload
+   */
+  void printTelemetry(const std::vector<uint8_t>& report) {
+    if (report.size() < 48) {
+      return;
+    }
+    uint8_t state = report[10];
+    printf("t=%u ms frames=%u fps=%.1f state=%s transitions=%u max=%u us dropped=%u bad=%u hist(ms <1,<2,<4..>=64):",
+           readU32(&report[0]), readU32(&report[4]), readU16(&report[8]) / 10.0,
+           state < NUM_OF_STATES ? STATE_NAMES[state] : "?", readU32(&report[11]),
+           readU32(&report[31]), readU32(&report[35]), readU16(&report[39]));
+    for (uint8_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+      printf(" %u", readU16(&report[15 + i * 2]));
+    }
+    printf(" degradation=%u missed=%u cpu=%u MHz\n", report[41], readU32(&report[42]), readU16(&report[46]));
+    fflush(stdout);
+  }
+  
+  /**
+   * @brief Send a target for the eyes to look at
+   * @param x X in logical screen coordinates
+   * @param y Y in logical screen coordinates
+   */
+  void lookAt(int16_t x, int16_t y) {
+    std::vector<uint8_t> reply;
+    transact(LOOK_AT, { static_cast<uint8_t>(x), static_cast<uint8_t>(static_cast<uint16_t>(x) >> 8),
+                        static_cast<uint8_t>(y), static_cast<uint8_t>(static_cast<uint16_t>(y) >> 8) }, reply);
+  }
+  
+  /**
+   * @brief Open the device, switching terminals to raw mode
+   * @param path Device path
+   */
+  void openDevice(const char* path) {
+    device = open(path, O_RDWR | O_NOCTTY);
+    if (device < 0) {
+      perror(path);
+      exit(1);
+    }
+    termios settings;
+    if (tcgetattr(device, &settings) == 0) {
+      cfmakeraw(&settings);
+      cfsetispeed(&settings, B115200);
+      cfsetospeed(&settings, B115200);
+      tcsetattr(device, TCSANOW, &settings);
+    }
+  }
+  
+  /**
+   * @brief Print usage and exit
+   * @param program Program name
+   */
+  [[noreturn]] void usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s <device> ping | list | get <name> | set <name> <value> |\n"
+            "       telemetry <interval-ms> [count] | memory | boot | gaze | rotation |\n"
+            "       sinks | expression <index> | expressions | tilt |\n"
+            "       batch <capture-file> [seed] | trace <frames> <trace-file> |\n"
+            "       imu <samples> <trace-file> | look <x> <y> | look off |\n"
+            "       track <seconds> [rate-hz] | sources | audio | instances | touchbench |\n"
+            "       colors\n",
+            program);
+    exit(1);
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    usage(argv[0]);
+  }
+  openDevice(argv[1]);
+  std::string command = argv[2];
+  std::vector<uint8_t> reply;
+  
+  if (command == "ping") {
+    transact(PING, {}, reply);
+    printf("protocol %u, %u parameters\n", reply[1], reply[2]);
+  } else if (command == "list") {
+    transact(PING, {}, reply);
+    for (uint8_t id = 0; id < reply[2]; id++) {
+      ParameterInfo info = fetchInfo(id);
+      printf("%2u %-24s %-10s [%s, %s]\n", info.id, info.name.c_str(),
+             formatValue(info.type, info.value).c_str(),
+             formatValue(info.type, info.minValue).c_str(), formatValue(info.type, info.maxValue).c_str());
+    }
+  } else if (command == "get" && argc == 4) {
+    ParameterInfo info = findParameter(argv[3]);
+    transact(PARAM_GET, { info.id }, reply);
+    printf("%s\n", formatValue(info.type, readU32(&reply[2])).c_str());
+  } else if (command == "set" && argc == 5) {
+    ParameterInfo info = findParameter(argv[3]);
+    uint32_t value;
+    if (info.type == 3) {
+      float number = strtof(argv[4], nullptr);
+      memcpy(&value, &number, sizeof(value));
+    } else {
+      value = static_cast<uint32_t>(strtoul(argv[4], nullptr, 0));
+    }
+    transact(PARAM_SET, { info.id, static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                          static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24) }, reply);
+    printf("%s = %s\n", info.name.c_str(), formatValue(info.type, readU32(&reply[2])).c_str());
+  } else if (command == "telemetry" && (argc == 4 || argc == 5)) {
+    uint16_t interval = static_cast<uint16_t>(strtoul(argv[3], nullptr, 0));
+    long count = (argc == 5) ? strtol(argv[4], nullptr, 0) : -1;
+    transact(TELEMETRY, { static_cast<uint8_t>(interval), static_cast<uint8_t>(interval >> 8) }, reply);
+    for (long i = 0; interval > 0 && (count < 0 || i < count); i++) {
+      std::vector<uint8_t> report;
+      if (receive(TELEMETRY_REPORT, interval * 4 + 1000, report)) {
+        printTelemetry(report);
+      }
+    }
+    if (count >= 0) {
+      transact(TELEMETRY, { 0, 0 }, reply);
+    }
+  } else if (command == "memory") {
+    transact(MEMORY_REPORT, {}, reply);
+    drain(500);
+  } else if (command == "boot") {
+    transact(BOOT_REPORT, {}, reply);
+    drain(500);
+  } else if (command == "gaze") {
+    // The device compares every screen pixel per cell size before the report is complete
+    transact(GAZE_REPORT, {}, reply);
+    drain(3000);
+  } else if (command == "rotation") {
+    transact(ROTATION_BENCH, {}, reply);
+    drain(2000);
+  } else if (command == "sinks") {
+    transact(SINK_REPORT, {}, reply);
+    drain(500);
+  } else if (command == "expression" && argc == 4) {
+    transact(EXPRESSION, { static_cast<uint8_t>(strtoul(argv[3], nullptr, 0)) }, reply);
+  } else if (command == "expressions") {
+    transact(EXPRESSION_REPORT, {}, reply);
+    drain(1000);
+  } else if (command == "tilt") {
+    transact(TILT_REPORT, {}, reply);
+    drain(500);
+  } else if (command == "imu" && argc == 5) {
+    uint16_t samples = static_cast<uint16_t>(strtoul(argv[3], nullptr, 0));
+    FILE* trace = fopen(argv[4], "w");
+    if (trace == nullptr) {
+      perror(argv[4]);
+      return 1;
+    }
+    fprintf(trace, "# time_ms ax_mg ay_mg az_mg gx_ddps gy_ddps gz_ddps\n");
+    transact(IMU_TRACE, { static_cast<uint8_t>(samples), static_cast<uint8_t>(samples >> 8) }, reply);
+    uint16_t received = 0;
+    std::vector<uint8_t> report;
+    while (received < samples && receive(IMU_TRACE_REPORT, 2000, report)) {
+      if (report.size() >= 16) {
+        fprintf(trace, "%u", readU32(&report[0]));
+        for (uint8_t i = 0; i < 6; i++) {
+          fprintf(trace, " %d", static_cast<int16_t>(readU16(&report[4 + i * 2])));
+        }
+        fprintf(trace, "\n");
+        received++;
+      }
+    }
+    fclose(trace);
+    printf("%u of %u IMU samples traced\n", received, samples);
+  } else if (command == "look" && argc == 4 && strcmp(argv[3], "off") == 0) {
+    transact(LOOK_AT, {}, reply);
+  } else if (command == "look" && argc == 5) {
+    lookAt(static_cast<int16_t>(strtol(argv[3], nullptr, 0)), static_cast<int16_t>(strtol(argv[4], nullptr, 0)));
+  } else if (command == "track" && (argc == 4 || argc == 5)) {
+    // Refreshes well within the device's external target expiry
+    double seconds = strtod(argv[3], nullptr);
+    double rate = (argc == 5) ? strtod(argv[4], nullptr) : 30.0;
+    if (seconds <= 0.0 || rate <= 0.0) {
+      usage(argv[0]);
+    }
+    uint64_t start = nowMillis();
+    uint64_t intervalMs = static_cast<uint64_t>(1000.0 / rate);
+    uint32_t sent = 0;
+    for (uint64_t next = start; next - start < seconds * 1000.0; next += intervalMs) {
+      double t = (next - start) / 1000.0;
+      double angle = 2.0 * M_PI * t / TRACK_PERIOD_S;
+      lookAt(static_cast<int16_t>(lround(TRACK_CENTER_X + TRACK_RADIUS_X * cos(angle))),
+             static_cast<int16_t>(lround(TRACK_CENTER_Y + TRACK_RADIUS_Y * sin(2.0 * angle) / 2.0)));
+      sent++;
+      uint64_t now = nowMillis();
+      if (next + intervalMs > now) {
+        drain(next + intervalMs - now);
+      }
+    }
+    transact(LOOK_AT, {}, reply);
+    printf("%u targets sent in %.1f s\n", sent, (nowMillis() - start) / 1000.0);
+  } else if (command == "sources") {
+    transact(GAZE_SOURCE_REPORT, {}, reply);
+    drain(500);
+  } else if (command == "audio") {
+    transact(AUDIO_REPORT, {}, reply);
+    drain(500);
+  } else if (command == "touchbench") {
+    transact(TOUCH_BENCH, {}, reply);
+    drain(1000);
+  } else if (command == "colors") {
+    transact(COLOR_BENCH, {}, reply);
+    drain(2000);
+  } else if (command == "instances") {
+    // The report is printed while the runs go on; the reply comes last
+    transact(INSTANCE_BENCH, {}, reply, 300000);
+    drain(500);
+  } else if (command == "trace" && argc == 5) {
+    uint16_t frames = static_cast<uint16_t>(strtoul(argv[3], nullptr, 0));
+    FILE* trace = fopen(argv[4], "w");
+    if (trace == nullptr) {
+      perror(argv[4]);
+      return 1;
+    }
+    fprintf(trace, "# state load work_us mhz budget_ms\n");
+    transact(FRAME_TRACE, { static_cast<uint8_t>(frames), static_cast<uint8_t>(frames >> 8) }, reply);
+    uint16_t received = 0;
+    std::vector<uint8_t> report;
+    while (received < frames && receive(FRAME_TRACE_REPORT, 2000, report)) {
+      if (report.size() >= 10) {
+        fprintf(trace, "%u %u %u %u %u\n", report[0], report[1], readU32(&report[2]),
+                readU16(&report[6]), readU16(&report[8]));
+        received++;
+      }
+    }
+    fclose(trace);
+    printf("%u of %u frames traced\n", received, frames);
+  } else if (command == "batch" && (argc == 4 || argc == 5)) {
+    FILE* capture = fopen(argv[3], "wb");
+    if (capture == nullptr) {
+      perror(argv[3]);
+      return 1;
+    }
+    uint32_t seed = (argc == 5) ? static_cast<uint32_t>(strtoul(argv[4], nullptr, 0)) : 1;
+    sendRequest(BATCH_RENDER, { static_cast<uint8_t>(seed), static_cast<uint8_t>(seed >> 8),
+                                static_cast<uint8_t>(seed >> 16), static_cast<uint8_t>(seed >> 24) });
+    passthrough = capture;
+    bool replied = receive(BATCH_RENDER | REPLY_FLAG, 300000, reply);
+    fclose(capture);
+    passthrough = stdout;
+    if (!replied || reply.empty() || reply[0] != 0) {
+      fprintf(stderr, "batch render failed\n");
+      return 1;
+    }
+    drain(500);
+  } else {
+    usage(argv[0]);
+  }
+  return 0;
+}
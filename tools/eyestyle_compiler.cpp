@@ -0,0 +1,428 @@
+/**
+ * @brief Host-side compiler for eye style assets
+ *
+ * Reads a text description, rasterises its shapes into spans and writes the
+ * binary asset described in include/EyeStyleFormat.h, the C++ source of the
+ * built-in style, or the C++ source of the prerendered first frame
+ * (include/BootFrame.h).
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o eyestyle_compiler tools/eyestyle_compiler.cpp
+ * Usage:  eyestyle_compiler <style.txt> <style.bin>
+ *         eyestyle_compiler --cpp <style.txt> <EyeStyleDefault.cpp>
+ *         eyestyle_compiler --boot-frame <style.txt> <BootFrame.cpp>
+ *
+ * Flash a binary asset into the "eyestyle" partition (see partitions.csv), e.g.
+ *   parttool.py --port /dev/ttyUSB0 write_partition --partition-name eyestyle --input style.bin
+ *
+ * Description syntax ('#' starts a comment):
+ *   sclera_radius <rx> <ry>             pupil travel ellipse
+ *   pupil_radius <rx> <ry>              subtracted from the travel ellipse
+ *   pupil_margin <percent>              share of the travel range used
+ *   pupil_offset <left|right> <dx> <dy> pupil drawing offset
+ *   eyelid <open|half_closed|closed> <top> <bottom>
+ *                                       rows above top and from bottom down are covered
+ *   layer <sclera|pupil> <color> <mono|palette|all> ellipse <rx> <ry>
+ *   layer <sclera|pupil> <color> <mono|palette|all> bitmap
+ *     <rows of '#' (set) and '.' (clear), centered on the layer origin>
+ *   end
+ *
+ * Colors are EyePalette index names (BACKGROUND, SCLERA_RING, ..., PUPIL).
+ * Layers are drawn in the order given.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "EyeStyleFormat.h"
+
+namespace {
+  const char* const COLOR_NAMES[] = {
+    "BACKGROUND", "SCLERA_RING", "SCLERA_SHADE", "SCLERA",
+    "IRIS_OUTER_RING", "IRIS", "IRIS_INNER_RING", "PUPIL"
+  };
+  const char* const EYELID_NAMES[] = { "open", "half_closed", "closed" };
+  constexpr uint8_t EYELID_LEVELS = 3;
+  
+  // Palette entries drawn white in mono (see Eye::color)
+  constexpr uint8_t SCLERA_SHADE_INDEX = 2;
+  constexpr uint8_t SCLERA_INDEX = 3;
+  
+  // Half size of the canvas the first frame of an eye is composed on
+  constexpr int BOOT_FRAME_EXTENT = 256;
+  
+  /**
+   * @brief Structure holding a parsed layer
+   */
+  struct LayerSource {
+    EyeStyleFormat::Layer layer;
+    std::vector<EyeStyleFormat::Span> spans;
+  };
+  
+  /**
+   * @brief Report a syntax error and exit
+   * @param line Line number
+   * @param message Error message
+   */
+  [[noreturn]] void fail(int line, const std::string& message) {
+    fprintf(stderr, "line %d: %s\n", line, message.c_str());
+    exit(1);
+  }
+  
+  /**
+   * @brief Look up a name in a table
+   * @param names Table of names
+   * @param count Number of names
+   * @param name Name to find
+   * @return Index, or -1 if not found
+   */
+  int lookup(const char* const* names, int count, const std::string& name) {
+    for (int i = 0; i < count; i++) {
+      if (name == names[i]) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  
+  /**
+   * @brief Rasterise a filled ellipse centered on the origin
+   * @param rx Horizontal radius
+   * @param ry Vertical radius
+   * @param spans Destination
+   */
+  void rasteriseEllipse(int rx, int ry, std::vector<EyeStyleFormat::Span>& spans) {
+    for (int dy = -ry; dy <= ry; dy++) {
+      double t = static_cast<double>(dy) / ry;
+      int half = static_cast<int>(std::floor(rx * std::sqrt(1.0 - t * t) + 0.5));
+      spans.push_back({ static_cast<int16_t>(dy), static_cast<int16_t>(-half),
+                        static_cast<uint16_t>(half * 2 + 1) });
+    }
+  }
+  
+  /**
+   * @brief Rasterise bitmap rows centered on the origin
+   * @param rows Rows of '#' and '.'
+   * @param spans Destination
+   */
+  void rasteriseBitmap(const std::vector<std::string>& rows, std::vector<EyeStyleFormat::Span>& spans) {
+    size_t width = 0;
+    for (const std::string& row : rows) {
+      width = std::max(width, row.size());
+    }
+    int originY = static_cast<int>(rows.size() / 2);
+    int originX = static_cast<int>(width / 2);
+    for (size_t y = 0; y < rows.size(); y++) {
+      const std::string& row = rows[y];
+      size_t x = 0;
+      while (x < row.size()) {
+        if (row[x] != '#') {
+          x++;
+          continue;
+        }
+        size_t start = x;
+        while (x < row.size() && row[x] == '#') {
+          x++;
+        }
+        spans.push_back({ static_cast<int16_t>(static_cast<int>(y) - originY),
+                          static_cast<int16_t>(static_cast<int>(start) - originX),
+                          static_cast<uint16_t>(x - start) });
+      }
+    }
+  }
+  
+  /**
+   * @brief Compose the mono first frame of one eye and split it into white runs
+   * @param header Style header (pupil offsets)
+   * @param layers Parsed layers, drawn in order with the pupil centered
+   * @param side Which eye (0: left, 1: right)
+   * @param runs Destination, relative to the eye center
+   */
+  void renderBootFrame(const EyeStyleFormat::Header& header, const std::vector<LayerSource>& layers,
+                       int side, std::vector<EyeStyleFormat::Span>& runs) {
+    const int size = BOOT_FRAME_EXTENT * 2;
+    std::vector<uint8_t> white(static_cast<size_t>(size) * size, 0);
+    for (const LayerSource& source : layers) {
+      if ((source.layer.modes & EyeStyleFormat::MODE_MONO) == 0) {
+        continue;
+      }
+      bool isWhite = source.layer.colorIndex == SCLERA_SHADE_INDEX || source.layer.colorIndex == SCLERA_INDEX;
+      bool isPupil = source.layer.target == EyeStyleFormat::TARGET_PUPIL;
+      int originX = BOOT_FRAME_EXTENT + (isPupil ? header.pupilOffsetX[side] : 0);
+      int originY = BOOT_FRAME_EXTENT + (isPupil ? header.pupilOffsetY[side] : 0);
+      for (const EyeStyleFormat::Span& span : source.spans) {
+        int y = originY + span.dy;
+        for (int x = originX + span.dx; x < originX + span.dx + span.length; x++) {
+          if (x >= 0 && x < size && y >= 0 && y < size) {
+            white[static_cast<size_t>(y) * size + x] = isWhite;
+          }
+        }
+      }
+    }
+    
+    for (int y = 0; y < size; y++) {
+      const uint8_t* row = &white[static_cast<size_t>(y) * size];
+      int x = 0;
+      while (x < size) {
+        if (!row[x]) {
+          x++;
+          continue;
+        }
+        int start = x;
+        while (x < size && row[x]) {
+          x++;
+        }
+        runs.push_back({ static_cast<int16_t>(y - BOOT_FRAME_EXTENT),
+                         static_cast<int16_t>(start - BOOT_FRAME_EXTENT),
+                         static_cast<uint16_t>(x - start) });
+      }
+    }
+  }
+  
+  /**
+   * @brief Append raw bytes to a buffer, padded to an alignment
+   * @param out Buffer
+   * @param data Bytes
+   * @param length Number of bytes
+   */
+  void append(std::vector<uint8_t>& out, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + length);
+    while (out.size() % 4 != 0) {
+      out.push_back(0);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  bool emitCpp = argc == 4 && strcmp(argv[1], "--cpp") == 0;
+  bool emitBootFrame = argc == 4 && strcmp(argv[1], "--boot-frame") == 0;
+  if (argc != 3 && !emitCpp && !emitBootFrame) {
+    fprintf(stderr, "usage: %s [--cpp | --boot-frame] <style.txt> <output>\n", argv[0]);
+    return 1;
+  }
+  const char* inputPath = argv[argc - 2];
+  const char* outputPath = argv[argc - 1];
+  
+  std::ifstream input(inputPath);
+  if (!input) {
+    perror(inputPath);
+    return 1;
+  }
+  
+  EyeStyleFormat::Header header = {};
+  memcpy(header.magic, EyeStyleFormat::MAGIC, sizeof(header.magic));
+  header.version = EyeStyleFormat::VERSION;
+  header.headerSize = sizeof(header);
+  header.pupilMarginPercent = 100;
+  
+  EyeStyleFormat::Eyelid eyelids[EYELID_LEVELS];
+  for (EyeStyleFormat::Eyelid& eyelid : eyelids) {
+    eyelid = { INT16_MIN, INT16_MAX };
+  }
+  std::vector<LayerSource> layers;
+  
+  std::string text;
+  int lineNumber = 0;
+  while (std::getline(input, text)) {
+    lineNumber++;
+    text = text.substr(0, text.find('#'));
+    std::istringstream line(text);
+    std::string keyword;
+    if (!(line >> keyword)) {
+      continue;
+    }
+  
+    if (keyword == "sclera_radius" || keyword == "pupil_radius") {
+      int rx, ry;
+      if (!(line >> rx >> ry) || rx <= 0 || ry <= 0 || rx > 255 || ry > 255) {
+        fail(lineNumber, "expected two radii in 1..255");
+      }
+      uint8_t& x = (keyword == "sclera_radius") ? header.scleraRadiusX : header.pupilRadiusX;
+      uint8_t& y = (keyword == "sclera_radius") ? header.scleraRadiusY : header.pupilRadiusY;
+      x = static_cast<uint8_t>(rx);
+      y = static_cast<uint8_t>(ry);
+    } else if (keyword == "pupil_margin") {
+      int percent;
+      if (!(line >> percent) || percent < 0 || percent > 100) {
+        fail(lineNumber, "expected a percentage");
+      }
+      header.pupilMarginPercent = static_cast<uint8_t>(percent);
+    } else if (keyword == "pupil_offset") {
+      std::string side;
+      int dx, dy;
+      if (!(line >> side >> dx >> dy) || (side != "left" && side != "right") ||
+          dx < INT8_MIN || dx > INT8_MAX || dy < INT8_MIN || dy > INT8_MAX) {
+        fail(lineNumber, "expected left|right and two offsets in -128..127");
+      }
+      int index = (side == "left") ? 0 : 1;
+      header.pupilOffsetX[index] = static_cast<int8_t>(dx);
+      header.pupilOffsetY[index] = static_cast<int8_t>(dy);
+    } else if (keyword == "eyelid") {
+      std::string level;
+      int top, bottom;
+      if (!(line >> level >> top >> bottom)) {
+        fail(lineNumber, "expected a level and two edges");
+      }
+      int index = lookup(EYELID_NAMES, EYELID_LEVELS, level);
+      if (index < 0) {
+        fail(lineNumber, "unknown eyelid level " + level);
+      }
+      eyelids[index] = { static_cast<int16_t>(top), static_cast<int16_t>(bottom) };
+    } else if (keyword == "layer") {
+      std::string target, color, modes, shape;
+      if (!(line >> target >> color >> modes >> shape)) {
+        fail(lineNumber, "expected target, color, modes and shape");
+      }
+  
+      LayerSource source = {};
+      if (target == "sclera") {
+        source.layer.target = EyeStyleFormat::TARGET_SCLERA;
+      } else if (target == "pupil") {
+        source.layer.target = EyeStyleFormat::TARGET_PUPIL;
+      } else {
+        fail(lineNumber, "unknown target " + target);
+      }
+  
+      int colorIndex = lookup(COLOR_NAMES, sizeof(COLOR_NAMES) / sizeof(COLOR_NAMES[0]), color);
+      if (colorIndex < 0) {
+        fail(lineNumber, "unknown color " + color);
+      }
+      source.layer.colorIndex = static_cast<uint8_t>(colorIndex);
+  
+      if (modes == "mono") {
+        source.layer.modes = EyeStyleFormat::MODE_MONO;
+      } else if (modes == "palette") {
+        source.layer.modes = EyeStyleFormat::MODE_PALETTE;
+      } else if (modes == "all") {
+        source.layer.modes = EyeStyleFormat::MODE_ALL;
+      } else {
+        fail(lineNumber, "unknown modes " + modes);
+      }
+  
+      if (shape == "ellipse") {
+        int rx, ry;
+        if (!(line >> rx >> ry) || rx < 0 || ry < 0) {
+          fail(lineNumber, "expected two radii");
+        }
+        rasteriseEllipse(rx, ry, source.spans);
+      } else if (shape == "bitmap") {
+        std::vector<std::string> rows;
+        while (std::getline(input, text)) {
+          lineNumber++;
+          size_t first = text.find_first_not_of(" \t");
+          std::string row = (first == std::string::npos) ? "" : text.substr(first);
+          if (row == "end") {
+            break;
+          }
+          rows.push_back(row);
+        }
+        rasteriseBitmap(rows, source.spans);
+      } else {
+        fail(lineNumber, "unknown shape " + shape);
+      }
+  
+      if (source.spans.size() > UINT16_MAX) {
+        fail(lineNumber, "too many spans");
+      }
+      source.layer.spanCount = static_cast<uint16_t>(source.spans.size());
+      layers.push_back(source);
+    } else {
+      fail(lineNumber, "unknown keyword " + keyword);
+    }
+  }
+  
+  if (header.pupilRadiusX >= header.scleraRadiusX || header.pupilRadiusY >= header.scleraRadiusY) {
+    fail(lineNumber, "pupil_radius must be smaller than sclera_radius");
+  }
+  if (layers.empty() || layers.size() > UINT8_MAX) {
+    fail(lineNumber, "expected 1..255 layers");
+  }
+  header.layerCount = static_cast<uint8_t>(layers.size());
+  header.eyelidCount = EYELID_LEVELS;
+  
+  if (emitBootFrame) {
+    std::vector<EyeStyleFormat::Span> runs[2];
+    renderBootFrame(header, layers, 0, runs[0]);
+    renderBootFrame(header, layers, 1, runs[1]);
+    
+    FILE* output = fopen(outputPath, "w");
+    if (output == nullptr) {
+      perror(outputPath);
+      return 1;
+    }
+    fprintf(output, "// Generated by tools/eyestyle_compiler from %s. Do not edit.\n", inputPath);
+    fprintf(output, "#include \"BootFrame.h\"\n\n");
+    fprintf(output, "const EyeStyleFormat::Span BootFrame::SPANS[] = {");
+    size_t count = 0;
+    for (const std::vector<EyeStyleFormat::Span>& eyeRuns : runs) {
+      for (const EyeStyleFormat::Span& run : eyeRuns) {
+        fprintf(output, "%s{ %d, %d, %u },", (count % 6 == 0) ? "\n  " : " ",
+                run.dy, run.dx, static_cast<unsigned>(run.length));
+        count++;
+      }
+    }
+    fprintf(output, "\n};\n\n");
+    fprintf(output, "const uint16_t BootFrame::SPAN_COUNTS[2] = { %u, %u };\n",
+            static_cast<unsigned>(runs[0].size()), static_cast<unsigned>(runs[1].size()));
+    fclose(output);
+    
+    printf("%s: %u + %u runs\n", outputPath, static_cast<unsigned>(runs[0].size()),
+           static_cast<unsigned>(runs[1].size()));
+    return 0;
+  }
+  
+  // Lay out header, layer table, eyelid table, then the spans of each layer
+  header.layerOffset = sizeof(header);
+  header.eyelidOffset = header.layerOffset + static_cast<uint32_t>(layers.size() * sizeof(EyeStyleFormat::Layer));
+  uint32_t spanOffset = header.eyelidOffset + sizeof(eyelids);
+  for (LayerSource& source : layers) {
+    source.layer.spanOffset = spanOffset;
+    spanOffset += static_cast<uint32_t>(source.spans.size() * sizeof(EyeStyleFormat::Span));
+    spanOffset = (spanOffset + 3) & ~3U;
+  }
+  
+  std::vector<uint8_t> asset;
+  append(asset, &header, sizeof(header));
+  for (const LayerSource& source : layers) {
+    asset.insert(asset.end(), reinterpret_cast<const uint8_t*>(&source.layer),
+                 reinterpret_cast<const uint8_t*>(&source.layer) + sizeof(source.layer));
+  }
+  append(asset, eyelids, sizeof(eyelids));
+  for (const LayerSource& source : layers) {
+    append(asset, source.spans.data(), source.spans.size() * sizeof(EyeStyleFormat::Span));
+  }
+  
+  EyeStyleFormat::Header* finalHeader = reinterpret_cast<EyeStyleFormat::Header*>(asset.data());
+  finalHeader->totalSize = static_cast<uint32_t>(asset.size());
+  finalHeader->checksum = EyeStyleFormat::checksum(asset.data() + sizeof(header),
+                                                   finalHeader->totalSize - sizeof(header));
+  
+  FILE* output = fopen(outputPath, emitCpp ? "w" : "wb");
+  if (output == nullptr) {
+    perror(outputPath);
+    return 1;
+  }
+  if (emitCpp) {
+    fprintf(output, "// Generated by tools/eyestyle_compiler from %s. Do not edit.\n", inputPath);
+    fprintf(output, "#include \"EyeStyle.h\"\n\n");
+    fprintf(output, "alignas(4) const uint8_t EyeStyleData::DEFAULT_STYLE[] = {");
+    for (size_t i = 0; i < asset.size(); i++) {
+      fprintf(output, "%s0x%02X,", (i % 16 == 0) ? "\n  " : " ", asset[i]);
+    }
+    fprintf(output, "\n};\n\n");
+    fprintf(output, "const uint32_t EyeStyleData::DEFAULT_STYLE_SIZE = sizeof(EyeStyleData::DEFAULT_STYLE);\n");
+  } else {
+    fwrite(asset.data(), 1, asset.size(), output);
+  }
+  fclose(output);
+  
+  printf("%s: %u layers, %u bytes\n", outputPath, static_cast<unsigned>(layers.size()),
+         static_cast<unsigned>(asset.size()));
+  return 0;
+}
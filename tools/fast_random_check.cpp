@@ -0,0 +1,143 @@
+/**
+ * @brief Host-side check of the animation's random number generator
+ *
+ * Checks that include/FastRandom.h stays inside the requested ranges
+ * (including empty and one-value ranges), that values spread evenly over
+ * buckets (chi-square against the uniform distribution), that a seed
+ * reproduces its sequence and that zero falls back to the default seed.
+ * Then times range() against the C library's random() with a modulo, the
+ * way Arduino's random(min, max) picks a value. Exits with status 1 if any
+ * check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o fast_random_check tools/fast_random_check.cpp
+ * Usage:  fast_random_check
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "FastRandom.h"
+
+namespace {
+  constexpr uint32_t DRAWS = 1000000;
+  
+  bool passed = true;
+  
+  /**
+   * @brief Record and print one check with a detail
+   */
+  void report(const char* name, bool ok, const char* detail) {
+    passed = passed && ok;
+    printf("%-40s %s  (%s)\n", name, ok ? "ok" : "FAIL", detail);
+  }
+  
+  /**
+   * @brief Check every value stays in [min, max) and both ends are reached
+   */
+  void checkBounds() {
+    struct Range {
+      int32_t min;
+      int32_t max;
+    };
+    // Saccade and blink ranges of the animation, then edge cases
+    const Range ranges[] = { { -11, 11 }, { 10, 200 }, { 0, 1 }, { -5, -4 }, { 0, 2 }, { INT32_MIN / 2, INT32_MAX / 2 } };
+    FastRandom rng(1);
+    bool ok = true;
+    for (const Range& range : ranges) {
+      int32_t lowest = range.max;
+      int32_t highest = range.min;
+      for (uint32_t i = 0; i < DRAWS; i++) {
+        int32_t value = rng.range(range.min, range.max);
+        ok = ok && value >= range.min && value < range.max;
+        lowest = (value < lowest) ? value : lowest;
+        highest = (value > highest) ? value : highest;
+      }
+      // Small ranges must hit both ends in a million draws
+      if (static_cast<int64_t>(range.max) - range.min <= 1000) {
+        ok = ok && lowest == range.min && highest == range.max - 1;
+      }
+    }
+    ok = ok && rng.range(5, 5) == 5 && rng.range(7, 3) == 7 && rng.range(0) == 0 && rng.range(-3) == 0;
+    report("values within [min, max)", ok, "6 ranges and empty ones");
+  }
+  
+  /**
+   * @brief Compare bucket counts with the uniform distribution
+   */
+  void checkUniformity() {
+    constexpr uint32_t BUCKETS = 22;
+    uint32_t counts[BUCKETS] = {};
+    FastRandom rng(12345);
+    for (uint32_t i = 0; i < DRAWS; i++) {
+      counts[rng.range(BUCKETS)]++;
+    }
+    double expected = static_cast<double>(DRAWS) / BUCKETS;
+    double chiSquare = 0.0;
+    for (uint32_t count : counts) {
+      chiSquare += (count - expected) * (count - expected) / expected;
+    }
+    // 99.9th percentile of chi-square with 21 degrees of freedom
+    char detail[48];
+    snprintf(detail, sizeof(detail), "chi-square %.1f, limit 46.8", chiSquare);
+    report("buckets uniform", chiSquare < 46.8, detail);
+  }
+  
+  /**
+   * @brief Check seeds reproduce their sequences
+   */
+  void checkSeeds() {
+    FastRandom a(42);
+    FastRandom b(42);
+    FastRandom c(43);
+    bool same = true;
+    bool differs = false;
+    for (uint32_t i = 0; i < 1000; i++) {
+      uint32_t value = a.next();
+      same = same && value == b.next();
+      differs = differs || value != c.next();
+    }
+    a.setSeed(42);
+    FastRandom fresh(42);
+    same = same && a.next() == fresh.next();
+    report("seed reproduces its sequence", same && differs, "1000 values, reseeding");
+    
+    FastRandom zero(0);
+    FastRandom fallback(FastRandom::DEFAULT_SEED);
+    bool ok = true;
+    for (uint32_t i = 0; i < 1000; i++) {
+      uint32_t value = zero.next();
+      ok = ok && value != 0 && value == fallback.next();
+    }
+    report("zero seed uses DEFAULT_SEED", ok, "never reaches zero");
+  }
+  
+  /**
+   * @brief Time a function drawing values
+   * @return Nanoseconds per value
+   */
+  template <typename Draw>
+  double measure(Draw draw) {
+    int64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < DRAWS * 20; i++) {
+      sink += draw();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    volatile int64_t keep = sink;
+    (void)keep;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (DRAWS * 20);
+  }
+}
+
+int main() {
+  checkBounds();
+  checkUniformity();
+  checkSeeds();
+  
+  FastRandom rng(1);
+  srandom(1);
+  double fast = measure([&rng]() { return rng.range(-11, 11); });
+  double libc = measure([]() { return static_cast<int32_t>(random() % 22) - 11; });
+  printf("range(): %.2f ns, random() %% n: %.2f ns (%.1fx)\n", fast, libc, libc / fast);
+  return passed ? 0 : 1;
+}
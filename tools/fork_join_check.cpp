@@ -0,0 +1,186 @@
+/**
+ * @brief Host-side check of the per-eye fork/join drawing
+ *
+ * Builds src/ForkJoin.cpp with its std::thread backend and draws a
+ * sequence of frames into two 1-bit eye sprites the size of Eye's: a
+ * sclera ellipse, an iris ring and a pupil at a random gaze offset per
+ * eye, covered by eyelids during blinks. Every frame is drawn once with
+ * both eyes on the caller (before begin()) and once in parallel, and the
+ * two pairs of sprites must match byte for byte. Then times both ways
+ * over the same frames; the parallel run must be faster when the host has
+ * at least two cores. Exits with status 1 if any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -pthread -Iinclude -o fork_join_check tools/fork_join_check.cpp src/ForkJoin.cpp
+ * Usage:  fork_join_check
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "FastRandom.h"
+#include "ForkJoin.h"
+
+namespace {
+  // Sprite geometry of Eye in mono mode
+  constexpr int SCLERA_RADIUS_X = 60;
+  constexpr int SCLERA_RADIUS_Y = 75;
+  constexpr int SPRITE_WIDTH = SCLERA_RADIUS_X * 2 + 1;
+  constexpr int SPRITE_HEIGHT = SCLERA_RADIUS_Y * 2 + 1;
+  constexpr int ROW_BYTES = (SPRITE_WIDTH + 7) / 8;
+  constexpr int SPRITE_BYTES = ROW_BYTES * SPRITE_HEIGHT;
+  constexpr int IRIS_RADIUS = 26;
+  constexpr int PUPIL_RADIUS = 14;
+  constexpr uint32_t FRAMES = 2000;
+  
+  bool passed = true;
+  
+  /**
+   * @brief Per-frame drawing parameters shared by both eyes
+   */
+  struct Frame {
+    int8_t gazeX[2];   // Pupil offset per eye
+    int8_t gazeY[2];
+    uint8_t eyelid;    // Rows covered from the top and the bottom
+  };
+  
+  /**
+   * @brief Context of one fork/join run
+   */
+  struct Job {
+    const Frame* frame;
+    uint8_t* sprites[2];
+  };
+  
+  /**
+   * @brief Record and print one check with a detail
+   */
+  void report(const char* name, bool ok, const char* detail) {
+    passed = passed && ok;
+    printf("%-40s %s  (%s)\n", name, ok ? "ok" : "FAIL", detail);
+  }
+  
+  /**
+   * @brief Set or clear one pixel of a 1-bit sprite
+   */
+  void setPixel(uint8_t* sprite, int x, int y, bool white) {
+    uint8_t mask = static_cast<uint8_t>(0x80 >> (x & 7));
+    uint8_t& byte = sprite[y * ROW_BYTES + (x >> 3)];
+    byte = white ? (byte | mask) : (byte & ~mask);
+  }
+  
+  /**
+   * @brief Fork/join job drawing one eye of the frame
+   * @param context Job
+   * @param index Eye index (0: left, 1: right)
+   */
+  void drawEyeJob(void* context, uint8_t index) {
+    const Job* job = static_cast<const Job*>(context);
+    const Frame& frame = *job->frame;
+    uint8_t* sprite = job->sprites[index];
+    // The right eye is the mirror image of the left one
+    int pupilX = (index == 0) ? frame.gazeX[index] : -frame.gazeX[index];
+    int pupilY = frame.gazeY[index];
+    const int64_t scleraRadius = static_cast<int64_t>(SCLERA_RADIUS_X) * SCLERA_RADIUS_X * SCLERA_RADIUS_Y * SCLERA_RADIUS_Y;
+    for (int y = 0; y < SPRITE_HEIGHT; y++) {
+      int dy = y - SCLERA_RADIUS_Y;
+      bool covered = y < frame.eyelid || y >= SPRITE_HEIGHT - frame.eyelid;
+      for (int x = 0; x < SPRITE_WIDTH; x++) {
+        int dx = x - SCLERA_RADIUS_X;
+        bool inSclera = static_cast<int64_t>(dx) * dx * SCLERA_RADIUS_Y * SCLERA_RADIUS_Y +
+                        static_cast<int64_t>(dy) * dy * SCLERA_RADIUS_X * SCLERA_RADIUS_X <= scleraRadius;
+        int px = dx - pupilX;
+        int py = dy - pupilY;
+        int distance = px * px + py * py;
+        bool onIrisRing = distance <= IRIS_RADIUS * IRIS_RADIUS && distance > (IRIS_RADIUS - 2) * (IRIS_RADIUS - 2);
+        bool inPupil = distance <= PUPIL_RADIUS * PUPIL_RADIUS;
+        setPixel(sprite, x, y, !covered && inSclera && !onIrisRing && !inPupil);
+      }
+    }
+  }
+  
+  /**
+   * @brief Make a frame sequence with saccades and blinks
+   */
+  std::vector<Frame> makeFrames() {
+    std::vector<Frame> frames(FRAMES);
+    FastRandom rng(7);
+    int8_t gazeX = 0;
+    int8_t gazeY = 0;
+    uint8_t blink = 0;
+    for (Frame& frame : frames) {
+      if (rng.range(10) == 0) {
+        gazeX = static_cast<int8_t>(rng.range(-30, 31));
+        gazeY = static_cast<int8_t>(rng.range(-40, 41));
+      }
+      if (blink == 0 && rng.range(50) == 0) {
+        blink = 10;
+      }
+      // Close over five frames, then open over five
+      uint8_t step = (blink > 5) ? 10 - blink : blink;
+      blink = (blink > 0) ? blink - 1 : 0;
+      frame.gazeX[0] = gazeX;
+      frame.gazeX[1] = static_cast<int8_t>(gazeX + rng.range(-2, 3));  // Vergence jitter
+      frame.gazeY[0] = gazeY;
+      frame.gazeY[1] = gazeY;
+      frame.eyelid = static_cast<uint8_t>(step * (SCLERA_RADIUS_Y / 5));
+    }
+    return frames;
+  }
+  
+  /**
+   * @brief Draw every frame into both sprites
+   * @return Nanoseconds per frame
+   */
+  double measure(ForkJoin& forkJoin, const std::vector<Frame>& frames, uint8_t* left, uint8_t* right) {
+    Job job = { nullptr, { left, right } };
+    auto start = std::chrono::steady_clock::now();
+    for (const Frame& frame : frames) {
+      job.frame = &frame;
+      forkJoin.run(drawEyeJob, &job);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    volatile uint8_t keep = left[SPRITE_BYTES / 2] ^ right[SPRITE_BYTES / 2];
+    (void)keep;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / frames.size();
+  }
+}
+
+int main() {
+  std::vector<Frame> frames = makeFrames();
+  static uint8_t sequential[2][SPRITE_BYTES];
+  static uint8_t parallel[2][SPRITE_BYTES];
+  
+  // Each frame drawn both ways from the same previous sprites
+  ForkJoin serial;
+  ForkJoin forked;
+  bool started = forked.begin();
+  report("worker started", started && forked.isParallel() && !serial.isParallel(), "std::thread backend");
+  Job serialJob = { nullptr, { sequential[0], sequential[1] } };
+  Job forkedJob = { nullptr, { parallel[0], parallel[1] } };
+  uint32_t mismatches = 0;
+  for (const Frame& frame : frames) {
+    serialJob.frame = &frame;
+    forkedJob.frame = &frame;
+    serial.run(drawEyeJob, &serialJob);
+    forked.run(drawEyeJob, &forkedJob);
+    if (memcmp(sequential, parallel, sizeof(sequential)) != 0) {
+      mismatches++;
+    }
+  }
+  char detail[64];
+  snprintf(detail, sizeof(detail), "%u frames, %u differ", static_cast<unsigned>(FRAMES), static_cast<unsigned>(mismatches));
+  report("parallel matches sequential", mismatches == 0, detail);
+  
+  double serialNs = measure(serial, frames, sequential[0], sequential[1]);
+  double forkedNs = measure(forked, frames, parallel[0], parallel[1]);
+  unsigned cores = std::thread::hardware_concurrency();
+  double speedup = serialNs / forkedNs;
+  snprintf(detail, sizeof(detail), "%.1f vs %.1f us per frame, x%.2f on %u cores",
+           serialNs / 1000.0, forkedNs / 1000.0, speedup, cores);
+  // A single core can only interleave the two eyes
+  report("parallel faster than sequential", cores < 2 || speedup > 1.0, detail);
+  
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+/**
+ * @brief Host-side check of the frame deadline hysteresis
+ *
+ * Replays frame work times through src/FrameDeadline.cpp and checks that
+ * DEGRADE_AFTER_FRAMES consecutive overruns raise the level one step at a
+ * time up to MAX_LEVEL, that an overrun or a frame without headroom
+ * restarts the count, that RESTORE_AFTER_FRAMES frames with headroom lower
+ * it one step, and that nothing changes while shedding is not allowed.
+ * Exits with status 1 if any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o frame_deadline_check tools/frame_deadline_check.cpp src/FrameDeadline.cpp
+ * Usage:  frame_deadline_check
+ */
+#include <cstdint>
+#include <cstdio>
+#include "FrameDeadline.h"
+
+namespace {
+  constexpr uint32_t BUDGET_MICROS = 33333;                  // 30 fps
+  constexpr uint32_t OVERRUN_MICROS = BUDGET_MICROS + 1;
+  constexpr uint32_t HEADROOM_MICROS = BUDGET_MICROS / 4;    // Well below HEADROOM_PERCENT
+  constexpr uint32_t TIGHT_MICROS = BUDGET_MICROS - 1;       // Within budget, no headroom
+  
+  bool passed = true;
+  
+  /**
+   * @brief Record and print one check with a detail
+   */
+  void report(const char* name, bool ok, const char* detail) {
+    passed = passed && ok;
+    printf("%-40s %s  (%s)\n", name, ok ? "ok" : "FAIL", detail);
+  }
+  
+  /**
+   * @brief Record the same frame several times
+   */
+  void feed(FrameDeadline& deadline, uint32_t workMicros, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; i++) {
+      deadline.recordFrame(workMicros, BUDGET_MICROS / 1000, BUDGET_MICROS);
+    }
+  }
+  
+  /**
+   * @brief Get a level as a number
+   */
+  uint8_t levelOf(const FrameDeadline& deadline) {
+    return static_cast<uint8_t>(deadline.getLevel());
+  }
+  
+  /**
+   * @brief Check each run of overruns sheds exactly one level
+   */
+  void checkDegrade() {
+    FrameDeadline deadline;
+    const uint8_t maxLevel = static_cast<uint8_t>(FrameDeadline::MAX_LEVEL);
+    bool ok = true;
+    for (uint8_t level = 1; level <= maxLevel; level++) {
+      feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES - 1);
+      ok = ok && levelOf(deadline) == level - 1;
+      feed(deadline, OVERRUN_MICROS, 1);
+      ok = ok && levelOf(deadline) == level;
+    }
+    feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES * 4);
+    ok = ok && levelOf(deadline) == maxLevel && deadline.getStats().degradations == maxLevel;
+    ok = ok && deadline.isShedding(Degradation::HOLD_SACCADES) && deadline.isShedding(Degradation::ALTERNATE_PUSH);
+    char detail[48];
+    snprintf(detail, sizeof(detail), "%u overruns per level, stops at %u",
+             static_cast<unsigned>(FrameDeadline::DEGRADE_AFTER_FRAMES), static_cast<unsigned>(maxLevel));
+    report("overruns shed one level at a time", ok, detail);
+  }
+  
+  /**
+   * @brief Check a frame within budget breaks a run of overruns
+   */
+  void checkOverrunStreak() {
+    FrameDeadline deadline;
+    for (uint32_t i = 0; i < 10; i++) {
+      feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES - 1);
+      feed(deadline, TIGHT_MICROS, 1);
+    }
+    bool ok = deadline.getLevel() == Degradation::NONE && deadline.getStats().missedDeadlines == 10u * (FrameDeadline::DEGRADE_AFTER_FRAMES - 1);
+    report("isolated overruns keep full quality", ok, "streaks one frame short");
+  }
+  
+  /**
+   * @brief Check each run of headroom frames restores exactly one level
+   */
+  void checkRestore() {
+    FrameDeadline deadline;
+    const uint8_t maxLevel = static_cast<uint8_t>(FrameDeadline::MAX_LEVEL);
+    feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES * maxLevel);
+    bool ok = levelOf(deadline) == maxLevel;
+    for (uint8_t level = maxLevel; level > 0; level--) {
+      feed(deadline, HEADROOM_MICROS, FrameDeadline::RESTORE_AFTER_FRAMES - 1);
+      ok = ok && levelOf(deadline) == level;
+      feed(deadline, HEADROOM_MICROS, 1);
+      ok = ok && levelOf(deadline) == level - 1;
+    }
+    feed(deadline, HEADROOM_MICROS, FrameDeadline::RESTORE_AFTER_FRAMES * 2);
+    ok = ok && deadline.getLevel() == Degradation::NONE && deadline.getStats().restorations == maxLevel;
+    char detail[48];
+    snprintf(detail, sizeof(detail), "%u headroom frames per level",
+             static_cast<unsigned>(FrameDeadline::RESTORE_AFTER_FRAMES));
+    report("headroom restores one level at a time", ok, detail);
+  }
+  
+  /**
+   * @brief Check frames without headroom and overruns restart the restore count
+   */
+  void checkRestoreStreak() {
+    FrameDeadline deadline;
+    feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES);
+    feed(deadline, HEADROOM_MICROS, FrameDeadline::RESTORE_AFTER_FRAMES - 1);
+    feed(deadline, TIGHT_MICROS, 1);
+    feed(deadline, HEADROOM_MICROS, FrameDeadline::RESTORE_AFTER_FRAMES - 1);
+    feed(deadline, OVERRUN_MICROS, 1);
+    feed(deadline, HEADROOM_MICROS, FrameDeadline::RESTORE_AFTER_FRAMES - 1);
+    bool ok = deadline.getLevel() == Degradation::HOLD_SACCADES;
+    feed(deadline, HEADROOM_MICROS, 1);
+    ok = ok && deadline.getLevel() == Degradation::NONE;
+    report("tight frames restart the restore count", ok, "no headroom, then one overrun");
+  }
+  
+  /**
+   * @brief Check nothing is shed while shedding is forbidden
+   */
+  void checkSheddingForbidden() {
+    FrameDeadline deadline;
+    feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES * 2);
+    bool ok = deadline.getLevel() == Degradation::COARSE_BLINK;
+    deadline.setSheddingAllowed(false);
+    ok = ok && deadline.getLevel() == Degradation::NONE;
+    feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES * 10);
+    const DeadlineStats& stats = deadline.getStats();
+    ok = ok && deadline.getLevel() == Degradation::NONE && !deadline.isShedding(Degradation::HOLD_SACCADES);
+    ok = ok && stats.degradations == 2 && stats.missedDeadlines == FrameDeadline::DEGRADE_AFTER_FRAMES * 12u;
+    ok = ok && stats.worstWorkMicros == OVERRUN_MICROS;
+    deadline.setSheddingAllowed(true);
+    feed(deadline, OVERRUN_MICROS, FrameDeadline::DEGRADE_AFTER_FRAMES);
+    ok = ok && deadline.getLevel() == Degradation::HOLD_SACCADES;
+    report("forbidden shedding keeps full quality", ok, "counters still kept");
+  }
+}
+
+int main() {
+  checkDegrade();
+  checkOverrunStreak();
+  checkRestore();
+  checkRestoreStreak();
+  checkSheddingForbidden();
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+/**
+ * @brief Host-side decoder for the FrameStreamer serial stream
+ * 
+ * Reads packets from a capture file or a serial device / pty, rebuilds
+ * each eye sprite, composes them at their display position and writes
+ * one PGM image per frame.
+ * 
+ * Build:  g++ -std=c++17 -O2 -o frame_decoder tools/frame_decoder.cpp
+ * Usage:  frame_decoder <input> <output-prefix> [screen-width screen-height]
+ *         e.g. frame_decoder /dev/ttyUSB0 capture/frame
+ * 
+ * The serial port must already be configured (e.g. stty -F /dev/ttyUSB0 115200 raw).
+ * The BATCH_RENDER request (eyes_tune <device> batch) renders the scripted demo
+ * timeline (BatchRenderer) and streams every frame of it, regardless of
+ * FRAME_STREAM_ENABLED.
+ * 1-bit pixels map to black/white; 4-bit palette indices map to grey levels.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+  constexpr size_t HEADER_SIZE = 17;
+  constexpr uint8_t FLAG_KEYFRAME = 0x01;
+  constexpr uint8_t MAX_EYES = 2;
+  
+  /**
+   * @brief Structure holding the reconstructed state of one eye
+   */
+  struct EyeFrame {
+    std::vector<uint8_t> buffer;
+    int16_t x = 0;
+    int16_t y = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t colorDepth = 0;
+    bool valid = false;
+  };
+  
+  uint16_t readU16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+  }
+  
+  /**
+   * @brief Apply RLE tokens over the XOR delta to a frame
+   * @return false if the payload does not match the frame size
+   */
+  bool applyDelta(const uint8_t* payload, size_t payloadLength, std::vector<uint8_t>& frame) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < payloadLength) {
+      uint8_t token = payload[in++];
+      if (token < 0x80) {
+        out += token + 1;
+      } else {
+        size_t count = token - 0x7F;
+        if (in + count > payloadLength || out + count > frame.size()) {
+          return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+          frame[out++] ^= payload[in++];
+        }
+      }
+    }
+    return out == frame.size();
+  }
+  
+  /**
+   * @brief Get a pixel from a packed sprite buffer as a grey level
+   */
+  uint8_t getPixel(const EyeFrame& eye, int x, int y) {
+    size_t stride = (static_cast<size_t>(eye.width) * eye.colorDepth + 7) / 8;
+    size_t bit = static_cast<size_t>(x) * eye.colorDepth;
+    uint8_t byte = eye.buffer[y * stride + bit / 8];
+    uint8_t shift = static_cast<uint8_t>(8 - eye.colorDepth - (bit % 8));
+    uint8_t value = (byte >> shift) & ((1 << eye.colorDepth) - 1);
+    return static_cast<uint8_t>(value * 255 / ((1 << eye.colorDepth) - 1));
+  }
+  
+  /**
+   * @brief Compose all eyes onto the screen and write a PGM file
+   */
+  bool writeScreen(const char* prefix, unsigned index, const EyeFrame* eyes, int width, int height) {
+    std::vector<uint8_t> screen(static_cast<size_t>(width) * height, 0);
+    for (uint8_t e = 0; e < MAX_EYES; e++) {
+      const EyeFrame& eye = eyes[e];
+      if (!eye.valid) {
+        continue;
+      }
+      for (int y = 0; y < eye.height; y++) {
+        int sy = eye.y + y;
+        if (sy < 0 || sy >= height) {
+          continue;
+        }
+        for (int x = 0; x < eye.width; x++) {
+          int sx = eye.x + x;
+          if (sx >= 0 && sx < width) {
+            screen[sy * width + sx] = getPixel(eye, x, y);
+          }
+        }
+      }
+    }
+    
+    char path[512];
+    snprintf(path, sizeof(path), "%s_%06u.pgm", prefix, index);
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+      perror(path);
+      return false;
+    }
+    fprintf(file, "P5\n%d %d\n255\n", width, height);
+    fwrite(screen.data(), 1, screen.size(), file);
+    fclose(file);
+    return true;
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3 && argc != 5) {
+    fprintf(stderr, "usage: %s <input> <output-prefix> [screen-width screen-height]\n", argv[0]);
+    return 1;
+  }
+  
+  const char* prefix = argv[2];
+  int screenWidth = (argc == 5) ? atoi(argv[3]) : 320;
+  int screenHeight = (argc == 5) ? atoi(argv[4]) : 240;
+  
+  FILE* input = fopen(argv[1], "rb");
+  if (input == nullptr) {
+    perror(argv[1]);
+    return 1;
+  }
+  
+  EyeFrame eyes[MAX_EYES];
+  bool updated[MAX_EYES] = {};
+  std::vector<uint8_t> packet;
+  unsigned frameIndex = 0;
+  unsigned packets = 0;
+  unsigned errors = 0;
+  size_t payloadBytes = 0;
+  size_t rawBytes = 0;
+  int c;
+  int previous = -1;
+  
+  while ((c = fgetc(input)) != EOF) {
+    // Resynchronise on the magic bytes
+    if (!(previous == 'E' && c == 'F')) {
+      previous = c;
+      continue;
+    }
+    previous = -1;
+    
+    packet.assign(HEADER_SIZE, 0);
+    packet[0] = 'E';
+    packet[1] = 'F';
+    if (fread(packet.data() + 2, 1, HEADER_SIZE - 2, input) != HEADER_SIZE - 2) {
+      break;
+    }
+    
+    uint8_t eyeIndex = packet[2];
+    uint16_t payloadLength = readU16(&packet[15]);
+    packet.resize(HEADER_SIZE + payloadLength + 1);
+    if (fread(packet.data() + HEADER_SIZE, 1, payloadLength + 1, input) != payloadLength + 1u) {
+      break;
+    }
+    
+    uint8_t checksum = 0;
+    for (size_t i = 0; i + 1 < packet.size(); i++) {
+      checksum += packet[i];
+    }
+    uint16_t width = readU16(&packet[10]);
+    uint16_t height = readU16(&packet[12]);
+    uint8_t colorDepth = packet[14];
+    if (checksum != packet.back() || eyeIndex >= MAX_EYES ||
+        (colorDepth != 1 && colorDepth != 2 && colorDepth != 4 && colorDepth != 8)) {
+      errors++;
+      continue;
+    }
+    
+    // A second update of the same eye starts a new screen frame
+    if (updated[eyeIndex]) {
+      writeScreen(prefix, frameIndex++, eyes, screenWidth, screenHeight);
+      memset(updated, 0, sizeof(updated));
+    }
+    
+    EyeFrame& eye = eyes[eyeIndex];
+    size_t length = ((static_cast<size_t>(width) * colorDepth + 7) / 8) * height;
+    bool keyframe = (packet[3] & FLAG_KEYFRAME) != 0;
+    if (keyframe) {
+      eye.buffer.assign(length, 0);
+      eye.valid = true;
+    } else if (!eye.valid || eye.buffer.size() != length) {
+      // Deltas are useless until the first keyframe
+      continue;
+    }
+    
+    if (!applyDelta(&packet[HEADER_SIZE], payloadLength, eye.buffer)) {
+      eye.valid = false;
+      errors++;
+      continue;
+    }
+    eye.x = static_cast<int16_t>(readU16(&packet[6]));
+    eye.y = static_cast<int16_t>(readU16(&packet[8]));
+    eye.width = width;
+    eye.height = height;
+    eye.colorDepth = colorDepth;
+    packets++;
+    payloadBytes += packet.size();
+    rawBytes += length;
+    updated[eyeIndex] = true;
+  }
+  
+  writeScreen(prefix, frameIndex++, eyes, screenWidth, screenHeight);
+  fclose(input);
+  
+  fprintf(stderr, "%u packets, %u frames, %u errors, %zu bytes for %zu raw bytes\n",
+          packets, frameIndex, errors, payloadBytes, rawBytes);
+  return 0;
+}
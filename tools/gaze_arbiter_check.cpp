@@ -0,0 +1,219 @@
+/**
+ * @brief Host-side check of the gaze arbiter's rules and of its lock-free slots
+ *
+ * Runs include/GazeArbiter.h through scripted scenarios (priorities, expiry,
+ * withdrawal, weighted averaging and blending over to a new winner), then
+ * lets producer threads hammer their slots while the main thread reads them
+ * and checks that no read ever mixes two submissions. Prints the results
+ * and the cost of a resolve, and exits with status 1 if any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -pthread -Iinclude -o gaze_arbiter_check tools/gaze_arbiter_check.cpp src/GazeArbiter.cpp
+ * Usage:  gaze_arbiter_check [stress-seconds]
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "GazeArbiter.h"
+
+namespace {
+  constexpr uint8_t TOUCH_PRIORITY = 3;
+  constexpr uint8_t EXTERNAL_PRIORITY = 2;
+  constexpr uint8_t TILT_PRIORITY = 1;
+  constexpr uint16_t EXPIRY_MS = 100;
+  constexpr uint16_t BLEND_MS = 100;
+  
+  bool passed = true;
+  
+  /**
+   * @brief Record and print one check
+   * @param name Check name
+   * @param ok Whether it passed
+   */
+  void report(const char* name, bool ok) {
+    passed = passed && ok;
+    printf("%-44s %s\n", name, ok ? "ok" : "FAIL");
+  }
+  
+  /**
+   * @brief Submit the same target for both eyes
+   */
+  void submit(GazeArbiter& arbiter, uint8_t source, int16_t x, int16_t y, uint32_t timeMs) {
+    GazeTarget target = { x, y };
+    arbiter.submit(source, target, target, timeMs);
+  }
+  
+  /**
+   * @brief Resolve and compare the left eye's target
+   * @return true if resolved to exactly (x, y)
+   */
+  bool resolvesTo(GazeArbiter& arbiter, uint32_t nowMs, int16_t x, int16_t y) {
+    GazeTarget targets[2];
+    return arbiter.resolve(nowMs, targets) && targets[0].x == x && targets[0].y == y;
+  }
+  
+  /**
+   * @brief Set an arbiter up like the animation's, without blending
+   * @param arbiter Arbiter to set up
+   */
+  void setUp(GazeArbiter& arbiter) {
+    arbiter.configure(GazeArbiter::TOUCH, TOUCH_PRIORITY, EXPIRY_MS);
+    arbiter.configure(GazeArbiter::EXTERNAL, EXTERNAL_PRIORITY, EXPIRY_MS * 5);
+    arbiter.configure(GazeArbiter::TILT, TILT_PRIORITY, EXPIRY_MS);
+    arbiter.setBlendTime(0);
+  }
+  
+  /**
+   * @brief Check priorities, expiry and withdrawal without blending
+   */
+  void checkRules() {
+    GazeArbiter arbiter;
+    setUp(arbiter);
+    GazeTarget targets[2];
+    report("nothing submitted looks ahead", !arbiter.resolve(1000, targets));
+  
+    submit(arbiter, GazeArbiter::TILT, 10, 10, 1000);
+    submit(arbiter, GazeArbiter::EXTERNAL, 20, 20, 1000);
+    report("external outranks tilt", resolvesTo(arbiter, 1010, 20, 20));
+    submit(arbiter, GazeArbiter::TOUCH, 30, 30, 1020);
+    report("touch outranks external", resolvesTo(arbiter, 1020, 30, 30));
+    report("touch live until its expiry", resolvesTo(arbiter, 1020 + EXPIRY_MS - 1, 30, 30));
+    report("expired touch falls back to external", resolvesTo(arbiter, 1020 + EXPIRY_MS, 20, 20));
+    arbiter.withdraw(GazeArbiter::EXTERNAL);
+    submit(arbiter, GazeArbiter::TILT, 11, 12, 1120);
+    report("withdrawn external falls back to tilt", resolvesTo(arbiter, 1125, 11, 12));
+    report("everything expired looks ahead", !arbiter.resolve(1120 + EXPIRY_MS, targets));
+  
+    // A producer on another task may stamp just after the frame began
+    submit(arbiter, GazeArbiter::TILT, 5, 6, 2003);
+    report("submission stamped after the frame is live", resolvesTo(arbiter, 2000, 5, 6));
+  
+    // Equal priorities are averaged by weight
+    arbiter.configure(GazeArbiter::USER, EXTERNAL_PRIORITY, EXPIRY_MS, 3);
+    submit(arbiter, GazeArbiter::EXTERNAL, 0, 100, 3000);
+    submit(arbiter, GazeArbiter::USER, 100, 0, 3000);
+    report("equal priorities averaged by weight", resolvesTo(arbiter, 3000, 75, 25));
+    arbiter.disable(GazeArbiter::USER);
+    report("disabled source ignored", resolvesTo(arbiter, 3001, 0, 100));
+  }
+  
+  /**
+   * @brief Check the output slides over to a new winner and follows it afterwards
+   */
+  void checkBlend() {
+    GazeArbiter arbiter;
+    setUp(arbiter);
+    arbiter.setBlendTime(BLEND_MS);
+    submit(arbiter, GazeArbiter::EXTERNAL, 0, 0, 1000);
+    report("first winner taken without a blend", resolvesTo(arbiter, 1000, 0, 0));
+  
+    submit(arbiter, GazeArbiter::TOUCH, 200, -100, 1010);
+    bool ok = resolvesTo(arbiter, 1010, 0, 0) && arbiter.isBlending();
+    ok = ok && resolvesTo(arbiter, 1010 + BLEND_MS / 4, 50, -25);
+    submit(arbiter, GazeArbiter::TOUCH, 200, -100, 1010 + BLEND_MS / 2);
+    ok = ok && resolvesTo(arbiter, 1010 + BLEND_MS / 2, 100, -50);
+    submit(arbiter, GazeArbiter::TOUCH, 220, -100, 1010 + BLEND_MS);
+    ok = ok && resolvesTo(arbiter, 1010 + BLEND_MS, 220, -100) && !arbiter.isBlending();
+    report("new winner blended in over the blend time", ok);
+  
+    // Falling back blends from wherever the output was
+    submit(arbiter, GazeArbiter::EXTERNAL, 20, 0, 1110);
+    uint32_t expiredMs = 1010 + BLEND_MS + EXPIRY_MS;
+    ok = resolvesTo(arbiter, expiredMs, 220, -100) && resolvesTo(arbiter, expiredMs + BLEND_MS / 2, 120, -50);
+    report("fallback blended from the previous output", ok && arbiter.getSwitches() == 2);
+  }
+  
+  /**
+   * @brief Let producer threads submit as fast as they can while the consumer reads
+   * @param seconds How long to run
+   */
+  void checkConcurrency(double seconds) {
+    GazeArbiter arbiter;
+    setUp(arbiter);
+    std::atomic<bool> running(true);
+    std::atomic<uint32_t> submitted(0);
+  
+    // Every submission is self-consistent, so a torn read shows up as a mismatch
+    auto produce = [&](uint8_t source) {
+      uint32_t n = 1;
+      while (running.load(std::memory_order_relaxed)) {
+        int16_t value = static_cast<int16_t>(n & 0x3FFF);
+        GazeTarget left = { value, static_cast<int16_t>(-value) };
+        GazeTarget right = { static_cast<int16_t>(value ^ 0x1555), static_cast<int16_t>(value + source) };
+        arbiter.submit(source, left, right, n);
+        n++;
+      }
+      submitted.fetch_add(n - 1);
+    };
+    std::vector<std::thread> producers;
+    producers.emplace_back(produce, GazeArbiter::TOUCH);
+    producers.emplace_back(produce, GazeArbiter::EXTERNAL);
+  
+    uint64_t reads = 0;
+    uint64_t skipped = 0;
+    uint64_t torn = 0;
+    auto stop = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < stop) {
+      for (uint8_t source = GazeArbiter::TOUCH; source <= GazeArbiter::EXTERNAL; source++) {
+        GazeArbiter::Submission submission;
+        if (!arbiter.peek(source, submission)) {
+          skipped++;
+          continue;
+        }
+        int16_t value = submission.targets[0].x;
+        bool consistent = submission.targets[0].y == -value && submission.targets[1].x == (value ^ 0x1555) &&
+                          submission.targets[1].y == value + source &&
+                          static_cast<int16_t>(submission.timeMs & 0x3FFF) == value;
+        torn += consistent ? 0 : 1;
+        reads++;
+      }
+    }
+    running.store(false);
+    for (std::thread& producer : producers) {
+      producer.join();
+    }
+    printf("%u submissions, %llu reads, %llu skipped mid-write, %u retries\n",
+           static_cast<unsigned>(submitted.load()), static_cast<unsigned long long>(reads),
+           static_cast<unsigned long long>(skipped), static_cast<unsigned>(arbiter.getRetries()));
+    report("no read mixed two submissions", torn == 0 && reads > 0);
+  }
+  
+  /**
+   * @brief Time resolves with every predefined source live
+   * @return Nanoseconds per resolve
+   */
+  double measureResolve() {
+    constexpr uint32_t RESOLVES = 10000000;
+    GazeArbiter arbiter;
+    setUp(arbiter);
+    arbiter.setBlendTime(BLEND_MS);
+    GazeTarget targets[2] = {};
+    int32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < RESOLVES; i++) {
+      submit(arbiter, static_cast<uint8_t>(i % 3), static_cast<int16_t>(i & 255), 0, i);
+      arbiter.resolve(i, targets);
+      sink += targets[0].x;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    volatile int32_t keep = sink;
+    (void)keep;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / RESOLVES;
+  }
+}
+
+int main(int argc, char** argv) {
+  double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+  if (argc > 2 || seconds <= 0.0) {
+    fprintf(stderr, "usage: %s [stress-seconds]\n", argv[0]);
+    return 1;
+  }
+  checkRules();
+  checkBlend();
+  checkConcurrency(seconds);
+  printf("submit and resolve: %.1f ns\n", measureResolve());
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,392 @@
+/**
+ * @brief Host-side check of the gesture recogniser with synthetic touch sequences
+ *
+ * Feeds include/GestureRecognizer.h scripted sample streams at the input
+ * sampler's touch rate (taps, double taps, long presses, drags, flicks in
+ * every direction, a second finger) and compares the events with what each
+ * script should produce. Also checks how late long presses arrive, how
+ * close drag velocities come to the scripted speed under sampling jitter,
+ * that nothing is allocated, and times a sample. Exits with status 1 if
+ * any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o gesture_check tools/gesture_check.cpp src/GestureRecognizer.cpp
+ * Usage:  gesture_check [-v]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "GestureRecognizer.h"
+
+namespace {
+  constexpr uint32_t SAMPLE_MS = 10;  // InputSampler touch interval
+  
+  // Allocations made while the recogniser runs
+  bool countAllocations = false;
+  uint32_t allocations = 0;
+  
+  bool passed = true;
+  bool verbose = false;
+  
+  const char* const TYPE_NAMES[] = { "tap", "double_tap", "long_press", "drag_begin", "drag", "drag_end", "flick" };
+  const char* const DIRECTION_NAMES[] = { "", "-left", "-right", "-up", "-down" };
+  
+  /**
+   * @brief Class driving a recogniser with scripted samples and recording its events
+   */
+  class Script {
+  public:
+    Script() : timeMs(1000), x(160), y(120) {}
+  
+    /**
+     * @brief Touch, optionally moving at constant speed, for a while
+     * @param durationMs How long to stay down
+     * @param toX X to arrive at
+     * @param toY Y to arrive at
+     * @param jitterMs Random sampling jitter (0: exact SAMPLE_MS)
+     */
+    void touch(uint32_t durationMs, int16_t toX, int16_t toY, uint32_t jitterMs = 0) {
+      int16_t fromX = x;
+      int16_t fromY = y;
+      uint32_t startMs = timeMs;
+      while (timeMs - startMs < durationMs) {
+        double progress = static_cast<double>(timeMs - startMs) / durationMs;
+        x = static_cast<int16_t>(lround(fromX + (toX - fromX) * progress));
+        y = static_cast<int16_t>(lround(fromY + (toY - fromY) * progress));
+        sample(true, 1);
+        timeMs += SAMPLE_MS + (jitterMs > 0 ? rand() % (2 * jitterMs + 1) - jitterMs : 0);
+      }
+      x = toX;
+      y = toY;
+      sample(true, 1);
+      timeMs += SAMPLE_MS;
+    }
+  
+    /**
+     * @brief Touch without moving
+     * @param durationMs How long to stay down
+     */
+    void hold(uint32_t durationMs) {
+      touch(durationMs, x, y);
+    }
+  
+    /**
+     * @brief Put a second finger down
+     */
+    void secondFinger() {
+      sample(true, 2);
+      timeMs += SAMPLE_MS;
+    }
+  
+    /**
+     * @brief Lift every finger and wait
+     * @param gapMs Time until the next touch
+     */
+    void release(uint32_t gapMs) {
+      sample(false, 0);
+      timeMs += gapMs;
+    }
+  
+    /**
+     * @brief Move without touching
+     */
+    void moveTo(int16_t toX, int16_t toY) {
+      x = toX;
+      y = toY;
+    }
+  
+    /**
+     * @brief Let time pass without samples
+     * @param durationMs Time to pass
+     */
+    void wait(uint32_t durationMs) {
+      timeMs += durationMs;
+      countAllocations = true;
+      recognizer.advance(timeMs);
+      countAllocations = false;
+      collect();
+    }
+  
+    /**
+     * @brief Get the recorded events as text (consecutive drags collapsed)
+     * @return Event names separated by spaces
+     */
+    std::string text() const {
+      std::string result;
+      for (size_t i = 0; i < events.size(); i++) {
+        if (i > 0 && events[i].type == GestureType::DRAG && events[i - 1].type == GestureType::DRAG) {
+          continue;
+        }
+        result += result.empty() ? "" : " ";
+        result += TYPE_NAMES[static_cast<uint8_t>(events[i].type)];
+        if (events[i].type == GestureType::FLICK) {
+          result += DIRECTION_NAMES[static_cast<uint8_t>(events[i].direction)];
+        }
+      }
+      return result;
+    }
+  
+    uint32_t timeMs;                    // Time of the next sample
+    int16_t x;                          // Current position
+    int16_t y;
+    GestureRecognizer recognizer;       // Recogniser under test
+    std::vector<GestureEvent> events;   // Events taken so far
+  
+  private:
+    /**
+     * @brief Feed one sample and take the resulting events, as the frame loop would
+     */
+    void sample(bool touching, uint8_t count) {
+      countAllocations = true;
+      recognizer.addSample(timeMs, touching, count, x, y);
+      recognizer.advance(timeMs);
+      countAllocations = false;
+      collect();
+    }
+  
+    /**
+     * @brief Take queued events
+     */
+    void collect() {
+      GestureEvent event;
+      countAllocations = true;
+      while (recognizer.takeEvent(event)) {
+        countAllocations = false;
+        events.push_back(event);
+        countAllocations = true;
+      }
+      countAllocations = false;
+    }
+  };
+  
+  /**
+   * @brief Compare a script's events with the expected ones
+   * @param name Check name
+   * @param script Script that ran
+   * @param expected Expected events
+   */
+  void expect(const char* name, const Script& script, const char* expected) {
+    std::string actual = script.text();
+    bool ok = actual == expected;
+    passed = passed && ok;
+    printf("%-36s %s", name, ok ? "ok" : "FAIL");
+    if (!ok || verbose) {
+      printf("  (got \"%s\", expected \"%s\")", actual.c_str(), expected);
+    }
+    printf("\n");
+  }
+  
+  /**
+   * @brief Record and print one check with a detail
+   */
+  void report(const char* name, bool ok, const char* detail) {
+    passed = passed && ok;
+    printf("%-36s %s  (%s)\n", name, ok ? "ok" : "FAIL", detail);
+  }
+  
+  void checkTaps() {
+    Script tap;
+    tap.hold(100);
+    tap.release(500);
+    expect("tap", tap, "tap");
+  
+    Script wobbly;
+    wobbly.touch(150, 166, 114);
+    wobbly.release(500);
+    expect("tap moving within the slop", wobbly, "tap");
+  
+    Script twice;
+    twice.hold(80);
+    twice.release(150);
+    twice.hold(80);
+    twice.release(500);
+    expect("double tap", twice, "tap double_tap");
+  
+    Script thrice;
+    for (uint8_t i = 0; i < 3; i++) {
+      thrice.hold(80);
+      thrice.release(150);
+    }
+    expect("triple tap", thrice, "tap double_tap tap");
+  
+    Script slow;
+    slow.hold(80);
+    slow.release(GestureRecognizer::DOUBLE_TAP_MS + 50);
+    slow.hold(80);
+    slow.release(500);
+    expect("taps too far apart in time", slow, "tap tap");
+  
+    Script apart;
+    apart.hold(80);
+    apart.release(150);
+    apart.moveTo(220, 120);
+    apart.hold(80);
+    apart.release(500);
+    expect("taps too far apart on screen", apart, "tap tap");
+  
+    Script press;
+    press.hold(400);
+    press.release(500);
+    expect("press between tap and long press", press, "");
+  }
+  
+  void checkLongPress() {
+    Script held;
+    held.hold(1500);
+    held.release(500);
+    expect("long press", held, "long_press");
+    uint32_t lateMs = held.events.empty() ? UINT32_MAX : held.events[0].timeMs - 1000 - GestureRecognizer::LONG_PRESS_MS;
+    char detail[48];
+    snprintf(detail, sizeof(detail), "%u ms after LONG_PRESS_MS", static_cast<unsigned>(lateMs));
+    report("long press latency", lateMs < SAMPLE_MS, detail);
+  
+    // The sampler may stall; advance() still completes it on time
+    Script stalled;
+    stalled.hold(0);
+    stalled.wait(GestureRecognizer::LONG_PRESS_MS + 20);
+    expect("long press without samples", stalled, "long_press");
+  
+    Script dragged;
+    dragged.hold(800);
+    dragged.touch(300, 260, 120);
+    dragged.release(500);
+    expect("long press, then moving", dragged, "long_press");
+  }
+  
+  void checkDrags() {
+    Script slow;
+    slow.touch(1000, 260, 120);
+    slow.hold(100);
+    slow.release(500);
+    expect("slow drag", slow, "drag_begin drag drag_end");
+  
+    struct Flick {
+      const char* name;
+      int16_t x;
+      int16_t y;
+      const char* expected;
+    };
+    const Flick flicks[] = {
+      { "flick right", 260, 130, "drag_begin drag drag_end flick-right" },
+      { "flick left", 60, 110, "drag_begin drag drag_end flick-left" },
+      { "flick up", 150, 20, "drag_begin drag drag_end flick-up" },
+      { "flick down", 170, 220, "drag_begin drag drag_end flick-down" }
+    };
+    for (const Flick& flick : flicks) {
+      Script script;
+      script.touch(120, flick.x, flick.y);
+      script.release(500);
+      expect(flick.name, script, flick.expected);
+    }
+  
+    Script stopped;
+    stopped.touch(120, 260, 120);
+    stopped.hold(GestureRecognizer::VELOCITY_WINDOW_MS + 20);
+    stopped.release(500);
+    expect("fast drag stopped before release", stopped, "drag_begin drag drag_end");
+  
+    Script pinch;
+    pinch.hold(50);
+    pinch.secondFinger();
+    pinch.touch(200, 260, 120);
+    pinch.release(500);
+    expect("second finger cancels", pinch, "");
+  
+    Script dragPinch;
+    dragPinch.touch(200, 260, 120);
+    dragPinch.secondFinger();
+    dragPinch.release(500);
+    expect("second finger ends a drag", dragPinch, "drag_begin drag drag_end");
+  }
+  
+  /**
+   * @brief Compare drag velocities with the scripted speed under sampling jitter
+   */
+  void checkVelocity() {
+    srand(1);
+    double worst = 0.0;
+    const double speeds[] = { 200.0, 800.0, 2000.0 };
+    for (double speed : speeds) {
+      Script script;
+      uint32_t startMs = script.timeMs;
+      uint32_t durationMs = static_cast<uint32_t>(150000.0 / speed);
+      script.touch(durationMs, static_cast<int16_t>(script.x + 150), script.y, 3);
+  
+      // Once the window is full, and before the last sample snaps to the end point
+      for (const GestureEvent& event : script.events) {
+        if (event.type == GestureType::DRAG && event.timeMs - script.events[0].timeMs >= 2 * SAMPLE_MS &&
+            event.timeMs - startMs <= durationMs) {
+          worst = fmax(worst, fabs(event.velocityX - speed) / speed);
+        }
+      }
+    }
+    char detail[48];
+    snprintf(detail, sizeof(detail), "worst %.1f%% off", worst * 100.0);
+    report("drag velocity with +-3 ms jitter", worst < 0.1, detail);
+  }
+  
+  /**
+   * @brief Time samples of a long drag
+   * @return Nanoseconds per sample
+   */
+  double measureSample() {
+    constexpr uint32_t SAMPLES = 10000000;
+    GestureRecognizer recognizer;
+    GestureEvent event;
+    uint32_t taken = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+      bool touching = (i & 1023) != 1023;
+      recognizer.addSample(i * SAMPLE_MS, touching, 1, static_cast<int16_t>(i & 511), 100);
+      while (recognizer.takeEvent(event)) {
+        taken++;
+      }
+    }
+    auto stop = std::chrono::steady_clock::now();
+    volatile uint32_t sink = taken;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / SAMPLES;
+  }
+}
+
+void* operator new(size_t size) {
+  if (countAllocations) {
+    allocations++;
+  }
+  void* memory = malloc(size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+  free(memory);
+}
+
+int main(int argc, char** argv) {
+  if (argc > 2 || (argc == 2 && strcmp(argv[1], "-v") != 0)) {
+    fprintf(stderr, "usage: %s [-v]\n", argv[0]);
+    return 1;
+  }
+  verbose = argc == 2;
+  checkTaps();
+  checkLongPress();
+  checkDrags();
+  checkVelocity();
+  
+  char detail[32];
+  snprintf(detail, sizeof(detail), "%u allocations", static_cast<unsigned>(allocations));
+  report("allocation-free", allocations == 0, detail);
+  printf("sample: %.1f ns\n", measureSample());
+  return passed ? 0 : 1;
+}
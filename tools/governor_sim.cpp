@@ -0,0 +1,144 @@
+/**
+ * @brief Host-side replay of recorded frame traces against CPU frequency policies
+ *
+ * Runs the policies from include/GovernorPolicy.h over a trace captured with
+ * "eyes_tune <device> trace <frames> <trace-file>" and prints, per policy,
+ * the average clock, the number of switches and the frames that would have
+ * missed their budget, so policies can be compared before flashing them.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o governor_sim tools/governor_sim.cpp src/GovernorPolicy.cpp
+ * Usage:  governor_sim [--fixed-percent <n>] <trace-file>
+ *
+ * Work time is rescaled from the clock it was recorded at to the clock the
+ * policy picked. By default all of it scales (CPU-bound, the pessimistic
+ * case); --fixed-percent keeps that share constant, e.g. for time spent
+ * waiting on the display bus.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "GovernorPolicy.h"
+
+namespace {
+  /**
+   * @brief Structure holding one traced frame
+   */
+  struct TraceFrame {
+    uint8_t load;         // AnimationLoad
+    uint32_t workMicros;  // Work time at recordedMhz
+    uint16_t recordedMhz; // Clock the frame ran at
+    uint32_t budgetMicros; // Frame budget
+  };
+  
+  /**
+   * @brief Structure holding the outcome of one replay
+   */
+  struct Result {
+    double averageMhz;
+    uint32_t switches;
+    uint32_t missed;
+    double averageUtilisation;
+  };
+  
+  /**
+   * @brief Read a trace file
+   * @param path Trace path
+   * @param frames Destination
+   * @return false if the file cannot be read
+   */
+  bool readTrace(const char* path, std::vector<TraceFrame>& frames) {
+    FILE* input = fopen(path, "r");
+    if (input == nullptr) {
+      perror(path);
+      return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), input) != nullptr) {
+      unsigned state, load, work, mhz, budget;
+      if (line[0] == '#' || sscanf(line, "%u %u %u %u %u", &state, &load, &work, &mhz, &budget) != 5) {
+        continue;
+      }
+      if (load > static_cast<unsigned>(AnimationLoad::HEAVY) || mhz == 0) {
+        continue;
+      }
+      frames.push_back({ static_cast<uint8_t>(load), work, static_cast<uint16_t>(mhz), budget * 1000 });
+    }
+    fclose(input);
+    return true;
+  }
+  
+  /**
+   * @brief Replay a trace against a policy
+   * @param frames Trace
+   * @param policy Policy
+   * @param context Policy instance
+   * @param fixedPercent Share of the work time that does not scale with the clock
+   * @return Outcome
+   */
+  Result replay(const std::vector<TraceFrame>& frames, FrequencyPolicy policy, void* context,
+                unsigned fixedPercent) {
+    Result result = {};
+    uint16_t mhz = LoadFrequencyPolicy::STEPS_MHZ[LoadFrequencyPolicy::NUM_OF_STEPS - 1];
+    double totalMhz = 0.0;
+    double totalUtilisation = 0.0;
+    for (const TraceFrame& frame : frames) {
+      double fixed = frame.workMicros * fixedPercent / 100.0;
+      double scaled = fixed + (frame.workMicros - fixed) * frame.recordedMhz / mhz;
+      uint32_t workMicros = static_cast<uint32_t>(scaled + 0.5);
+      if (workMicros > frame.budgetMicros) {
+        result.missed++;
+      }
+      totalMhz += mhz;
+      totalUtilisation += scaled / frame.budgetMicros;
+  
+      uint16_t next = policy(context, { static_cast<AnimationLoad>(frame.load), workMicros,
+                                        frame.budgetMicros, mhz });
+      if (next != mhz) {
+        result.switches++;
+        mhz = next;
+      }
+    }
+    if (!frames.empty()) {
+      result.averageMhz = totalMhz / frames.size();
+      result.averageUtilisation = totalUtilisation / frames.size();
+    }
+    return result;
+  }
+}
+
+int main(int argc, char** argv) {
+  unsigned fixedPercent = 0;
+  int argument = 1;
+  if (argc == 4 && strcmp(argv[1], "--fixed-percent") == 0) {
+    fixedPercent = static_cast<unsigned>(strtoul(argv[2], nullptr, 0));
+    argument = 3;
+  }
+  if (argument != argc - 1 || fixedPercent > 100) {
+    fprintf(stderr, "usage: %s [--fixed-percent <n>] <trace-file>\n", argv[0]);
+    return 1;
+  }
+  
+  std::vector<TraceFrame> frames;
+  if (!readTrace(argv[argument], frames)) {
+    return 1;
+  }
+  printf("%zu frames, %u%% of work time fixed\n", frames.size(), fixedPercent);
+  printf("%-10s %8s %9s %7s %12s\n", "policy", "avg MHz", "switches", "missed", "utilisation");
+  
+  for (uint16_t mhz : LoadFrequencyPolicy::STEPS_MHZ) {
+    FixedFrequencyPolicy fixed(mhz);
+    Result result = replay(frames, FixedFrequencyPolicy::decide, &fixed, fixedPercent);
+    char name[16];
+    snprintf(name, sizeof(name), "fixed-%u", mhz);
+    printf("%-10s %8.1f %9u %7u %11.1f%%\n", name, result.averageMhz, result.switches, result.missed,
+           result.averageUtilisation * 100.0);
+  }
+  
+  LoadFrequencyPolicy load;
+  Result result = replay(frames, LoadFrequencyPolicy::decide, &load, fixedPercent);
+  printf("%-10s %8.1f %9u %7u %11.1f%%\n", "load", result.averageMhz, result.switches, result.missed,
+         result.averageUtilisation * 100.0);
+  return 0;
+}
@@ -0,0 +1,436 @@
+/**
+ * @brief Host-side check of the loudness detector, on synthetic sound or WAV files
+ *
+ * Without files, synthesizes room noise with claps, slow swells, sustained
+ * noise, a microphone DC offset and loud backgrounds, feeds them through
+ * include/LoudnessDetector.h in the microphone task's block size and
+ * compares the onsets with where the claps are. The sound also makes a
+ * round trip through a WAV file to check the reader, and a block is timed.
+ * Exits with status 1 if any check fails.
+ *
+ * With files, feeds each one (16-bit PCM; the first channel if there are
+ * several) through the same block interface and prints the onsets with the
+ * level and noise floor at each. Blocks last as long as on the device
+ * whatever the file's sample rate.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o loudness_check tools/loudness_check.cpp src/LoudnessDetector.cpp
+ * Usage:  loudness_check [-t <threshold-db>] [file.wav ...]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "LoudnessDetector.h"
+
+namespace {
+  // Must match AudioInput
+  constexpr uint32_t SAMPLE_RATE = 16000;
+  constexpr uint16_t BLOCK_SAMPLES = 256;
+  
+  constexpr double PI = 3.14159265358979323846;
+  
+  bool passed = true;
+  uint8_t thresholdDb = LoudnessDetector::THRESHOLD_DB;
+  
+  /**
+   * @brief Structure holding mono sound
+   */
+  struct Sound {
+    uint32_t sampleRate;            // Sample rate in Hz
+    std::vector<int16_t> samples;   // Samples
+  };
+  
+  /**
+   * @brief Class building synthetic sound as floating point, clipped on output
+   */
+  class Synth {
+  public:
+    /**
+     * @brief Constructor
+     * @param seconds Length
+     */
+    explicit Synth(double seconds) : signal(static_cast<size_t>(seconds * SAMPLE_RATE), 0.0), random(1) {}
+  
+    /**
+     * @brief Add a constant offset, like a PDM microphone's
+     */
+    void offset(double value) {
+      for (double& sample : signal) {
+        sample += value;
+      }
+    }
+  
+    /**
+     * @brief Add white noise whose RMS ramps from one level to another
+     * @param fromS Start time
+     * @param toS End time
+     * @param fromRms RMS at the start
+     * @param toRms RMS at the end
+     */
+    void noise(double fromS, double toS, double fromRms, double toRms) {
+      std::normal_distribution<double> gauss(0.0, 1.0);
+      size_t from = index(fromS);
+      size_t to = index(toS);
+      for (size_t i = from; i < to; i++) {
+        double progress = static_cast<double>(i - from) / (to - from);
+        signal[i] += gauss(random) * (fromRms + (toRms - fromRms) * progress);
+      }
+    }
+  
+    /**
+     * @brief Add a hum
+     */
+    void tone(double fromS, double toS, double frequency, double rms) {
+      for (size_t i = index(fromS); i < index(toS); i++) {
+        signal[i] += rms * sqrt(2.0) * sin(2.0 * PI * frequency * i / SAMPLE_RATE);
+      }
+    }
+  
+    /**
+     * @brief Add a clap: a burst of noise decaying over about 30 ms
+     * @param atS Start time
+     * @param peak Peak amplitude
+     */
+    void clap(double atS, double peak) {
+      std::normal_distribution<double> gauss(0.0, 1.0);
+      size_t from = index(atS);
+      for (size_t i = from; i < index(atS + 0.12); i++) {
+        double t = static_cast<double>(i - from) / SAMPLE_RATE;
+        signal[i] += gauss(random) * peak * 0.5 * exp(-t / 0.03);
+      }
+    }
+  
+    /**
+     * @brief Get the sound clipped to 16 bits
+     */
+    Sound sound() const {
+      Sound result = { SAMPLE_RATE, {} };
+      result.samples.reserve(signal.size());
+      for (double sample : signal) {
+        result.samples.push_back(static_cast<int16_t>(fmax(-32768.0, fmin(32767.0, round(sample)))));
+      }
+      return result;
+    }
+  
+  private:
+    std::vector<double> signal;
+    std::mt19937 random;
+  
+    size_t index(double seconds) const {
+      return std::min(signal.size(), static_cast<size_t>(seconds * SAMPLE_RATE));
+    }
+  };
+  
+  /**
+   * @brief Structure holding one detected onset
+   */
+  struct Onset {
+    double timeS;    // End of the block that started it
+    uint16_t level;  // Block RMS
+    uint16_t floor;  // Floor RMS after the block
+  };
+  
+  /**
+   * @brief Feed a sound through a detector in device-length blocks
+   * @param sound Sound to feed
+   * @return Onsets
+   */
+  std::vector<Onset> detect(const Sound& sound) {
+    LoudnessDetector detector(sound.sampleRate);
+    detector.setThresholdDb(thresholdDb);
+    size_t blockSamples = std::max<size_t>(1, static_cast<size_t>(BLOCK_SAMPLES) * sound.sampleRate / SAMPLE_RATE);
+    std::vector<Onset> onsets;
+    for (size_t start = 0; start + blockSamples <= sound.samples.size(); start += blockSamples) {
+      if (detector.process(&sound.samples[start], blockSamples)) {
+        onsets.push_back({ static_cast<double>(start + blockSamples) / sound.sampleRate, detector.getLevel(),
+                           detector.getFloor() });
+      }
+    }
+    return onsets;
+  }
+  
+  /**
+   * @brief Compare onsets with clap times
+   * @param name Check name
+   * @param sound Sound to feed
+   * @param claps Expected clap times (each must be detected within two blocks)
+   */
+  void expect(const char* name, const Sound& sound, const std::vector<double>& claps) {
+    std::vector<Onset> onsets = detect(sound);
+    double blockS = static_cast<double>(BLOCK_SAMPLES) / SAMPLE_RATE;
+    bool ok = onsets.size() == claps.size();
+    double worstMs = 0.0;
+    for (size_t i = 0; ok && i < claps.size(); i++) {
+      double lateS = onsets[i].timeS - claps[i];
+      ok = lateS > 0.0 && lateS <= 2.0 * blockS;
+      worstMs = fmax(worstMs, lateS * 1000.0);
+    }
+    passed = passed && ok;
+    printf("%-44s %s  (%zu of %zu onsets", name, ok ? "ok" : "FAIL", onsets.size(), claps.size());
+    if (!claps.empty() && ok) {
+      printf(", at most %.0f ms late", worstMs);
+    }
+    printf(")\n");
+    if (!ok) {
+      for (const Onset& onset : onsets) {
+        printf("    onset at %.3f s, level %u, floor %u\n", onset.timeS, onset.level, onset.floor);
+      }
+    }
+  }
+  
+  /**
+   * @brief Record and print one check
+   */
+  void report(const char* name, bool ok) {
+    passed = passed && ok;
+    printf("%-44s %s\n", name, ok ? "ok" : "FAIL");
+  }
+  
+  /**
+   * @brief Read a little-endian value
+   */
+  uint32_t readLe(const uint8_t* bytes, uint8_t size) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < size; i++) {
+      value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+  }
+  
+  /**
+   * @brief Read a 16-bit PCM WAV file
+   * @param path File path
+   * @param sound Receives the first channel
+   * @return false (with a message) if unreadable or not 16-bit PCM
+   */
+  bool readWav(const char* path, Sound& sound) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+      perror(path);
+      return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[4096];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      bytes.insert(bytes.end(), buffer, buffer + got);
+    }
+    fclose(file);
+  
+    if (bytes.size() < 12 || memcmp(&bytes[0], "RIFF", 4) != 0 || memcmp(&bytes[8], "WAVE", 4) != 0) {
+      fprintf(stderr, "%s: not a WAV file\n", path);
+      return false;
+    }
+    uint16_t channels = 0;
+    uint16_t bits = 0;
+    size_t offset = 12;
+    while (offset + 8 <= bytes.size()) {
+      uint32_t size = readLe(&bytes[offset + 4], 4);
+      const uint8_t* body = &bytes[offset + 8];
+      size_t available = std::min<size_t>(size, bytes.size() - offset - 8);
+      if (memcmp(&bytes[offset], "fmt ", 4) == 0 && available >= 16) {
+        uint16_t format = static_cast<uint16_t>(readLe(body, 2));
+        channels = static_cast<uint16_t>(readLe(body + 2, 2));
+        sound.sampleRate = readLe(body + 4, 4);
+        bits = static_cast<uint16_t>(readLe(body + 14, 2));
+        // WAVE_FORMAT_EXTENSIBLE carries the real format in its subformat
+        if (format == 0xFFFE && available >= 26) {
+          format = static_cast<uint16_t>(readLe(body + 24, 2));
+        }
+        if (format != 1 || bits != 16 || channels == 0 || sound.sampleRate == 0) {
+          fprintf(stderr, "%s: only 16-bit PCM is supported\n", path);
+          return false;
+        }
+      } else if (memcmp(&bytes[offset], "data", 4) == 0 && channels > 0) {
+        sound.samples.clear();
+        for (size_t i = 0; i + 2 * channels <= available; i += 2 * channels) {
+          sound.samples.push_back(static_cast<int16_t>(readLe(body + i, 2)));
+        }
+        return true;
+      }
+      offset += 8 + size + (size & 1);
+    }
+    fprintf(stderr, "%s: no format or data chunk\n", path);
+    return false;
+  }
+  
+  /**
+   * @brief Write a mono 16-bit PCM WAV file
+   * @return false if the file could not be written
+   */
+  bool writeWav(const char* path, const Sound& sound) {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+      return false;
+    }
+    auto le = [file](uint32_t value, uint8_t size) {
+      for (uint8_t i = 0; i < size; i++) {
+        fputc((value >> (8 * i)) & 0xFF, file);
+      }
+    };
+    uint32_t dataBytes = static_cast<uint32_t>(sound.samples.size() * 2);
+    fwrite("RIFF", 1, 4, file);
+    le(36 + dataBytes, 4);
+    fwrite("WAVEfmt ", 1, 8, file);
+    le(16, 4);
+    le(1, 2);
+    le(1, 2);
+    le(sound.sampleRate, 4);
+    le(sound.sampleRate * 2, 4);
+    le(2, 2);
+    le(16, 2);
+    fwrite("data", 1, 4, file);
+    le(dataBytes, 4);
+    for (int16_t sample : sound.samples) {
+      le(static_cast<uint16_t>(sample), 2);
+    }
+    return fclose(file) == 0;
+  }
+  
+  void checkClaps() {
+    Synth quiet(6.0);
+    quiet.noise(0.0, 6.0, 60.0, 60.0);
+    expect("quiet room, no claps", quiet.sound(), {});
+    for (double atS : { 1.0, 2.5, 4.013 }) {
+      quiet.clap(atS, 20000.0);
+    }
+    expect("claps in a quiet room", quiet.sound(), { 1.0, 2.5, 4.013 });
+  
+    Synth close(3.0);
+    close.noise(0.0, 3.0, 60.0, 60.0);
+    close.clap(1.0, 20000.0);
+    close.clap(1.0 + LoudnessDetector::REFRACTORY_MS / 2000.0, 20000.0);
+    close.clap(2.0, 20000.0);
+    expect("clap within the refractory time ignored", close.sound(), { 1.0, 2.0 });
+  
+    Synth faint(3.0);
+    faint.noise(0.0, 3.0, 20.0, 20.0);
+    faint.clap(1.5, 800.0);
+    expect("faint tap below MIN_RMS ignored", faint.sound(), {});
+  
+    Synth early(2.0);
+    early.noise(0.0, 2.0, 60.0, 60.0);
+    early.clap(0.05, 20000.0);
+    early.clap(1.0, 20000.0);
+    expect("clap during warm-up ignored", early.sound(), { 1.0 });
+  }
+  
+  void checkBackgrounds() {
+    Synth swell(8.0);
+    swell.noise(0.0, 1.0, 60.0, 60.0);
+    swell.noise(1.0, 6.0, 60.0, 6000.0);
+    swell.noise(6.0, 8.0, 6000.0, 6000.0);
+    expect("slow swell to loud noise", swell.sound(), {});
+  
+    Synth sustained(6.0);
+    sustained.noise(0.0, 6.0, 60.0, 60.0);
+    sustained.noise(1.0, 6.0, 4000.0, 4000.0);
+    expect("sustained noise starts once", sustained.sound(), { 1.0 });
+  
+    Synth offset(4.0);
+    offset.offset(-3000.0);
+    offset.tone(0.0, 4.0, 50.0, 100.0);
+    offset.noise(0.0, 4.0, 60.0, 60.0);
+    offset.clap(2.0, 20000.0);
+    expect("clap over DC offset and hum", offset.sound(), { 2.0 });
+  
+    Synth loud(5.0);
+    loud.noise(0.0, 5.0, 2000.0, 2000.0);
+    loud.clap(2.0, 40000.0);
+    loud.clap(3.5, 6000.0);
+    expect("loud background, only the loud clap", loud.sound(), { 2.0 });
+  }
+  
+  /**
+   * @brief Check the WAV reader returns what was written
+   */
+  void checkWavRoundTrip() {
+    Synth synth(3.0);
+    synth.noise(0.0, 3.0, 60.0, 60.0);
+    synth.clap(1.5, 20000.0);
+    Sound written = synth.sound();
+    std::string path = "/tmp/loudness_check_" + std::to_string(getpid()) + ".wav";
+    Sound read = { 0, {} };
+    bool ok = writeWav(path.c_str(), written) && readWav(path.c_str(), read);
+    remove(path.c_str());
+    report("WAV round trip", ok && read.sampleRate == written.sampleRate && read.samples == written.samples);
+    if (ok) {
+      expect("clap read from a WAV file", read, { 1.5 });
+    }
+  }
+  
+  /**
+   * @brief Time blocks of noise
+   * @return Nanoseconds per block
+   */
+  double measureBlock() {
+    constexpr uint32_t BLOCKS = 200000;
+    Synth synth(4.0);
+    synth.noise(0.0, 4.0, 1000.0, 1000.0);
+    Sound sound = synth.sound();
+    size_t blocksInSound = sound.samples.size() / BLOCK_SAMPLES;
+    LoudnessDetector detector(SAMPLE_RATE);
+    uint32_t onsets = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+      onsets += detector.process(&sound.samples[(i % blocksInSound) * BLOCK_SAMPLES], BLOCK_SAMPLES) ? 1 : 0;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    volatile uint32_t sink = onsets;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / BLOCKS;
+  }
+  
+  /**
+   * @brief Print the onsets of a WAV file
+   * @return false if the file could not be read
+   */
+  bool printFile(const char* path) {
+    Sound sound = { 0, {} };
+    if (!readWav(path, sound)) {
+      return false;
+    }
+    std::vector<Onset> onsets = detect(sound);
+    printf("%s: %u Hz, %.2f s, %zu onsets at %u dB\n", path, static_cast<unsigned>(sound.sampleRate),
+           static_cast<double>(sound.samples.size()) / sound.sampleRate, onsets.size(), thresholdDb);
+    for (const Onset& onset : onsets) {
+      printf("  %8.3f s  level %5u (%6.1f dBFS), floor %5u (%6.1f dBFS)\n", onset.timeS, onset.level,
+             20.0 * log10(onset.level / 32767.0), onset.floor, 20.0 * log10(fmax(onset.floor, 1) / 32767.0));
+    }
+    return true;
+  }
+}
+
+int main(int argc, char** argv) {
+  int first = 1;
+  if (argc > 2 && strcmp(argv[1], "-t") == 0) {
+    thresholdDb = static_cast<uint8_t>(atoi(argv[2]));
+    first = 3;
+  }
+  if (first < argc && argv[first][0] == '-') {
+    fprintf(stderr, "usage: %s [-t <threshold-db>] [file.wav ...]\n", argv[0]);
+    return 1;
+  }
+  
+  if (first < argc) {
+    bool ok = true;
+    for (int i = first; i < argc; i++) {
+      ok = printFile(argv[i]) && ok;
+    }
+    return ok ? 0 : 1;
+  }
+  
+  checkClaps();
+  checkBackgrounds();
+  checkWavRoundTrip();
+  double blockNanos = measureBlock();
+  printf("block of %u samples: %.0f ns (%.2f ns per sample)\n", BLOCK_SAMPLES, blockNanos, blockNanos / BLOCK_SAMPLES);
+  return passed ? 0 : 1;
+}
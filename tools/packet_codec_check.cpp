@@ -0,0 +1,319 @@
+/**
+ * @brief Host-side check of the tuning protocol's request parser and reply framing
+ *
+ * Feeds byte streams through src/PacketCodec.cpp, the part of SerialProtocol
+ * that parses requests and frames replies, with a real ParameterRegistry
+ * behind it. Checks that the parser resyncs on the next request after
+ * random garbage, drops packets with a bad checksum or an oversize length
+ * and counts them, that every request gets a reply with the right sync,
+ * command, length and checksum (PING and the parameter requests with their
+ * fields, the others with a bare status), and that PARAM_SET rejects values
+ * outside the limits, NaN and infinities without touching the parameter.
+ * Exits with status 1 if any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o packet_codec_check tools/packet_codec_check.cpp src/PacketCodec.cpp src/ParameterRegistry.cpp
+ * Usage:  packet_codec_check
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "FastRandom.h"
+#include "PacketCodec.h"
+#include "ParameterRegistry.h"
+
+namespace {
+  constexpr uint32_t GARBAGE_TRIALS = 10000;
+  constexpr uint32_t MAX_RESYNC_REPEATS = 4;  // A false sync swallows at most 11 bytes
+  
+  bool passed = true;
+  
+  /**
+   * @brief Parameters registered the way EyesAnimation registers its own
+   */
+  struct Parameters {
+    uint8_t small = 5;
+    uint16_t medium = 1000;
+    uint32_t large = 70000;
+    float ratio = 1.0F;
+    ParameterRegistry registry;
+  
+    Parameters() {
+      registry.add("small", &small, 1, 10);
+      registry.add("medium", &medium, 100, 5000);
+      registry.add("large", &large, 0, 100000);
+      registry.add("ratio", &ratio, 0.5F, 2.0F);
+    }
+  };
+  
+  /**
+   * @brief Record and print one check with a detail
+   */
+  void report(const char* name, bool ok, const char* detail) {
+    passed = passed && ok;
+    printf("%-40s %s  (%s)\n", name, ok ? "ok" : "FAIL", detail);
+  }
+  
+  /**
+   * @brief Build a request packet the way tools/eyes_tune does
+   */
+  std::vector<uint8_t> request(uint8_t command, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> packet = { PacketCodec::SYNC_REQUEST, command, static_cast<uint8_t>(payload.size()) };
+    for (uint8_t value : payload) {
+      packet.push_back(value);
+    }
+    uint8_t sum = 0;
+    for (uint8_t value : packet) {
+      sum += value;
+    }
+    packet.push_back(sum);
+    return packet;
+  }
+  
+  /**
+   * @brief Build a PARAM_SET packet
+   */
+  std::vector<uint8_t> setRequest(uint8_t id, uint32_t value) {
+    std::vector<uint8_t> payload(5);
+    payload[0] = id;
+    PacketCodec::writeU32(&payload[1], value);
+    return request(PacketCodec::PARAM_SET, payload);
+  }
+  
+  /**
+   * @brief Feed bytes to the parser
+   * @return Number of complete requests
+   */
+  uint32_t feed(PacketCodec& codec, const std::vector<uint8_t>& bytes) {
+    uint32_t requests = 0;
+    for (uint8_t value : bytes) {
+      requests += codec.parse(value) ? 1 : 0;
+    }
+    return requests;
+  }
+  
+  /**
+   * @brief Check the framed reply's header and checksum
+   * @param command Request command
+   * @param payloadLength Expected payload length
+   */
+  bool isFramed(const PacketCodec& codec, uint8_t command, uint8_t payloadLength) {
+    const uint8_t* packet = codec.getPacket();
+    uint8_t length = codec.getPacketLength();
+    if (length != payloadLength + PacketCodec::OVERHEAD || packet[0] != PacketCodec::SYNC_REPLY ||
+        packet[1] != (command | PacketCodec::REPLY_FLAG) || packet[2] != payloadLength) {
+      return false;
+    }
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < length - 1; i++) {
+      sum += packet[i];
+    }
+    return packet[length - 1] == sum;
+  }
+  
+  /**
+   * @brief Get the status byte of the framed reply
+   */
+  uint8_t replyStatus(const PacketCodec& codec) {
+    return codec.getPacket()[PacketCodec::PAYLOAD_OFFSET];
+  }
+  
+  /**
+   * @brief Send one request and let the codec answer it
+   * @return false if the request did not complete or was not a parameter request
+   */
+  bool exchange(PacketCodec& codec, Parameters& parameters, const std::vector<uint8_t>& packet) {
+    return feed(codec, packet) == 1 && codec.answerParameterRequest(parameters.registry);
+  }
+  
+  /**
+   * @brief Check the parser finds the next request after random bytes
+   */
+  void checkResync() {
+    FastRandom rng(3);
+    std::vector<uint8_t> get = request(PacketCodec::PARAM_GET, { 2 });
+    uint32_t worst = 0;
+    uint32_t spurious = 0;
+    bool ok = true;
+    for (uint32_t trial = 0; trial < GARBAGE_TRIALS; trial++) {
+      PacketCodec codec;
+      std::vector<uint8_t> garbage(rng.range(1, 64));
+      for (uint8_t& value : garbage) {
+        value = static_cast<uint8_t>(rng.next());
+      }
+      // A false sync can complete by chance (one checksum in 256)
+      spurious += feed(codec, garbage);
+  
+      uint32_t repeats = 0;
+      bool found = false;
+      while (!found && repeats < MAX_RESYNC_REPEATS) {
+        repeats++;
+        for (uint8_t value : get) {
+          if (codec.parse(value)) {
+            found = codec.getCommand() == PacketCodec::PARAM_GET && codec.getLength() == 1 && codec.getPayload()[0] == 2;
+            spurious += found ? 0 : 1;
+          }
+        }
+      }
+      ok = ok && found;
+      worst = (repeats > worst) ? repeats : worst;
+    }
+    char detail[64];
+    snprintf(detail, sizeof(detail), "%u trials, worst %u requests, %u spurious",
+             static_cast<unsigned>(GARBAGE_TRIALS), static_cast<unsigned>(worst), static_cast<unsigned>(spurious));
+    report("resyncs after garbage", ok, detail);
+  }
+  
+  /**
+   * @brief Check malformed packets are dropped, counted and do not hide the next one
+   */
+  void checkMalformed() {
+    PacketCodec codec;
+    std::vector<uint8_t> ping = request(PacketCodec::PING, {});
+  
+    std::vector<uint8_t> corrupt = request(PacketCodec::PARAM_GET, { 1 });
+    corrupt.back()++;
+    bool checksumOk = feed(codec, corrupt) == 0 && codec.getBadPackets() == 1 && feed(codec, ping) == 1;
+    report("bad checksum dropped", checksumOk, "then PING parses");
+  
+    // Oversize length: the parser gives up at the length byte and skips the rest
+    std::vector<uint8_t> oversize = { PacketCodec::SYNC_REQUEST, PacketCodec::PARAM_SET, PacketCodec::MAX_REQUEST_PAYLOAD + 1 };
+    oversize.insert(oversize.end(), PacketCodec::MAX_REQUEST_PAYLOAD + 2, 0x11);
+    bool lengthOk = feed(codec, oversize) == 0 && codec.getBadPackets() == 2 && feed(codec, ping) == 1;
+    std::vector<uint8_t> longest(PacketCodec::MAX_REQUEST_PAYLOAD, 0x22);
+    lengthOk = lengthOk && feed(codec, request(PacketCodec::BATCH_RENDER, longest)) == 1 &&
+               codec.getLength() == PacketCodec::MAX_REQUEST_PAYLOAD && codec.getBadPackets() == 2;
+    char detail[64];
+    snprintf(detail, sizeof(detail), "length %u rejected, %u accepted",
+             static_cast<unsigned>(PacketCodec::MAX_REQUEST_PAYLOAD + 1), static_cast<unsigned>(PacketCodec::MAX_REQUEST_PAYLOAD));
+    report("oversize length dropped", lengthOk, detail);
+  }
+  
+  /**
+   * @brief Check PING and the parameter requests and their reply layouts
+   */
+  void checkParameterReplies() {
+    PacketCodec codec;
+    Parameters parameters;
+  
+    bool pingOk = exchange(codec, parameters, request(PacketCodec::PING, {})) && isFramed(codec, PacketCodec::PING, 3);
+    const uint8_t* out = codec.getPacket() + PacketCodec::PAYLOAD_OFFSET;
+    pingOk = pingOk && out[0] == PacketCodec::OK && out[1] == PacketCodec::VERSION && out[2] == 4;
+    report("PING reply", pingOk, "status, version, parameter count");
+  
+    bool infoOk = exchange(codec, parameters, request(PacketCodec::PARAM_INFO, { 1 })) &&
+                  isFramed(codec, PacketCodec::PARAM_INFO, 15 + 6);
+    infoOk = infoOk && out[0] == PacketCodec::OK && out[1] == 1 && out[2] == static_cast<uint8_t>(ParameterType::UINT16) &&
+             PacketCodec::readU32(out + 3) == 100 && PacketCodec::readU32(out + 7) == 5000 &&
+             PacketCodec::readU32(out + 11) == 1000 && memcmp(out + 15, "medium", 6) == 0;
+    report("PARAM_INFO reply", infoOk, "type, limits, value, name");
+  
+    bool getOk = exchange(codec, parameters, request(PacketCodec::PARAM_GET, { 3 })) &&
+                 isFramed(codec, PacketCodec::PARAM_GET, 6);
+    getOk = getOk && out[0] == PacketCodec::OK && out[1] == 3 &&
+            PacketCodec::readU32(out + 2) == ParameterRegistry::encodeFloat(1.0F);
+    report("PARAM_GET reply", getOk, "id, encoded value");
+  
+    bool setOk = exchange(codec, parameters, setRequest(2, 12345)) && isFramed(codec, PacketCodec::PARAM_SET, 6);
+    setOk = setOk && out[0] == PacketCodec::OK && out[1] == 2 && PacketCodec::readU32(out + 2) == 12345 &&
+            parameters.large == 12345;
+    report("PARAM_SET reply", setOk, "value in effect");
+  
+    // Wrong lengths and unknown IDs get a bare status
+    bool errorsOk = exchange(codec, parameters, request(PacketCodec::PARAM_GET, {})) &&
+                    isFramed(codec, PacketCodec::PARAM_GET, 1) && replyStatus(codec) == PacketCodec::BAD_LENGTH;
+    errorsOk = errorsOk && exchange(codec, parameters, request(PacketCodec::PARAM_SET, { 0, 1, 0, 0 })) &&
+               isFramed(codec, PacketCodec::PARAM_SET, 1) && replyStatus(codec) == PacketCodec::BAD_LENGTH;
+    errorsOk = errorsOk && exchange(codec, parameters, request(PacketCodec::PARAM_INFO, { 4 })) &&
+               isFramed(codec, PacketCodec::PARAM_INFO, 1) && replyStatus(codec) == PacketCodec::UNKNOWN_PARAMETER;
+    errorsOk = errorsOk && exchange(codec, parameters, setRequest(200, 1)) &&
+               isFramed(codec, PacketCodec::PARAM_SET, 1) && replyStatus(codec) == PacketCodec::UNKNOWN_PARAMETER;
+    report("parameter request errors", errorsOk, "BAD_LENGTH, UNKNOWN_PARAMETER");
+  }
+  
+  /**
+   * @brief Check every other request is left to SerialProtocol and framed with a bare status
+   */
+  void checkStatusReplies() {
+    PacketCodec codec;
+    Parameters parameters;
+    bool ok = true;
+    uint32_t commands = 0;
+    for (uint8_t command = PacketCodec::TELEMETRY; command <= PacketCodec::COLOR_BENCH; command++) {
+      ok = ok && feed(codec, request(command, { 1, 2 })) == 1 && !codec.answerParameterRequest(parameters.registry);
+      ok = ok && codec.getCommand() == command && codec.getLength() == 2;
+      codec.frameStatus(PacketCodec::OK);
+      ok = ok && isFramed(codec, command, 1) && replyStatus(codec) == PacketCodec::OK;
+      commands++;
+    }
+    // Unknown commands get the same framing
+    ok = ok && feed(codec, request(0x40, {})) == 1 && !codec.answerParameterRequest(parameters.registry);
+    codec.frameStatus(PacketCodec::UNKNOWN_COMMAND);
+    ok = ok && isFramed(codec, 0x40, 1) && replyStatus(codec) == PacketCodec::UNKNOWN_COMMAND;
+  
+    // Reports framed in place keep their own command
+    uint8_t* out = codec.getReplyPayload();
+    memset(out, 0x5A, PacketCodec::MAX_REPLY_PAYLOAD);
+    codec.frame(PacketCodec::TELEMETRY_REPORT, PacketCodec::MAX_REPLY_PAYLOAD);
+    const uint8_t* packet = codec.getPacket();
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < codec.getPacketLength() - 1; i++) {
+      sum += packet[i];
+    }
+    ok = ok && packet[1] == PacketCodec::TELEMETRY_REPORT && packet[2] == PacketCodec::MAX_REPLY_PAYLOAD &&
+         codec.getPacketLength() == PacketCodec::MAX_REPLY_PAYLOAD + PacketCodec::OVERHEAD &&
+         packet[codec.getPacketLength() - 1] == sum;
+    char detail[64];
+    snprintf(detail, sizeof(detail), "%u commands, unknown, full-size report", static_cast<unsigned>(commands));
+    report("status replies framed", ok, detail);
+  }
+  
+  /**
+   * @brief Check PARAM_SET only accepts values within the limits
+   */
+  void checkSetLimits() {
+    PacketCodec codec;
+    Parameters parameters;
+  
+    // Integers: just outside, then both limits
+    bool ok = exchange(codec, parameters, setRequest(0, 0)) && replyStatus(codec) == PacketCodec::OUT_OF_RANGE;
+    ok = ok && exchange(codec, parameters, setRequest(0, 11)) && replyStatus(codec) == PacketCodec::OUT_OF_RANGE;
+    ok = ok && exchange(codec, parameters, setRequest(0, 0x105)) && replyStatus(codec) == PacketCodec::OUT_OF_RANGE;
+    ok = ok && exchange(codec, parameters, setRequest(1, 99)) && replyStatus(codec) == PacketCodec::OUT_OF_RANGE;
+    ok = ok && exchange(codec, parameters, setRequest(1, 0x10000 + 1000)) && replyStatus(codec) == PacketCodec::OUT_OF_RANGE;
+    ok = ok && exchange(codec, parameters, setRequest(2, 100001)) && replyStatus(codec) == PacketCodec::OUT_OF_RANGE;
+    ok = ok && parameters.small == 5 && parameters.medium == 1000 && parameters.large == 70000;
+    ok = ok && exchange(codec, parameters, setRequest(0, 1)) && replyStatus(codec) == PacketCodec::OK && parameters.small == 1;
+    ok = ok && exchange(codec, parameters, setRequest(0, 10)) && replyStatus(codec) == PacketCodec::OK && parameters.small == 10;
+    ok = ok && exchange(codec, parameters, setRequest(1, 5000)) && replyStatus(codec) == PacketCodec::OK && parameters.medium == 5000;
+    report("PARAM_SET integer limits", ok, "outside rejected, limits accepted");
+  
+    // Floats: outside, NaN of either sign and infinities
+    const float rejected[] = { 0.49F, 2.01F, std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(),
+                               std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+    bool floatOk = true;
+    for (float value : rejected) {
+      floatOk = floatOk && exchange(codec, parameters, setRequest(3, ParameterRegistry::encodeFloat(value))) &&
+                replyStatus(codec) == PacketCodec::OUT_OF_RANGE && parameters.ratio == 1.0F;
+    }
+    // A signalling NaN bit pattern as a host might send it
+    floatOk = floatOk && exchange(codec, parameters, setRequest(3, 0x7F800001)) &&
+              replyStatus(codec) == PacketCodec::OUT_OF_RANGE && parameters.ratio == 1.0F;
+    floatOk = floatOk && exchange(codec, parameters, setRequest(3, ParameterRegistry::encodeFloat(2.0F))) &&
+              replyStatus(codec) == PacketCodec::OK && parameters.ratio == 2.0F;
+    floatOk = floatOk && exchange(codec, parameters, setRequest(3, ParameterRegistry::encodeFloat(0.5F))) &&
+              replyStatus(codec) == PacketCodec::OK && parameters.ratio == 0.5F && !std::isnan(parameters.ratio);
+    report("PARAM_SET float limits and NaN", floatOk, "NaN, infinities rejected");
+  }
+}
+
+int main() {
+  checkResync();
+  checkMalformed();
+  checkParameterReplies();
+  checkStatusReplies();
+  checkSetLimits();
+  return passed ? 0 : 1;
+}
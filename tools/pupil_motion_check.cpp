@@ -0,0 +1,213 @@
+/**
+ * @brief Host-side check of the pupil motion model against its analytic solution
+ *
+ * Steps include/PupilMotion.h through pursuit moves (including a target
+ * change while moving) and compares every step with the closed-form
+ * critically damped trajectory, checks that pursuit never overshoots, that
+ * saccades land exactly and on time, and that the trajectory does not
+ * depend on how steps are spread over frames. Prints the worst errors and
+ * the cost of a step, and exits with status 1 if any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o pupil_motion_check tools/pupil_motion_check.cpp src/PupilMotion.cpp
+ * Usage:  pupil_motion_check [tolerance-px]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "PupilMotion.h"
+
+namespace {
+  constexpr double STEP_S = PupilMotion::STEP_MS / 1000.0;
+  constexpr double ONE = 1 << PupilMotion::FRACTION_BITS;
+  
+  /**
+   * @brief Structure holding a critically damped trajectory segment
+   */
+  struct Segment {
+    double target;    // Target in pixels
+    double offset;    // Offset from the target at the segment start
+    double velocity;  // Velocity at the segment start in pixels per second
+    double rate;      // Spring rate in 1/s
+  
+    /**
+     * @brief Get the position
+     * @param t Time from the segment start in seconds
+     * @return Position in pixels
+     */
+    double position(double t) const {
+      return target + (offset + (velocity + rate * offset) * t) * exp(-rate * t);
+    }
+  
+    /**
+     * @brief Get the velocity
+     * @param t Time from the segment start in seconds
+     * @return Velocity in pixels per second
+     */
+    double speed(double t) const {
+      return (velocity - rate * (velocity + rate * offset) * t) * exp(-rate * t);
+    }
+  };
+  
+  /**
+   * @brief Compare pursuit from rest with the analytic solution, with one target change on the way
+   * @param rate Spring rate in 1/s
+   * @param first First target in pixels (within the saccade threshold)
+   * @param second Second target in pixels
+   * @param switchStep Step at which the target changes
+   * @param overshoot Receives whether the pupil went past a target it set off towards from rest
+   * @return Largest error in pixels
+   */
+  double checkPursuit(float rate, int16_t first, int16_t second, uint16_t switchStep, bool& overshoot) {
+    PupilMotion motion(rate);
+    motion.reset(0, 0);
+    motion.setTarget(first, -first);
+    Segment segment = { static_cast<double>(first), -static_cast<double>(first), 0.0, rate };
+  
+    double maxError = 0.0;
+    uint16_t segmentStart = 0;
+    for (uint16_t step = 1; step <= 200; step++) {
+      if (step - 1 == switchStep) {
+        double t = (switchStep - segmentStart) * STEP_S;
+        double position = segment.position(t);
+        segment = { static_cast<double>(second), position - second, segment.speed(t), rate };
+        segmentStart = switchStep;
+        motion.setTarget(second, -second);
+      }
+      motion.step(1);
+  
+      double expected = segment.position((step - segmentStart) * STEP_S);
+      double x = motion.getX() / ONE;
+      double y = motion.getY() / ONE;
+      maxError = fmax(maxError, fmax(fabs(x - expected), fabs(y + expected)));
+  
+      // Starting from rest, a critically damped spring never crosses its target (beyond rounding)
+      double past = (x - segment.target) * (segment.offset < 0.0 ? 1.0 : -1.0);
+      if (segment.velocity == 0.0 && past > 1.0 / 256.0) {
+        overshoot = true;
+      }
+    }
+    return maxError;
+  }
+  
+  /**
+   * @brief Check a saccade lands on its target when expected without turning back
+   * @param distance Distance in pixels
+   * @return true if it passed
+   */
+  bool checkSaccade(int16_t distance) {
+    PupilMotion motion;
+    motion.reset(0, 0);
+    motion.setTarget(distance, distance / 2);
+    if (!motion.isSaccading()) {
+      return false;
+    }
+  
+    uint32_t durationMs = PupilMotion::SACCADE_BASE_MS + distance * PupilMotion::SACCADE_MS_PER_8PX / 8;
+    uint16_t expectedSteps = static_cast<uint16_t>((durationMs + PupilMotion::STEP_MS - 1) / PupilMotion::STEP_MS);
+    int32_t previous = motion.getX();
+    uint16_t steps = 0;
+    while (motion.isSaccading() && steps < 1000) {
+      // Targets set in flight only apply after landing
+      motion.setTarget(0, 0);
+      motion.setTarget(distance, distance / 2);
+      motion.step(1);
+      steps++;
+      if (motion.getX() < previous) {
+        return false;
+      }
+      previous = motion.getX();
+    }
+    return steps == expectedSteps && motion.getPixelX() == distance && motion.getPixelY() == distance / 2 &&
+      motion.getX() == distance * ONE;
+  }
+  
+  /**
+   * @brief Check that spreading steps over uneven frames gives the same trajectory
+   * @return true if both runs end in the same place at every whole step
+   */
+  bool checkFrameIndependence() {
+    PupilMotion fixed;
+    PupilMotion uneven;
+    fixed.reset(0, 0);
+    uneven.reset(0, 0);
+  
+    uint32_t fixedTime = 0;
+    uint32_t unevenTime = 0;
+    uint32_t nowMs = 0;
+    srand(1);
+    for (uint16_t frame = 0; frame < 400; frame++) {
+      nowMs += 5 + rand() % 60;
+      int16_t target = (frame / 40) % 2 == 0 ? 30 : 2;
+      fixed.setTarget(target, 0);
+      uneven.setTarget(target, 0);
+  
+      // One whole step at a time, against everything at once
+      while (nowMs - fixedTime >= PupilMotion::STEP_MS) {
+        fixedTime += PupilMotion::STEP_MS;
+        fixed.step(1);
+      }
+      uneven.step(PupilMotion::takeSteps(nowMs, unevenTime));
+      if (fixed.getX() != uneven.getX() || fixedTime != unevenTime) {
+        return false;
+      }
+    }
+    return true;
+  }
+  
+  /**
+   * @brief Time pursuit steps
+   * @return Nanoseconds per step of one pupil
+   */
+  double measureStep() {
+    constexpr uint32_t STEPS = 10000000;
+    PupilMotion motion;
+    motion.reset(0, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < STEPS; i += 100) {
+      motion.setTarget(static_cast<int16_t>(i & 3), static_cast<int16_t>(-(i & 3)));
+      motion.step(100);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    volatile int32_t sink = motion.getX();
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / STEPS;
+  }
+}
+
+int main(int argc, char** argv) {
+  double tolerance = argc > 1 ? atof(argv[1]) : 0.05;
+  if (argc > 2 || tolerance <= 0.0) {
+    fprintf(stderr, "usage: %s [tolerance-px]\n", argv[0]);
+    return 1;
+  }
+  bool passed = true;
+  
+  printf("%-8s %7s %7s %7s %12s %10s\n", "rate/s", "first", "second", "switch", "max error px", "overshoot");
+  const float rates[] = { 10.0F, PupilMotion::PURSUIT_RATE, 60.0F };
+  const int16_t moves[][3] = { { 6, 6, 0 }, { 5, -1, 12 }, { -4, 1, 30 }, { 1, 0, 60 } };
+  for (float rate : rates) {
+    for (const int16_t* move : moves) {
+      bool overshoot = false;
+      double error = checkPursuit(rate, move[0], move[1], static_cast<uint16_t>(move[2]), overshoot);
+      bool ok = error <= tolerance && !overshoot;
+      passed = passed && ok;
+      printf("%-8.0f %7d %7d %7d %12.4f %10s%s\n", rate, move[0], move[1], move[2], error,
+             overshoot ? "yes" : "no", ok ? "" : "  FAIL");
+    }
+  }
+  
+  const int16_t distances[] = { 7, 20, 60, 120 };
+  for (int16_t distance : distances) {
+    bool ok = checkSaccade(distance);
+    passed = passed && ok;
+    printf("saccade %3d px: %s\n", distance, ok ? "lands on time" : "FAIL");
+  }
+  
+  bool independent = checkFrameIndependence();
+  passed = passed && independent;
+  printf("uneven frames: %s\n", independent ? "same trajectory" : "FAIL");
+  printf("pursuit step: %.1f ns per pupil\n", measureStep());
+  return passed ? 0 : 1;
+}
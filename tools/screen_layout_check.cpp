@@ -0,0 +1,198 @@
+/**
+ * @brief Host-side check of the mount rotation mappings
+ *
+ * Checks src/ScreenLayout.cpp for all four mount rotations: toPanel() maps
+ * the logical screen onto every panel pixel exactly once and toLogical()
+ * undoes it, rotate() does the same for an eye sprite's area, rotateRect()
+ * covers exactly the rotated pixels of random rectangles, and
+ * directionToLogical() turns vectors the way toLogical() turns points.
+ * The eye sprites must stay on screen apart from the columns a narrow
+ * (portrait) screen cannot hold.
+ * Exits with status 1 if any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o screen_layout_check tools/screen_layout_check.cpp src/ScreenLayout.cpp
+ * Usage:  screen_layout_check
+ */
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "FastRandom.h"
+#include "ScreenLayout.h"
+
+namespace {
+  // Eye sprite area (Eye::SPRITE_WIDTH x SPRITE_HEIGHT)
+  constexpr int32_t SPRITE_WIDTH = 121;
+  constexpr int32_t SPRITE_HEIGHT = 151;
+  constexpr uint32_t RECT_TRIALS = 2000;
+  
+  bool passed = true;
+  
+  /**
+   * @brief Record and print one check with a detail
+   */
+  void report(const char* name, bool ok, const char* detail) {
+    passed = passed && ok;
+    printf("%-40s %s  (%s)\n", name, ok ? "ok" : "FAIL", detail);
+  }
+  
+  /**
+   * @brief Check whether a rotation swaps width and height
+   */
+  bool isQuarterTurn(MountRotation rotation) {
+    return rotation == MountRotation::PORTRAIT || rotation == MountRotation::PORTRAIT_FLIPPED;
+  }
+  
+  /**
+   * @brief Check the screen mapping is a bijection onto the panel and toLogical() inverts it
+   */
+  bool checkScreen(const ScreenLayout& layout) {
+    std::vector<uint8_t> hits(ScreenLayout::PANEL_WIDTH * ScreenLayout::PANEL_HEIGHT, 0);
+    bool ok = layout.getWidth() * layout.getHeight() == ScreenLayout::PANEL_WIDTH * ScreenLayout::PANEL_HEIGHT;
+    for (int16_t y = 0; y < layout.getHeight(); y++) {
+      for (int16_t x = 0; x < layout.getWidth(); x++) {
+        Point logical(x, y);
+        Point panel = layout.toPanel(logical);
+        if (panel.x < 0 || panel.x >= ScreenLayout::PANEL_WIDTH || panel.y < 0 || panel.y >= ScreenLayout::PANEL_HEIGHT) {
+          return false;
+        }
+        hits[panel.y * ScreenLayout::PANEL_WIDTH + panel.x]++;
+        Point back = layout.toLogical(panel);
+        ok = ok && back.x == x && back.y == y;
+      }
+    }
+    for (uint8_t count : hits) {
+      ok = ok && count == 1;
+    }
+    return ok;
+  }
+  
+  /**
+   * @brief Check rotate() maps a sprite area onto its rotated area exactly once per pixel
+   */
+  bool checkArea(MountRotation rotation) {
+    int32_t rotatedWidth = isQuarterTurn(rotation) ? SPRITE_HEIGHT : SPRITE_WIDTH;
+    int32_t rotatedHeight = isQuarterTurn(rotation) ? SPRITE_WIDTH : SPRITE_HEIGHT;
+    std::vector<uint8_t> hits(SPRITE_WIDTH * SPRITE_HEIGHT, 0);
+    for (int16_t y = 0; y < SPRITE_HEIGHT; y++) {
+      for (int16_t x = 0; x < SPRITE_WIDTH; x++) {
+        Point rotated = ScreenLayout::rotate(rotation, Point(x, y), SPRITE_WIDTH, SPRITE_HEIGHT);
+        if (rotated.x < 0 || rotated.x >= rotatedWidth || rotated.y < 0 || rotated.y >= rotatedHeight) {
+          return false;
+        }
+        hits[rotated.y * rotatedWidth + rotated.x]++;
+      }
+    }
+    for (uint8_t count : hits) {
+      if (count != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+  
+  /**
+   * @brief Check rotated rectangles hold exactly the rotated pixels of the originals
+   */
+  bool checkRects(MountRotation rotation, uint32_t& checked) {
+    FastRandom rng(static_cast<uint32_t>(rotation) + 1);
+    bool ok = true;
+    for (uint32_t trial = 0; trial < RECT_TRIALS + 2; trial++) {
+      int32_t x, y, w, h;
+      if (trial == 0) {
+        // The whole area, then a single pixel in the last corner
+        x = 0, y = 0, w = SPRITE_WIDTH, h = SPRITE_HEIGHT;
+      } else if (trial == 1) {
+        x = SPRITE_WIDTH - 1, y = SPRITE_HEIGHT - 1, w = 1, h = 1;
+      } else {
+        x = rng.range(SPRITE_WIDTH);
+        y = rng.range(SPRITE_HEIGHT);
+        w = rng.range(1, SPRITE_WIDTH - x + 1);
+        h = rng.range(1, SPRITE_HEIGHT - y + 1);
+      }
+      int32_t rx = x, ry = y, rw = w, rh = h;
+      ScreenLayout::rotateRect(rotation, SPRITE_WIDTH, SPRITE_HEIGHT, rx, ry, rw, rh);
+      // Same area, and every pixel of the original lands inside
+      ok = ok && rw * rh == w * h;
+      for (int32_t py = y; py < y + h; py++) {
+        for (int32_t px = x; px < x + w; px++) {
+          Point rotated = ScreenLayout::rotate(rotation, Point(px, py), SPRITE_WIDTH, SPRITE_HEIGHT);
+          ok = ok && rotated.x >= rx && rotated.x < rx + rw && rotated.y >= ry && rotated.y < ry + rh;
+        }
+      }
+      checked++;
+    }
+  
+    // Empty rectangles are left alone
+    int32_t x = 5, y = 6, w = 0, h = 4;
+    ScreenLayout::rotateRect(rotation, SPRITE_WIDTH, SPRITE_HEIGHT, x, y, w, h);
+    return ok && x == 5 && y == 6 && w == 0 && h == 4;
+  }
+  
+  /**
+   * @brief Check directions turn like points, without the origin
+   */
+  bool checkDirections(const ScreenLayout& layout) {
+    const Point origin(100, 100);
+    const Point directions[] = { Point(1, 0), Point(0, 1), Point(-7, 3), Point(20, -45) };
+    bool ok = true;
+    for (const Point& direction : directions) {
+      Point moved = layout.toLogical(origin + direction) - layout.toLogical(origin);
+      Point turned = layout.directionToLogical(direction);
+      ok = ok && moved.x == turned.x && moved.y == turned.y;
+    }
+    return ok;
+  }
+  
+  /**
+   * @brief Check the eyes sit on the screen, side by side as seen by the viewer
+   * @param overhang Set to the sprite columns past the screen edges
+   */
+  bool checkEyes(const ScreenLayout& layout, int32_t& overhang) {
+    Point left = layout.getEyeCenter(0);
+    Point right = layout.getEyeCenter(1);
+    int32_t leftEdge = left.x - SPRITE_WIDTH / 2;
+    int32_t rightEdge = right.x + SPRITE_WIDTH / 2;
+    overhang = (leftEdge < 0 ? -leftEdge : 0) + (rightEdge >= layout.getWidth() ? rightEdge - layout.getWidth() + 1 : 0);
+    // Two sprites only fit side by side when the screen is wide enough; a narrower one clips only the excess
+    int32_t excess = 2 * SPRITE_WIDTH - layout.getWidth();
+    return left.x < right.x && left.y == right.y && left.x >= 0 && right.x < layout.getWidth() &&
+           overhang <= (excess > 0 ? excess : 0) && left.y - SPRITE_HEIGHT / 2 >= 0 &&
+           left.y + SPRITE_HEIGHT / 2 < layout.getHeight();
+  }
+}
+
+int main() {
+  for (uint8_t i = 0; i < ScreenLayout::NUM_OF_ROTATIONS; i++) {
+    MountRotation rotation = static_cast<MountRotation>(i);
+    ScreenLayout layout(rotation);
+    const char* name = ScreenLayout::getName(rotation);
+    char label[48];
+    char detail[64];
+  
+    snprintf(label, sizeof(label), "%s: screen round trip", name);
+    snprintf(detail, sizeof(detail), "%ux%u logical, every panel pixel once",
+             layout.getWidth(), layout.getHeight());
+    report(label, checkScreen(layout), detail);
+  
+    snprintf(label, sizeof(label), "%s: sprite area", name);
+    snprintf(detail, sizeof(detail), "%dx%d, every rotated pixel once",
+             static_cast<int>(SPRITE_WIDTH), static_cast<int>(SPRITE_HEIGHT));
+    report(label, checkArea(rotation), detail);
+  
+    uint32_t rects = 0;
+    bool rectsOk = checkRects(rotation, rects);
+    snprintf(label, sizeof(label), "%s: rectangles", name);
+    snprintf(detail, sizeof(detail), "%u rectangles and an empty one", static_cast<unsigned>(rects));
+    report(label, rectsOk, detail);
+  
+    snprintf(label, sizeof(label), "%s: directions", name);
+    report(label, checkDirections(layout), "same turn as toLogical");
+  
+    int32_t overhang = 0;
+    bool eyesOk = checkEyes(layout, overhang);
+    snprintf(label, sizeof(label), "%s: eyes", name);
+    snprintf(detail, sizeof(detail), "%d sprite columns off screen", static_cast<int>(overhang));
+    report(label, eyesOk, detail);
+  }
+  return passed ? 0 : 1;
+}
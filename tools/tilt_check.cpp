@@ -0,0 +1,342 @@
+/**
+ * @brief Host-side replay of recorded IMU traces through the tilt filter
+ *
+ * Replays a trace captured with "eyes_tune <device> imu <samples> <file>"
+ * through include/TiltFilter.h and through the same filter in double
+ * precision (with exact rotations), and prints the largest difference, how
+ * much the filter smooths the raw accelerometer, and the cost of an update.
+ * Exits with status 1 if the fixed-point filter strays from the reference
+ * by more than the tolerance.
+ *
+ * --synthesize writes a trace of a known motion first (slow tilting with
+ * sensor noise, gyro bias and a shake) and also checks the filter against
+ * the true tilt, so the filter can be checked without a device.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o tilt_check tools/tilt_check.cpp src/TiltFilter.cpp
+ * Usage:  tilt_check [--time-constant <ms>] [--tolerance <milli-g>] <trace-file>
+ *         tilt_check --synthesize <trace-file>
+ *
+ * Trace lines: time_ms ax_mg ay_mg az_mg gx_ddps gy_ddps gz_ddps (panel axes).
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "TiltFilter.h"
+
+namespace {
+  constexpr double GRAVITY_ONE = 1 << TiltFilter::GRAVITY_BITS;
+  constexpr double PI = 3.14159265358979323846;
+  constexpr uint32_t SAMPLE_INTERVAL_MS = 5;  // InputSampler::SAMPLE_INTERVAL_MS
+  
+  /**
+   * @brief Structure holding a gravity vector in g
+   */
+  struct Vector {
+    double x;
+    double y;
+    double z;
+  };
+  
+  /**
+   * @brief Read a trace file
+   * @param path Trace path
+   * @param samples Destination
+   * @return false if the file cannot be read
+   */
+  bool readTrace(const char* path, std::vector<ImuSample>& samples) {
+    FILE* input = fopen(path, "r");
+    if (input == nullptr) {
+      perror(path);
+      return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), input) != nullptr) {
+      unsigned time;
+      int values[6];
+      if (line[0] == '#' || sscanf(line, "%u %d %d %d %d %d %d", &time, &values[0], &values[1], &values[2],
+                                   &values[3], &values[4], &values[5]) != 7) {
+        continue;
+      }
+      ImuSample sample;
+      sample.timeMs = time;
+      for (uint8_t i = 0; i < 3; i++) {
+        sample.accel[i] = static_cast<int16_t>(values[i]);
+        sample.gyro[i] = static_cast<int16_t>(values[3 + i]);
+      }
+      samples.push_back(sample);
+    }
+    fclose(input);
+    return true;
+  }
+  
+  /**
+   * @brief Rotate a vector about an axis
+   * @param v Vector
+   * @param axis Rotation vector (direction is the axis, length the angle in radians)
+   * @return Rotated vector (Rodrigues' formula)
+   */
+  Vector rotate(const Vector& v, const Vector& axis) {
+    double angle = sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    if (angle == 0.0) {
+      return v;
+    }
+    Vector k = { axis.x / angle, axis.y / angle, axis.z / angle };
+    Vector cross = { k.y * v.z - k.z * v.y, k.z * v.x - k.x * v.z, k.x * v.y - k.y * v.x };
+    double dot = k.x * v.x + k.y * v.y + k.z * v.z;
+    double c = cos(angle);
+    double s = sin(angle);
+    return { v.x * c + cross.x * s + k.x * dot * (1 - c), v.y * c + cross.y * s + k.y * dot * (1 - c),
+             v.z * c + cross.z * s + k.z * dot * (1 - c) };
+  }
+  
+  /**
+   * @brief Double-precision counterpart of TiltFilter
+   */
+  class ReferenceFilter {
+  public:
+    /**
+     * @brief Constructor
+     * @param timeConstantMs Accelerometer time constant
+     */
+    explicit ReferenceFilter(double timeConstantMs) : timeConstantMs(timeConstantMs), started(false) {}
+  
+    /**
+     * @brief Fuse one reading
+     * @param sample Reading
+     */
+    void update(const ImuSample& sample) {
+      Vector accel = { clamp(sample.accel[0] / 1000.0), clamp(sample.accel[1] / 1000.0),
+                       clamp(sample.accel[2] / 1000.0) };
+      if (!started) {
+        gravity = accel;
+        lastTimeMs = sample.timeMs;
+        started = true;
+        return;
+      }
+      double stepMs = fmin(sample.timeMs - lastTimeMs, TiltFilter::MAX_STEP_MS);
+      lastTimeMs = sample.timeMs;
+  
+      // Gravity turns against the unit
+      double scale = -stepMs / 1000.0 * PI / 1800.0;
+      gravity = rotate(gravity, { sample.gyro[0] * scale, sample.gyro[1] * scale, sample.gyro[2] * scale });
+  
+      double magnitude = sqrt(static_cast<double>(sample.accel[0]) * sample.accel[0] +
+                              static_cast<double>(sample.accel[1]) * sample.accel[1] +
+                              static_cast<double>(sample.accel[2]) * sample.accel[2]);
+      if (fabs(magnitude - 1000.0) > TiltFilter::ACCEL_GATE_MILLI_G) {
+        return;
+      }
+      double weight = fmin(stepMs / fmax(timeConstantMs, TiltFilter::MAX_STEP_MS), 1.0);
+      gravity.x += (accel.x - gravity.x) * weight;
+      gravity.y += (accel.y - gravity.y) * weight;
+      gravity.z += (accel.z - gravity.z) * weight;
+    }
+  
+    /**
+     * @brief Get the estimated reaction to gravity
+     * @return Estimate in g
+     */
+    const Vector& get() const {
+      return gravity;
+    }
+  
+  private:
+    double timeConstantMs;              // Accelerometer time constant
+    bool started;                       // Whether gravity holds an estimate
+    uint32_t lastTimeMs = 0;            // Time of the previous reading
+    Vector gravity = { 0.0, 0.0, 0.0 }; // Estimate in g
+  
+    /**
+     * @brief Limit a reading like TiltFilter::toGravity()
+     * @param value Reading in g
+     * @return Reading limited to 2 g
+     */
+    static double clamp(double value) {
+      return fmax(-2.0, fmin(2.0, value));
+    }
+  };
+  
+  /**
+   * @brief Write a trace of a known motion
+   * @param path Trace path
+   * @param truth Receives the true gravity reaction at every sample
+   * @return false if the file cannot be written
+   */
+  bool synthesize(const char* path, std::vector<Vector>& truth) {
+    FILE* output = fopen(path, "w");
+    if (output == nullptr) {
+      perror(path);
+      return false;
+    }
+    fprintf(output, "# synthesized: rocking up to about 50 degrees, 20 mg / 0.3 deg/s noise, gyro bias, shake at 8 s\n");
+    fprintf(output, "# time_ms ax_mg ay_mg az_mg gx_ddps gy_ddps gz_ddps\n");
+  
+    std::mt19937 random(1);
+    std::normal_distribution<double> accelNoise(0.0, 20.0);
+    std::normal_distribution<double> gyroNoise(0.0, 3.0);
+    const double bias[3] = { 5.0, -4.0, 2.0 };  // 0.1 deg/s
+  
+    // Lying face up: in panel axes (z into the screen) the reaction to gravity points along -z
+    Vector gravity = { 0.0, 0.0, -1.0 };
+    for (uint32_t step = 0; step <= 20000 / SAMPLE_INTERVAL_MS; step++) {
+      uint32_t timeMs = step * SAMPLE_INTERVAL_MS;
+      double t = timeMs / 1000.0;
+  
+      // Rock about x and y at different rates, and turn slowly about z
+      double rates[3] = { 40.0 * sin(2.0 * PI * 0.25 * t), 55.0 * cos(2.0 * PI * 0.17 * t), 10.0 };
+      if (step > 0) {
+        double scale = -(SAMPLE_INTERVAL_MS / 1000.0) * PI / 180.0;
+        gravity = rotate(gravity, { rates[0] * scale, rates[1] * scale, rates[2] * scale });
+      }
+      truth.push_back(gravity);
+  
+      // A 300 ms shake adds large, fast-changing acceleration
+      Vector shake = { 0.0, 0.0, 0.0 };
+      if (t >= 8.0 && t < 8.3) {
+        shake = { 2.5 * sin(2.0 * PI * 12.0 * t), 1.5 * cos(2.0 * PI * 9.0 * t), 0.0 };
+      }
+      fprintf(output, "%u %d %d %d %d %d %d\n", timeMs,
+              static_cast<int>(lround((gravity.x + shake.x) * 1000.0 + accelNoise(random))),
+              static_cast<int>(lround((gravity.y + shake.y) * 1000.0 + accelNoise(random))),
+              static_cast<int>(lround((gravity.z + shake.z) * 1000.0 + accelNoise(random))),
+              static_cast<int>(lround(rates[0] * 10.0 + bias[0] + gyroNoise(random))),
+              static_cast<int>(lround(rates[1] * 10.0 + bias[1] + gyroNoise(random))),
+              static_cast<int>(lround(rates[2] * 10.0 + bias[2] + gyroNoise(random))));
+    }
+    fclose(output);
+    return true;
+  }
+  
+  /**
+   * @brief Get the largest component difference
+   * @param a First vector in g
+   * @param b Second vector in g
+   * @return Difference in milli-g
+   */
+  double difference(const Vector& a, const Vector& b) {
+    return fmax(fabs(a.x - b.x), fmax(fabs(a.y - b.y), fabs(a.z - b.z))) * 1000.0;
+  }
+  
+  /**
+   * @brief Get the fixed-point estimate in g
+   * @param filter Filter
+   * @return Estimate
+   */
+  Vector estimate(const TiltFilter& filter) {
+    return { filter.get(0) / GRAVITY_ONE, filter.get(1) / GRAVITY_ONE, filter.get(2) / GRAVITY_ONE };
+  }
+  
+  /**
+   * @brief Time filter updates
+   * @param samples Trace
+   * @param timeConstantMs Time constant
+   * @return Nanoseconds per update
+   */
+  double measureUpdate(const std::vector<ImuSample>& samples, uint16_t timeConstantMs) {
+    constexpr uint32_t PASSES = 200;
+    TiltFilter filter(timeConstantMs);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < PASSES; pass++) {
+      filter.reset();
+      for (const ImuSample& sample : samples) {
+        filter.update(sample);
+      }
+    }
+    auto stop = std::chrono::steady_clock::now();
+    volatile int32_t sink = filter.get(0);
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (PASSES * samples.size());
+  }
+}
+
+int main(int argc, char** argv) {
+  uint16_t timeConstantMs = TiltFilter::TIME_CONSTANT_MS;
+  double tolerance = 20.0;
+  const char* path = nullptr;
+  bool synthesized = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--time-constant") == 0 && i + 1 < argc) {
+      timeConstantMs = static_cast<uint16_t>(strtoul(argv[++i], nullptr, 0));
+    } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+      tolerance = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--synthesize") == 0) {
+      synthesized = true;
+    } else if (path == nullptr) {
+      path = argv[i];
+    } else {
+      path = nullptr;
+      break;
+    }
+  }
+  if (path == nullptr || tolerance <= 0.0) {
+    fprintf(stderr, "usage: %s [--time-constant <ms>] [--tolerance <milli-g>] <trace-file>\n"
+                    "       %s --synthesize <trace-file>\n", argv[0], argv[0]);
+    return 1;
+  }
+  
+  std::vector<Vector> truth;
+  if (synthesized && !synthesize(path, truth)) {
+    return 1;
+  }
+  std::vector<ImuSample> samples;
+  if (!readTrace(path, samples)) {
+    return 1;
+  }
+  if (samples.size() < 2) {
+    fprintf(stderr, "%s: no samples\n", path);
+    return 1;
+  }
+  printf("%zu samples over %.1f s, time constant %u ms\n", samples.size(),
+         (samples.back().timeMs - samples.front().timeMs) / 1000.0, timeConstantMs);
+  
+  TiltFilter filter(timeConstantMs);
+  ReferenceFilter reference(timeConstantMs);
+  double maxError = 0.0;
+  double maxTruthError = 0.0;
+  double rawJitter = 0.0;
+  double filteredJitter = 0.0;
+  uint32_t gaps = 0;
+  Vector previousRaw = { 0.0, 0.0, 0.0 };
+  Vector previousFiltered = { 0.0, 0.0, 0.0 };
+  for (size_t i = 0; i < samples.size(); i++) {
+    const ImuSample& sample = samples[i];
+    if (i > 0 && sample.timeMs - samples[i - 1].timeMs > 2 * SAMPLE_INTERVAL_MS) {
+      gaps++;
+    }
+    filter.update(sample);
+    reference.update(sample);
+    Vector fixed = estimate(filter);
+    maxError = fmax(maxError, difference(fixed, reference.get()));
+  
+    // Settled after a second; what remains against the truth is the filter's own lag and noise
+    if (i < truth.size() && sample.timeMs >= samples.front().timeMs + 1000) {
+      maxTruthError = fmax(maxTruthError, difference(fixed, truth[i]));
+    }
+  
+    Vector raw = { sample.accel[0] / 1000.0, sample.accel[1] / 1000.0, sample.accel[2] / 1000.0 };
+    if (i > 0) {
+      rawJitter += pow(difference(raw, previousRaw), 2.0);
+      filteredJitter += pow(difference(fixed, previousFiltered), 2.0);
+    }
+    previousRaw = raw;
+    previousFiltered = fixed;
+  }
+  
+  bool passed = maxError <= tolerance;
+  printf("gaps (dropped samples): %u\n", gaps);
+  printf("fixed point vs double reference: max %.2f mg%s\n", maxError, passed ? "" : "  FAIL");
+  printf("sample-to-sample change (rms): accelerometer %.2f mg, filter %.2f mg\n",
+         sqrt(rawJitter / (samples.size() - 1)), sqrt(filteredJitter / (samples.size() - 1)));
+  if (!truth.empty()) {
+    bool accurate = maxTruthError <= 3.0 * tolerance;
+    passed = passed && accurate;
+    printf("filter vs true tilt after 1 s: max %.2f mg%s\n", maxTruthError, accurate ? "" : "  FAIL");
+  }
+  printf("update: %.1f ns\n", measureUpdate(samples, timeConstantMs));
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/**
+ * @brief Host-side check of the touch state interpretation and coalescing
+ *
+ * Feeds src/TouchCoalescer.cpp the M5Stack touch state sequences the M5
+ * driver reports (gesture_check feeds the recogniser booleans, so it
+ * cannot see how the states are read). Every touching state must count
+ * as touching and every end state as a release. A hold that turns into a
+ * drag (hold_begin, hold, drag_begin, drag, drag_end) and a plain drag
+ * must each be one continuous touch: one begin edge, one end edge, no
+ * release before drag_end, and one gesture (a long press, or a drag
+ * begin with its end). Checked with one sample per batch and with
+ * several, as the render loop takes them from the queue.
+ * Exits with status 1 if any check fails.
+ *
+ * Build:  g++ -std=c++17 -O2 -Iinclude -o touch_check tools/touch_check.cpp src/TouchCoalescer.cpp src/GestureRecognizer.cpp
+ * Usage:  touch_check
+ */
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "TouchCoalescer.h"
+
+namespace {
+  constexpr uint32_t SAMPLE_MS = 10;  // InputSampler touch interval
+  constexpr int16_t MOVE_PX = 4;      // Movement per drag sample
+  
+  bool passed = true;
+  
+  /**
+   * @brief Structure holding what a sequence produced
+   */
+  struct Outcome {
+    uint32_t begins;                // Batches with a begin edge
+    uint32_t ends;                  // Batches with an end edge
+    uint32_t earlyReleases;         // Batches reported RELEASED before the last one
+    bool releasedLast;              // Last batch reported RELEASED
+    std::vector<GestureType> events; // Gestures in order
+  };
+  
+  /**
+   * @brief Record and print one check with a detail
+   */
+  void report(const char* name, bool ok, const char* detail) {
+    passed = passed && ok;
+    printf("%-40s %s  (%s)\n", name, ok ? "ok" : "FAIL", detail);
+  }
+  
+  /**
+   * @brief Make one sample of the first touch point
+   */
+  TouchSample makeSample(uint32_t timeMs, uint8_t state, int16_t x, int16_t y) {
+    TouchSample sample = {};
+    sample.timeMs = timeMs;
+    sample.state = state;
+    sample.count = (state & TouchCoalescer::STATE_TOUCH) ? 1 : 0;
+    sample.points[0] = Point(x, y);
+    return sample;
+  }
+  
+  /**
+   * @brief Make a touch held still, then dragged to the right
+   * @param holdFirst Whether the driver reports a hold before the drag
+   */
+  std::vector<TouchSample> makeSequence(bool holdFirst) {
+    std::vector<TouchSample> samples;
+    uint32_t time = 0;
+    int16_t x = 100;
+    const int16_t y = 120;
+    samples.push_back(makeSample(time, TouchCoalescer::STATE_TOUCH_BEGIN, x, y));
+    uint32_t stillMs = holdFirst ? 800 : 100;
+    for (time += SAMPLE_MS; time < stillMs; time += SAMPLE_MS) {
+      uint8_t state = TouchCoalescer::STATE_TOUCH;
+      if (holdFirst && time >= 500) {
+        state = (time == 500) ? TouchCoalescer::STATE_HOLD_BEGIN : TouchCoalescer::STATE_HOLD;
+      }
+      samples.push_back(makeSample(time, state, x, y));
+    }
+    for (uint8_t i = 0; i < 20; i++, time += SAMPLE_MS) {
+      x += MOVE_PX;
+      samples.push_back(makeSample(time, (i == 0) ? TouchCoalescer::STATE_DRAG_BEGIN : TouchCoalescer::STATE_DRAG, x, y));
+    }
+    samples.push_back(makeSample(time, TouchCoalescer::STATE_DRAG_END, x, y));
+    return samples;
+  }
+  
+  /**
+   * @brief Run a sequence through a coalescer in batches
+   * @param batchSize Samples per batch
+   */
+  Outcome run(const std::vector<TouchSample>& samples, size_t batchSize) {
+    TouchCoalescer coalescer;
+    Outcome outcome = {};
+    for (size_t first = 0; first < samples.size(); first += batchSize) {
+      coalescer.beginBatch();
+      TouchState state = TouchState::NONE;
+      size_t last = (first + batchSize < samples.size()) ? first + batchSize : samples.size();
+      for (size_t i = first; i < last; i++) {
+        state = coalescer.apply(samples[i]);
+      }
+      state = coalescer.endBatch(state, samples[last - 1].timeMs);
+      outcome.begins += coalescer.wasBegun() ? 1 : 0;
+      outcome.ends += coalescer.wasEnded() ? 1 : 0;
+      bool lastBatch = (last == samples.size());
+      if (state == TouchState::RELEASED) {
+        outcome.earlyReleases += lastBatch ? 0 : 1;
+        outcome.releasedLast = lastBatch;
+      }
+      GestureEvent event;
+      while (coalescer.takeGesture(event)) {
+        outcome.events.push_back(event.type);
+      }
+    }
+    return outcome;
+  }
+  
+  /**
+   * @brief Check that a sequence is one touch making one gesture
+   * @param gesture Gesture the touch must start, and the only one it may start
+   */
+  void checkContinuous(const char* name, const std::vector<TouchSample>& samples, size_t batchSize,
+                       GestureType gesture) {
+    Outcome outcome = run(samples, batchSize);
+    uint32_t starts = 0;
+    uint32_t dragBegins = 0;
+    uint32_t dragEnds = 0;
+    for (GestureType type : outcome.events) {
+      starts += (type == GestureType::TAP || type == GestureType::DOUBLE_TAP || type == GestureType::LONG_PRESS ||
+                 type == GestureType::DRAG_BEGIN) ? 1 : 0;
+      dragBegins += (type == GestureType::DRAG_BEGIN) ? 1 : 0;
+      dragEnds += (type == GestureType::DRAG_END) ? 1 : 0;
+    }
+    char detail[96];
+    snprintf(detail, sizeof(detail), "%u per batch: %u begins, %u ends, %u early releases, %u gestures",
+             static_cast<unsigned>(batchSize), static_cast<unsigned>(outcome.begins),
+             static_cast<unsigned>(outcome.ends), static_cast<unsigned>(outcome.earlyReleases),
+             static_cast<unsigned>(starts));
+    report(name, outcome.begins == 1 && outcome.ends == 1 && outcome.earlyReleases == 0 && outcome.releasedLast &&
+                 starts == 1 && !outcome.events.empty() && outcome.events.front() == gesture &&
+                 dragBegins == dragEnds, detail);
+  }
+}
+
+int main() {
+  // Bit 0 of a state is set while touching; bit 1 alone marks the release
+  uint32_t wrong = 0;
+  for (uint8_t state = 0; state < 16; state++) {
+    TouchState expected = (state & 0x01) ? TouchState::TOUCHING
+                        : (state & 0x02) ? TouchState::RELEASED
+                        : TouchState::NONE;
+    if (TouchCoalescer::interpretTouchState(state) != expected) {
+      printf("  state 0x%02X interpreted wrongly\n", state);
+      wrong++;
+    }
+  }
+  char detail[64];
+  snprintf(detail, sizeof(detail), "16 states, %u wrong", static_cast<unsigned>(wrong));
+  report("touch states interpreted", wrong == 0, detail);
+  
+  // A hold ignores movement, so a hold turned drag is one long press and nothing else
+  std::vector<TouchSample> holdThenDrag = makeSequence(true);
+  checkContinuous("hold then drag is one touch", holdThenDrag, 1, GestureType::LONG_PRESS);
+  checkContinuous("hold then drag is one touch, batched", holdThenDrag, 3, GestureType::LONG_PRESS);
+  
+  std::vector<TouchSample> drag = makeSequence(false);
+  checkContinuous("plain drag is one touch", drag, 1, GestureType::DRAG_BEGIN);
+  checkContinuous("plain drag is one touch, batched", drag, 3, GestureType::DRAG_BEGIN);
+  
+  return passed ? 0 : 1;
+}